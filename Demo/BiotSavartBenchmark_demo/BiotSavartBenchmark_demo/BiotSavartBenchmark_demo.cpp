@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <HBTK/CartesianPoint.h>
+#include <HBTK/CartesianVector.h>
+#include <HBTK/Constants.h>
+
+// Times the induced velocity of a set of straight vortex filaments on a set
+// of points using the HBTK Cartesian types, and compares this to the same
+// calculation written with raw std::array<double, 3> as a reference for the
+// cost of the arithmetic alone.
+
+namespace {
+	HBTK::CartesianVector3D biot_savart(
+		const HBTK::CartesianPoint3D & start, const HBTK::CartesianPoint3D & end,
+		const HBTK::CartesianPoint3D & point)
+	{
+		HBTK::CartesianVector3D r0 = end - start;
+		HBTK::CartesianVector3D r1 = point - start;
+		HBTK::CartesianVector3D r2 = point - end;
+		HBTK::CartesianVector3D r1xr2 = r1.cross(r2);
+		double denom = r1xr2.dot(r1xr2);
+		if (denom < 1e-12) { return HBTK::CartesianVector3D({ 0, 0, 0 }); }
+		double coeff = r0.dot(r1 / r1.magnitude() - r2 / r2.magnitude())
+			/ (4 * HBTK::Constants::pi() * denom);
+		return r1xr2 * coeff;
+	}
+
+	std::array<double, 3> biot_savart_raw(
+		const std::array<double, 3> & start, const std::array<double, 3> & end,
+		const std::array<double, 3> & point)
+	{
+		std::array<double, 3> r0, r1, r2, r1xr2;
+		for (int i = 0; i < 3; i++) {
+			r0[i] = end[i] - start[i];
+			r1[i] = point[i] - start[i];
+			r2[i] = point[i] - end[i];
+		}
+		r1xr2[0] = r1[1] * r2[2] - r1[2] * r2[1];
+		r1xr2[1] = r1[2] * r2[0] - r1[0] * r2[2];
+		r1xr2[2] = r1[0] * r2[1] - r1[1] * r2[0];
+		double denom = r1xr2[0] * r1xr2[0] + r1xr2[1] * r1xr2[1] + r1xr2[2] * r1xr2[2];
+		if (denom < 1e-12) { return std::array<double, 3>({ 0, 0, 0 }); }
+		double r1mag = sqrt(r1[0] * r1[0] + r1[1] * r1[1] + r1[2] * r1[2]);
+		double r2mag = sqrt(r2[0] * r2[0] + r2[1] * r2[1] + r2[2] * r2[2]);
+		double coeff = 0;
+		for (int i = 0; i < 3; i++) {
+			coeff += r0[i] * (r1[i] / r1mag - r2[i] / r2mag);
+		}
+		coeff /= 4 * HBTK::Constants::pi() * denom;
+		return std::array<double, 3>({ r1xr2[0] * coeff, r1xr2[1] * coeff, r1xr2[2] * coeff });
+	}
+}
+
+int main()
+{
+	std::cout << "BiotSavartBenchmark demo\n\n";
+
+	const int num_filaments = 2000;
+	const int num_points = 2000;
+
+	std::vector<HBTK::CartesianPoint3D> fil_ends(num_filaments + 1), points(num_points);
+	std::vector<std::array<double, 3>> fil_ends_raw(num_filaments + 1), points_raw(num_points);
+	for (int i = 0; i <= num_filaments; i++) {
+		double t = i / (double)num_filaments;
+		fil_ends[i] = HBTK::CartesianPoint3D({ cos(6 * t), sin(6 * t), t });
+		fil_ends_raw[i] = fil_ends[i].as_array();
+	}
+	for (int i = 0; i < num_points; i++) {
+		double t = i / (double)num_points;
+		points[i] = HBTK::CartesianPoint3D({ 0.5 * cos(17 * t), 0.5 * sin(13 * t), 2 * t - 0.5 });
+		points_raw[i] = points[i].as_array();
+	}
+
+	std::vector<HBTK::CartesianVector3D> vel(num_points, HBTK::CartesianVector3D({ 0, 0, 0 }));
+	auto start = std::chrono::steady_clock::now();
+	for (int j = 0; j < num_points; j++) {
+		for (int i = 0; i < num_filaments; i++) {
+			vel[j] += biot_savart(fil_ends[i], fil_ends[i + 1], points[j]);
+		}
+	}
+	auto end = std::chrono::steady_clock::now();
+	double time_hbtk = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+
+	std::vector<std::array<double, 3>> vel_raw(num_points, std::array<double, 3>({ 0, 0, 0 }));
+	start = std::chrono::steady_clock::now();
+	for (int j = 0; j < num_points; j++) {
+		for (int i = 0; i < num_filaments; i++) {
+			std::array<double, 3> v = biot_savart_raw(fil_ends_raw[i], fil_ends_raw[i + 1], points_raw[j]);
+			for (int k = 0; k < 3; k++) { vel_raw[j][k] += v[k]; }
+		}
+	}
+	end = std::chrono::steady_clock::now();
+	double time_raw = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+
+	double max_diff = 0;
+	for (int j = 0; j < num_points; j++) {
+		for (int k = 0; k < 3; k++) {
+			max_diff = std::max(max_diff, std::abs(vel[j].as_array()[k] - vel_raw[j][k]));
+		}
+	}
+
+	double interactions = (double)num_filaments * num_points;
+	std::cout << "Filament-point interactions:\t" << interactions << "\n";
+	std::cout << "HBTK Cartesian types:\t" << time_hbtk << " s\t("
+		<< interactions / time_hbtk * 1e-6 << " M/s)\n";
+	std::cout << "Raw std::array:\t\t" << time_raw << " s\t("
+		<< interactions / time_raw * 1e-6 << " M/s)\n";
+	std::cout << "Max difference:\t\t" << max_diff << "\n";
+	return 0;
+}
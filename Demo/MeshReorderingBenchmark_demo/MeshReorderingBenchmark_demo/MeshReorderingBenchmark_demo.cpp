@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <HBTK/CartesianPoint.h>
+#include <HBTK/MeshReordering.h>
+#include <HBTK/VtkUnstructuredMeshHolder.h>
+
+// Builds a hexahedral grid with randomly numbered points and cells, as a 
+// mesher that doesn't care about locality might, then times an element sweep
+// (gather the nodes of each element, accumulate the centroid) before and
+// after renumbering with reverse Cuthill-McKee, Hilbert and Morton orderings.
+
+namespace {
+	HBTK::Vtk::VtkUnstructuredMeshHolder shuffled_grid(int n)
+	{
+		std::mt19937 gen(1);
+		const int np = n + 1;
+		std::vector<int> point_numbers(np * np * np), cell_order(n * n * n);
+		std::iota(point_numbers.begin(), point_numbers.end(), 0);
+		std::iota(cell_order.begin(), cell_order.end(), 0);
+		std::shuffle(point_numbers.begin(), point_numbers.end(), gen);
+		std::shuffle(cell_order.begin(), cell_order.end(), gen);
+
+		HBTK::Vtk::VtkUnstructuredMeshHolder mesh;
+		mesh.points.resize(point_numbers.size());
+		for (int i = 0; i < np; i++) {
+			for (int j = 0; j < np; j++) {
+				for (int k = 0; k < np; k++) {
+					mesh.points[point_numbers[(i * np + j) * np + k]] = 
+						HBTK::CartesianPoint3D({ (double)i, (double)j, (double)k });
+				}
+			}
+		}
+		mesh.cells.reserve(cell_order.size());
+		for (int c : cell_order) {
+			int i = c / (n * n), j = (c / n) % n, k = c % n;
+			auto p = [&](int a, int b, int d) { return point_numbers[((i + a) * np + j + b) * np + k + d]; };
+			mesh.cells.push_back({ HBTK::Vtk::VTK_HEXAHEDRON,
+				{ p(0, 0, 0), p(1, 0, 0), p(1, 1, 0), p(0, 1, 0), p(0, 0, 1), p(1, 0, 1), p(1, 1, 1), p(0, 1, 1) } });
+		}
+		return mesh;
+	}
+
+	void report(const std::string & name, const HBTK::Vtk::VtkUnstructuredMeshHolder & mesh)
+	{
+		std::vector<int> offsets, nodes;
+		mesh.cell_connectivity(offsets, nodes);
+		HBTK::LocalityReport locality = HBTK::locality_report(offsets, nodes);
+
+		// The sweep runs on the flat connectivity so that only the ordering differs.
+		const int repeats = 10;
+		double checksum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < repeats; r++) {
+			for (int e = 0; e + 1 < (int)offsets.size(); e++) {
+				double x = 0, y = 0, z = 0;
+				for (int i = offsets[e]; i < offsets[e + 1]; i++) {
+					const HBTK::CartesianPoint3D & point = mesh.points[nodes[i]];
+					x += point.x();
+					y += point.y();
+					z += point.z();
+				}
+				checksum += x + 2 * y + 3 * z;
+			}
+		}
+		auto end = std::chrono::steady_clock::now();
+		double time = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+
+		std::cout << name << "\tbandwidth " << locality.bandwidth 
+			<< "\tmean span " << locality.mean_element_span
+			<< "\tmean jump " << locality.mean_element_jump
+			<< "\tsweep " << time / repeats * 1e3 << " ms"
+			<< "\t(checksum " << checksum << ")\n";
+	}
+
+	void reorder(HBTK::Vtk::VtkUnstructuredMeshHolder & mesh, const std::vector<int> & point_order)
+	{
+		mesh.reorder_points(point_order);
+		std::vector<int> offsets, nodes;
+		mesh.cell_connectivity(offsets, nodes);
+		mesh.reorder_cells(HBTK::element_order_by_nodes(offsets, nodes));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::cout << "MeshReorderingBenchmark demo\n\n";
+	const int n = argc > 1 ? std::stoi(argv[1]) : 80;
+	HBTK::Vtk::VtkUnstructuredMeshHolder original = shuffled_grid(n);
+	std::cout << original.points.size() << " points, " << original.cells.size() << " hexahedra\n\n";
+	report("Shuffled", original);
+
+	HBTK::Vtk::VtkUnstructuredMeshHolder mesh = original;
+	std::vector<int> offsets, nodes;
+	mesh.cell_connectivity(offsets, nodes);
+	auto start = std::chrono::steady_clock::now();
+	std::vector<int> order = HBTK::reverse_cuthill_mckee((int)mesh.points.size(), offsets, nodes);
+	auto end = std::chrono::steady_clock::now();
+	reorder(mesh, order);
+	report("RCM\t", mesh);
+	std::cout << "\t\t(ordering took " 
+		<< std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count() << " s)\n";
+
+	mesh = original;
+	start = std::chrono::steady_clock::now();
+	order = HBTK::hilbert_order(mesh.points);
+	end = std::chrono::steady_clock::now();
+	reorder(mesh, order);
+	report("Hilbert\t", mesh);
+	std::cout << "\t\t(ordering took " 
+		<< std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count() << " s)\n";
+
+	mesh = original;
+	start = std::chrono::steady_clock::now();
+	order = HBTK::morton_order(mesh.points);
+	end = std::chrono::steady_clock::now();
+	reorder(mesh, order);
+	report("Morton\t", mesh);
+	std::cout << "\t\t(ordering took " 
+		<< std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count() << " s)\n";
+	return 0;
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <HBTK/GmshParser.h>
+#include <HBTK/NumberParsing.h>
+
+// Times converting the numeric fields of a Gmsh mesh (by default the test
+// mesh in test/res) to doubles with std::stod, strtod and HBTK::to_double,
+// and then the whole file with GmshParser. Usage:
+//	NumberParsingBenchmark_demo [path to .msh]
+
+namespace {
+	template<typename TFunc>
+	double time_passes(int passes, const std::vector<std::string> & fields, double & checksum, TFunc func)
+	{
+		checksum = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (int pass = 0; pass < passes; pass++) {
+			for (auto & field : fields) { checksum += func(field); }
+		}
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+	}
+}
+
+int main(int argc, char * argv[])
+{
+	std::cout << "NumberParsingBenchmark demo\n\n";
+
+	std::string path = argc > 1 ? argv[1] : "../test/res/GMSH_test_file_1.msh";
+	std::ifstream file(path);
+	if (!file) {
+		std::cout << "Could not open " << path << "\n";
+		return 1;
+	}
+	std::stringstream contents;
+	contents << file.rdbuf();
+	const std::string text = contents.str();
+
+	// Every whitespace separated field that is a number.
+	std::vector<std::string> fields;
+	std::istringstream words(text);
+	std::string word;
+	while (words >> word) {
+		double value;
+		if (HBTK::parse_number(word.data(), word.data() + word.size(), value) == word.data() + word.size()) {
+			fields.push_back(word);
+		}
+	}
+	if (fields.empty()) {
+		std::cout << "No numbers in " << path << "\n";
+		return 1;
+	}
+
+	const int passes = std::max(1, 20000000 / (int)fields.size());
+	const double count = (double)passes * fields.size();
+	double sum_stod, sum_strtod, sum_hbtk;
+	double time_stod = time_passes(passes, fields, sum_stod,
+		[](const std::string & str) { return std::stod(str); });
+	double time_strtod = time_passes(passes, fields, sum_strtod,
+		[](const std::string & str) { return strtod(str.c_str(), nullptr); });
+	double time_hbtk = time_passes(passes, fields, sum_hbtk,
+		[](const std::string & str) { return HBTK::to_double(str); });
+
+	std::cout << "Numeric fields:\t\t" << fields.size() << " x " << passes << " passes\n";
+	std::cout << "std::stod:\t\t" << time_stod << " s\t(" << count / time_stod * 1e-6 << " M/s)\n";
+	std::cout << "strtod:\t\t\t" << time_strtod << " s\t(" << count / time_strtod * 1e-6 << " M/s)\n";
+	std::cout << "HBTK::to_double:\t" << time_hbtk << " s\t(" << count / time_hbtk * 1e-6 << " M/s)\n";
+	std::cout << "Results agree:\t\t" << (sum_stod == sum_hbtk && sum_strtod == sum_hbtk ? "yes" : "NO") << "\n";
+
+	const int file_passes = std::max(1, 20000000 / (int)text.size());
+	int nodes = 0;
+	HBTK::Gmsh::GmshParser parser;
+	parser.add_node_function([&](int, double, double, double) { nodes++; return true; });
+	auto start = std::chrono::steady_clock::now();
+	for (int pass = 0; pass < file_passes; pass++) {
+		std::ifstream mesh_file(path);
+		parser.parse(mesh_file);
+	}
+	auto end = std::chrono::steady_clock::now();
+	double time_file = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+	std::cout << "\nGmshParser:\t\t" << file_passes * text.size() / time_file * 1e-6 << " MB/s ("
+		<< nodes / file_passes << " nodes)\n";
+	return 0;
+}
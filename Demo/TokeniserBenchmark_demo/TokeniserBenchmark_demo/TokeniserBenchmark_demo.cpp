@@ -0,0 +1,93 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <HBTK/BasicTokeniser.h>
+#include <HBTK/BufferedTokeniser.h>
+
+// Times tokenising a large synthetic input deck (a Gmsh style node list) 
+// with BasicTokeniser and BufferedTokeniser, reading both the Token 
+// strings and the StringView text of each token, and with BufferedTokeniser
+// parsing the numbers as it goes.
+
+namespace {
+	std::string make_deck(int num_lines)
+	{
+		std::ostringstream deck;
+		deck << "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n$Nodes\n" << num_lines << "\n";
+		for (int i = 0; i < num_lines; i++) {
+			deck << i + 1 << " " << 0.001 * i << " " << -0.5 * i << " " << 1.25e-3 * i 
+				<< " node_" << i % 17 << "\n";
+		}
+		deck << "$EndNodes\n";
+		return deck.str();
+	}
+
+	template<typename TFunc>
+	double time_run(TFunc && func, long long & count)
+	{
+		auto start = std::chrono::steady_clock::now();
+		count = func();
+		auto end = std::chrono::steady_clock::now();
+		return std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+	}
+}
+
+int main()
+{
+	std::cout << "TokeniserBenchmark demo\n\n";
+	const std::string deck = make_deck(200000);
+	std::cout << "Input:\t\t\t" << deck.size() * 1e-6 << " MB\n";
+
+	long long basic_count, buffered_count, view_count, number_count;
+	double basic_time = time_run([&]() {
+		HBTK::BasicTokeniser tokeniser(deck);
+		long long count = 0, chars = 0;
+		while (!tokeniser.eof()) {
+			chars += tokeniser.next().value().size();
+			count++;
+		}
+		return count + 0 * chars;
+	}, basic_count);
+	double buffered_time = time_run([&]() {
+		HBTK::BufferedTokeniser tokeniser(deck);
+		long long count = 0, chars = 0;
+		while (!tokeniser.eof()) {
+			chars += tokeniser.next().value().size();
+			count++;
+		}
+		return count + 0 * chars;
+	}, buffered_count);
+	double view_time = time_run([&]() {
+		HBTK::BufferedTokeniser tokeniser(deck);
+		long long count = 0, chars = 0;
+		while (!tokeniser.eof()) {
+			tokeniser.next();
+			chars += tokeniser.view().size();
+			count++;
+		}
+		return count + 0 * chars;
+	}, view_count);
+	double number_sum = 0;
+	double number_time = time_run([&]() {
+		HBTK::BufferedTokeniser tokeniser(deck, true);
+		long long count = 0;
+		while (!tokeniser.eof()) {
+			const HBTK::Token & token = tokeniser.next();
+			if (token.isnum()) { number_sum += token.number(); }
+			count++;
+		}
+		return count;
+	}, number_count);
+
+	std::cout << "BasicTokeniser:\t\t" << basic_count << " tokens\t" << basic_time << " s\t("
+		<< basic_count / basic_time * 1e-6 << " M tokens/s)\n";
+	std::cout << "BufferedTokeniser:\t" << buffered_count << " tokens\t" << buffered_time << " s\t("
+		<< buffered_count / buffered_time * 1e-6 << " M tokens/s)\n";
+	std::cout << "BufferedTokeniser views:\t" << view_count << " tokens\t" << view_time << " s\t("
+		<< view_count / view_time * 1e-6 << " M tokens/s)\n";
+	std::cout << "With number parsing:\t" << number_count << " tokens\t" << number_time << " s\t("
+		<< number_count / number_time * 1e-6 << " M tokens/s, checksum " << number_sum << ")\n";
+	return (basic_count == buffered_count && buffered_count == view_count) ? 0 : 1;
+}
@@ -26,8 +26,10 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <string>
+#include <vector>
 
 #include "AerofoilGeometry.h"
+#include "AerofoilSectionSet.h"
 
 namespace HBTK {
 	namespace AerofoilGenerators {
@@ -42,6 +44,15 @@ namespace HBTK {
 		// percent of chord.
 		AerofoilGeometry naca_four_digit(double thickness, double camber, double camber_position);
 		AerofoilGeometry naca_four_digit(std::string name);
+		// Generate many NACA 4 digit sections at x_points, in parallel. 
+		// Section i has parameters thickness[i], camber[i] and camber_position[i].
+		AerofoilSectionSet naca_four_digit(const std::vector<double> & thickness, 
+			const std::vector<double> & camber, const std::vector<double> & camber_position,
+			const std::vector<double> & x_points, int num_threads = 0);
+
+		// number_of_points chordwise points from 0 to 1, clustered at the 
+		// leading and trailing edges.
+		std::vector<double> cosine_chord_points(int number_of_points);
 
 		// Generate the SD7003-il aerofoil. Why this specifically? Because I use it. Duh.
 		AerofoilGeometry sd7003(void);
@@ -0,0 +1,100 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+AerofoilSectionSet.h
+
+Many aerofoil sections stored together, and a cache of aerofoil camber and
+thickness splines.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AerofoilGeometry.h"
+#include "CubicSpline1D.h"
+
+namespace HBTK {
+	// Sections sharing one set of chordwise points, stored as contiguous 
+	// camber and thickness arrays: section s has camber 
+	// camber(s)[i] at x_points()[i]. Surfaces are z = camber +- thickness / 2,
+	// as for AerofoilGeometry::add_camber and add_thickness.
+	class AerofoilSectionSet {
+	public:
+		AerofoilSectionSet();
+		// x_points must increase from 0 to 1.
+		AerofoilSectionSet(std::vector<double> x_points);
+
+		int number_of_sections() const;
+		int number_of_points() const;
+		const std::vector<double> & x_points() const;
+
+		// Add sections with no camber or thickness. Returns the index of
+		// the first new section.
+		int add_sections(int number);
+
+		double * camber(int section);
+		const double * camber(int section) const;
+		double * thickness(int section);
+		const double * thickness(int section) const;
+
+		// Surface coordinates of a section at x_points(), written to z.
+		void z_upper(int section, double * z) const;
+		void z_lower(int section, double * z) const;
+
+		// A section as an AerofoilGeometry.
+		AerofoilGeometry geometry(int section) const;
+
+	private:
+		std::vector<double> m_x_points;
+		std::vector<double> m_camber;
+		std::vector<double> m_thickness;
+	};
+
+	// Camber and thickness splines of NACA four digit aerofoils, built on 
+	// first request and kept by parameters, so that repeated requests cost 
+	// only a lookup. Safe to use from several threads. References remain 
+	// valid until clear() is called or the cache is destroyed.
+	class AerofoilSplineCache {
+	public:
+		struct Splines {
+			CubicSpline1D camber;
+			CubicSpline1D thickness;
+		};
+
+		// Splines are fitted to number_of_points cosine spaced points.
+		AerofoilSplineCache(int number_of_points = 60);
+
+		// Parameters as AerofoilGenerators::naca_four_digit.
+		Splines & naca_four_digit(double thickness, double camber, double camber_position);
+
+		int size() const;
+		void clear();
+
+	private:
+		int m_number_of_points;
+		mutable std::mutex m_mutex;
+		std::map<std::array<double, 3>, std::unique_ptr<Splines>> m_splines;
+	};
+}
@@ -0,0 +1,415 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+AutomaticDifferentiation.h
+
+Forward mode automatic differentiation and complex step derivatives.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <ostream>
+
+namespace HBTK {
+	// DECLARATIONS
+
+	// Dual and its functions are in their own namespace, where only Dual 
+	// arguments find them, so they don't hide <cmath> from HBTK's templates.
+	namespace AutomaticDifferentiation {
+		/// \brief A value and its derivatives with respect to N inputs.
+		///
+		/// Forward mode automatic differentiation: arithmetic and the functions 
+		/// below carry the derivatives (tangents) through by the chain rule, so 
+		/// one evaluation gives exact derivatives with respect to all N inputs.
+		/// Use as the Ty of HBTK's templates (PotentialFlowDistributions.h, 
+		/// Remaps.h, Integrators.h...):
+		/// \code
+		/// #include "HBTK/AutomaticDifferentiation.h"
+		/// #include "HBTK/PotentialFlowDistributions.h"
+		/// // d/dx and d/dy of the velocity at (1, 2) due to a vortex at (0, 0).
+		/// HBTK::Dual<double, 2> x = HBTK::Dual<double, 2>::variable(1., 0);
+		/// HBTK::Dual<double, 2> y = HBTK::Dual<double, 2>::variable(2., 1);
+		/// auto u = HBTK::PointVortex::unity_u_vel<HBTK::Dual<double, 2>>(x, y, 0., 0.);
+		/// double du_dx = u.tangent(0), du_dy = u.tangent(1);
+		/// \endcode
+		/// Comparisons compare values only.
+		template<typename Ty, int N = 1>
+		class Dual {
+		public:
+			typedef Ty value_type;
+			static_assert(N > 0, "HBTK::Dual needs at least one tangent.");
+
+			constexpr Dual() : m_value(0), m_tangents() {}
+			// A constant.
+			constexpr Dual(Ty value) : m_value(value), m_tangents() {}
+			Dual(Ty value, const std::array<Ty, N> & tangents) : m_value(value), m_tangents(tangents) {}
+
+			// An input: a unit tangent in direction 0 to N - 1.
+			static Dual variable(Ty value, int direction = 0);
+
+			Ty & value() { return m_value; }
+			const Ty & value() const { return m_value; }
+			Ty & tangent(int direction) { return m_tangents[direction]; }
+			const Ty & tangent(int direction) const { return m_tangents[direction]; }
+			std::array<Ty, N> & tangents() { return m_tangents; }
+			const std::array<Ty, N> & tangents() const { return m_tangents; }
+
+			// f(this), given f(value()) and f'(value()), by the chain rule.
+			Dual apply(Ty f, Ty derivative) const;
+
+			Dual & operator+=(const Dual & other);
+			Dual & operator-=(const Dual & other);
+			Dual & operator*=(const Dual & other);
+			Dual & operator/=(const Dual & other);
+			Dual & operator+=(Ty other) { m_value += other; return *this; }
+			Dual & operator-=(Ty other) { m_value -= other; return *this; }
+			Dual & operator*=(Ty other);
+			Dual & operator/=(Ty other) { return *this *= 1 / other; }
+
+			Dual operator+() const { return *this; }
+			Dual operator-() const { return *this * Ty(-1); }
+
+			// Friends, so that constants convert to Dual.
+			friend Dual operator+(Dual a, const Dual & b) { return a += b; }
+			friend Dual operator-(Dual a, const Dual & b) { return a -= b; }
+			friend Dual operator*(Dual a, const Dual & b) { return a *= b; }
+			friend Dual operator/(Dual a, const Dual & b) { return a /= b; }
+			friend Dual operator+(Dual a, Ty b) { return a += b; }
+			friend Dual operator-(Dual a, Ty b) { return a -= b; }
+			friend Dual operator*(Dual a, Ty b) { return a *= b; }
+			friend Dual operator/(Dual a, Ty b) { return a /= b; }
+			friend Dual operator+(Ty a, Dual b) { return b += a; }
+			friend Dual operator-(Ty a, const Dual & b) { return -b + a; }
+			friend Dual operator*(Ty a, Dual b) { return b *= a; }
+			friend Dual operator/(Ty a, const Dual & b) { return Dual(a) / b; }
+
+			friend bool operator==(const Dual & a, const Dual & b) { return a.m_value == b.m_value; }
+			friend bool operator!=(const Dual & a, const Dual & b) { return a.m_value != b.m_value; }
+			friend bool operator<(const Dual & a, const Dual & b) { return a.m_value < b.m_value; }
+			friend bool operator>(const Dual & a, const Dual & b) { return a.m_value > b.m_value; }
+			friend bool operator<=(const Dual & a, const Dual & b) { return a.m_value <= b.m_value; }
+			friend bool operator>=(const Dual & a, const Dual & b) { return a.m_value >= b.m_value; }
+
+		private:
+			Ty m_value;
+			std::array<Ty, N> m_tangents;
+		};
+
+		template<typename Ty, int N> Dual<Ty, N> sqrt(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> cbrt(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> exp(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> log(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> sin(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> cos(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> tan(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> asin(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> acos(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> atan(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> atan2(const Dual<Ty, N> & y, const Dual<Ty, N> & x);
+		template<typename Ty, int N> Dual<Ty, N> sinh(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> cosh(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> tanh(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> abs(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> fabs(const Dual<Ty, N> & a);
+		template<typename Ty, int N> Dual<Ty, N> hypot(const Dual<Ty, N> & a, const Dual<Ty, N> & b);
+		template<typename Ty, int N> Dual<Ty, N> pow(const Dual<Ty, N> & a, const Dual<Ty, N> & b);
+		template<typename Ty, int N> Dual<Ty, N> pow(const Dual<Ty, N> & a, typename Dual<Ty, N>::value_type b);
+		template<typename Ty, int N> Dual<Ty, N> pow(const Dual<Ty, N> & a, int b);
+		template<typename Ty, int N> Dual<Ty, N> pow(typename Dual<Ty, N>::value_type a, const Dual<Ty, N> & b);
+
+		template<typename Ty, int N> std::ostream & operator<<(std::ostream & stream, const Dual<Ty, N> & a);
+	}
+
+	using AutomaticDifferentiation::Dual;
+
+	template<typename Ty, int N> bool check_finite(const Dual<Ty, N> & a);
+
+	/// \brief The derivative of a function at position, with one evaluation
+	/// of function using Dual<TIn>.
+	template<typename TFunc, typename TIn>
+	TIn forward_derivative(TFunc function, TIn position);
+
+	/// \brief The gradient of a function of N inputs at position, with one
+	/// evaluation of function using Dual<TIn, N>.
+	template<typename TFunc, typename TIn, size_t N>
+	std::array<TIn, N> forward_gradient(TFunc function, const std::array<TIn, N> & position);
+
+	/// \brief The derivative of a function at position by the complex step 
+	/// method: Im(f(x + ih)) / h. 
+	///
+	/// function must be complex analytic (no abs, comparisons or atan2 of 
+	/// complex values), but the result has no subtractive cancellation, so 
+	/// h can be tiny and the result is exact to rounding. Prefer 
+	/// forward_derivative for HBTK's templates.
+	template<typename TFunc, typename TIn>
+	TIn complex_step_derivative(TFunc function, TIn position, TIn step = TIn(1e-30));
+
+	// DEFINITIONS
+
+	namespace AutomaticDifferentiation {
+		template<typename Ty, int N>
+		Dual<Ty, N> Dual<Ty, N>::variable(Ty value, int direction)
+		{
+			Dual result(value);
+			result.m_tangents[direction] = 1;
+			return result;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> Dual<Ty, N>::apply(Ty f, Ty derivative) const
+		{
+			Dual result(f);
+			for (int i = 0; i < N; i++) { result.m_tangents[i] = derivative * m_tangents[i]; }
+			return result;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> & Dual<Ty, N>::operator+=(const Dual & other)
+		{
+			m_value += other.m_value;
+			for (int i = 0; i < N; i++) { m_tangents[i] += other.m_tangents[i]; }
+			return *this;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> & Dual<Ty, N>::operator-=(const Dual & other)
+		{
+			m_value -= other.m_value;
+			for (int i = 0; i < N; i++) { m_tangents[i] -= other.m_tangents[i]; }
+			return *this;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> & Dual<Ty, N>::operator*=(const Dual & other)
+		{
+			for (int i = 0; i < N; i++) {
+				m_tangents[i] = m_tangents[i] * other.m_value + m_value * other.m_tangents[i];
+			}
+			m_value *= other.m_value;
+			return *this;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> & Dual<Ty, N>::operator/=(const Dual & other)
+		{
+			const Ty inverse = 1 / other.m_value;
+			m_value *= inverse;
+			for (int i = 0; i < N; i++) {
+				m_tangents[i] = (m_tangents[i] - m_value * other.m_tangents[i]) * inverse;
+			}
+			return *this;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> & Dual<Ty, N>::operator*=(Ty other)
+		{
+			m_value *= other;
+			for (int i = 0; i < N; i++) { m_tangents[i] *= other; }
+			return *this;
+		}
+
+		template<typename Ty, int N> 
+		Dual<Ty, N> sqrt(const Dual<Ty, N> & a)
+		{
+			const Ty value = std::sqrt(a.value());
+			return a.apply(value, 1 / (2 * value));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> cbrt(const Dual<Ty, N> & a)
+		{
+			const Ty value = std::cbrt(a.value());
+			return a.apply(value, 1 / (3 * value * value));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> exp(const Dual<Ty, N> & a)
+		{
+			const Ty value = std::exp(a.value());
+			return a.apply(value, value);
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> log(const Dual<Ty, N> & a)
+		{
+			return a.apply(std::log(a.value()), 1 / a.value());
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> sin(const Dual<Ty, N> & a)
+		{
+			return a.apply(std::sin(a.value()), std::cos(a.value()));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> cos(const Dual<Ty, N> & a)
+		{
+			return a.apply(std::cos(a.value()), -std::sin(a.value()));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> tan(const Dual<Ty, N> & a)
+		{
+			const Ty value = std::tan(a.value());
+			return a.apply(value, 1 + value * value);
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> asin(const Dual<Ty, N> & a)
+		{
+			return a.apply(std::asin(a.value()), 1 / std::sqrt(1 - a.value() * a.value()));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> acos(const Dual<Ty, N> & a)
+		{
+			return a.apply(std::acos(a.value()), -1 / std::sqrt(1 - a.value() * a.value()));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> atan(const Dual<Ty, N> & a)
+		{
+			return a.apply(std::atan(a.value()), 1 / (1 + a.value() * a.value()));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> atan2(const Dual<Ty, N> & y, const Dual<Ty, N> & x)
+		{
+			const Ty scale = 1 / (x.value() * x.value() + y.value() * y.value());
+			Dual<Ty, N> result = y.apply(std::atan2(y.value(), x.value()), x.value() * scale);
+			for (int i = 0; i < N; i++) { result.tangent(i) -= y.value() * scale * x.tangent(i); }
+			return result;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> sinh(const Dual<Ty, N> & a)
+		{
+			return a.apply(std::sinh(a.value()), std::cosh(a.value()));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> cosh(const Dual<Ty, N> & a)
+		{
+			return a.apply(std::cosh(a.value()), std::sinh(a.value()));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> tanh(const Dual<Ty, N> & a)
+		{
+			const Ty value = std::tanh(a.value());
+			return a.apply(value, 1 - value * value);
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> abs(const Dual<Ty, N> & a)
+		{
+			return a.value() < 0 ? -a : a;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> fabs(const Dual<Ty, N> & a)
+		{
+			return abs(a);
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> hypot(const Dual<Ty, N> & a, const Dual<Ty, N> & b)
+		{
+			const Ty value = std::hypot(a.value(), b.value());
+			Dual<Ty, N> result = a.apply(value, a.value() / value);
+			for (int i = 0; i < N; i++) { result.tangent(i) += b.value() / value * b.tangent(i); }
+			return result;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> pow(const Dual<Ty, N> & a, const Dual<Ty, N> & b)
+		{
+			const Ty value = std::pow(a.value(), b.value());
+			Dual<Ty, N> result = a.apply(value, b.value() == 0 ? 0 : b.value() * std::pow(a.value(), b.value() - 1));
+			// The log term is only needed (and for a <= 0, only finite) if b varies.
+			bool b_varies = false;
+			for (int i = 0; i < N; i++) { b_varies = b_varies || b.tangent(i) != 0; }
+			if (value != 0 && b_varies) {
+				const Ty log_a = std::log(a.value());
+				for (int i = 0; i < N; i++) { result.tangent(i) += value * log_a * b.tangent(i); }
+			}
+			return result;
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> pow(const Dual<Ty, N> & a, typename Dual<Ty, N>::value_type b)
+		{
+			return a.apply(std::pow(a.value(), b), b == 0 ? 0 : b * std::pow(a.value(), b - 1));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> pow(const Dual<Ty, N> & a, int b)
+		{
+			return a.apply(std::pow(a.value(), b), b == 0 ? 0 : b * std::pow(a.value(), b - 1));
+		}
+
+		template<typename Ty, int N>
+		Dual<Ty, N> pow(typename Dual<Ty, N>::value_type a, const Dual<Ty, N> & b)
+		{
+			const Ty value = std::pow(a, b.value());
+			return b.apply(value, value == 0 ? 0 : value * std::log(a));
+		}
+
+		template<typename Ty, int N>
+		std::ostream & operator<<(std::ostream & stream, const Dual<Ty, N> & a)
+		{
+			stream << a.value() << " [";
+			for (int i = 0; i < N; i++) { stream << (i ? ", " : "") << a.tangent(i); }
+			return stream << "]";
+		}
+	}
+
+	template<typename Ty, int N>
+	bool check_finite(const Dual<Ty, N> & a)
+	{
+		bool finite = std::isfinite(a.value());
+		for (int i = 0; i < N; i++) { finite = finite && std::isfinite(a.tangent(i)); }
+		return finite;
+	}
+
+	template<typename TFunc, typename TIn>
+	TIn forward_derivative(TFunc function, TIn position)
+	{
+		return function(Dual<TIn>::variable(position)).tangent(0);
+	}
+
+	template<typename TFunc, typename TIn, size_t N>
+	std::array<TIn, N> forward_gradient(TFunc function, const std::array<TIn, N> & position)
+	{
+		std::array<Dual<TIn, (int)N>, N> inputs;
+		for (int i = 0; i < (int)N; i++) { inputs[i] = Dual<TIn, (int)N>::variable(position[i], i); }
+		return function(inputs).tangents();
+	}
+
+	template<typename TFunc, typename TIn>
+	TIn complex_step_derivative(TFunc function, TIn position, TIn step)
+	{
+		return std::imag(function(std::complex<TIn>(position, step))) / step;
+	}
+
+} // END namespace HBTK
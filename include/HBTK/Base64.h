@@ -26,6 +26,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -35,4 +36,11 @@ namespace HBTK {
 
 	// Decode a Base64 representation of binary data.
 	std::vector<unsigned char> decode_base64(const std::string & data);
+
+	// Decode n_chars of Base64 to out, which must have room for 
+	// 3 * (n_chars / 4 + 1) bytes. Whitespace is skipped, and padding may end 
+	// one encoded block in the middle of the text, as when separately 
+	// encoded blocks are concatenated. Returns the number of bytes written.
+	// Throws std::invalid_argument on characters outside the alphabet.
+	size_t decode_base64(const char * data, size_t n_chars, unsigned char * out);
 }
\ No newline at end of file
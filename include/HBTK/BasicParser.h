@@ -28,9 +28,15 @@ SOFTWARE.
 #include <array>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "ByteSource.h"
+#include "FieldSplitter.h"
+#include "Gzip.h"
+
 
 namespace HBTK {
 	template <typename TParentClass>
@@ -39,20 +45,29 @@ namespace HBTK {
 	public:
 		// DECLARATIONS
 
-		// Parse file at path.
+		// Parse file at path. The file is memory mapped where possible, and
+		// decompressed first if it is gzip. Throws -1 if it can't be opened.
 		void parse(std::string file_path) {
 			if (file_path.empty()) { throw - 1; }
-			std::ifstream inpt_stream(file_path.c_str(), std::ios::binary);
-			parse(inpt_stream, std::cerr);
+			parse(decompressed(open_file(file_path)), std::cerr);
+		}
+
+		// Parse from a file, memory, or any stream. See ByteSource.
+		void parse(ByteSource source) {
+			parse(source.stream(), std::cerr);
 		}
 
-		// Parse Ifstream
-		void parse(std::ifstream & input_stream) {
+		void parse(ByteSource source, std::ostream & error_stream) {
+			parse(source.stream(), error_stream);
+		}
+
+		// Parse input stream
+		void parse(std::istream & input_stream) {
 			parse(input_stream, std::cerr);
 		}
 
-		// Parse based on both input fstream and output stream
-		void parse(std::ifstream & input_stream, std::ostream & error_stream) {
+		// Parse based on both input stream and output stream
+		void parse(std::istream & input_stream, std::ostream & error_stream) {
 			if (!input_stream) { throw - 1; }
 			if (!error_stream) { throw - 1; }
 			static_cast<TParentClass *>(this)->main_parser(input_stream, error_stream);
@@ -60,19 +75,29 @@ namespace HBTK {
 
 
 	protected:
-		// Unpack chars to a Packed (!) structure
+		// Unpack chars to a Packed (!) structure. The bytes are read straight
+		// into structure: from a ByteSource in memory, that is one memcpy.
 		template<typename Tstruct>
-		inline void unpack_binary_to_struct(std::ifstream & input_stream, Tstruct & structure)
+		inline void unpack_binary_to_struct(std::istream & input_stream, Tstruct & structure)
 		{
-			std::array<char, (int)sizeof(Tstruct)> buffer;
-			if (!input_stream.read(buffer.data(), buffer.size())) {
+			static_assert(std::is_trivially_copyable<Tstruct>::value,
+				"HBTK::BasicParser::unpack_binary_to_struct: Tstruct must be trivially copyable.");
+			if (!input_stream.read(reinterpret_cast<char *>(&structure), sizeof(Tstruct))) {
 				throw - 1;
 			}
-			structure = *reinterpret_cast<Tstruct *>(buffer.data());
 			return;
 		}
 
-		// Separate a string into substrings by whitespace.
+		// Separate a string into whitespace separated fields, viewing
+		// input_string's characters. Valid until the next call.
+		const FieldSplitter & split_fields(const std::string & input_string)
+		{
+			m_field_splitter.split(input_string);
+			return m_field_splitter;
+		}
+
+		// Separate a string into substrings by whitespace. Allocates for 
+		// every substring: prefer split_fields.
 		std::vector<std::string> tokenise(const std::string & input_string)
 		{
 			std::vector<std::string> tokens;
@@ -99,6 +124,16 @@ namespace HBTK {
 			return tokens;
 		}
 
+	private:
+		FieldSplitter m_field_splitter;
+
+		// As ByteSource::from_file, but failing to open throws -1 as parse 
+		// always has.
+		static ByteSource open_file(const std::string & file_path) {
+			try { return ByteSource::from_file(file_path); }
+			catch (const std::invalid_argument &) { throw - 1; }
+		}
+
 	};
 }
 	
@@ -0,0 +1,353 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+BoundingVolumeHierarchy.h
+
+A bounding volume hierarchy (BVH) of axis aligned boxes for accelerating
+proximity and ray queries, and BVHs over finite lines and rectilinear panels.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include "CartesianBoundingBox.h"
+#include "CartesianFiniteLine.h"
+#include "CartesianLine.h"
+#include "CartesianPoint.h"
+#include "CartesianRectilinearPanel.h"
+
+namespace HBTK {
+	// A BVH over a set of "primitives", each described only by its bounding
+	// box and referred to by its index in the vector given to build(). Exact
+	// primitive geometry is supplied to the queries as a function object.
+	// Built with a binned surface area heuristic.
+	class BoundingVolumeHierarchy3D {
+	public:
+		BoundingVolumeHierarchy3D();
+
+		// Build the tree. Large subtrees are built concurrently using up to
+		// num_threads threads (default_thread_count() if num_threads <= 0).
+		void build(const std::vector<CartesianBoundingBox3D> & primitive_boxes, 
+			int num_threads = 0);
+		// Update the node boxes for primitives that have moved, keeping the 
+		// tree topology. Cheaper than a rebuild, but queries get slower if
+		// the primitives move a long way. Must be the same number of primitives.
+		void refit(const std::vector<CartesianBoundingBox3D> & primitive_boxes);
+
+		int number_of_primitives() const;
+		int number_of_nodes() const;
+		// Box containing all primitives.
+		CartesianBoundingBox3D bounds() const;
+
+		// Index of the primitive nearest to point, or -1 if there are none.
+		// distance_func(int primitive, const CartesianPoint3D & point) must
+		// return the exact distance, which will be no less than the distance
+		// to the primitive's box.
+		template<typename TDistanceFunc>
+		int nearest(const CartesianPoint3D & point, TDistanceFunc && distance_func,
+			double & distance) const;
+
+		// Indices (ascending) of primitives within radius of point, using 
+		// distance_func as for nearest.
+		template<typename TDistanceFunc>
+		std::vector<int> within_radius(const CartesianPoint3D & point, double radius,
+			TDistanceFunc && distance_func) const;
+
+		// Indices (ascending) of primitives whose boxes intersect box.
+		std::vector<int> overlapping(const CartesianBoundingBox3D & box) const;
+
+		// The first primitive (in traversal order) whose box contains point 
+		// and for which test_func(int primitive, const CartesianPoint3D & point)
+		// returns true, or -1. Stops at the first success. Does not allocate.
+		template<typename TTestFunc>
+		int first_containing(const CartesianPoint3D & point, TTestFunc && test_func) const;
+
+		// First primitive hit by line(t) for t_min <= t <= t_max, or -1.
+		// hit_func(int primitive, const CartesianLine3D & line, double & t) 
+		// must return true and set t if the primitive is hit in [t_min, t_max].
+		template<typename THitFunc>
+		int first_hit(const CartesianLine3D & line, double t_min, double t_max,
+			THitFunc && hit_func, double & t_hit) const;
+
+		// Indices (ascending) of all primitives hit by line(t) for 
+		// t_min <= t <= t_max, using hit_func as for first_hit.
+		template<typename THitFunc>
+		std::vector<int> all_hits(const CartesianLine3D & line, double t_min, double t_max,
+			THitFunc && hit_func) const;
+
+	private:
+		// A leaf if count > 0: m_indices[first, first + count) are its primitives.
+		// Otherwise children are m_nodes[first] and m_nodes[first + 1]. Children
+		// always have a larger index than their parent.
+		struct node {
+			CartesianBoundingBox3D box;
+			int first;
+			int count;
+		};
+		std::vector<node> m_nodes;
+		// Primitive indices, ordered so that each leaf's primitives are contiguous.
+		std::vector<int> m_indices;
+
+		// Depth is limited so that queries can use a fixed size stack.
+		static constexpr int max_depth = 60;
+		static constexpr int max_leaf_size = 4;
+		using traversal_stack = std::array<int, max_depth + 2>;
+
+		void build_node(int node_idx, int begin, int end, int depth, int parallel_depth,
+			const std::vector<CartesianBoundingBox3D> & primitive_boxes,
+			const std::vector<CartesianPoint3D> & centroids,
+			std::atomic<int> & node_count);
+	};
+
+
+	// BVH over straight line segments - for example, the filaments of a 
+	// vortex lattice wake.
+	class FiniteLineBVH3D {
+	public:
+		FiniteLineBVH3D();
+		FiniteLineBVH3D(const std::vector<CartesianFiniteLine3D> & lines, int num_threads = 0);
+
+		void build(const std::vector<CartesianFiniteLine3D> & lines, int num_threads = 0);
+		// Replace the lines with moved versions of the same lines and refit.
+		void refit(const std::vector<CartesianFiniteLine3D> & lines);
+		const std::vector<CartesianFiniteLine3D> & lines() const;
+
+		// Index of nearest line to point and its distance. -1 if no lines.
+		int nearest(const CartesianPoint3D & point, double & distance) const;
+		// Nearest line to each point, computed in parallel.
+		void nearest(const std::vector<CartesianPoint3D> & points, std::vector<int> & line_indices,
+			std::vector<double> & distances, int num_threads = 0) const;
+		// Indices of lines within radius of point.
+		std::vector<int> within_radius(const CartesianPoint3D & point, double radius) const;
+
+		// Shortest distance between a point and a finite line.
+		static double point_distance(const CartesianFiniteLine3D & line, const CartesianPoint3D & point);
+
+	private:
+		std::vector<CartesianFiniteLine3D> m_lines;
+		BoundingVolumeHierarchy3D m_bvh;
+		static std::vector<CartesianBoundingBox3D> boxes(const std::vector<CartesianFiniteLine3D> & lines);
+	};
+
+
+	// BVH over rectilinear panels. Each panel is treated as the two triangles
+	// (corners 0, 1, 2) and (0, 2, 3), which is exact for planar panels.
+	class RectilinearPanelBVH {
+	public:
+		RectilinearPanelBVH();
+		RectilinearPanelBVH(const std::vector<CartesianRectilinearPanel> & panels, int num_threads = 0);
+
+		void build(const std::vector<CartesianRectilinearPanel> & panels, int num_threads = 0);
+		void refit(const std::vector<CartesianRectilinearPanel> & panels);
+		const std::vector<CartesianRectilinearPanel> & panels() const;
+
+		int nearest(const CartesianPoint3D & point, double & distance) const;
+		void nearest(const std::vector<CartesianPoint3D> & points, std::vector<int> & panel_indices,
+			std::vector<double> & distances, int num_threads = 0) const;
+		std::vector<int> within_radius(const CartesianPoint3D & point, double radius) const;
+
+		// First panel hit by the ray ray(t), t >= 0. Returns -1 if none.
+		int first_intersection(const CartesianLine3D & ray, double & t) const;
+		// Panels crossed by a finite line - for example, a wake filament
+		// passing through a body.
+		std::vector<int> intersections(const CartesianFiniteLine3D & line) const;
+
+		static double point_distance(const CartesianRectilinearPanel & panel, const CartesianPoint3D & point);
+		// True if line(t) crosses the panel for t_min <= t <= t_max, setting t.
+		static bool line_intersection(const CartesianRectilinearPanel & panel, const CartesianLine3D & line,
+			double t_min, double t_max, double & t);
+
+	private:
+		std::vector<CartesianRectilinearPanel> m_panels;
+		BoundingVolumeHierarchy3D m_bvh;
+		static std::vector<CartesianBoundingBox3D> boxes(const std::vector<CartesianRectilinearPanel> & panels);
+	};
+
+
+
+
+	// DEFINITIONS
+
+	template<typename TDistanceFunc>
+	inline int BoundingVolumeHierarchy3D::nearest(const CartesianPoint3D & point, 
+		TDistanceFunc && distance_func, double & distance) const
+	{
+		int best = -1;
+		double best_dist = std::numeric_limits<double>::infinity();
+		if (m_nodes.empty()) { 
+			distance = best_dist;
+			return best; 
+		}
+		traversal_stack stack;
+		int stack_size = 0;
+		stack[stack_size++] = 0;
+		while (stack_size > 0) {
+			const node & n = m_nodes[stack[--stack_size]];
+			double box_dist_sq = n.box.distance_squared(point);
+			if (box_dist_sq >= best_dist * best_dist) { continue; }
+			if (n.count > 0) {
+				for (int i = n.first; i < n.first + n.count; i++) {
+					int prim = m_indices[i];
+					double dist = distance_func(prim, point);
+					if (dist < best_dist || (dist == best_dist && prim < best)) {
+						best_dist = dist;
+						best = prim;
+					}
+				}
+			}
+			else {
+				// Push the further child first so that the nearer is searched first.
+				double d0 = m_nodes[n.first].box.distance_squared(point);
+				double d1 = m_nodes[n.first + 1].box.distance_squared(point);
+				if (d0 <= d1) {
+					stack[stack_size++] = n.first + 1;
+					stack[stack_size++] = n.first;
+				}
+				else {
+					stack[stack_size++] = n.first;
+					stack[stack_size++] = n.first + 1;
+				}
+			}
+		}
+		distance = best_dist;
+		return best;
+	}
+
+	template<typename TDistanceFunc>
+	inline std::vector<int> BoundingVolumeHierarchy3D::within_radius(const CartesianPoint3D & point, 
+		double radius, TDistanceFunc && distance_func) const
+	{
+		std::vector<int> found;
+		if (m_nodes.empty()) { return found; }
+		traversal_stack stack;
+		int stack_size = 0;
+		stack[stack_size++] = 0;
+		while (stack_size > 0) {
+			const node & n = m_nodes[stack[--stack_size]];
+			if (n.box.distance_squared(point) > radius * radius) { continue; }
+			if (n.count > 0) {
+				for (int i = n.first; i < n.first + n.count; i++) {
+					if (distance_func(m_indices[i], point) <= radius) { 
+						found.push_back(m_indices[i]); 
+					}
+				}
+			}
+			else {
+				stack[stack_size++] = n.first;
+				stack[stack_size++] = n.first + 1;
+			}
+		}
+		std::sort(found.begin(), found.end());
+		return found;
+	}
+
+	template<typename THitFunc>
+	inline int BoundingVolumeHierarchy3D::first_hit(const CartesianLine3D & line, 
+		double t_min, double t_max, THitFunc && hit_func, double & t_hit) const
+	{
+		int best = -1;
+		double best_t = t_max;
+		if (m_nodes.empty()) { return best; }
+		traversal_stack stack;
+		int stack_size = 0;
+		stack[stack_size++] = 0;
+		while (stack_size > 0) {
+			const node & n = m_nodes[stack[--stack_size]];
+			double t_entry;
+			if (!n.box.intersection(line, t_min, best_t, t_entry)) { continue; }
+			if (n.count > 0) {
+				for (int i = n.first; i < n.first + n.count; i++) {
+					int prim = m_indices[i];
+					double t;
+					if (hit_func(prim, line, t) && t >= t_min && t <= best_t
+						&& (t < best_t || best == -1 || prim < best)) {
+						best_t = t;
+						best = prim;
+					}
+				}
+			}
+			else {
+				stack[stack_size++] = n.first;
+				stack[stack_size++] = n.first + 1;
+			}
+		}
+		if (best != -1) { t_hit = best_t; }
+		return best;
+	}
+
+	template<typename TTestFunc>
+	inline int BoundingVolumeHierarchy3D::first_containing(const CartesianPoint3D & point, 
+		TTestFunc && test_func) const
+	{
+		if (m_nodes.empty()) { return -1; }
+		traversal_stack stack;
+		int stack_size = 0;
+		stack[stack_size++] = 0;
+		while (stack_size > 0) {
+			const node & n = m_nodes[stack[--stack_size]];
+			if (!n.box.contains(point)) { continue; }
+			if (n.count > 0) {
+				for (int i = n.first; i < n.first + n.count; i++) {
+					if (test_func(m_indices[i], point)) { return m_indices[i]; }
+				}
+			}
+			else {
+				stack[stack_size++] = n.first + 1;
+				stack[stack_size++] = n.first;
+			}
+		}
+		return -1;
+	}
+
+	template<typename THitFunc>
+	inline std::vector<int> BoundingVolumeHierarchy3D::all_hits(const CartesianLine3D & line, 
+		double t_min, double t_max, THitFunc && hit_func) const
+	{
+		std::vector<int> found;
+		if (m_nodes.empty()) { return found; }
+		traversal_stack stack;
+		int stack_size = 0;
+		stack[stack_size++] = 0;
+		while (stack_size > 0) {
+			const node & n = m_nodes[stack[--stack_size]];
+			double t_entry;
+			if (!n.box.intersection(line, t_min, t_max, t_entry)) { continue; }
+			if (n.count > 0) {
+				for (int i = n.first; i < n.first + n.count; i++) {
+					double t;
+					if (hit_func(m_indices[i], line, t) && t >= t_min && t <= t_max) {
+						found.push_back(m_indices[i]);
+					}
+				}
+			}
+			else {
+				stack[stack_size++] = n.first;
+				stack[stack_size++] = n.first + 1;
+			}
+		}
+		std::sort(found.begin(), found.end());
+		return found;
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+BufferedTokeniser.h
+
+A tokeniser over an in-memory buffer.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <istream>
+#include <memory>
+#include <string>
+
+#include "StringView.h"
+#include "Token.h"
+#include "TokenStream.h"
+
+namespace HBTK {
+	// Produces the same tokens as BasicTokeniser, but reads the whole input
+	// into one buffer up front and scans it directly rather than a 
+	// character at a time through an istream. Lookahead tokens are held in
+	// a fixed size ring whose Token strings keep their capacity, so once
+	// warmed up no allocation is done per token. view() gives the text of
+	// a token as a StringView into the buffer, which avoids even the copy.
+	//
+	// With parse_numbers, integer and floating point literals (1, 1.5, .5,
+	// 3., 1e5, 1.5E-3) are each read as a single INTEGER or FLOAT token 
+	// carrying its parsed value (Token::number, Token::integer), so 
+	// NumberTokenModifier and later string conversions are unnecessary.
+	// Signs remain separate punctuation tokens.
+	class BufferedTokeniser :
+		public TokenStream
+	{
+	public:
+		BufferedTokeniser(std::unique_ptr<std::istream> stream, bool parse_numbers = false);
+		BufferedTokeniser(const std::string & str, bool parse_numbers = false);
+
+		virtual const Token& current() override;
+		virtual const Token& next() override;
+		// ahead must be less than max_lookahead.
+		virtual const Token& peek(int ahead) override;
+
+		virtual bool eof() const override;
+		virtual int line_number() override;
+		virtual int char_number() override;
+		virtual int position() override;
+
+		// Text of the token peek(ahead), valid for the tokeniser's lifetime.
+		StringView view(int ahead = 0);
+
+		static constexpr int max_lookahead = 16;
+
+	protected:
+		std::string m_buffer;
+		// Index in m_buffer of the first character not yet tokenised, and its
+		// line and character number.
+		int m_cursor;
+		int m_stream_line_no;
+		int m_stream_char_no;
+
+		// Tokens parsed but not yet consumed are m_ring[(m_first + i) % max_lookahead]
+		// for i < m_count.
+		std::array<Token, max_lookahead> m_ring;
+		std::array<StringView, max_lookahead> m_views;
+		int m_first;
+		int m_count;
+
+		int m_position;
+		bool m_parse_numbers;
+
+		void parse_another_token();
+		// Extend the integer token at m_cursor to a full number literal and
+		// parse its value.
+		void parse_number(Token & token, int start);
+	};
+}
@@ -0,0 +1,100 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+ByteSource.h
+
+Sources of bytes for the parsers: files, memory and streams.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+
+namespace HBTK {
+	// A read only, seekable streambuf over bytes held elsewhere. Nothing is
+	// copied until it is read.
+	class MemoryStreamBuffer
+		: public std::streambuf
+	{
+	public:
+		MemoryStreamBuffer(const char * data, size_t size);
+
+	protected:
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+			std::ios_base::openmode which = std::ios_base::in) override;
+		pos_type seekpos(pos_type pos, 
+			std::ios_base::openmode which = std::ios_base::in) override;
+		std::streamsize showmanyc() override;
+		std::streamsize xsgetn(char * out, std::streamsize count) override;
+	};
+
+	// Where a parser reads its bytes from. Every source provides an istream.
+	// Files and memory also provide all of their bytes contiguously in 
+	// memory. Files are memory mapped where the platform allows.
+	//
+	//	HBTK::Gmsh::GmshParser parser;
+	//	parser.parse(HBTK::ByteSource::from_memory(buffer.data(), buffer.size()));
+	//
+	class ByteSource {
+	public:
+		// The file at path. Throws std::invalid_argument if it can't be opened.
+		static ByteSource from_file(const std::string & path);
+		// size bytes at data, which must outlive the ByteSource. Not copied.
+		static ByteSource from_memory(const char * data, size_t size);
+		// Takes ownership of contents.
+		static ByteSource from_string(std::string contents);
+		// Reads from stream, which must outlive the ByteSource. Suitable for 
+		// pipes and std::cin, but not contiguous.
+		static ByteSource from_stream(std::istream & stream);
+		// Takes ownership of stream. For instance, a decompressing stream.
+		static ByteSource from_stream(std::unique_ptr<std::istream> stream);
+
+		ByteSource(ByteSource && other);
+		ByteSource & operator=(ByteSource && other);
+		~ByteSource();
+
+		std::istream & stream();
+
+		// True if all the bytes are available through data() and size().
+		bool contiguous() const;
+		const char * data() const;
+		size_t size() const;
+
+	private:
+		ByteSource();
+		void release();
+		void view(const char * data, size_t size);
+
+		std::istream * m_stream;
+		std::unique_ptr<std::istream> m_owned_stream;
+		std::unique_ptr<MemoryStreamBuffer> m_buffer;
+		std::string m_contents;
+		const char * m_data;
+		size_t m_size;
+		bool m_contiguous;
+		// Memory map to unmap on destruction.
+		void * m_mapping;
+		size_t m_mapping_size;
+	};
+}
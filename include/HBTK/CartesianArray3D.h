@@ -0,0 +1,192 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+CartesianArray3D.h
+
+Structure-of-arrays containers for many points and vectors in 3D Cartesian
+space, with bulk geometric operations.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <vector>
+
+#include "CartesianPoint.h"
+#include "CartesianVector.h"
+
+namespace HBTK {
+	class CartesianPlane;
+	class PointArray3D;
+	class VectorArray3D;
+
+	// A non-owning view of size() points, where point i is 
+	// (x[i * stride], y[i * stride], z[i * stride]). 
+	// A PointArray3D gives a view of stride 1. A std::vector<CartesianPoint3D>
+	// can be viewed in place with stride 3.
+	// The view is invalidated by anything that reallocates the viewed data.
+	class PointArrayView3D {
+	public:
+		PointArrayView3D(double * x, double * y, double * z, int size, int stride);
+		// View an array of structures in place - no copy is made.
+		PointArrayView3D(std::vector<CartesianPoint3D> & points);
+
+		int size() const;
+		int stride() const;
+		double * x_data() const;
+		double * y_data() const;
+		double * z_data() const;
+
+		CartesianPoint3D operator[](int index) const;
+		void set(int index, const CartesianPoint3D & point) const;
+
+		// Move all points by translation.
+		void translate(const CartesianVector3D & translation) const;
+		// Rotate all points by angle (radians, right hand rule) about an
+		// axis through centre.
+		void rotate(const CartesianVector3D & axis, double angle,
+			const CartesianPoint3D & centre) const;
+		// Apply a 3x3 matrix (row major) to all points about centre.
+		void transform(const std::array<std::array<double, 3>, 3> & matrix,
+			const CartesianPoint3D & centre) const;
+
+		// Signed distance of every point from a plane. Same as
+		// CartesianPlane::distance for each point.
+		std::vector<double> distance(const CartesianPlane & plane) const;
+		void distance(const CartesianPlane & plane, std::vector<double> & result) const;
+		// Local coordinates of every point projected onto the plane. Same as
+		// CartesianPlane::projection for each point.
+		void projection(const CartesianPlane & plane,
+			std::vector<double> & local_x, std::vector<double> & local_y) const;
+
+		// Copy into an owning array of structures.
+		std::vector<CartesianPoint3D> as_points() const;
+
+	private:
+		double * m_x;
+		double * m_y;
+		double * m_z;
+		int m_size;
+		int m_stride;
+	};
+
+	// Many points in 3D, stored as one array per coordinate.
+	class PointArray3D {
+	public:
+		PointArray3D();
+		PointArray3D(int size);
+		PointArray3D(const std::vector<CartesianPoint3D> & points);
+		PointArray3D(const PointArrayView3D & points);
+
+		int size() const;
+		void resize(int size);
+		void reserve(int size);
+		void push_back(const CartesianPoint3D & point);
+
+		CartesianPoint3D operator[](int index) const;
+		void set(int index, const CartesianPoint3D & point);
+
+		std::vector<double> & x();
+		const std::vector<double> & x() const;
+		std::vector<double> & y();
+		const std::vector<double> & y() const;
+		std::vector<double> & z();
+		const std::vector<double> & z() const;
+
+		PointArrayView3D view();
+
+		// Vectors from other[i] to this[i]. Arrays must be of the same size.
+		VectorArray3D operator-(const PointArray3D & other) const;
+		// Vectors from point to this[i].
+		VectorArray3D operator-(const CartesianPoint3D & point) const;
+
+		void translate(const CartesianVector3D & translation);
+		// Move point i by translation[i]. Arrays must be of the same size.
+		void translate(const VectorArray3D & translation);
+		void rotate(const CartesianVector3D & axis, double angle,
+			const CartesianPoint3D & centre);
+		std::vector<double> distance(const CartesianPlane & plane) const;
+		void projection(const CartesianPlane & plane,
+			std::vector<double> & local_x, std::vector<double> & local_y) const;
+
+		std::vector<CartesianPoint3D> as_points() const;
+
+	private:
+		std::vector<double> m_x;
+		std::vector<double> m_y;
+		std::vector<double> m_z;
+
+		// For const operations that share the view's kernels.
+		PointArrayView3D const_view() const;
+	};
+
+	// Many vectors in 3D, stored as one array per component.
+	class VectorArray3D {
+	public:
+		VectorArray3D();
+		VectorArray3D(int size);
+		VectorArray3D(const std::vector<CartesianVector3D> & vectors);
+
+		int size() const;
+		void resize(int size);
+		void reserve(int size);
+		void push_back(const CartesianVector3D & vector);
+
+		CartesianVector3D operator[](int index) const;
+		void set(int index, const CartesianVector3D & vector);
+
+		std::vector<double> & x();
+		const std::vector<double> & x() const;
+		std::vector<double> & y();
+		const std::vector<double> & y() const;
+		std::vector<double> & z();
+		const std::vector<double> & z() const;
+
+		// Elementwise arithmetic. Arrays must be of the same size.
+		VectorArray3D & operator+=(const VectorArray3D & other);
+		VectorArray3D & operator-=(const VectorArray3D & other);
+		VectorArray3D & operator*=(double multiplyer);
+		// Multiply vector i by multiplyers[i].
+		VectorArray3D & operator*=(const std::vector<double> & multiplyers);
+
+		// Length of each vector.
+		std::vector<double> magnitude() const;
+		void magnitude(std::vector<double> & result) const;
+		// Set the length of all vectors to 1.
+		void normalise();
+		// Dot product of vector i with other[i].
+		std::vector<double> dot(const VectorArray3D & other) const;
+		void dot(const VectorArray3D & other, std::vector<double> & result) const;
+		// Dot product of every vector with other.
+		std::vector<double> dot(const CartesianVector3D & other) const;
+		// Cross product of vector i with other[i].
+		VectorArray3D cross(const VectorArray3D & other) const;
+		void cross(const VectorArray3D & other, VectorArray3D & result) const;
+		// Cross product of every vector with other.
+		VectorArray3D cross(const CartesianVector3D & other) const;
+
+		std::vector<CartesianVector3D> as_vectors() const;
+
+	private:
+		std::vector<double> m_x;
+		std::vector<double> m_y;
+		std::vector<double> m_z;
+	};
+}
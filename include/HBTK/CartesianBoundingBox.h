@@ -0,0 +1,72 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+CartesianBoundingBox.h
+
+Axis aligned bounding boxes in Cartesian space.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include "CartesianPoint.h"
+
+namespace HBTK {
+	class CartesianLine3D;
+
+	class CartesianBoundingBox3D {
+	public:
+		// An empty box. Expanding it by a point gives a box containing
+		// only that point.
+		CartesianBoundingBox3D();
+		CartesianBoundingBox3D(const CartesianPoint3D & corner_1, const CartesianPoint3D & corner_2);
+
+		CartesianPoint3D & lower_corner();
+		const CartesianPoint3D & lower_corner() const;
+		CartesianPoint3D & upper_corner();
+		const CartesianPoint3D & upper_corner() const;
+
+		bool empty() const;
+		CartesianPoint3D centre() const;
+		// Total area of the faces of the box. 0 if empty.
+		double surface_area() const;
+		// Index (0, 1, 2 for x, y, z) of the longest side.
+		int longest_axis() const;
+
+		void expand(const CartesianPoint3D & point);
+		void expand(const CartesianBoundingBox3D & other);
+		// Grow the box by distance in every direction.
+		void pad(double distance);
+
+		bool contains(const CartesianPoint3D & point) const;
+		bool intersects(const CartesianBoundingBox3D & other) const;
+		// Distance from a point to the box. 0 if inside.
+		double distance(const CartesianPoint3D & point) const;
+		// Squared distance. Cheaper for comparisons.
+		double distance_squared(const CartesianPoint3D & point) const;
+		// If the line intersects the box between line positions t_min and t_max, 
+		// returns true and the position where it enters the box (clamped to t_min).
+		bool intersection(const CartesianLine3D & line, double t_min, double t_max, 
+			double & t_entry) const;
+
+	private:
+		CartesianPoint3D m_min;
+		CartesianPoint3D m_max;
+	};
+}
@@ -32,31 +32,34 @@ namespace HBTK {
 	class CartesianVector3D;
 	class CartesianVector2D;
 
+	// CartesianPoint3D and CartesianPoint2D are trivially copyable and
+	// their arithmetic is defined inline below, so std::vector<CartesianPoint3D>
+	// can be treated as contiguous doubles and simple geometry is not
+	// a function call per operation.
 	class CartesianPoint3D {
 	public:
-		CartesianPoint3D();
-		CartesianPoint3D(const std::array<double, 3> & location);
-		~CartesianPoint3D();
+		CartesianPoint3D() = default;
+		constexpr CartesianPoint3D(const std::array<double, 3> & location);
 
 		double & x();
-		const double & x() const;
+		constexpr const double & x() const;
 		double & y();
-		const double & y() const;
+		constexpr const double & y() const;
 		double & z();
-		const double & z() const;
+		constexpr const double & z() const;
 		std::array<double, 3> & as_array();
-		const std::array<double, 3> & as_array() const;
+		constexpr const std::array<double, 3> & as_array() const;
 
-		CartesianVector3D operator-(const HBTK::CartesianPoint3D & other) const;
-		CartesianPoint3D operator+(const HBTK::CartesianVector3D & other) const;
+		constexpr CartesianVector3D operator-(const HBTK::CartesianPoint3D & other) const;
+		constexpr CartesianPoint3D operator+(const HBTK::CartesianVector3D & other) const;
 		CartesianPoint3D & operator+=(const HBTK::CartesianVector3D & other);
-		CartesianPoint3D operator-(const HBTK::CartesianVector3D & other) const;
+		constexpr CartesianPoint3D operator-(const HBTK::CartesianVector3D & other) const;
 		CartesianPoint3D & operator-=(const HBTK::CartesianVector3D & other);
 
-		static CartesianPoint3D origin();
+		static constexpr CartesianPoint3D origin();
 
-		bool operator==(const CartesianPoint3D & other) const;
-		bool operator!=(const CartesianPoint3D & other) const;
+		constexpr bool operator==(const CartesianPoint3D & other) const;
+		constexpr bool operator!=(const CartesianPoint3D & other) const;
 
 		double distance(const CartesianPlane & plane) const;
 
@@ -67,9 +70,8 @@ namespace HBTK {
 
 	class CartesianPoint2D {
 	public:
-		CartesianPoint2D();
-		CartesianPoint2D(const std::array<double, 2> & location);
-		~CartesianPoint2D();
+		CartesianPoint2D() = default;
+		constexpr CartesianPoint2D(const std::array<double, 2> & location);
 
 		// Rotate about the origin anticlockwise angle in radians.
 		void rotate(double angle);
@@ -77,27 +79,219 @@ namespace HBTK {
 		void rotate(double angle, CartesianPoint2D other);
 
 		double & x();
-		const double & x() const;
+		constexpr const double & x() const;
 		double & y();
-		const double & y() const;
+		constexpr const double & y() const;
 		std::array<double, 2> & as_array();
-		const std::array<double, 2> & as_array() const;
+		constexpr const std::array<double, 2> & as_array() const;
 
-		CartesianVector2D operator-(const HBTK::CartesianPoint2D & other) const;
-		CartesianPoint2D operator+(const HBTK::CartesianVector2D & other) const;
+		constexpr CartesianVector2D operator-(const HBTK::CartesianPoint2D & other) const;
+		constexpr CartesianPoint2D operator+(const HBTK::CartesianVector2D & other) const;
 		CartesianPoint2D operator+=(const HBTK::CartesianVector2D & other);
-		CartesianPoint2D operator-(const HBTK::CartesianVector2D & other) const;
+		constexpr CartesianPoint2D operator-(const HBTK::CartesianVector2D & other) const;
 		CartesianPoint2D operator-=(const HBTK::CartesianVector2D & other);
 
-		static CartesianPoint2D origin();
+		static constexpr CartesianPoint2D origin();
 
-		bool operator==(const CartesianPoint2D & other) const;
-		bool operator!=(const CartesianPoint2D & other) const;
+		constexpr bool operator==(const CartesianPoint2D & other) const;
+		constexpr bool operator!=(const CartesianPoint2D & other) const;
 
 	private:
 		std::array<double, 2> m_coord;
 	};
 }
 
+// CartesianVector.h includes this file back - both classes must be complete
+// before the inline definitions below.
+#include "CartesianVector.h"
 
+namespace HBTK {
+
+	// DEFINITIONS
+
+	inline constexpr CartesianPoint3D::CartesianPoint3D(const std::array<double, 3> & location)
+		: m_coord(location)
+	{
+	}
+
+	inline double & CartesianPoint3D::x()
+	{
+		return m_coord[0];
+	}
+
+	inline constexpr const double & CartesianPoint3D::x() const
+	{
+		return m_coord[0];
+	}
+
+	inline double & CartesianPoint3D::y()
+	{
+		return m_coord[1];
+	}
+
+	inline constexpr const double & CartesianPoint3D::y() const
+	{
+		return m_coord[1];
+	}
+
+	inline double & CartesianPoint3D::z()
+	{
+		return m_coord[2];
+	}
+
+	inline constexpr const double & CartesianPoint3D::z() const
+	{
+		return m_coord[2];
+	}
+
+	inline std::array<double, 3>& CartesianPoint3D::as_array()
+	{
+		return m_coord;
+	}
+
+	inline constexpr const std::array<double, 3>& CartesianPoint3D::as_array() const
+	{
+		return m_coord;
+	}
+
+	inline constexpr CartesianPoint3D CartesianPoint3D::operator+(const CartesianVector3D & other) const
+	{
+		return CartesianPoint3D({
+			x() + other.x(),
+			y() + other.y(),
+			z() + other.z() });
+	}
+
+	inline CartesianPoint3D & CartesianPoint3D::operator+=(const CartesianVector3D & other)
+	{
+		x() += other.x();
+		y() += other.y();
+		z() += other.z();
+		return *this;
+	}
+
+	inline constexpr CartesianPoint3D CartesianPoint3D::operator-(const CartesianVector3D & other) const
+	{
+		return CartesianPoint3D({
+			x() - other.x(),
+			y() - other.y(),
+			z() - other.z() });
+	}
+
+	inline CartesianPoint3D & CartesianPoint3D::operator-=(const CartesianVector3D & other)
+	{
+		x() -= other.x();
+		y() -= other.y();
+		z() -= other.z();
+		return *this;
+	}
+
+	inline constexpr CartesianVector3D CartesianPoint3D::operator-(const CartesianPoint3D & other) const
+	{
+		return CartesianVector3D({
+			x() - other.x(),
+			y() - other.y(),
+			z() - other.z() });
+	}
+
+	inline constexpr CartesianPoint3D CartesianPoint3D::origin()
+	{
+		return CartesianPoint3D({ 0, 0, 0 });
+	}
+
+	inline constexpr bool CartesianPoint3D::operator==(const CartesianPoint3D & other) const
+	{
+		return (x() == other.x()) && (y() == other.y()) && (z() == other.z());
+	}
 
+	inline constexpr bool CartesianPoint3D::operator!=(const CartesianPoint3D & other) const
+	{
+		return !operator==(other);
+	}
+
+
+	inline constexpr CartesianPoint2D::CartesianPoint2D(const std::array<double, 2> & location)
+		: m_coord(location)
+	{
+	}
+
+	inline constexpr CartesianPoint2D CartesianPoint2D::origin()
+	{
+		return CartesianPoint2D({ 0, 0 });
+	}
+
+	inline constexpr bool CartesianPoint2D::operator==(const CartesianPoint2D & other) const
+	{
+		return (x() == other.x()) && (y() == other.y());
+	}
+
+	inline constexpr bool CartesianPoint2D::operator!=(const CartesianPoint2D & other) const
+	{
+		return !operator==(other);
+	}
+
+	inline double & CartesianPoint2D::x()
+	{
+		return m_coord[0];
+	}
+
+	inline constexpr const double & CartesianPoint2D::x() const
+	{
+		return m_coord[0];
+	}
+
+	inline double & CartesianPoint2D::y()
+	{
+		return m_coord[1];
+	}
+
+	inline constexpr const double & CartesianPoint2D::y() const
+	{
+		return m_coord[1];
+	}
+
+	inline std::array<double, 2>& CartesianPoint2D::as_array()
+	{
+		return m_coord;
+	}
+
+	inline constexpr const std::array<double, 2>& CartesianPoint2D::as_array() const
+	{
+		return m_coord;
+	}
+
+	inline constexpr CartesianPoint2D CartesianPoint2D::operator+(const CartesianVector2D & other) const
+	{
+		return CartesianPoint2D({
+			x() + other.x(),
+			y() + other.y() });
+	}
+
+	inline CartesianPoint2D CartesianPoint2D::operator+=(const CartesianVector2D & other)
+	{
+		x() += other.x();
+		y() += other.y();
+		return *this;
+	}
+
+	inline constexpr CartesianPoint2D CartesianPoint2D::operator-(const CartesianVector2D & other) const
+	{
+		return CartesianPoint2D({
+			x() - other.x(),
+			y() - other.y() });
+	}
+
+	inline CartesianPoint2D CartesianPoint2D::operator-=(const CartesianVector2D & other)
+	{
+		x() -= other.x();
+		y() -= other.y();
+		return *this;
+	}
+
+	inline constexpr CartesianVector2D CartesianPoint2D::operator-(const CartesianPoint2D & other) const
+	{
+		return CartesianVector2D({
+			x() - other.x(),
+			y() - other.y() });
+	}
+}
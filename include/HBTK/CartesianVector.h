@@ -26,26 +26,27 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <cmath>
 
 namespace HBTK {
 	class CartesianPoint3D;	// Include CartesianPoint.h
 	class CartesianPoint2D;	// Include CartesianPoint.h
 
+	// Trivially copyable. Arithmetic is defined inline below.
 	class CartesianVector3D {
 	public:
-		CartesianVector3D();
-		CartesianVector3D(const std::array<double, 3> vector);
-		~CartesianVector3D();
+		CartesianVector3D() = default;
+		constexpr CartesianVector3D(const std::array<double, 3> vector);
 
-		CartesianVector3D operator+(const CartesianVector3D & other) const;
+		constexpr CartesianVector3D operator+(const CartesianVector3D & other) const;
 		CartesianVector3D & operator+=(const CartesianVector3D & other);
-		CartesianVector3D operator-(const CartesianVector3D & other) const;
-		CartesianVector3D operator-() const;
+		constexpr CartesianVector3D operator-(const CartesianVector3D & other) const;
+		constexpr CartesianVector3D operator-() const;
 		CartesianVector3D & operator-=(const CartesianVector3D & other);
-		CartesianPoint3D operator+(const CartesianPoint3D & other) const;
-		CartesianVector3D operator*(const double & multiplyer) const;
+		constexpr CartesianPoint3D operator+(const CartesianPoint3D & other) const;
+		constexpr CartesianVector3D operator*(const double & multiplyer) const;
 		CartesianVector3D & operator*=(const double & multiplyer);
-		CartesianVector3D operator/(const double & divisor) const;
+		constexpr CartesianVector3D operator/(const double & divisor) const;
 		CartesianVector3D & operator/=(const double & divisor);
 
 		// Returns the length of the vector. Same as: abs(this)
@@ -53,9 +54,9 @@ namespace HBTK {
 		// Set vector length to 1.
 		void normalise();
 		// Dot product between to vectors.
-		double dot(const CartesianVector3D & other) const;
+		constexpr double dot(const CartesianVector3D & other) const;
 		// Cross product of two vectors
-		CartesianVector3D cross(const CartesianVector3D & other) const;
+		constexpr CartesianVector3D cross(const CartesianVector3D & other) const;
 		// The cos of the angle between two vectors.
 		double cos_angle(const CartesianVector3D & other) const;
 		// The angle between two vectors in radians.
@@ -63,40 +64,40 @@ namespace HBTK {
 
 
 		double & x();
-		const double & x() const;
+		constexpr const double & x() const;
 		double & y();
-		const double & y() const;
+		constexpr const double & y() const;
 		double & z();
-		const double & z() const;
+		constexpr const double & z() const;
 		std::array<double, 3> & as_array();
-		const std::array<double, 3> & as_array() const;
+		constexpr const std::array<double, 3> & as_array() const;
 
-		operator std::array<double, 3>() const;
+		constexpr operator std::array<double, 3>() const;
 
-		bool operator==(const CartesianVector3D & other) const;
-		bool operator!=(const CartesianVector3D & other) const;
+		constexpr bool operator==(const CartesianVector3D & other) const;
+		constexpr bool operator!=(const CartesianVector3D & other) const;
 	private:
 		std::array<double, 3> m_coord;
 	};
 
 	double abs(const CartesianVector3D & vector);
-	CartesianVector3D operator*(const double lhs, const CartesianVector3D & rhs);
+	constexpr CartesianVector3D operator*(const double lhs, const CartesianVector3D & rhs);
 
+	// Trivially copyable. Arithmetic is defined inline below.
 	class CartesianVector2D {
 	public:
-		CartesianVector2D();
-		CartesianVector2D(const std::array<double, 2> & vector);
-		~CartesianVector2D();
+		CartesianVector2D() = default;
+		constexpr CartesianVector2D(const std::array<double, 2> & vector);
 
-		CartesianVector2D operator+(const CartesianVector2D & other) const;
+		constexpr CartesianVector2D operator+(const CartesianVector2D & other) const;
 		CartesianVector2D& operator+=(const CartesianVector2D & other);
-		CartesianVector2D operator-(const CartesianVector2D & other) const;
-		CartesianVector2D operator-() const;
+		constexpr CartesianVector2D operator-(const CartesianVector2D & other) const;
+		constexpr CartesianVector2D operator-() const;
 		CartesianVector2D& operator-=(const CartesianVector2D & other);
-		CartesianPoint2D operator+(const CartesianPoint2D & other) const;
-		CartesianVector2D operator*(const double & multiplyer) const;
+		constexpr CartesianPoint2D operator+(const CartesianPoint2D & other) const;
+		constexpr CartesianVector2D operator*(const double & multiplyer) const;
 		CartesianVector2D& operator*=(const double & multiplyer);
-		CartesianVector2D operator/(const double & divisor)const ;
+		constexpr CartesianVector2D operator/(const double & divisor)const ;
 		CartesianVector2D& operator/=(const double & divisor);
 
 		// Set vector length to 1.
@@ -109,31 +110,366 @@ namespace HBTK {
 		// Returns the length of the vector. Same as: abs(this)
 		double magnitude() const;
 		// Dot product between to vectors.
-		double dot(const CartesianVector2D & other) const;
+		constexpr double dot(const CartesianVector2D & other) const;
 		// Cross product of.. well, its just a single vector.
-		CartesianVector2D cross() const;
+		constexpr CartesianVector2D cross() const;
 		// The cos of the angle between two vectors.
 		double cos_angle(const CartesianVector2D & other) const;
 		// The angle between two vectors in radians.
 		double angle(const CartesianVector2D & other) const;
 
 		double & x();
-		const double & x() const;
+		constexpr const double & x() const;
 		double & y();
-		const double & y() const;
+		constexpr const double & y() const;
 		std::array<double, 2> & as_array();
-		const std::array<double, 2> & as_array() const;
+		constexpr const std::array<double, 2> & as_array() const;
 
-		operator std::array<double, 2>() const;
+		constexpr operator std::array<double, 2>() const;
 
-		bool operator==(const CartesianVector2D & other) const;
-		bool operator!=(const CartesianVector2D & other) const;
+		constexpr bool operator==(const CartesianVector2D & other) const;
+		constexpr bool operator!=(const CartesianVector2D & other) const;
 
 	private:
 		std::array<double, 2> m_coord;
 	};
 
 	double abs(const CartesianVector2D & vector);
-	CartesianVector2D operator*(const double lhs, const CartesianVector2D & rhs);
+	constexpr CartesianVector2D operator*(const double lhs, const CartesianVector2D & rhs);
 
 } // End namespace HBTK
+
+// CartesianPoint.h includes this file back - both classes must be complete
+// before the inline definitions below.
+#include "CartesianPoint.h"
+
+namespace HBTK {
+
+	// DEFINITIONS
+
+	inline constexpr CartesianVector3D::CartesianVector3D(const std::array<double, 3> vector)
+		: m_coord(vector)
+	{
+	}
+
+	inline constexpr CartesianVector3D CartesianVector3D::operator+(const CartesianVector3D & other) const
+	{
+		return CartesianVector3D({
+			x() + other.x(),
+			y() + other.y(),
+			z() + other.z() });
+	}
+
+	inline CartesianVector3D & CartesianVector3D::operator+=(const CartesianVector3D & other)
+	{
+		x() += other.x();
+		y() += other.y();
+		z() += other.z();
+		return *this;
+	}
+
+	inline constexpr CartesianVector3D CartesianVector3D::operator-(const CartesianVector3D & other) const
+	{
+		return CartesianVector3D({
+			x() - other.x(),
+			y() - other.y(),
+			z() - other.z() });
+	}
+
+	inline constexpr CartesianVector3D CartesianVector3D::operator-() const
+	{
+		return CartesianVector3D({ -x(), -y(), -z() });
+	}
+
+	inline CartesianVector3D & CartesianVector3D::operator-=(const CartesianVector3D & other)
+	{
+		x() -= other.x();
+		y() -= other.y();
+		z() -= other.z();
+		return *this;
+	}
+
+	inline constexpr CartesianPoint3D CartesianVector3D::operator+(const CartesianPoint3D & other) const
+	{
+		return CartesianPoint3D({
+			x() + other.x(),
+			y() + other.y(),
+			z() + other.z() });
+	}
+
+	inline constexpr CartesianVector3D CartesianVector3D::operator*(const double & multiplyer) const
+	{
+		return CartesianVector3D({
+			x() * multiplyer,
+			y() * multiplyer,
+			z() * multiplyer });
+	}
+
+	inline CartesianVector3D & CartesianVector3D::operator*=(const double & multiplyer)
+	{
+		x() *= multiplyer;
+		y() *= multiplyer;
+		z() *= multiplyer;
+		return *this;
+	}
+
+	inline constexpr CartesianVector3D CartesianVector3D::operator/(const double & divisor) const
+	{
+		return CartesianVector3D({
+			x() / divisor,
+			y() / divisor,
+			z() / divisor });
+	}
+
+	inline CartesianVector3D & CartesianVector3D::operator/=(const double & divisor)
+	{
+		x() /= divisor;
+		y() /= divisor;
+		z() /= divisor;
+		return *this;
+	}
+
+	inline double CartesianVector3D::magnitude() const
+	{
+		return std::sqrt(x() * x() + y() * y() + z() * z());
+	}
+
+	inline void CartesianVector3D::normalise()
+	{
+		double len = magnitude();
+		x() /= len;
+		y() /= len;
+		z() /= len;
+		return;
+	}
+
+	inline constexpr double CartesianVector3D::dot(const CartesianVector3D & other) const
+	{
+		return x() * other.x() + y() * other.y() + z() * other.z();
+	}
+
+	inline constexpr CartesianVector3D CartesianVector3D::cross(const CartesianVector3D & other) const
+	{
+		return CartesianVector3D({
+			y() * other.z() - z() * other.y(),
+			z() * other.x() - x() * other.z(),
+			x() * other.y() - y() * other.x() });
+	}
+
+	inline double & CartesianVector3D::x()
+	{
+		return m_coord[0];
+	}
+
+	inline constexpr const double & CartesianVector3D::x() const
+	{
+		return m_coord[0];
+	}
+
+	inline double & CartesianVector3D::y()
+	{
+		return m_coord[1];
+	}
+
+	inline constexpr const double & CartesianVector3D::y() const
+	{
+		return m_coord[1];
+	}
+
+	inline double & CartesianVector3D::z()
+	{
+		return m_coord[2];
+	}
+
+	inline constexpr const double & CartesianVector3D::z() const
+	{
+		return m_coord[2];
+	}
+
+	inline constexpr const std::array<double, 3>& CartesianVector3D::as_array() const
+	{
+		return m_coord;
+	}
+
+	inline std::array<double, 3>& CartesianVector3D::as_array()
+	{
+		return m_coord;
+	}
+
+	inline constexpr bool CartesianVector3D::operator==(const CartesianVector3D & other) const
+	{
+		return (x() == other.x()) && (y() == other.y()) && (z() == other.z());
+	}
+
+	inline constexpr bool CartesianVector3D::operator!=(const CartesianVector3D & other) const
+	{
+		return !operator==(other);
+	}
+
+	inline constexpr CartesianVector3D::operator std::array<double, 3>() const
+	{
+		return m_coord;
+	}
+
+	inline double abs(const CartesianVector3D & vector)
+	{
+		return vector.magnitude();
+	}
+
+	inline constexpr CartesianVector3D operator*(const double lhs, const CartesianVector3D & rhs)
+	{
+		return rhs * lhs;
+	}
+
+
+	inline constexpr CartesianVector2D::CartesianVector2D(const std::array<double, 2> & vector)
+		: m_coord(vector)
+	{
+	}
+
+	inline constexpr CartesianVector2D CartesianVector2D::operator+(const CartesianVector2D & other) const
+	{
+		return CartesianVector2D({
+			x() + other.x(),
+			y() + other.y() });
+	}
+
+	inline CartesianVector2D & CartesianVector2D::operator+=(const CartesianVector2D & other)
+	{
+		x() += other.x();
+		y() += other.y();
+		return *this;
+	}
+
+	inline constexpr CartesianVector2D CartesianVector2D::operator-(const CartesianVector2D & other) const
+	{
+		return CartesianVector2D({
+			x() - other.x(),
+			y() - other.y() });
+	}
+
+	inline constexpr CartesianVector2D CartesianVector2D::operator-() const
+	{
+		return CartesianVector2D({ -x(), -y() });
+	}
+
+	inline CartesianVector2D & CartesianVector2D::operator-=(const CartesianVector2D & other)
+	{
+		x() -= other.x();
+		y() -= other.y();
+		return *this;
+	}
+
+	inline constexpr CartesianPoint2D CartesianVector2D::operator+(const CartesianPoint2D & other) const
+	{
+		return CartesianPoint2D({
+			x() + other.x(),
+			y() + other.y() });
+	}
+
+	inline constexpr CartesianVector2D CartesianVector2D::operator*(const double & multiplyer) const
+	{
+		return CartesianVector2D({
+			x() * multiplyer,
+			y() * multiplyer });
+	}
+
+	inline CartesianVector2D& CartesianVector2D::operator*=(const double & multiplyer)
+	{
+		x() *= multiplyer;
+		y() *= multiplyer;
+		return *this;
+	}
+
+	inline constexpr CartesianVector2D CartesianVector2D::operator/(const double & divisor) const
+	{
+		return CartesianVector2D({
+			x() / divisor,
+			y() / divisor });
+	}
+
+	inline CartesianVector2D& CartesianVector2D::operator/=(const double & divisor)
+	{
+		x() /= divisor;
+		y() /= divisor;
+		return *this;
+	}
+
+	inline double CartesianVector2D::magnitude() const
+	{
+		return std::sqrt(x() * x() + y() * y());
+	}
+
+	inline void CartesianVector2D::normalise()
+	{
+		double len = magnitude();
+		x() /= len;
+		y() /= len;
+		return;
+	}
+
+	inline constexpr double CartesianVector2D::dot(const CartesianVector2D & other) const
+	{
+		return x() * other.x() + y() * other.y();
+	}
+
+	inline constexpr CartesianVector2D CartesianVector2D::cross() const
+	{
+		return CartesianVector2D({ y(), -x() });
+	}
+
+	inline double & CartesianVector2D::x()
+	{
+		return m_coord[0];
+	}
+
+	inline constexpr const double & CartesianVector2D::x() const
+	{
+		return m_coord[0];
+	}
+
+	inline double & CartesianVector2D::y()
+	{
+		return m_coord[1];
+	}
+
+	inline constexpr const double & CartesianVector2D::y() const
+	{
+		return m_coord[1];
+	}
+
+	inline std::array<double, 2>& CartesianVector2D::as_array()
+	{
+		return m_coord;
+	}
+
+	inline constexpr const std::array<double, 2>& CartesianVector2D::as_array() const
+	{
+		return m_coord;
+	}
+
+	inline constexpr bool CartesianVector2D::operator==(const CartesianVector2D & other) const
+	{
+		return (x() == other.x()) && (y() == other.y());
+	}
+
+	inline constexpr bool CartesianVector2D::operator!=(const CartesianVector2D & other) const
+	{
+		return !operator==(other);
+	}
+
+	inline constexpr CartesianVector2D::operator std::array<double, 2>() const
+	{
+		return m_coord;
+	}
+
+	inline double abs(const CartesianVector2D & vector)
+	{
+		return vector.magnitude();
+	}
+
+	inline constexpr CartesianVector2D operator*(const double lhs, const CartesianVector2D & rhs)
+	{
+		return rhs * lhs;
+	}
+}
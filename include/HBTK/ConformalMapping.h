@@ -26,6 +26,9 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <complex>
+#include <vector>
+
+#include "StructuredMeshBlock2D.h"
 
 namespace HBTK {
 
@@ -40,4 +43,21 @@ namespace HBTK {
 	// Derivative of above wrt// zeta.
 	std::complex<double> karman_trefftz_transform_derivative(std::complex<double> zeta_point, double alpha);
 
+	// Batched versions of the above for n points held as separate real and
+	// imaginary arrays, so the arithmetic can be vectorised. The derivative
+	// is also computed if dz_real and dz_imag are not nullptr. Outputs may 
+	// alias inputs.
+	void joukowsky_transform(int n, const double * zeta_real, const double * zeta_imag,
+		double * z_real, double * z_imag, double * dz_real = nullptr, double * dz_imag = nullptr);
+	void karman_trefftz_transform(int n, const double * zeta_real, const double * zeta_imag, double alpha,
+		double * z_real, double * z_imag, double * dz_real = nullptr, double * dz_imag = nullptr);
+
+	// Map a polar grid on the zeta plane to the aerofoil plane. Node (i, j) 
+	// of the result is the image of centre + radii[i] * exp(i angles[j]). 
+	// Rows are mapped in parallel on num_threads threads.
+	StructuredMeshBlock2D joukowsky_grid(std::complex<double> centre, const std::vector<double> & radii,
+		const std::vector<double> & angles, int num_threads = 0);
+	StructuredMeshBlock2D karman_trefftz_grid(std::complex<double> centre, const std::vector<double> & radii,
+		const std::vector<double> & angles, double alpha, int num_threads = 0);
+
 } // End namespace HBTK
@@ -31,7 +31,7 @@ namespace HBTK {
 	namespace Elements
 	{
 		class PointGeometry;
-		class LineGemoetry;
+		class LineGeometry;
 		class RightAngleTriangleGeometry;
 		class QuadrangleGeometry;
 		class TetrahedronGeometry;
@@ -43,61 +43,67 @@ namespace HBTK {
 	namespace Elements
 	{
 		class PointGeometry {
-			const int local_number_of_dimensions = 0;
+		public:
+			static constexpr int local_number_of_dimensions = 0;
 
 			template < typename TCoord >
-			constexpr bool is_local_coord_in_element(TCoord local_coord) {
+			static constexpr bool is_local_coord_in_element(const TCoord & local_coord) {
 				return true;
 			}
 		};
 
 		class LineGeometry {
-			const int local_number_of_dimensions = 1;
+		public:
+			static constexpr int local_number_of_dimensions = 1;
 
 			template < typename TCoord >
-			constexpr bool is_local_coord_in_element(TCoord local_coord) {
-				return local_coord[0] >= -1.0 && local_coord[0] <= 1.0
+			static constexpr bool is_local_coord_in_element(const TCoord & local_coord) {
+				return local_coord[0] >= -1.0 && local_coord[0] <= 1.0;
 			}
 		};
 
 		class RightAngleTriangleGeometry {
-			const int local_number_of_dimensions = 2;
+		public:
+			static constexpr int local_number_of_dimensions = 2;
 
 			template < typename TCoord >
-			constexpr bool is_local_coord_in_element(TCoord local_coord) {
+			static constexpr bool is_local_coord_in_element(const TCoord & local_coord) {
 				return (local_coord[0] >= 0.0
 					&& local_coord[1] >= 0.0
-					&& local_coord[0] + local_coord[1] >= 1.0);
+					&& local_coord[0] + local_coord[1] <= 1.0);
 			}
 		};
 
 		class QuadrangleGeometry {
-			const int local_number_of_dimensions = 2;
+		public:
+			static constexpr int local_number_of_dimensions = 2;
 
 			template < typename TCoord >
-			constexpr bool is_local_coord_in_element(TCoord local_coord) {
+			static constexpr bool is_local_coord_in_element(const TCoord & local_coord) {
 				return (local_coord[0] >= -1.0 && local_coord[0] <= 1.0
 					&& local_coord[1] >= -1.0 && local_coord[1] <= 1.0);
 			}
 		};
 
 		class TetrahedronGeometry {
-			const int local_number_of_dimensions = 3;
+		public:
+			static constexpr int local_number_of_dimensions = 3;
 
 			template < typename TCoord >
-			constexpr bool is_local_coord_in_element(TCoord local_coord) {
+			static constexpr bool is_local_coord_in_element(const TCoord & local_coord) {
 				return (local_coord[0] >= 0.0
 					&& local_coord[1] >= 0.0
 					&& local_coord[2] >= 0.0
-					&& local_coord[0] + local_coord[1] + local_coord[2] >= 1.0);
+					&& local_coord[0] + local_coord[1] + local_coord[2] <= 1.0);
 			}
 		};
 
 		class HexahedronGeometry {
-			const int local_number_of_dimensions = 3;
+		public:
+			static constexpr int local_number_of_dimensions = 3;
 
 			template < typename TCoord >
-			constexpr bool is_local_coord_in_element(TCoord local_coord) {
+			static constexpr bool is_local_coord_in_element(const TCoord & local_coord) {
 				return (local_coord[0] >= -1.0 && local_coord[0] <= 1.0
 					&& local_coord[1] >= -1.0 && local_coord[1] <= 1.0
 					&& local_coord[2] >= -1.0 && local_coord[2] <= 1.0);
@@ -105,30 +111,31 @@ namespace HBTK {
 		};
 
 		class RightAngleTrianglePrismGeometry {
-			const int local_number_of_dimensions = 3;
+		public:
+			static constexpr int local_number_of_dimensions = 3;
 
 			template < typename TCoord >
-			constexpr bool is_local_coord_in_element(TCoord local_coord) {
+			static constexpr bool is_local_coord_in_element(const TCoord & local_coord) {
 				return (local_coord[0] >= 0.0
 					&& local_coord[1] >= 0.0
-					&& local_coord[0] + local_coord[1] >= 1.0
+					&& local_coord[0] + local_coord[1] <= 1.0
 					&& local_coord[2] >= -1.0 && local_coord[2] <= 1.0);
 			}
 		};
 
 		class PyramidGeometry {
-			const int local_number_of_dimensions = 3;
+		public:
+			static constexpr int local_number_of_dimensions = 3;
 
 			template < typename TCoord >
-			constexpr bool is_local_coord_in_element(TCoord local_coord) {
+			static constexpr bool is_local_coord_in_element(const TCoord & local_coord) {
 				return (local_coord[0] >= -1.0 && local_coord[0] <= 1.0
 					&& local_coord[1] >= -1.0 && local_coord[1] <= 1.0
 					&& local_coord[2] >= 0.0 && local_coord[2] <= 1.0
-					&& local_coord[2] + abs(local_coord[0]) <= 1.0
-					&& local_coord[2] + abs(local_coord[1]) <= 1.0
+					&& local_coord[2] + (local_coord[0] < 0 ? -local_coord[0] : local_coord[0]) <= 1.0
+					&& local_coord[2] + (local_coord[1] < 0 ? -local_coord[1] : local_coord[1]) <= 1.0
 					);
 			}
 		};
 	}
 }
-
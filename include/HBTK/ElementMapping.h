@@ -0,0 +1,72 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+ElementMapping.h
+
+Runtime access to element shape functions by element type, and forward 
+and inverse mapping between local and global coordinates.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+
+#include "CartesianPoint.h"
+
+namespace HBTK {
+	namespace Elements {
+		// The shape functions of an element type behind function pointers, so 
+		// that meshes of mixed element types can be handled in a single loop.
+		struct ElementShape {
+			int number_of_nodes;
+			int local_dimensions;
+			// Polynomial order. Elements of order > 1 may be curved.
+			int order;
+			// Sets values[i] = N_i and derivatives[d * number_of_nodes + i] =
+			// dN_i / dlocal_d. derivatives may be nullptr.
+			void(*evaluate)(const double * local, double * values, double * derivatives);
+			// True if local is within the reference element, allowing tolerance.
+			bool(*contains)(const double * local, double tolerance);
+			// Centroid of the reference element.
+			std::array<double, 3> centre;
+		};
+
+		// Upper bound on ElementShape::number_of_nodes, for stack buffers.
+		constexpr int max_shape_nodes = 27;
+
+		// The shape of the Gmsh element type ele_id (see GmshInfo.h), or 
+		// nullptr if there are no shape functions for that type.
+		const ElementShape * gmsh_element_shape(int ele_id);
+
+		// Global coordinate of local coordinate in element with nodes.
+		CartesianPoint3D forward_map(const ElementShape & shape, 
+			const CartesianPoint3D * nodes, const double * local);
+
+		// Local coordinate of point in an element by Newton's method, starting 
+		// from the value in local. For elements of fewer than three dimensions, 
+		// finds the closest point on the (infinitely extended) element by 
+		// Gauss-Newton. Returns false if the iteration did not converge to 
+		// step size tolerance in max_iterations. Does not check that the 
+		// result is within the element.
+		bool inverse_map(const ElementShape & shape, const CartesianPoint3D * nodes,
+			const CartesianPoint3D & point, double * local, 
+			double tolerance = 1e-10, int max_iterations = 25);
+	}
+}
@@ -77,27 +77,31 @@ namespace HBTK {
 	namespace Elements
 	{
 		class Point1
-			: Elements::PointGeometry
+			: public Elements::PointGeometry
 		{
-			const std::array<std::array<double, 0>, 0> nodes = { { {{ }} } };
+		public:
+			static constexpr std::array<std::array<double, 0>, 0> nodes = { {} };
 		};
 
 		class Line2
-			: Elements::LineGeometry
+			: public Elements::LineGeometry
 		{
-			const std::array<std::array<double, 1>, 2> nodes = { { {{ -1.0 }},{{ 1.0 }} } };
+		public:
+			static constexpr std::array<std::array<double, 1>, 2> nodes = { { {{ -1.0 }},{{ 1.0 }} } };
 		};
 
 		class Line3
-			: Elements::LineGeometry
+			: public Elements::LineGeometry
 		{
-			const std::array<std::array<double, 1>, 3> nodes = { { {{ -1.0 }},{{ 1.0 }},{{ 0.0 }} } };
+		public:
+			static constexpr std::array<std::array<double, 1>, 3> nodes = { { {{ -1.0 }},{{ 1.0 }},{{ 0.0 }} } };
 		};
 
 		class Line4
-			: Elements::LineGeometry
+			: public Elements::LineGeometry
 		{
-			const std::array<std::array<double, 1>, 4> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 1>, 4> nodes = { {
 			{{ -1.0 }},
 			{{ 1.0 }},
 			{{ -1.0 / 3.0 }},
@@ -105,9 +109,10 @@ namespace HBTK {
 		};
 
 		class Line5
-			: Elements::LineGeometry
+			: public Elements::LineGeometry
 		{
-			const std::array<std::array<double, 1>, 5> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 1>, 5> nodes = { {
 			{{ -1.0 }},
 			{{ 1.0 }},
 			{{ -0.5 }},
@@ -116,9 +121,10 @@ namespace HBTK {
 		};
 
 		class Line6
-			: Elements::LineGeometry
+			: public Elements::LineGeometry
 		{
-			const std::array<std::array<double, 1>, 6> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 1>, 6> nodes = { {
 			{{ -1.0 }},
 			{{ 1.0 }},
 			{{ -3.0 / 5.0 }},
@@ -129,9 +135,10 @@ namespace HBTK {
 		};
 
 		class Triangle3
-			: Elements::RightAngleTriangleGeometry
+			: public Elements::RightAngleTriangleGeometry
 		{
-			const std::array<std::array<double, 2>, 3> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 3> nodes = { {
 			{{ 0.0,  0.0 }},
 			{{ 1.0,  0.0 }},
 			{{ 0.0,  1.0 }}
@@ -139,9 +146,10 @@ namespace HBTK {
 		};
 
 		class Triangle6
-			: Elements::RightAngleTriangleGeometry
+			: public Elements::RightAngleTriangleGeometry
 		{
-			const std::array<std::array<double, 2>, 6> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 6> nodes = { {
 			{{ 0.0,  0.0 }},
 			{{ 1.0,  0.0 }},
 			{{ 0.0,  1.0 }},
@@ -152,9 +160,10 @@ namespace HBTK {
 		};
 
 		class Triangle9
-			: Elements::RightAngleTriangleGeometry
+			: public Elements::RightAngleTriangleGeometry
 		{
-			const std::array<std::array<double, 2>, 9> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 9> nodes = { {
 			{{ 0.0,			0.0 }},
 			{{ 1.0,			0.0 }},
 			{{ 0.0,			1.0 }},
@@ -167,9 +176,10 @@ namespace HBTK {
 		};
 
 		class Triangle10
-			: Elements::RightAngleTriangleGeometry
+			: public Elements::RightAngleTriangleGeometry
 		{
-			const std::array<std::array<double, 2>, 10> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 10> nodes = { {
 			{{ 0.0,			0.0 }},
 			{{ 1.0,			0.0 }},
 			{{ 0.0,			1.0 }},
@@ -183,9 +193,10 @@ namespace HBTK {
 		};
 
 		class Triangle12
-			: Elements::RightAngleTriangleGeometry
+			: public Elements::RightAngleTriangleGeometry
 		{
-			const std::array<std::array<double, 2>, 12> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 12> nodes = { {
 			{{ 0.0,     0.0 }},
 			{{ 1.0,     0.0 }},
 			{{ 0.0,     1.0 }},
@@ -201,9 +212,10 @@ namespace HBTK {
 		};
 
 		class Triangle15O4
-			: Elements::RightAngleTriangleGeometry
+			: public Elements::RightAngleTriangleGeometry
 		{
-			const std::array<std::array<double, 2>, 15> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 15> nodes = { {
 			{{ 0.0,  0.0 }},
 			{{ 1.0,  0.0 }},
 			{{ 0.0,  1.0 }},
@@ -222,9 +234,10 @@ namespace HBTK {
 		};
 
 		class Triangle15O5
-			: Elements::RightAngleTriangleGeometry
+			: public Elements::RightAngleTriangleGeometry
 		{
-			const std::array<std::array<double, 2>, 15> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 15> nodes = { {
 			{{ 0.0,	0.0 }},
 			{{ 1.0,	0.0 }},
 			{{ 0.0,  1.0 }},
@@ -236,16 +249,17 @@ namespace HBTK {
 			{{ 0.6,	0.4 }},
 			{{ 0.4,	0.6 }},
 			{{ 0.2,	0.8 }},
-			{{ 0.8,	0.0 }},
-			{{ 0.6,	0.0 }},
-			{{ 0.4,	0.0 }},
-			{{ 0.2,	0.0 }} } };
+			{{ 0.0,  0.8 }},
+			{{ 0.0,  0.6 }},
+			{{ 0.0,  0.4 }},
+			{{ 0.0,  0.2 }} } };
 		};
 
 		class Triangle21
-			: Elements::RightAngleTriangleGeometry
+			: public Elements::RightAngleTriangleGeometry
 		{
-			const std::array<std::array<double, 2>, 21> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 21> nodes = { {
 			{{ 0.0,  0.0 }},
 			{{ 1.0,  0.0 }},
 			{{ 0.0,  1.0 }},
@@ -257,22 +271,23 @@ namespace HBTK {
 			{{ 0.6,  0.4 }},
 			{{ 0.4,  0.6 }},
 			{{ 0.2,  0.8 }},
-			{{ 0.8,  0.0 }},
-			{{ 0.6,  0.0 }},
-			{{ 0.4,  0.0 }},
-			{{ 0.2,  0.0 }},
-			{{ 0.2,	0.2 }},
-			{{ 0.4,	0.2 }},
-			{{ 0.6,	0.2 }},
-			{{ 0.4,	0.4 }},
-			{{ 0.2,	0.6 }},
-			{{ 0.2,	0.4 }} } };
+			{{ 0.0,  0.8 }},
+			{{ 0.0,  0.6 }},
+			{{ 0.0,  0.4 }},
+			{{ 0.0,  0.2 }},
+			{{ 0.2,  0.2 }},
+			{{ 0.6,  0.2 }},
+			{{ 0.2,  0.6 }},
+			{{ 0.4,  0.2 }},
+			{{ 0.4,  0.4 }},
+			{{ 0.2,  0.4 }} } };
 		};
 
 		class Quadrangle4
-			: Elements::QuadrangleGeometry
+			: public Elements::QuadrangleGeometry
 		{
-			const std::array<std::array<double, 2>, 4> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 4> nodes = { {
 			{{ -1.0, -1.0 }},
 			{{ 1.0,  -1.0 }},
 			{{ 1.0,  1.0 }},
@@ -280,9 +295,10 @@ namespace HBTK {
 		};
 
 		class Quadrangle8
-			: Elements::QuadrangleGeometry
+			: public Elements::QuadrangleGeometry
 		{
-			const std::array<std::array<double, 2>, 8> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 8> nodes = { {
 			{{ -1.0, -1.0 }},
 			{{ 1.0,  -1.0 }},
 			{{ 1.0,  1.0 }},
@@ -294,9 +310,10 @@ namespace HBTK {
 		};
 
 		class Quadrangle9
-			: Elements::QuadrangleGeometry
+			: public Elements::QuadrangleGeometry
 		{
-			const std::array<std::array<double, 2>, 9> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 9> nodes = { {
 			{{ -1.0, -1.0 }},
 			{{ 1.0,  -1.0 }},
 			{{ 1.0,  1.0 }},
@@ -309,9 +326,10 @@ namespace HBTK {
 		};
 
 		class Quadrangle12
-			: Elements::QuadrangleGeometry
+			: public Elements::QuadrangleGeometry
 		{
-			const std::array<std::array<double, 2>, 12> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 12> nodes = { {
 			{{ -1.0,			-1.0 }},
 			{{ 1.0,			-1.0 }},
 			{{ 1.0,			1.0 }},
@@ -327,9 +345,10 @@ namespace HBTK {
 		};
 
 		class Quadrangle16
-			: Elements::QuadrangleGeometry
+			: public Elements::QuadrangleGeometry
 		{
-			const std::array<std::array<double, 2>, 16> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 2>, 16> nodes = { {
 			{{ -1.0,         -1.0 }},
 			{{ 1.0,          -1.0 }},
 			{{ 1.0,          1.0 }},
@@ -349,9 +368,10 @@ namespace HBTK {
 		};
 
 		class Tetrahedron4
-			: Elements::TetrahedronGeometry
+			: public Elements::TetrahedronGeometry
 		{
-			const std::array<std::array<double, 3>, 4> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 4> nodes = { {
 			{{ 0.0,  0.0,  0.0 }},
 			{{ 1.0,  0.0,  0.0 }},
 			{{ 0.0,  1.0,  0.0 }},
@@ -359,9 +379,10 @@ namespace HBTK {
 		};
 
 		class Tetrahedron10
-			: Elements::TetrahedronGeometry
+			: public Elements::TetrahedronGeometry
 		{
-			const std::array<std::array<double, 3>, 10> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 10> nodes = { {
 			{{ 0.0,  0.0,  0.0 }},
 			{{ 1.0,  0.0,  0.0 }},
 			{{ 0.0,  1.0,  0.0 }},
@@ -375,9 +396,10 @@ namespace HBTK {
 		};
 
 		class Tetrahedron20
-			: Elements::TetrahedronGeometry
+			: public Elements::TetrahedronGeometry
 		{
-			const std::array<std::array<double, 3>, 20> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 20> nodes = { {
 			{{ 0.0,			0.0,		0.0 }},
 			{{ 1.0,			0.0,		0.0 }},
 			{{ 0.0,			1.0,		0.0 }},
@@ -386,46 +408,48 @@ namespace HBTK {
 			{{ 2.0 / 3.0,	0.0,		0.0 }} ,
 			{{ 2.0 / 3.0,	1.0 / 3.0,	0.0 }} ,
 			{{ 1.0 / 3.0,	2.0 / 3.0,	0.0 }} ,
-			{{ 0.0,			2.0 / 3.0,	0.0 }} ,
-			{{ 0.0,			1.0 / 3.0,	0.0 }} ,
-			{{ 0.0,			1.0 / 3.0,	0.0 }} ,
-			{{ 0.0,			2.0 / 3.0,	0.0 }} ,
-			{{ 0.0,			2.0 / 3.0,	1.0 / 3.0 }} ,
-			{{ 0.0,			1.0 / 3.0,	2.0 / 3.0 }} ,
-			{{ 2.0 / 3.0,	1.0 / 3.0,	0.0 }} ,
-			{{ 1.0 / 3.0,	2.0 / 3.0,	0.0 }} ,
+			{{ 0.0,		2.0 / 3.0,	0.0 }} ,
+			{{ 0.0,		1.0 / 3.0,	0.0 }} ,
+			{{ 0.0,		0.0,		2.0 / 3.0 }} ,
+			{{ 0.0,		0.0,		1.0 / 3.0 }} ,
+			{{ 0.0,		1.0 / 3.0,	2.0 / 3.0 }} ,
+			{{ 0.0,		2.0 / 3.0,	1.0 / 3.0 }} ,
+			{{ 1.0 / 3.0,	0.0,		2.0 / 3.0 }} ,
+			{{ 2.0 / 3.0,	0.0,		1.0 / 3.0 }} ,
 			{{ 1.0 / 3.0,	1.0 / 3.0,	0.0 }} ,
 			{{ 1.0 / 3.0,	0.0,		1.0 / 3.0 }} ,
-			{{ 0.0,			1.0 / 3.0,	1.0 / 3.0 }} ,
-			{{ 1.0 / 3.0,	1.0 / 3.0,	2.0 / 3.0 }} } };
+			{{ 0.0,		1.0 / 3.0,	1.0 / 3.0 }} ,
+			{{ 1.0 / 3.0,	1.0 / 3.0,	1.0 / 3.0 }} } };
 		};
 
 		class Hexahedron8
-			: Elements::HexahedronGeometry
+			: public Elements::HexahedronGeometry
 		{
-			const std::array<std::array<double, 3>, 8> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 8> nodes = { {
 			{{ -1.0, -1.0, -1.0 }},
 			{{ 1.0,	-1.0, -1.0 }},
 			{{ 1.0,	1.0,  -1.0 }},
 			{{ -1.0, 1.0,  -1.0 }},
 			{{ -1.0, -1.0, 1.0 }},
 			{{ 1.0,	-1.0, 1.0 }},
-			{{ 1.0,	-1.0, 1.0 }},
-			{{ 1.0,	1.0,  1.0 }} } };
+			{{ 1.0,  1.0,  1.0 }},
+			{{ -1.0, 1.0,  1.0 }} } };
 		};
 
 		class Hexahedron20
-			: Elements::HexahedronGeometry
+			: public Elements::HexahedronGeometry
 		{
-			const std::array<std::array<double, 3>, 20> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 20> nodes = { {
 			{{ -1.0, -1.0, -1.0 }},
 			{{ 1.0,  -1.0, -1.0 }},
 			{{ 1.0,  1.0,  -1.0 }},
 			{{ -1.0, 1.0,  -1.0 }},
 			{{ -1.0, -1.0, 1.0 }},
 			{{ 1.0,  -1.0, 1.0 }},
-			{{ 1.0,  -1.0, 1.0 }},
 			{{ 1.0,  1.0,  1.0 }},
+			{{ -1.0, 1.0,  1.0 }},
 			{{ 0.0,  -1.0, -1.0 }},
 			{{ -1.0, 0.0,  -1.0 }},
 			{{ -1.0, -1.0, 0.0 }},
@@ -441,17 +465,18 @@ namespace HBTK {
 		};
 
 		class Hexahedron27
-			: Elements::HexahedronGeometry
+			: public Elements::HexahedronGeometry
 		{
-			const std::array<std::array<double, 3>, 27> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 27> nodes = { {
 			{{ -1.0, -1.0, -1.0 }},
 			{{ 1.0, -1.0, -1.0 }},
 			{{ 1.0, 1.0, -1.0 }},
 			{{ -1.0, 1.0, -1.0 }},
 			{{ -1.0, -1.0, 1.0 }},
 			{{ 1.0, -1.0, 1.0 }},
-			{{ 1.0, -1.0, 1.0 }},
-			{{ 1.0, 1.0, 1.0 }},
+			{{ 1.0,  1.0,  1.0 }},
+			{{ -1.0, 1.0,  1.0 }},
 			{{ 0.0, -1.0, -1.0 }},
 			{{ -1.0, 0.0, -1.0 }},
 			{{ -1.0, -1.0, 0.0 }},
@@ -474,9 +499,10 @@ namespace HBTK {
 		};
 
 		class Prism6
-			: Elements::RightAngleTrianglePrismGeometry
+			: public Elements::RightAngleTrianglePrismGeometry
 		{
-			const std::array<std::array<double, 3>, 6> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 6> nodes = { {
 			{{ 0.0, 0.0, -1.0 }},
 			{{ 1.0, 0.0, -1.0 }},
 			{{ 0.0, 1.0, -1.0 }},
@@ -486,9 +512,10 @@ namespace HBTK {
 		};
 
 		class Prism15
-			: Elements::RightAngleTrianglePrismGeometry
+			: public Elements::RightAngleTrianglePrismGeometry
 		{
-			const std::array<std::array<double, 3>, 15> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 15> nodes = { {
 			{{ 0.0, 0.0, -1.0 }},
 			{{ 1.0, 0.0, -1.0 }},
 			{{ 0.0, 1.0, -1.0 }},
@@ -507,9 +534,10 @@ namespace HBTK {
 		};
 
 		class Prism18
-			: Elements::RightAngleTrianglePrismGeometry
+			: public Elements::RightAngleTrianglePrismGeometry
 		{
-			const std::array<std::array<double, 3>, 18> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 18> nodes = { {
 			{{ 0.0, 0.0, -1.0 }},
 			{{ 1.0, 0.0, -1.0 }},
 			{{ 0.0, 1.0, -1.0 }},
@@ -531,9 +559,10 @@ namespace HBTK {
 		};
 
 		class Pyramid5
-			: Elements::PyramidGeometry
+			: public Elements::PyramidGeometry
 		{
-			const std::array<std::array<double, 3>, 5> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 5> nodes = { {
 			{{ -1.0, -1.0, 0.0 }},
 			{{ 1.0,	-1.0, 0.0 }},
 			{{ 1.0,	1.0,  0.0 }},
@@ -542,9 +571,10 @@ namespace HBTK {
 		};
 
 		class Pyramid13
-			: Elements::PyramidGeometry
+			: public Elements::PyramidGeometry
 		{
-			const std::array<std::array<double, 3>, 13> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 13> nodes = { {
 			{{ -1.0, -1.0, 0.0 }},
 			{{ 1.0,  -1.0, 0.0 }},
 			{{ 1.0,  1.0,  0.0 }},
@@ -561,9 +591,10 @@ namespace HBTK {
 		};
 
 		class Pyramid14
-			: Elements::PyramidGeometry
+			: public Elements::PyramidGeometry
 		{
-			const std::array<std::array<double, 3>, 14> nodes = { {
+		public:
+			static constexpr std::array<std::array<double, 3>, 14> nodes = { {
 			{{ -1.0, -1.0, 0.0 }},
 			{{ 1.0,  -1.0, 0.0 }},
 			{{ 1.0,  1.0,  0.0 }},
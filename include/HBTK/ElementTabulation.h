@@ -0,0 +1,97 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+ElementTabulation.h
+
+Cubature rules over reference elements, and shape functions tabulated at
+the points of a cubature rule.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <vector>
+
+#include "CartesianPoint.h"
+#include "ElementMapping.h"
+
+namespace HBTK {
+	namespace Elements {
+		// A quadrature rule over a reference element.
+		struct ElementCubature {
+			int local_dimensions;
+			std::vector<std::array<double, 3>> points;
+			std::vector<double> weights;
+
+			int size() const { return (int)weights.size(); }
+		};
+
+		// A rule integrating polynomials up to degree order exactly over the
+		// reference element of Gmsh element type ele_id. Lines, quadrangles and
+		// hexahedra use (tensor products of) Gauss-Legendre rules. Triangles 
+		// and tetrahedra use Gauss-Legendre rules on the collapsed (Duffy)
+		// element, and prisms extrude the triangle rule. Throws 
+		// std::invalid_argument for other element types.
+		ElementCubature gmsh_element_cubature(int ele_id, int order);
+
+		// Shape functions and their derivatives evaluated once at the points 
+		// of a cubature rule and stored as dense row-major matrices, so the 
+		// work per element is small matrix-vector products.
+		class ShapeFunctionTable {
+		public:
+			ShapeFunctionTable(const ElementShape & shape, const ElementCubature & cubature);
+
+			int number_of_points() const;
+			int number_of_nodes() const;
+			int local_dimensions() const;
+			const std::vector<double> & weights() const;
+			const std::vector<std::array<double, 3>> & points() const;
+
+			// values()[q * number_of_nodes() + i] is N_i at point q.
+			const std::vector<double> & values() const;
+			// derivatives()[(q * local_dimensions() + d) * number_of_nodes() + i] 
+			// is dN_i / dlocal_d at point q.
+			const std::vector<double> & derivatives() const;
+
+			// Interpolate nodal values to the cubature points: 
+			// at_points[q] = sum_i N_i(q) nodal[i].
+			void interpolate(const double * nodal, double * at_points) const;
+			// The same for num_elements elements at once. nodal[e * number_of_nodes() + i]
+			// to at_points[e * number_of_points() + q].
+			void interpolate(int num_elements, const double * nodal, double * at_points) const;
+
+			// Global coordinates of the cubature points in an element with the
+			// given nodes, and the cubature weights scaled by the element's 
+			// Jacobian determinant (or length / area scale factor for line and
+			// surface elements) so that sum_q f(points[q]) * jacobian_weights[q]
+			// integrates f over the element.
+			void map(const CartesianPoint3D * nodes, CartesianPoint3D * points, 
+				double * jacobian_weights) const;
+
+		private:
+			int m_number_of_nodes;
+			int m_local_dimensions;
+			std::vector<std::array<double, 3>> m_points;
+			std::vector<double> m_weights;
+			std::vector<double> m_values;
+			std::vector<double> m_derivatives;
+		};
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+FieldSplitter.h
+
+Split lines into whitespace separated fields without allocation.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "StringView.h"
+
+namespace HBTK {
+	// Splits lines into whitespace separated fields, viewing the line's 
+	// characters rather than copying them. The field storage is kept
+	// between calls, so once it has grown to fit the longest line, splitting
+	// doesn't allocate.
+	class FieldSplitter {
+	public:
+		FieldSplitter();
+
+		// Split line, replacing the previous fields. Returns the number of 
+		// fields. The fields are valid until the next split or until line's
+		// characters change.
+		int split(StringView line);
+
+		int size() const;
+		bool empty() const;
+		StringView operator[](int index) const;
+		const StringView * begin() const;
+		const StringView * end() const;
+
+	private:
+		std::vector<StringView> m_fields;
+		int m_size;
+	};
+}
@@ -25,7 +25,7 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
-#include <fstream>
+#include <istream>
 
 namespace HBTK {
 	class FortranSequentialInputStream
@@ -41,38 +41,38 @@ namespace HBTK {
 
 		// Read Fortran record start marker and leave curser at data start.
 		// Returns number of bytes in length of current record.
-		int record_open(std::ifstream & input_stream);
+		int record_open(std::istream & input_stream);
 
 		// If you're reading a file backwards, you'll start 
 		// reading a record at its end. Use record_open_reverse
 		// to enter a record from its end.
 		// Curser left at the end of the records data.
-		int record_open_reverse(std::ifstream & input_stream);
+		int record_open_reverse(std::istream & input_stream);
 
 		// When you've reached the expected end of the record,
 		// call record_end(input_stream) and the record end will be
 		// checked.
 		// Curser left at the end of the closing record header.
 		// Returns length of record in bytes.
-		void record_close(std::ifstream & input_stream);
+		void record_close(std::istream & input_stream);
 
 		// If you're reading a file backwards, you'll want
 		// to close a record from its start. 
 		// This function closes the record and leaves the curser
 		// before its start.
-		void record_close_reverse(std::ifstream & input_stream);
+		void record_close_reverse(std::istream & input_stream);
 
 		// Jump back to the beginning of the current record.
 		// Returns length of record in bytes.
 		// Curser left at the beginning of the record's data.
-		int seek_record_start(std::ifstream & input_stream);
+		int seek_record_start(std::istream & input_stream);
 
 		// Jumps to the end of the current record.
 		// Checks that expected record end length is still
 		// there.
 		// Curser left at the end of the records data.
 		// Returns length of record in bytes.
-		int seek_record_end(std::ifstream & input_stream);
+		int seek_record_end(std::istream & input_stream);
 
 	private:
 
@@ -25,7 +25,7 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
-#include <fstream>
+#include <ostream>
 
 namespace HBTK {
 	class FortranSequentialOutputStream
@@ -41,9 +41,9 @@ namespace HBTK {
 		// having to read or write binary interfacing Fortran programs.
 
 		// Write a record start marker.
-		void record_start(std::ofstream & output_stream);
+		void record_start(std::ostream & output_stream);
 		// Write a record end marker.
-		void record_end(std::ofstream & output_stream);
+		void record_end(std::ostream & output_stream);
 
 	private:
 		int m_last_record_start;
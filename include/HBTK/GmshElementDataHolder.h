@@ -33,6 +33,10 @@ namespace HBTK {
 	namespace Gmsh {
 		class GmshMeshHolder;
 
+		// One dataset at one time step, as in an $ElementData section. Values are 
+		// stored contiguously, indexed densely by element tag, so a dataset costs 
+		// number_of_element_data_points() * components() doubles plus an int per
+		// tag rather than a heap allocation per element.
 		class GmshElementDataHolder {
 		public:
 			GmshElementDataHolder();
@@ -47,12 +51,29 @@ namespace HBTK {
 			double & time();
 			const double & time() const;
 
-			int number_of_element_data_points();
-			bool element_data_exists(int element_tag);
-			std::vector<double> & element_data(int element_tag);
+			int number_of_element_data_points() const;
+			bool element_data_exists(int element_tag) const;
+			// The components() values of element_tag.
+			double * element_data(int element_tag);
+			const double * element_data(int element_tag) const;
 			void add_element_data(int element_tag, std::vector<double> element_data);
+			void add_element_data(int element_tag, const double * element_data);
 			void remove_element_data(int element_tag);
 
+			// Element tags in the order they were added, and their values, 
+			// components() per tag, in the same order.
+			const std::vector<int> & element_tags() const;
+			const std::vector<double> & values() const;
+
+			// Change tags, for example after GmshMeshHolder::renumber_elements. 
+			// new_tags maps every old tag to its new tag.
+			void renumber_element_tags(const std::unordered_map<int, int> & new_tags);
+
+			// Remove all element data, keeping the storage for reuse.
+			void clear();
+			// Allocate for count elements with tags up to max_tag.
+			void reserve(int max_tag, int count);
+
 			std::vector<int> check_correct_element_data_length();
 			std::vector<int> check_consistant(GmshMeshHolder & mesh);
 
@@ -61,19 +82,32 @@ namespace HBTK {
 				vector,
 				tensor2
 			};
+			// Set before adding data.
 			data_type & element_data_type();
-
+			const data_type & element_data_type() const;
+			// Values per element: 1, 3 or 9.
+			int components() const;
+			// The data type with n components. Throws std::domain_error if
+			// there isn't one.
+			static data_type data_type_with_components(int n);
+			
 		private:
 			std::string m_element_data_name;
 			double m_time;
 			int m_time_step;
 			data_type m_element_data_type;
-			std::unordered_map<int, std::vector<double>> m_element_data;
-
-			// Expected number of values per node due according to node data type.
-			int data_len();
-			// A string of node data type.
-			std::string data_type_str();
+			// Slot of each element tag, or -1.
+			std::vector<int> m_slots;
+			// Element tag of each slot.
+			std::vector<int> m_tags;
+			// Values of slot i are m_values[i * components(), (i + 1) * components()).
+			std::vector<double> m_values;
+
+			int slot(int element_tag) const;
+			// Expected number of values per element due according to element data type.
+			int data_len() const;
+			// A string of element data type.
+			std::string data_type_str() const;
 		};
 	}
 }
\ No newline at end of file
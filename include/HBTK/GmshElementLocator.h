@@ -0,0 +1,84 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+GmshElementLocator.h
+
+Find the element of a Gmsh mesh containing a point, and the point's local
+coordinate within that element.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <vector>
+
+#include "BoundingVolumeHierarchy.h"
+#include "CartesianPoint.h"
+#include "ElementMapping.h"
+#include "GmshMeshHolder.h"
+
+namespace HBTK {
+	namespace Gmsh {
+		// Element bounding boxes are held in a BVH. Candidate elements are 
+		// tested by inverse mapping the point into them. The locator keeps
+		// its own copy of the node coordinates, so the mesh may change or be
+		// destroyed after building without affecting it.
+		class GmshElementLocator {
+		public:
+			GmshElementLocator();
+			// Locate in all elements of the highest dimension present in mesh.
+			GmshElementLocator(GmshMeshHolder & mesh, int num_threads = 0);
+
+			// Locate in the given elements only - for example, those of a 
+			// physical group. Elements without shape functions (see 
+			// Elements::gmsh_element_shape) are ignored. Points within 
+			// distance_tolerance of line and surface elements are located 
+			// on them.
+			void build(GmshMeshHolder & mesh, const std::vector<int> & element_tags,
+				double distance_tolerance = 1e-8, int num_threads = 0);
+
+			int number_of_elements() const;
+
+			// Tag of an element containing point, or -1 if there is none. On
+			// success local is the point's local coordinate in the element.
+			int locate(const CartesianPoint3D & point, std::array<double, 3> & local) const;
+			// Batched, evaluated in parallel.
+			void locate(const std::vector<CartesianPoint3D> & points, std::vector<int> & element_tags,
+				std::vector<std::array<double, 3>> & locals, int num_threads = 0) const;
+
+		private:
+			std::vector<int> m_element_tags;
+			std::vector<const Elements::ElementShape *> m_shapes;
+			// Nodes of element i are m_nodes[m_node_offsets[i], m_node_offsets[i + 1]).
+			std::vector<int> m_node_offsets;
+			std::vector<CartesianPoint3D> m_nodes;
+			// BVH leaves hold several elements, so each box is checked again 
+			// before the (much more expensive) inverse mapping.
+			std::vector<CartesianBoundingBox3D> m_boxes;
+			BoundingVolumeHierarchy3D m_bvh;
+			double m_distance_tolerance;
+
+			// Tolerance on the element boundary in local coordinates.
+			static constexpr double local_tolerance = 1e-8;
+
+			bool in_element(int element, const CartesianPoint3D & point, double * local) const;
+		};
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+GmshIntegrator.h
+
+Integration of functions over the elements of a Gmsh mesh.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "CartesianPoint.h"
+#include "GmshMeshHolder.h"
+#include "Parallel.h"
+
+namespace HBTK {
+	namespace Gmsh {
+		// Elements are mapped once when building: the global coordinates of 
+		// every cubature point and its weight (scaled by the Jacobian) are 
+		// stored contiguously, so integrating a function is a parallel loop 
+		// over these points with no work per element beyond a sum. Like
+		// GmshElementLocator, the integrator keeps its own copy of the 
+		// geometry, so it must be rebuilt if the mesh moves.
+		//
+		// Sums are formed per element and then added in order of element
+		// tag, so results do not depend on the number of threads.
+		class GmshIntegrator {
+		public:
+			GmshIntegrator();
+			// Integrate over the elements of physical group group_tag, exactly 
+			// for polynomials of degree order in local coordinates.
+			GmshIntegrator(GmshMeshHolder & mesh, int group_tag, int order = 2, int num_threads = 0);
+
+			// Integrate over the given elements. Throws std::invalid_argument
+			// if there is no cubature for an element type (see 
+			// Elements::gmsh_element_cubature).
+			void build(GmshMeshHolder & mesh, const std::vector<int> & element_tags, 
+				int order = 2, int num_threads = 0);
+
+			int number_of_elements() const;
+			int number_of_points() const;
+			// Sorted tags of the elements integrated over.
+			const std::vector<int> & element_tags() const;
+			// Cubature points and Jacobian scaled weights of element i (index 
+			// into element_tags()) are those in [point_offset(i), point_offset(i + 1)).
+			int point_offset(int element) const;
+			const std::vector<CartesianPoint3D> & points() const;
+			const std::vector<double> & weights() const;
+
+			// Integral of integrand over every element, where integrand is 
+			// callable as double(const CartesianPoint3D &) and must be safe
+			// to call concurrently.
+			template<typename TFunc>
+			double integrate(TFunc && integrand, int num_threads = 0) const;
+			// Integral over each element: element_integrals[i] is for element_tags()[i].
+			template<typename TFunc>
+			void integrate_elements(TFunc && integrand, std::vector<double> & element_integrals, 
+				int num_threads = 0) const;
+
+		private:
+			std::vector<int> m_element_tags;
+			std::vector<int> m_point_offsets;
+			std::vector<CartesianPoint3D> m_points;
+			std::vector<double> m_weights;
+		};
+
+
+
+
+		// DEFINITIONS
+
+		template<typename TFunc>
+		double GmshIntegrator::integrate(TFunc && integrand, int num_threads) const
+		{
+			std::vector<double> element_integrals;
+			integrate_elements(integrand, element_integrals, num_threads);
+			double sum = 0;
+			for (double value : element_integrals) { sum += value; }
+			return sum;
+		}
+
+		template<typename TFunc>
+		void GmshIntegrator::integrate_elements(TFunc && integrand, 
+			std::vector<double>& element_integrals, int num_threads) const
+		{
+			element_integrals.resize(m_element_tags.size());
+			parallel_for(0, number_of_elements(), [&](int ele) {
+				double sum = 0;
+				for (int q = m_point_offsets[ele]; q < m_point_offsets[ele + 1]; q++) {
+					sum += m_weights[q] * integrand(m_points[q]);
+				}
+				element_integrals[ele] = sum;
+			}, num_threads);
+			return;
+		}
+	}
+}
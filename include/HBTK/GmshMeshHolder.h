@@ -29,9 +29,11 @@ SOFTWARE.
 #include <unordered_set>
 #include <vector>
 
+#include "CartesianArray3D.h"
 #include "CartesianPoint.h"
 #include "GmshParser.h"
 #include "GmshWriter.h"
+#include "MeshTopology.h"
 
 namespace HBTK {
 	namespace Gmsh {
@@ -46,6 +48,7 @@ namespace HBTK {
 			bool node_tag_exists(int node_tag);
 			void add_node(int node_tag, CartesianPoint3D coordinate);
 			void remove_node(int node_tag);
+			PointArray3D node_coordinates(const std::vector<int> & node_tags);
 
 			int number_of_elements();
 			std::vector<int> get_all_element_tags();
@@ -75,6 +78,21 @@ namespace HBTK {
 			std::vector<int> check_element_correct_node_count();
 			std::vector<int> check_element_nodes_exist();
 
+			int merge_coincident_nodes(double tolerance = 0);
+			std::vector<int> nearest_node_tags(const std::vector<CartesianPoint3D> & points);
+
+			// Sorted node and element tags, and the element nodes as indices into
+			// node_tags, CSR style as used by MeshReordering.h.
+			void dense_connectivity(std::vector<int> & node_tags, std::vector<int> & element_tags,
+				std::vector<int> & element_offsets, std::vector<int> & element_nodes);
+			// Change node or element tags. new_tags maps every old tag to its new tag.
+			void renumber_nodes(const std::unordered_map<int, int> & new_tags);
+			void renumber_elements(const std::unordered_map<int, int> & new_tags);
+			// Node to element and element to element connectivity. Indices refer 
+			// to node_tags and element_tags, as from dense_connectivity.
+			MeshTopology topology(std::vector<int> & node_tags, std::vector<int> & element_tags,
+				int num_threads = 0);
+
 			GmshParser get_parser();
 			GmshWriter get_writer();
 
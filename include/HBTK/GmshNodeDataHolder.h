@@ -33,6 +33,10 @@ namespace HBTK {
 	namespace Gmsh {
 		class GmshMeshHolder;
 
+		// One dataset at one time step, as in a $NodeData section. Values are 
+		// stored contiguously, indexed densely by node tag, so a dataset costs 
+		// number_of_node_data_points() * components() doubles plus an int per
+		// tag rather than a heap allocation per node.
 		class GmshNodeDataHolder {
 		public:
 			GmshNodeDataHolder();
@@ -47,12 +51,29 @@ namespace HBTK {
 			double & time();
 			const double & time() const;
 
-			int number_of_node_data_points();
-			bool node_data_exists(int node_tag);
-			std::vector<double> & node_data(int node_tag);
+			int number_of_node_data_points() const;
+			bool node_data_exists(int node_tag) const;
+			// The components() values of node_tag.
+			double * node_data(int node_tag);
+			const double * node_data(int node_tag) const;
 			void add_node_data(int node_tag, std::vector<double> node_data);
+			void add_node_data(int node_tag, const double * node_data);
 			void remove_node_data(int node_tag);
 
+			// Node tags in the order they were added, and their values, 
+			// components() per tag, in the same order.
+			const std::vector<int> & node_tags() const;
+			const std::vector<double> & values() const;
+
+			// Change tags, for example after GmshMeshHolder::renumber_nodes. 
+			// new_tags maps every old tag to its new tag.
+			void renumber_node_tags(const std::unordered_map<int, int> & new_tags);
+
+			// Remove all node data, keeping the storage for reuse.
+			void clear();
+			// Allocate for count nodes with tags up to max_tag.
+			void reserve(int max_tag, int count);
+
 			std::vector<int> check_correct_node_data_length();
 			std::vector<int> check_consistant(GmshMeshHolder & mesh);
 
@@ -61,19 +82,32 @@ namespace HBTK {
 				vector,
 				tensor2
 			};
+			// Set before adding data.
 			data_type & node_data_type();
+			const data_type & node_data_type() const;
+			// Values per node: 1, 3 or 9.
+			int components() const;
+			// The data type with n components. Throws std::domain_error if
+			// there isn't one.
+			static data_type data_type_with_components(int n);
 			
 		private:
 			std::string m_node_data_name;
 			double m_time;
 			int m_time_step;
 			data_type m_node_data_type;
-			std::unordered_map<int, std::vector<double>> m_node_data;
+			// Slot of each node tag, or -1.
+			std::vector<int> m_slots;
+			// Node tag of each slot.
+			std::vector<int> m_tags;
+			// Values of slot i are m_values[i * components(), (i + 1) * components()).
+			std::vector<double> m_values;
 
+			int slot(int node_tag) const;
 			// Expected number of values per node due according to node data type.
-			int data_len();
+			int data_len() const;
 			// A string of node data type.
-			std::string data_type_str();
+			std::string data_type_str() const;
 		};
 	}
 }
\ No newline at end of file
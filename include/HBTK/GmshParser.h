@@ -31,6 +31,8 @@ SOFTWARE.
 #include <fstream>
 
 #include "BasicParser.h"
+#include "GmshElementDataHolder.h"
+#include "GmshNodeDataHolder.h"
 
 namespace HBTK {
 	namespace Gmsh {
@@ -54,14 +56,21 @@ namespace HBTK {
 			// Add a function to execute for elements on parsing.
 			// [tag, type, phys_group_tags, node_tags]
 			void add_elem_function(std::function<bool(int, int, std::vector<int>, std::vector<int>)> func);
+			// Add a function to execute for each $NodeData / $ElementData section (one 
+			// dataset at one time step). The holder is reused for the next section, 
+			// so copy out anything that is needed later.
+			void add_node_data_function(std::function<bool(const GmshNodeDataHolder &)> func);
+			void add_element_data_function(std::function<bool(const GmshElementDataHolder &)> func);
 
 			// To set the parser going, one of the following may be used (inherited from BasicParser):
-			// void parse(fs::path file_path);
-			// void parse(std::ifstream & input_stream);
-			// void parse(std::ifstream & input_stream, std::ofstream & error_stream);	
-			// Where file_path is the path to the .msh file, or ifstream is the file
-			// stream already opened. The error output stream can be set using ofstream,
-			// by using the ifstream, ofstream overload. Otherwise stderr will be used.
+			// void parse(std::string file_path);
+			// void parse(ByteSource source);
+			// void parse(std::istream & input_stream);
+			// void parse(std::istream & input_stream, std::ostream & error_stream);	
+			// Where file_path is the path to the .msh file, source is a file, buffer
+			// in memory or stream (see ByteSource.h), or input_stream is a stream already
+			// opened in binary mode. The error output stream can be set using the 
+			// istream, ostream overload. Otherwise stderr will be used.
 
 
 		private:
@@ -69,7 +78,7 @@ namespace HBTK {
 			// Generally, looking at http://gmsh.info/doc/texinfo/gmsh.html is useful!
 
 			// Call main parser
-			void main_parser(std::ifstream & input_stream, std::ostream & error_stream);
+			void main_parser(std::istream & input_stream, std::ostream & error_stream);
 
 			enum file_section {
 				no_section,
@@ -77,6 +86,8 @@ namespace HBTK {
 				nodes,
 				elements,
 				physical_names,
+				node_data,
+				element_data,
 				unsupported,
 				invalid
 			};
@@ -102,21 +113,35 @@ namespace HBTK {
 			std::vector<std::function<bool(int, int, std::string)>> phys_name_funcs;
 			std::vector<std::function<bool(int, double, double, double)>> node_funcs;
 			std::vector<std::function<bool(int, int, std::vector<int>, std::vector<int>)>> elem_funcs;
+			std::vector<std::function<bool(const GmshNodeDataHolder &)>> node_data_funcs;
+			std::vector<std::function<bool(const GmshElementDataHolder &)>> element_data_funcs;
+
+			// Reused between $NodeData / $ElementData sections.
+			GmshNodeDataHolder m_node_data;
+			GmshElementDataHolder m_element_data;
+			std::vector<char> m_data_buffer;
 
 			// Parse a line starting with "$".
 			file_section parse_file_section(std::string, file_section);
 			// Pares a line in the nodes section.
 			void parse_node_line(std::string line);
-			void parse_node_line_binary(std::ifstream & input_stream, struct binary_parse_info & b_info);
+			void parse_node_line_binary(std::istream & input_stream, struct binary_parse_info & b_info);
 			// Parse a line in the elements section.
 			void parse_elem_line(std::string);
-			void parse_elem_binary_spec(std::ifstream & input_stream, struct binary_parse_info & b_info);
-			void parse_elem_binary(std::ifstream & input_stream, struct binary_parse_info & b_info);
+			void parse_elem_binary_spec(std::istream & input_stream, struct binary_parse_info & b_info);
+			void parse_elem_binary(std::istream & input_stream, struct binary_parse_info & b_info);
 			// Parse a line in physical names section.
 			void parse_phys_name_line(std::string);
+			// Parse a whole $NodeData or $ElementData section, up to and including
+			// its $End line.
+			void parse_data_section(std::istream & input_stream, file_section section,
+				const file_format_info & f_info, int & line_count);
+			template<typename Holder>
+			void parse_data_values(std::istream & input_stream, Holder & holder, int count,
+				bool binary, int & line_count);
 			// Parse the file format information section
 			void parse_file_info(std::string this_line, binary_parse_info & b_info, file_format_info & f_info);
-			void parse_file_binary_endian(std::ifstream & input_stream, struct binary_parse_info & b_info,
+			void parse_file_binary_endian(std::istream & input_stream, struct binary_parse_info & b_info,
 				file_format_info & f_info);
 
 			// Get number of nodes for element type.
@@ -29,12 +29,21 @@ SOFTWARE.
 #include <vector>
 #include <map>
 #include <memory>
+#include <ostream>
+
+#include "GmshElementDataHolder.h"
+#include "GmshNodeDataHolder.h"
 
 namespace HBTK {
 	namespace Gmsh {
+		// Nodes and elements are stored densely in arrays rather than per object,
+		// and are cheapest to add in increasing tag order. For meshes too large to 
+		// hold at all, begin() puts the writer in streaming mode, where nodes and 
+		// elements are written to the stream as they are added.
 		class GmshWriter
 		{
 		public:
+			GmshWriter();
 
 			// Add a physical group.
 			// Returns -1 for physical group id already exists
@@ -51,16 +60,46 @@ namespace HBTK {
 			int add_element(int ele_type, const std::vector<int> & node_ids);
 			// Second overload: make part of physical groups given in vector phys_grps.
 			int add_element(int ele_type, const std::vector<int> & node_ids, const std::vector<int> & phys_groups);
+			// Third overload: node_count = element_node_count(ele_type) nodes from 
+			// node_ids and n_groups physical groups from phys_groups.
+			int add_element(int ele_type, const int * node_ids, int n_groups, const int * phys_groups);
+
+			// Reserve storage for a mesh of this size.
+			void reserve(int nodes, int elements, int element_nodes);
+
+			// Write binary rather than ASCII .msh. False by default.
+			bool & binary();
+			const bool & binary() const;
 
-			// Write out file to path:
+			// Write out file to path, gzip compressed if path ends in ".gz":
 			bool write(std::string path);
-			bool write(std::ofstream & output_stream);
+			bool write(std::ostream & output_stream);
+
+			// Streaming mode. begin() writes the header and the physical groups 
+			// added so far to output_stream, which must outlive end(). Then, as the
+			// format requires counts up front, begin_nodes(count) is followed by 
+			// count add_node calls and begin_elements(count) by count add_element 
+			// calls, each written immediately. end() closes the last section and
+			// returns false if any section got the wrong count or the stream failed.
+			bool begin(std::ostream & output_stream);
+			bool begin_nodes(int count);
+			bool begin_elements(int count);
+			bool end();
+
+			// Append a $NodeData / $ElementData section (one dataset at one time step)
+			// to a stream that write() has already written the mesh to. Call once per
+			// time step, so only one needs to be held in memory. binary must match 
+			// the format of the mesh.
+			static bool write_node_data(std::ostream & output_stream, 
+				const GmshNodeDataHolder & data, bool binary = false);
+			static bool write_element_data(std::ostream & output_stream,
+				const GmshElementDataHolder & data, bool binary = false);
 
 		private:
-			struct element {
-				int element_type;
-				std::vector<int> nodes;
-				std::vector<int> phys_groups;
+			enum section {
+				no_section,
+				nodes,
+				elements
 			};
 
 			struct physical_group {
@@ -68,13 +107,41 @@ namespace HBTK {
 				std::string name;
 			};
 
-			struct node_coordinate {
-				double x, y, z;
-			};
-
-			std::map<int, element> m_elements;
+			bool m_binary;
 			std::map<int, physical_group> m_physical_groups;
-			std::map<int, node_coordinate> m_nodes;
+
+			// Node tags, kept sorted, and x, y, z of each.
+			std::vector<int> m_node_tags;
+			std::vector<double> m_node_coords;
+
+			// Elements i has type m_element_types[i] and the ints 
+			// m_element_ints[m_element_offsets[i], m_element_offsets[i + 1]):
+			// the number of physical groups, the groups, then the nodes.
+			std::vector<int> m_element_types;
+			std::vector<size_t> m_element_offsets;
+			std::vector<int> m_element_ints;
+			int m_element_count;
+
+			// Streaming mode state. m_stream is null otherwise.
+			std::ostream * m_stream;
+			section m_section;
+			int m_section_remaining;
+			bool m_stream_ok;
+
+			// Output buffer for binary blocks, and the binary element block 
+			// in it: type, number of tags and number of elements.
+			std::vector<char> m_buffer;
+			int m_block_type, m_block_tags, m_block_count;
+			size_t m_block_start;
+
+			void write_header(std::ostream & output_stream);
+			void write_physical_groups(std::ostream & output_stream);
+			void write_node(std::ostream & output_stream, int id, const double * coords);
+			void write_element(std::ostream & output_stream, int id, int ele_type,
+				int n_groups, const int * phys_groups, int node_count, const int * node_ids);
+			void close_element_block();
+			void flush_buffer(std::ostream & output_stream);
+			void end_section(std::ostream & output_stream);
 		};
 	}
 } // END namespace HBTK
@@ -0,0 +1,105 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+Gzip.h
+
+Reading and writing gzip compressed data.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "ByteSource.h"
+
+namespace HBTK {
+	// gzip (RFC 1952 / DEFLATE, RFC 1951) without external dependencies.
+	//
+	// Compressed output is written as BGZF: a series of independent gzip 
+	// members each holding at most 64 KiB of input and recording its own 
+	// compressed size. Any gzip tool can read it, and HBTK can compress and
+	// decompress the members in parallel. Other gzip files are decompressed
+	// serially.
+
+	// True if data starts with the gzip magic number.
+	bool is_gzip(const char * data, size_t size);
+
+	// Decompress all of data, a gzip file of one or more members. Uses 
+	// num_threads (or default_thread_count() if <= 0) for BGZF files.
+	// Throws std::invalid_argument for corrupt or truncated data.
+	std::string gzip_decompress(const char * data, size_t size, int num_threads = 0);
+
+	// Compress data to BGZF using num_threads threads (or 
+	// default_thread_count() if <= 0).
+	std::string gzip_compress(const char * data, size_t size, int num_threads = 0);
+
+	// Append the decompressed zlib (RFC 1950) stream in data to out, as used 
+	// for compressed arrays in VTK XML files. Throws std::invalid_argument 
+	// for corrupt or truncated data.
+	void zlib_decompress(const char * data, size_t size, std::string & out);
+
+	// Compress data, at most 65280 bytes, to a single zlib stream.
+	std::string zlib_compress(const char * data, size_t size);
+
+	// True if path ends in ".gz".
+	bool has_gzip_extension(const std::string & path);
+
+	// source, decompressed in full if it is gzip, otherwise unchanged.
+	// Non-contiguous sources are read into memory first.
+	ByteSource decompressed(ByteSource source, int num_threads = 0);
+
+	// Decompresses source as it is read, one DEFLATE block at a time, so 
+	// the decompressed data is never all in memory. Not seekable.
+	class GzipInputStream
+		: public std::istream
+	{
+	public:
+		GzipInputStream(ByteSource source);
+		~GzipInputStream();
+
+	private:
+		class Buffer;
+		std::unique_ptr<Buffer> m_buffer;
+	};
+
+	// Compresses everything written to it as BGZF onto destination, which
+	// must outlive it. Blocks are compressed num_threads at a time. Call 
+	// finish() (or destroy the stream) to write the remaining data and the
+	// end of file marker.
+	class GzipOutputStream
+		: public std::ostream
+	{
+	public:
+		GzipOutputStream(std::ostream & destination, int num_threads = 0);
+		~GzipOutputStream();
+
+		void finish();
+
+	private:
+		class Buffer;
+		std::unique_ptr<Buffer> m_buffer;
+	};
+}
@@ -0,0 +1,87 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+KdTree3D.h
+
+A static k-d tree over a set of points in 3D for nearest neighbour and
+radius searches.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "CartesianPoint.h"
+
+namespace HBTK {
+	// An implicit, balanced k-d tree. The points are copied into tree order
+	// (coordinate arrays, not an array of points) and the tree is described 
+	// by index ranges alone - the node for range [b, e) is the point at 
+	// (b + e) / 2 - so there are no pointers to chase.
+	// Results refer to the indices of the points given to build().
+	class KdTree3D {
+	public:
+		KdTree3D();
+		KdTree3D(const std::vector<CartesianPoint3D> & points, int num_threads = 0);
+
+		// Build the tree. The upper levels are built concurrently using up to
+		// num_threads threads (default_thread_count() if num_threads <= 0).
+		void build(const std::vector<CartesianPoint3D> & points, int num_threads = 0);
+		int size() const;
+
+		// Index of the point nearest point, or -1 if the tree is empty.
+		int nearest(const CartesianPoint3D & point, double & distance) const;
+		// The k nearest points, nearest first. Fewer if size() < k.
+		void k_nearest(const CartesianPoint3D & point, int k,
+			std::vector<int> & indices, std::vector<double> & distances) const;
+		// Indices (ascending) of all points within radius of point.
+		std::vector<int> within_radius(const CartesianPoint3D & point, double radius) const;
+
+		// Batched queries, evaluated in parallel. For k_nearest, the results
+		// for query i are at [i * k, (i + 1) * k), padded with index -1 and 
+		// infinite distance if size() < k.
+		void nearest(const std::vector<CartesianPoint3D> & points, std::vector<int> & indices,
+			std::vector<double> & distances, int num_threads = 0) const;
+		void k_nearest(const std::vector<CartesianPoint3D> & points, int k, std::vector<int> & indices,
+			std::vector<double> & distances, int num_threads = 0) const;
+		std::vector<std::vector<int>> within_radius(const std::vector<CartesianPoint3D> & points,
+			double radius, int num_threads = 0) const;
+
+	private:
+		// Coordinates in tree order.
+		std::vector<double> m_x, m_y, m_z;
+		// Original index of each point in tree order.
+		std::vector<int> m_index;
+		// Split dimension of the node at each position (unused for leaves).
+		std::vector<unsigned char> m_split;
+
+		// Ranges this small are searched linearly.
+		static constexpr int leaf_size = 8;
+
+		struct query_state;
+		void build_range(int begin, int end, int depth, int parallel_depth,
+			const std::vector<CartesianPoint3D> & points);
+		void search_range(int begin, int end, query_state & state) const;
+		void nearest_range(int begin, int end, double px, double py, double pz,
+			double & best_sq, int & best) const;
+		void radius_range(int begin, int end, double px, double py, double pz,
+			double radius_sq, std::vector<int> & found) const;
+	};
+}
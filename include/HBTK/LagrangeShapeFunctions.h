@@ -0,0 +1,378 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+LagrangeShapeFunctions.h
+
+Lagrange shape functions generated at compile time from the node tables
+of ElementNodes.h.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <utility>
+
+#include "ElementNodes.h"
+
+namespace HBTK {
+	namespace Elements {
+		// The polynomial space spanned by an element's shape functions, as 
+		// the set of monomials x^a y^b z^c that it contains.
+		enum class PolynomialSpace {
+			complete,					// a + b + c <= order
+			tensor,						// a, b, c <= order
+			incomplete_triangle,		// complete, but only the monomials on the edges of the Pascal triangle
+			serendipity_quadrangle,		// complete, plus x^order y and x y^order
+			serendipity_hexahedron,		// tensor, with at most one of a, b, c equal to order
+			prism,						// complete in x, y times tensor in z
+			serendipity_prism			// prism, without z^order x^a y^b where a + b = order
+		};
+
+		namespace LagrangeBasis {
+			template<int N>
+			struct Exponents { int e[N][3]; };
+
+			template<int N>
+			struct Matrix { double a[N][N]; };
+
+			constexpr bool in_space(PolynomialSpace space, int order, int a, int b, int c)
+			{
+				switch (space) {
+				case PolynomialSpace::complete:
+					return a + b + c <= order;
+				case PolynomialSpace::tensor:
+					return a <= order && b <= order && c <= order;
+				case PolynomialSpace::incomplete_triangle:
+					return a + b <= order && (a == 0 || b == 0 || a + b == order);
+				case PolynomialSpace::serendipity_quadrangle:
+					return a + b <= order || (a == order && b == 1) || (a == 1 && b == order);
+				case PolynomialSpace::serendipity_hexahedron:
+					return a <= order && b <= order && c <= order
+						&& (a == order) + (b == order) + (c == order) <= 1;
+				case PolynomialSpace::prism:
+					return a + b <= order && c <= order;
+				case PolynomialSpace::serendipity_prism:
+					return (a + b <= order && c < order) || (a + b < order && c == order);
+				}
+				return false;
+			}
+
+			// Number of monomials in the space. Must equal the number of nodes.
+			constexpr int space_size(PolynomialSpace space, int dims, int order)
+			{
+				int count = 0;
+				for (int c = 0; c <= (dims > 2 ? order : 0); c++) {
+					for (int b = 0; b <= (dims > 1 ? order : 0); b++) {
+						for (int a = 0; a <= order; a++) {
+							if (in_space(space, order, a, b, c)) { count++; }
+						}
+					}
+				}
+				return count;
+			}
+
+			template<int N>
+			constexpr Exponents<N> exponents(PolynomialSpace space, int dims, int order)
+			{
+				Exponents<N> res{};
+				int k = 0;
+				for (int c = 0; c <= (dims > 2 ? order : 0); c++) {
+					for (int b = 0; b <= (dims > 1 ? order : 0); b++) {
+						for (int a = 0; a <= order; a++) {
+							if (in_space(space, order, a, b, c) && k < N) {
+								res.e[k][0] = a;
+								res.e[k][1] = b;
+								res.e[k][2] = c;
+								k++;
+							}
+						}
+					}
+				}
+				return res;
+			}
+
+			constexpr double power(double x, int n)
+			{
+				double res = 1;
+				for (int i = 0; i < n; i++) { res *= x; }
+				return res;
+			}
+
+			// Value of monomial with exponents e at x, or its derivative with 
+			// respect to x[deriv] if deriv >= 0.
+			constexpr double monomial(const int(&e)[3], const double * x, int dims, int deriv)
+			{
+				double res = 1;
+				for (int d = 0; d < dims; d++) {
+					if (d == deriv) {
+						res *= (e[d] == 0 ? 0. : e[d] * power(x[d], e[d] - 1));
+					}
+					else {
+						res *= power(x[d], e[d]);
+					}
+				}
+				return res;
+			}
+
+			// Coefficients A of the shape functions N_i = sum_j A[i][j] m_j such 
+			// that N_i(node_k) = delta_ik. A is the inverse transpose of the 
+			// Vandermonde matrix V[k][j] = m_j(node_k), found by Gauss-Jordan
+			// elimination with partial pivoting.
+			template<int N, typename TNodes>
+			constexpr Matrix<N> coefficients(const TNodes & nodes, const Exponents<N> & exps, int dims)
+			{
+				double aug[N][2 * N] = {};
+				for (int k = 0; k < N; k++) {
+					double x[3] = { 0, 0, 0 };
+					for (int d = 0; d < dims; d++) { x[d] = nodes[k][d]; }
+					for (int j = 0; j < N; j++) { aug[k][j] = monomial(exps.e[j], x, dims, -1); }
+					aug[k][N + k] = 1;
+				}
+				for (int col = 0; col < N; col++) {
+					int pivot = col;
+					for (int row = col + 1; row < N; row++) {
+						double a = aug[row][col], b = aug[pivot][col];
+						if ((a < 0 ? -a : a) > (b < 0 ? -b : b)) { pivot = row; }
+					}
+					for (int j = 0; j < 2 * N; j++) {
+						double tmp = aug[col][j];
+						aug[col][j] = aug[pivot][j];
+						aug[pivot][j] = tmp;
+					}
+					double diag = aug[col][col];
+					for (int j = 0; j < 2 * N; j++) { aug[col][j] /= diag; }
+					for (int row = 0; row < N; row++) {
+						if (row == col) { continue; }
+						double factor = aug[row][col];
+						for (int j = 0; j < 2 * N; j++) { aug[row][j] -= factor * aug[col][j]; }
+					}
+				}
+				Matrix<N> res{};
+				for (int i = 0; i < N; i++) {
+					for (int j = 0; j < N; j++) { res.a[i][j] = aug[j][N + i]; }
+				}
+				return res;
+			}
+		}
+
+		// Shape functions (and their first derivatives) for TElement of 
+		// ElementNodes.h, spanning the polynomial space given by Space and 
+		// Order. The coefficients are computed at compile time from the node
+		// table, and evaluation loops have compile time bounds, so they can be 
+		// unrolled. Interface as for the hand written shape functions of 
+		// ElementShapeFunctions.h, with one coordinate argument per dimension.
+		template<typename TElement, PolynomialSpace Space, int Order>
+		class LagrangeShapeFunctions {
+		public:
+			static constexpr int number_of_nodes = (int)std::tuple_size<decltype(TElement::nodes)>::value;
+			static constexpr int local_dimensions = TElement::local_number_of_dimensions;
+			static constexpr int order = Order;
+
+			template<typename... TCoords>
+			static constexpr std::array<double, number_of_nodes> shape_function(TCoords... local);
+			template<typename... TCoords>
+			static constexpr std::array<double, number_of_nodes> shape_function_d0(TCoords... local);
+			template<typename... TCoords>
+			static constexpr std::array<double, number_of_nodes> shape_function_d1(TCoords... local);
+			template<typename... TCoords>
+			static constexpr std::array<double, number_of_nodes> shape_function_d2(TCoords... local);
+
+			// As ElementShape::evaluate.
+			static void evaluate(const double * local, double * values, double * derivatives);
+
+		private:
+			static_assert(LagrangeBasis::space_size(Space, local_dimensions, Order) == number_of_nodes,
+				"The polynomial space must have as many monomials as the element has nodes.");
+
+			static constexpr LagrangeBasis::Exponents<number_of_nodes> exponents =
+				LagrangeBasis::exponents<number_of_nodes>(Space, local_dimensions, Order);
+			static constexpr LagrangeBasis::Matrix<number_of_nodes> coefficients =
+				LagrangeBasis::coefficients<number_of_nodes>(TElement::nodes, exponents, local_dimensions);
+
+			static constexpr std::array<double, number_of_nodes> evaluate_at(const double * x, int deriv);
+			template<std::size_t... Is>
+			static constexpr std::array<double, number_of_nodes> to_array(const double * values, 
+				std::index_sequence<Is...>);
+		};
+
+		// Lagrange shape functions for the elements of ElementNodes.h that
+		// ElementShapeFunctions.h does not cover. Pyramids are omitted since 
+		// their shape functions are not polynomials.
+		using CubicShapeFunctions = LagrangeShapeFunctions<Line4, PolynomialSpace::complete, 3>;
+		using QuarticShapeFunctions = LagrangeShapeFunctions<Line5, PolynomialSpace::complete, 4>;
+		using QuinticShapeFunctions = LagrangeShapeFunctions<Line6, PolynomialSpace::complete, 5>;
+
+		using IncompleteCubicTriangle9ShapeFunctions = 
+			LagrangeShapeFunctions<Triangle9, PolynomialSpace::incomplete_triangle, 3>;
+		using CubicTriangle10ShapeFunctions = 
+			LagrangeShapeFunctions<Triangle10, PolynomialSpace::complete, 3>;
+		using IncompleteQuarticTriangle12ShapeFunctions = 
+			LagrangeShapeFunctions<Triangle12, PolynomialSpace::incomplete_triangle, 4>;
+		using QuarticTriangle15ShapeFunctions = 
+			LagrangeShapeFunctions<Triangle15O4, PolynomialSpace::complete, 4>;
+		using IncompleteQuinticTriangle15ShapeFunctions = 
+			LagrangeShapeFunctions<Triangle15O5, PolynomialSpace::incomplete_triangle, 5>;
+		using QuinticTriangle21ShapeFunctions = 
+			LagrangeShapeFunctions<Triangle21, PolynomialSpace::complete, 5>;
+
+		using BiquadraticQuad9ShapeFunctions = 
+			LagrangeShapeFunctions<Quadrangle9, PolynomialSpace::tensor, 2>;
+		using SerendipityQuad12ShapeFunctions = 
+			LagrangeShapeFunctions<Quadrangle12, PolynomialSpace::serendipity_quadrangle, 3>;
+		using BicubicQuad16ShapeFunctions = 
+			LagrangeShapeFunctions<Quadrangle16, PolynomialSpace::tensor, 3>;
+
+		using CubicTetrahedron20ShapeFunctions = 
+			LagrangeShapeFunctions<Tetrahedron20, PolynomialSpace::complete, 3>;
+
+		using SerendipityHexahedron20ShapeFunctions = 
+			LagrangeShapeFunctions<Hexahedron20, PolynomialSpace::serendipity_hexahedron, 2>;
+		using TriquadraticHexahedron27ShapeFunctions = 
+			LagrangeShapeFunctions<Hexahedron27, PolynomialSpace::tensor, 2>;
+
+		using LinearPrism6ShapeFunctions = 
+			LagrangeShapeFunctions<Prism6, PolynomialSpace::prism, 1>;
+		using SerendipityPrism15ShapeFunctions = 
+			LagrangeShapeFunctions<Prism15, PolynomialSpace::serendipity_prism, 2>;
+		using QuadraticPrism18ShapeFunctions = 
+			LagrangeShapeFunctions<Prism18, PolynomialSpace::prism, 2>;
+
+
+
+
+		// DEFINITIONS
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		constexpr LagrangeBasis::Exponents<LagrangeShapeFunctions<TElement, Space, Order>::number_of_nodes>
+			LagrangeShapeFunctions<TElement, Space, Order>::exponents;
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		constexpr LagrangeBasis::Matrix<LagrangeShapeFunctions<TElement, Space, Order>::number_of_nodes>
+			LagrangeShapeFunctions<TElement, Space, Order>::coefficients;
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		template<std::size_t... Is>
+		inline constexpr std::array<double, LagrangeShapeFunctions<TElement, Space, Order>::number_of_nodes>
+			LagrangeShapeFunctions<TElement, Space, Order>::to_array(const double * values, 
+				std::index_sequence<Is...>)
+		{
+			return std::array<double, number_of_nodes>({ { values[Is]... } });
+		}
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		inline constexpr std::array<double, LagrangeShapeFunctions<TElement, Space, Order>::number_of_nodes>
+			LagrangeShapeFunctions<TElement, Space, Order>::evaluate_at(const double * x, int deriv)
+		{
+			double monomials[number_of_nodes] = {};
+			for (int j = 0; j < number_of_nodes; j++) {
+				monomials[j] = LagrangeBasis::monomial(exponents.e[j], x, local_dimensions, deriv);
+			}
+			double values[number_of_nodes] = {};
+			for (int i = 0; i < number_of_nodes; i++) {
+				for (int j = 0; j < number_of_nodes; j++) {
+					values[i] += coefficients.a[i][j] * monomials[j];
+				}
+			}
+			return to_array(values, std::make_index_sequence<number_of_nodes>());
+		}
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		template<typename... TCoords>
+		inline constexpr std::array<double, LagrangeShapeFunctions<TElement, Space, Order>::number_of_nodes>
+			LagrangeShapeFunctions<TElement, Space, Order>::shape_function(TCoords... local)
+		{
+			static_assert(sizeof...(TCoords) == local_dimensions, "One coordinate per local dimension.");
+			const double x[] = { (double)local... };
+			return evaluate_at(x, -1);
+		}
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		template<typename... TCoords>
+		inline constexpr std::array<double, LagrangeShapeFunctions<TElement, Space, Order>::number_of_nodes>
+			LagrangeShapeFunctions<TElement, Space, Order>::shape_function_d0(TCoords... local)
+		{
+			static_assert(sizeof...(TCoords) == local_dimensions, "One coordinate per local dimension.");
+			const double x[] = { (double)local... };
+			return evaluate_at(x, 0);
+		}
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		template<typename... TCoords>
+		inline constexpr std::array<double, LagrangeShapeFunctions<TElement, Space, Order>::number_of_nodes>
+			LagrangeShapeFunctions<TElement, Space, Order>::shape_function_d1(TCoords... local)
+		{
+			static_assert(sizeof...(TCoords) == local_dimensions && local_dimensions > 1, 
+				"One coordinate per local dimension.");
+			const double x[] = { (double)local... };
+			return evaluate_at(x, 1);
+		}
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		template<typename... TCoords>
+		inline constexpr std::array<double, LagrangeShapeFunctions<TElement, Space, Order>::number_of_nodes>
+			LagrangeShapeFunctions<TElement, Space, Order>::shape_function_d2(TCoords... local)
+		{
+			static_assert(sizeof...(TCoords) == local_dimensions && local_dimensions > 2, 
+				"One coordinate per local dimension.");
+			const double x[] = { (double)local... };
+			return evaluate_at(x, 2);
+		}
+
+		template<typename TElement, PolynomialSpace Space, int Order>
+		inline void LagrangeShapeFunctions<TElement, Space, Order>::evaluate(
+			const double * local, double * values, double * derivatives)
+		{
+			// Powers of each coordinate, shared by all the monomials.
+			double powers[3][Order + 1];
+			for (int d = 0; d < local_dimensions; d++) {
+				powers[d][0] = 1;
+				for (int p = 1; p <= Order; p++) { powers[d][p] = powers[d][p - 1] * local[d]; }
+			}
+			double monomials[number_of_nodes];
+			for (int j = 0; j < number_of_nodes; j++) {
+				double m = 1;
+				for (int d = 0; d < local_dimensions; d++) { m *= powers[d][exponents.e[j][d]]; }
+				monomials[j] = m;
+			}
+			for (int i = 0; i < number_of_nodes; i++) {
+				double v = 0;
+				for (int j = 0; j < number_of_nodes; j++) { v += coefficients.a[i][j] * monomials[j]; }
+				values[i] = v;
+			}
+			if (!derivatives) { return; }
+			for (int dd = 0; dd < local_dimensions; dd++) {
+				for (int j = 0; j < number_of_nodes; j++) {
+					int e = exponents.e[j][dd];
+					double m = (e == 0 ? 0. : e * powers[dd][e - 1]);
+					for (int d = 0; d < local_dimensions; d++) {
+						if (d != dd) { m *= powers[d][exponents.e[j][d]]; }
+					}
+					monomials[j] = m;
+				}
+				for (int i = 0; i < number_of_nodes; i++) {
+					double v = 0;
+					for (int j = 0; j < number_of_nodes; j++) { v += coefficients.a[i][j] * monomials[j]; }
+					derivatives[dd * number_of_nodes + i] = v;
+				}
+			}
+			return;
+		}
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+MeshReordering.h
+
+Renumbering mesh nodes and elements to improve memory locality.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "CartesianPoint.h"
+
+namespace HBTK {
+	// Connectivity is given CSR style: element i has the nodes 
+	// element_nodes[element_offsets[i], element_offsets[i + 1]), which are
+	// numbered 0 to number_of_nodes - 1. Orderings are returned as the new 
+	// index of each old node or element, so data is reordered with
+	// new_data[new_index[i]] = old_data[i] (see apply_ordering).
+
+	// Reverse Cuthill-McKee node ordering, which reduces the bandwidth of the 
+	// node adjacency so that nodes of each element are numbered close together.
+	// Each connected component starts from a pseudo-peripheral node.
+	std::vector<int> reverse_cuthill_mckee(int number_of_nodes,
+		const std::vector<int> & element_offsets, const std::vector<int> & element_nodes);
+
+	// Order points along a space filling curve through their bounding box. 
+	// Hilbert curves keep consecutive points closer than Morton (Z order) curves,
+	// but Morton keys are cheaper. Works for nodes or element centroids.
+	std::vector<int> hilbert_order(const std::vector<CartesianPoint3D> & points);
+	std::vector<int> morton_order(const std::vector<CartesianPoint3D> & points);
+
+	// Order elements by their lowest numbered node, so an element sweep walks
+	// through the nodes in order. Use after reordering nodes.
+	std::vector<int> element_order_by_nodes(const std::vector<int> & element_offsets,
+		const std::vector<int> & element_nodes);
+
+	// The old index of each new index, or vice versa.
+	std::vector<int> inverse_ordering(const std::vector<int> & new_index);
+
+	// Reorder data with components values per item. 
+	template<typename T>
+	void apply_ordering(std::vector<T> & data, const std::vector<int> & new_index, int components = 1)
+	{
+		assert(data.size() == new_index.size() * components);
+		std::vector<T> reordered(data.size());
+		for (size_t i = 0; i < new_index.size(); i++) {
+			for (int j = 0; j < components; j++) {
+				reordered[(size_t)new_index[i] * components + j] = std::move(data[i * components + j]);
+			}
+		}
+		data.swap(reordered);
+	}
+
+	// Measures of how well ordered a mesh is for an element sweep.
+	struct LocalityReport {
+		// Largest difference between two node numbers of one element.
+		int bandwidth;
+		// Mean of the largest difference between node numbers in an element.
+		double mean_element_span;
+		// Mean difference between the lowest node of consecutive elements.
+		double mean_element_jump;
+	};
+
+	LocalityReport locality_report(const std::vector<int> & element_offsets,
+		const std::vector<int> & element_nodes);
+}
@@ -0,0 +1,101 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+MeshTopology.h
+
+Node to element and element to element connectivity of unstructured meshes.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+namespace HBTK {
+	// Connectivity graphs of an unstructured mesh: the elements using each
+	// node and the elements sharing each face. Faces are the boundary entities
+	// of an element one dimension down (faces of volumes, edges of surfaces, 
+	// ends of lines), given by the corner nodes, which come first in both Gmsh
+	// and VTK node orderings. Element connectivity is given CSR style as in
+	// MeshReordering.h, and all graphs are CSR using the same element indices.
+	class MeshTopology {
+	public:
+		enum element_geometry {
+			point,
+			line,
+			triangle,
+			quadrangle,
+			tetrahedron,
+			hexahedron,
+			prism,
+			pyramid,
+			unknown // No faces.
+		};
+
+		MeshTopology();
+		MeshTopology(int number_of_nodes, const std::vector<element_geometry> & geometries,
+			const std::vector<int> & element_offsets, const std::vector<int> & element_nodes,
+			int num_threads = 0);
+
+		// Faces are matched by hashing their sorted corner nodes, using up to
+		// num_threads threads (default_thread_count() if num_threads <= 0). A face
+		// shared by more than two elements only pairs the first two.
+		void build(int number_of_nodes, const std::vector<element_geometry> & geometries,
+			const std::vector<int> & element_offsets, const std::vector<int> & element_nodes,
+			int num_threads = 0);
+
+		int number_of_nodes() const;
+		int number_of_elements() const;
+		int number_of_faces() const;
+
+		// Elements using node i are 
+		// node_elements()[node_element_offsets()[i], node_element_offsets()[i + 1]), ascending.
+		const std::vector<int> & node_element_offsets() const;
+		const std::vector<int> & node_elements() const;
+
+		// Faces of element i are numbered face_offsets()[i] to face_offsets()[i + 1].
+		// face_neighbours() is the element on the other side of each face, or -1
+		// on the boundary.
+		const std::vector<int> & face_offsets() const;
+		const std::vector<int> & face_neighbours() const;
+		int face_element(int face) const;
+		// Corner nodes of a face, ordered around the face.
+		std::vector<int> face_nodes(int face) const;
+		// Faces with no neighbour.
+		std::vector<int> boundary_faces() const;
+
+		// Elements sharing at least one face with element i are 
+		// element_neighbours()[element_neighbour_offsets()[i], element_neighbour_offsets()[i + 1]).
+		const std::vector<int> & element_neighbour_offsets() const;
+		const std::vector<int> & element_neighbours() const;
+
+		static int number_of_faces(element_geometry geometry);
+		// The element geometry of Gmsh element type / VTK cell type numbers.
+		// unknown if not supported.
+		static element_geometry gmsh_geometry(int gmsh_element_type);
+		static element_geometry vtk_geometry(int vtk_cell_type);
+
+	private:
+		std::vector<element_geometry> m_geometries;
+		std::vector<int> m_element_offsets, m_element_nodes;
+		std::vector<int> m_node_element_offsets, m_node_elements;
+		std::vector<int> m_face_offsets, m_face_neighbours, m_face_elements;
+		std::vector<int> m_neighbour_offsets, m_neighbours;
+	};
+}
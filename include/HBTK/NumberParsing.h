@@ -0,0 +1,58 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+NumberParsing.h
+
+Fast, locale independent parsing of numbers from characters.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <istream>
+
+#include "StringView.h"
+
+namespace HBTK {
+	// Parse a number at the start of [first, last): an optional sign, 
+	// digits with an optional decimal point, and an optional exponent 
+	// (or inf / nan for doubles). Leading whitespace is not skipped. 
+	// Returns a pointer to one past the last character used, or first if 
+	// there is no number (or an integer would overflow). 
+	//
+	// Doubles are correctly rounded. Most are found without division using
+	// the Eisel-Lemire algorithm; the rare remainder (more than 19 significant
+	// digits, or results too close to call) fall back to strtod. Unlike 
+	// std::stod and operator>>, the decimal point is always '.', whatever 
+	// the locale.
+	const char * parse_number(const char * first, const char * last, double & value);
+	const char * parse_number(const char * first, const char * last, long long & value);
+	const char * parse_number(const char * first, const char * last, int & value);
+
+	// The whole of text, ignoring surrounding whitespace, as a number. 
+	// Throws std::invalid_argument if it isn't one.
+	double to_double(StringView text);
+	long long to_integer(StringView text);
+	int to_int(StringView text);
+
+	// Skip whitespace and read one number from stream, as operator>> does.
+	// On failure, sets the stream's failbit and returns false.
+	bool read_number(std::istream & stream, double & value);
+	bool read_number(std::istream & stream, int & value);
+}
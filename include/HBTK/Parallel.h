@@ -0,0 +1,97 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+Parallel.h
+
+Minimal thread helpers for data-parallel loops over index ranges.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace HBTK {
+	// The number of threads used when a function is asked for 
+	// num_threads <= 0. At least 1.
+	inline int default_thread_count()
+	{
+		int n = (int)std::thread::hardware_concurrency();
+		return (n > 0 ? n : 1);
+	}
+
+	// Split [begin, end) into num_blocks contiguous blocks of near equal size
+	// and call func(block_begin, block_end, block_index) for each block, each 
+	// on its own thread (or the calling thread if no more threads can be 
+	// started). The split depends only on the range and num_blocks, 
+	// so a per-block result reduced in block order is deterministic.
+	// The first exception thrown by func is rethrown in the calling thread.
+	template<typename TFunc>
+	void parallel_blocks(int begin, int end, int num_blocks, TFunc && func)
+	{
+		int count = end - begin;
+		if (count <= 0) { return; }
+		num_blocks = std::max(1, std::min(num_blocks, count));
+		if (num_blocks == 1) {
+			func(begin, end, 0);
+			return;
+		}
+		std::vector<std::exception_ptr> errors(num_blocks);
+		std::vector<std::thread> threads;
+		threads.reserve(num_blocks - 1);
+		auto run_block = [&](int block) {
+			int b = begin + (int)((long long)count * block / num_blocks);
+			int e = begin + (int)((long long)count * (block + 1) / num_blocks);
+			try { func(b, e, block); }
+			catch (...) { errors[block] = std::current_exception(); }
+		};
+		int block = 1;
+		try {
+			for (; block < num_blocks; block++) { threads.emplace_back(run_block, block); }
+		}
+		catch (const std::system_error &) {
+			// No more threads: blocks without one run on the calling thread.
+		}
+		run_block(0);
+		for (; block < num_blocks; block++) { run_block(block); }
+		for (auto & thread : threads) { thread.join(); }
+		for (auto & error : errors) {
+			if (error) { std::rethrow_exception(error); }
+		}
+		return;
+	}
+
+	// Call func(i) for every i in [begin, end) using num_threads threads
+	// (default_thread_count() if num_threads <= 0). func must be safe to call
+	// concurrently for different i.
+	template<typename TFunc>
+	void parallel_for(int begin, int end, TFunc && func, int num_threads = 0)
+	{
+		if (num_threads <= 0) { num_threads = default_thread_count(); }
+		parallel_blocks(begin, end, num_threads, 
+			[&](int block_begin, int block_end, int) {
+			for (int i = block_begin; i < block_end; i++) { func(i); }
+		});
+		return;
+	}
+}
@@ -54,12 +54,12 @@ namespace HBTK {
 			friend class HBTK::BasicParser<Plot3DParser>;
 
 			// Main parsing function.
-			void main_parser(std::ifstream & input_stream, std::ostream & error_stream);
-			void parse_2d(std::ifstream & input_stream, std::ostream & error_stream);
-			void parse_3d(std::ifstream & input_stream, std::ostream & error_stream);
+			void main_parser(std::istream & input_stream, std::ostream & error_stream);
+			void parse_2d(std::istream & input_stream, std::ostream & error_stream);
+			void parse_3d(std::istream & input_stream, std::ostream & error_stream);
 
-			void parse_ascii(std::ifstream & input_stream, std::ostream & error_stream, int dimensions);
-			void parse_binary(std::ifstream & input_stream, std::ostream & error_stream, int dimensions);
+			void parse_ascii(std::istream & input_stream, std::ostream & error_stream, int dimensions);
+			void parse_binary(std::istream & input_stream, std::ostream & error_stream, int dimensions);
 
 			// The functions to apply to the mesh blocks once they're parsed.
 			std::vector<std::function<bool(HBTK::StructuredMeshBlock2D)>> m_mesh_2d_functions;
@@ -68,7 +68,7 @@ namespace HBTK {
 			// Applies a function to the input stream, such that the function recieves 
 			// the correct i, j, k (assuming in reads the correct amount from the stream)
 			void apply_function_to_input_array(int i_ext, int j_ext, int k_ext,
-				std::function<void(int, int, int, std::ifstream&)>, std::ifstream&);
+				std::function<void(int, int, int, std::istream &)>, std::istream &);
 		};
 	}
 }
@@ -24,7 +24,8 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
-#include <fstream>
+#include <ostream>
+#include <string>
 
 #include "StructuredMeshBlock2D.h"
 #include "StructuredMeshBlock3D.h"
@@ -44,13 +45,14 @@ namespace HBTK {
 			void add_mesh_block2d(HBTK::StructuredMeshBlock2D mesh);
 			void add_mesh_block3d(HBTK::StructuredMeshBlock3D mesh);
 
-			// Write out file to path:
+			// Write out file to path, gzip compressed if path ends in ".gz":
 			bool write(std::string path);
-			bool write(std::ofstream & output_stream);
+			// output_stream must be seekable (for Fortran record markers).
+			bool write(std::ostream & output_stream);
 
 		private:
-			void write_block_extent(int block, std::ofstream & output_stream);
-			void write_nodes(int block, std::ofstream & output_stream);
+			void write_block_extent(int block, std::ostream & output_stream);
+			void write_nodes(int block, std::ostream & output_stream);
 
 			std::vector<HBTK::StructuredMeshBlock2D> m_meshes_2d;
 			std::vector<HBTK::StructuredMeshBlock3D> m_meshes_3d;
@@ -0,0 +1,80 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+SpatialHash3D.h
+
+A uniform grid spatial hash over a set of points in 3D for fixed radius
+searches, and merging of coincident points.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <unordered_map>
+#include <vector>
+
+#include "CartesianPoint.h"
+
+namespace HBTK {
+	// Points are bucketed into cubic cells of a given size. Radius searches
+	// for radii of about the cell size only look at neighbouring cells, so
+	// this beats a k-d tree when the search radius is known in advance (for
+	// example, a merge tolerance). Results refer to the indices of the 
+	// points given to build().
+	class SpatialHash3D {
+	public:
+		SpatialHash3D();
+		SpatialHash3D(const std::vector<CartesianPoint3D> & points, double cell_size, 
+			int num_threads = 0);
+
+		// cell_size must be greater than zero. Cell keys are computed using up to
+		// num_threads threads (default_thread_count() if num_threads <= 0).
+		void build(const std::vector<CartesianPoint3D> & points, double cell_size, 
+			int num_threads = 0);
+		int size() const;
+		double cell_size() const;
+
+		// Indices (ascending) of all points within radius of point.
+		std::vector<int> within_radius(const CartesianPoint3D & point, double radius) const;
+		// Index of the nearest point within max_radius, or -1.
+		int nearest(const CartesianPoint3D & point, double max_radius, double & distance) const;
+		// Batched radius search, evaluated in parallel.
+		std::vector<std::vector<int>> within_radius(const std::vector<CartesianPoint3D> & points,
+			double radius, int num_threads = 0) const;
+
+	private:
+		double m_cell_size;
+		// Coordinates and original indices, sorted by cell.
+		std::vector<CartesianPoint3D> m_points;
+		std::vector<int> m_index;
+		// Cell key -> [first, last) in m_points.
+		std::unordered_map<long long, std::pair<int, int>> m_cells;
+
+		long long cell_key(long long ix, long long iy, long long iz) const;
+		long long cell_coordinate(double x) const;
+		template<typename TFunc>
+		void for_each_in_range(const CartesianPoint3D & point, double radius, TFunc && func) const;
+	};
+
+	// For each point, the index of the point it should be merged into: the 
+	// lowest index reachable through a chain of points each within tolerance of 
+	// the next. Points with no neighbours map to themselves. 
+	std::vector<int> coincident_point_map(const std::vector<CartesianPoint3D> & points,
+		double tolerance, int num_threads = 0);
+}
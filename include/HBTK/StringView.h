@@ -0,0 +1,166 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+StringView.h
+
+A non-owning view of a sequence of characters.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace HBTK {
+	// A pointer and length into characters owned elsewhere (C++14 has no
+	// std::string_view). The viewed characters must outlive the view.
+	class StringView {
+	public:
+		constexpr StringView();
+		constexpr StringView(const char * data, int size);
+		StringView(const char * c_string);
+		StringView(const std::string & string);
+
+		constexpr const char * data() const;
+		constexpr int size() const;
+		constexpr bool empty() const;
+		constexpr char operator[](int index) const;
+		constexpr const char * begin() const;
+		constexpr const char * end() const;
+
+		// Characters [pos, pos + count), limited to the end of the view.
+		StringView substr(int pos, int count = -1) const;
+		// Index of the first c at or after pos, or -1.
+		int find(char c, int pos = 0) const;
+		bool starts_with(StringView prefix) const;
+
+		std::string to_string() const;
+
+		bool operator==(StringView other) const;
+		bool operator!=(StringView other) const;
+
+	private:
+		const char * m_data;
+		int m_size;
+	};
+
+	std::ostream & operator<<(std::ostream & stream, StringView view);
+
+
+
+
+	// DEFINITIONS
+
+	inline constexpr StringView::StringView()
+		: m_data(nullptr),
+		m_size(0)
+	{
+	}
+
+	inline constexpr StringView::StringView(const char * data, int size)
+		: m_data(data),
+		m_size(size)
+	{
+	}
+
+	inline StringView::StringView(const char * c_string)
+		: m_data(c_string),
+		m_size((int)strlen(c_string))
+	{
+	}
+
+	inline StringView::StringView(const std::string & string)
+		: m_data(string.data()),
+		m_size((int)string.size())
+	{
+	}
+
+	inline constexpr const char * StringView::data() const
+	{
+		return m_data;
+	}
+
+	inline constexpr int StringView::size() const
+	{
+		return m_size;
+	}
+
+	inline constexpr bool StringView::empty() const
+	{
+		return m_size == 0;
+	}
+
+	inline constexpr char StringView::operator[](int index) const
+	{
+		return m_data[index];
+	}
+
+	inline constexpr const char * StringView::begin() const
+	{
+		return m_data;
+	}
+
+	inline constexpr const char * StringView::end() const
+	{
+		return m_data + m_size;
+	}
+
+	inline StringView StringView::substr(int pos, int count) const
+	{
+		if (pos > m_size) { pos = m_size; }
+		if (count < 0 || count > m_size - pos) { count = m_size - pos; }
+		return StringView(m_data + pos, count);
+	}
+
+	inline int StringView::find(char c, int pos) const
+	{
+		if (pos >= m_size) { return -1; }
+		const void * found = memchr(m_data + pos, c, m_size - pos);
+		return found ? (int)((const char*)found - m_data) : -1;
+	}
+
+	inline bool StringView::starts_with(StringView prefix) const
+	{
+		return prefix.m_size <= m_size 
+			&& (prefix.m_size == 0 || memcmp(m_data, prefix.m_data, prefix.m_size) == 0);
+	}
+
+	inline std::string StringView::to_string() const
+	{
+		return std::string(m_data, m_size);
+	}
+
+	inline bool StringView::operator==(StringView other) const
+	{
+		return m_size == other.m_size 
+			&& (m_size == 0 || memcmp(m_data, other.m_data, m_size) == 0);
+	}
+
+	inline bool StringView::operator!=(StringView other) const
+	{
+		return !(*this == other);
+	}
+
+	inline std::ostream & operator<<(std::ostream & stream, StringView view)
+	{
+		return stream.write(view.data(), view.size());
+	}
+}
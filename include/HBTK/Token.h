@@ -50,9 +50,15 @@ namespace HBTK {
 
 		bool isnewline() const;
 
+		// Value of an isnum() token. Tokenisers that parse numbers store it 
+		// with the token; otherwise it is converted from value().
+		double number() const;
+		long long integer() const;
+
 	protected:
 		friend class TokenStream;
 		friend class BasicTokeniser;
+		friend class BufferedTokeniser;
 		friend class NumberTokenModifier;
 		friend class StringTokenModifier;
 
@@ -73,5 +79,13 @@ namespace HBTK {
 		std::string m_value;
 		int m_line;
 		int m_char;
+
+		// Parsed value, if m_has_number.
+		bool m_has_number = false;
+		double m_number = 0;
+		long long m_integer = 0;
+
+		// value truncated, saturating at the limits of long long. 0 for NaN.
+		static long long saturated_integer(double value);
 	};
 }
\ No newline at end of file
@@ -32,8 +32,13 @@ namespace HBTK {
 	///
 	/// Useage:
 	/// \code Ty tol = HBTK::tolerance<double>() \endcode
+	/// Types with a value_type but no tolerance of their own (eg. HBTK::Dual)
+	/// have the tolerance of their value_type.
 	template < typename Ty >
-	constexpr Ty tolerance(void);
+	constexpr Ty tolerance(void)
+	{
+		return Ty(tolerance<typename Ty::value_type>());
+	}
 
 	/// \brief returns the tolerance of double (10^-15)
 	/// \code double tol = HBTK::tolerance<double>() \endcode
@@ -0,0 +1,162 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+VtkArrayRegistry.h
+
+Named, typed data arrays for VTK datasets.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace HBTK {
+	namespace Vtk {
+		// Named arrays of Float32, Float64, Int32 or Int64 tuples with any number
+		// of components, stored either interleaved (as in VTK files) or as one
+		// array per component. Arrays are used where they are: VtkWriter writes
+		// them without converting them first, and VtkParser can read into them
+		// keeping the file's types.
+		class VtkArrayRegistry {
+		public:
+			enum value_type {
+				FLOAT32, FLOAT64, INT32, INT64
+			};
+
+			enum storage_layout {
+				INTERLEAVED,		// Value j of tuple i at [i * components + j].
+				COMPONENT_ARRAYS	// Component j at [j * tuples, (j + 1) * tuples).
+			};
+
+			// Refers to an array until it is removed. Adding or removing other
+			// arrays doesn't change it.
+			typedef int handle;
+
+			VtkArrayRegistry();
+
+			// Add an array of zeros. Throws std::invalid_argument if the name is in use.
+			handle add(const std::string & name, value_type type, int components, int tuples,
+				storage_layout layout = INTERLEAVED);
+			// The array with name, or -1.
+			handle find(const std::string & name) const;
+			void remove(handle array);
+			void clear();
+			// Arrays in the order they were added.
+			std::vector<handle> handles() const;
+			int size() const;
+
+			const std::string & name(handle array) const;
+			value_type type(handle array) const;
+			int components(handle array) const;
+			int tuples(handle array) const;
+			storage_layout layout(handle array) const;
+
+			// Type written to files. A FLOAT64 array may be written as FLOAT32 to 
+			// halve its size. Defaults to type(array).
+			value_type output_type(handle array) const;
+			void set_output_type(handle array, value_type type);
+
+			// The values, where T is the array's type (float, double, int32_t or 
+			// int64_t - otherwise throws std::invalid_argument). Invalidated by 
+			// resize, reorder and append.
+			template<typename T>
+			T * data(handle array);
+			template<typename T>
+			const T * data(handle array) const;
+
+			// A single value, converted to or from double.
+			double value(handle array, int tuple, int component) const;
+			void set_value(handle array, int tuple, int component, double value);
+
+			// Change the number of tuples, keeping the existing ones.
+			void resize(handle array, int tuples);
+			// Reorder the tuples of every array. new_index is the new index of
+			// each old tuple.
+			void reorder(const std::vector<int> & new_index);
+			// Append the tuples of the matching arrays of other. Both must have
+			// arrays of the same names, types and components.
+			void append(const VtkArrayRegistry & other);
+			// The given tuples of every array, with the same types and layouts.
+			VtkArrayRegistry select(const std::vector<int> & tuples) const;
+			// True if other has arrays of the same names, types and components.
+			bool same_arrays(const VtkArrayRegistry & other) const;
+
+			// The value_type of T.
+			template<typename T>
+			static value_type type_of();
+			// Name of the type in VTK files, eg. "Float32".
+			static const char * type_name(value_type type);
+			static int type_size(value_type type);
+
+		private:
+			struct entry {
+				std::string name;
+				value_type type, output;
+				int components, tuples;
+				storage_layout layout;
+				bool in_use;
+				// Only the vector of type is used.
+				std::vector<float> float32;
+				std::vector<double> float64;
+				std::vector<int32_t> int32;
+				std::vector<int64_t> int64;
+			};
+			std::vector<entry> m_arrays;
+			std::unordered_map<std::string, handle> m_names;
+
+			entry & checked(handle array);
+			const entry & checked(handle array) const;
+			// Call f with the vector of e's type.
+			template<typename F>
+			static void visit(entry & e, F f);
+
+			static std::vector<float> & storage(entry & e, float *) { return e.float32; }
+			static std::vector<double> & storage(entry & e, double *) { return e.float64; }
+			static std::vector<int32_t> & storage(entry & e, int32_t *) { return e.int32; }
+			static std::vector<int64_t> & storage(entry & e, int64_t *) { return e.int64; }
+		};
+
+		template<> inline VtkArrayRegistry::value_type VtkArrayRegistry::type_of<float>() { return FLOAT32; }
+		template<> inline VtkArrayRegistry::value_type VtkArrayRegistry::type_of<double>() { return FLOAT64; }
+		template<> inline VtkArrayRegistry::value_type VtkArrayRegistry::type_of<int32_t>() { return INT32; }
+		template<> inline VtkArrayRegistry::value_type VtkArrayRegistry::type_of<int64_t>() { return INT64; }
+
+		template<typename T>
+		inline T * VtkArrayRegistry::data(handle array)
+		{
+			entry & e = checked(array);
+			if (type_of<T>() != e.type) {
+				throw std::invalid_argument("HBTK::Vtk::VtkArrayRegistry::data: Array " + e.name
+					+ " is " + type_name(e.type) + ". " __FILE__ ":" + std::to_string(__LINE__));
+			}
+			return storage(e, (T*)nullptr).data();
+		}
+
+		template<typename T>
+		inline const T * VtkArrayRegistry::data(handle array) const
+		{
+			return const_cast<VtkArrayRegistry*>(this)->data<T>(array);
+		}
+	}
+}
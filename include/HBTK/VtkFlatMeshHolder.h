@@ -0,0 +1,91 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+VtkFlatMeshHolder.h
+
+A dataless VTK unstructured mesh stored as VTK's own arrays.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <initializer_list>
+#include <vector>
+
+#include "CartesianArray3D.h"
+#include "CartesianPoint.h"
+#include "MeshTopology.h"
+#include "VtkCellType.h"
+#include "VtkUnstructuredMeshHolder.h"
+
+namespace HBTK {
+	namespace Vtk {
+		// An unstructured mesh laid out as VTK files store it: points as one
+		// array per coordinate and cells as connectivity, offsets and types 
+		// arrays. Building one takes one allocation per array (see reserve), 
+		// and VtkWriter writes the arrays as they are.
+		class VtkFlatMeshHolder {
+		public:
+			VtkFlatMeshHolder();
+			// Pack a cell-per-node-list mesh.
+			explicit VtkFlatMeshHolder(const VtkUnstructuredMeshHolder & mesh);
+
+			PointArray3D points;
+			// Nodes of cell i are connectivity[offsets[i], offsets[i + 1]). As in
+			// MeshReordering.h, offsets starts with 0, so it has a value per cell 
+			// more than VTK's offsets array (offsets[1:]).
+			std::vector<int> connectivity;
+			std::vector<int> offsets;
+			// CellType of each cell, as unsigned char like VTK's types array.
+			std::vector<unsigned char> types;
+
+			int number_of_points() const;
+			int number_of_cells() const;
+
+			// Make room for the given number of points, cells and cell node ids.
+			void reserve(int num_points, int num_cells, int num_connectivity);
+			// Remove all points and cells, keeping the allocated memory.
+			void clear();
+
+			// Add a point or cell. Returns its index.
+			int add_point(const CartesianPoint3D & point);
+			int add_cell(CellType type, const int * node_ids, int num_nodes);
+			int add_cell(CellType type, std::initializer_list<int> node_ids);
+
+			CellType cell_type(int cell) const;
+			int cell_size(int cell) const;
+			const int * cell_nodes(int cell) const;
+
+			// Cells with the wrong number of nodes for their type, or node ids 
+			// that are not points.
+			std::vector<int> check_consistant_node_counts() const;
+			std::vector<int> check_valid_cell_nodes_ids() const;
+
+			// Renumber points or cells. new_index is the new index of each 
+			// old point or cell.
+			void reorder_points(const std::vector<int> & new_index);
+			void reorder_cells(const std::vector<int> & new_index);
+			// Node to cell and cell to cell connectivity, indexed as points and cells.
+			MeshTopology topology(int num_threads = 0) const;
+
+			// Unpack to a cell-per-node-list mesh.
+			VtkUnstructuredMeshHolder to_unstructured() const;
+		};
+	}
+}
@@ -37,6 +37,9 @@ namespace HBTK {
 		// VtkScalar -> double
 		// VtkVector -> CartesianVector3D
 
+		// True if ele_id is one of the values of CellType.
+		bool is_cell_type(int ele_id);
+
 		// Returns a string describing the element given by ele_id
 		const std::string element_name(int ele_id);
 		const std::string element_name(CellType ele_id);
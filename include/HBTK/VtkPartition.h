@@ -0,0 +1,67 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+VtkPartition.h
+
+Splitting VTK datasets into pieces.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "VtkUnstructuredDataset.h"
+#include "VtkUnstructuredMeshHolder.h"
+
+namespace HBTK {
+	namespace Vtk {
+		// Partitions give the part of each cell, 0 to parts - 1. Parts are 
+		// balanced by their number of cell nodes, which is roughly what it costs 
+		// to write them.
+
+		// Runs of consecutive cells. Good when cells are already ordered
+		// locally (see MeshReordering.h).
+		std::vector<int> contiguous_partition(const VtkUnstructuredMeshHolder & mesh, int parts);
+
+		// Runs of cells in breadth first order through shared faces (see 
+		// MeshTopology), starting from a peripheral cell of each connected region.
+		// Parts are compact whatever the cell order, so few points are shared
+		// between pieces.
+		std::vector<int> graph_partition(const VtkUnstructuredMeshHolder & mesh, int parts,
+			int num_threads = 0);
+
+		// The cells of each part, ascending.
+		std::vector<std::vector<int>> part_cells(const std::vector<int> & cell_part, int parts);
+
+		// A dataset of the given cells and the points they use with their data.
+		// Points are renumbered in order of first use.
+		VtkUnstructuredDataset extract_cells(const VtkUnstructuredDataset & dataset,
+			const std::vector<int> & cells);
+		// Reusing point_map, which must be -1 for every point (and is left so),
+		// between pieces.
+		VtkUnstructuredDataset extract_cells(const VtkUnstructuredDataset & dataset,
+			const std::vector<int> & cells, std::vector<int> & point_map);
+
+		// Split a dataset into a piece per part, using up to num_threads threads
+		// (default_thread_count() if num_threads <= 0).
+		std::vector<VtkUnstructuredDataset> split_dataset(const VtkUnstructuredDataset & dataset,
+			const std::vector<int> & cell_part, int parts, int num_threads = 0);
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+/*////////////////////////////////////////////////////////////////////////////
+VtkPvtuWriter.h
+
+Parallel VTK unstructured grid (.pvtu) files.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "VtkUnstructuredDataset.h"
+#include "XmlWriter.h"
+
+namespace HBTK {
+	namespace Vtk {
+		// Write pieces as a .vtu file each, several at once, and a .pvtu file 
+		// listing them. The pieces of "dir/name.pvtu" are "dir/name_0.vtu", 
+		// "dir/name_1.vtu" and so on (see piece_path).
+		class VtkPvtuWriter {
+		public:
+			VtkPvtuWriter();
+
+			// Write pieces that are already split. All must have the same arrays.
+			void write(const std::string & pvtu_path, const std::vector<VtkUnstructuredDataset> & pieces);
+			// Split a dataset by the part of each cell (see VtkPartition.h) as the 
+			// pieces are written, so each thread only holds the piece it is writing.
+			void write(const std::string & pvtu_path, const VtkUnstructuredDataset & dataset,
+				const std::vector<int> & cell_part, int parts);
+
+			// The .vtu file of a piece.
+			static std::string piece_path(const std::string & pvtu_path, int piece);
+
+			// As VtkWriter, for each piece.
+			bool ascii;	// Default false
+			bool appended; // Default true
+			int write_precision;
+
+			// Pieces written at once. default_thread_count() if <= 0. Default 0.
+			int num_threads;
+
+		protected:
+			void write_piece_file(const std::string & path, const VtkUnstructuredDataset & piece) const;
+			void write_pvtu(const std::string & pvtu_path, const VtkDataArrays & arrays, int pieces);
+			void p_data_array(std::ostream & stream, const std::string & name, 
+				const std::string & type, int components);
+
+			Xml::XmlWriter m_xml_writer;
+		};
+	}
+}
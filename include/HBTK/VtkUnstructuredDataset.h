@@ -24,18 +24,20 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "CartesianVector.h"
+#include "VtkArrayRegistry.h"
+#include "VtkFlatMeshHolder.h"
 #include "VtkUnstructuredMeshHolder.h"
 
 namespace HBTK {
 	namespace Vtk {
-		class VtkUnstructuredDataset {
+		// The point and cell data arrays of a dataset.
+		class VtkDataArrays {
 		public:
-			
-			VtkUnstructuredMeshHolder mesh;
-			
 			// Point data - index linked correspondence to points in mesh.
 			// data name is key.
 			std::unordered_map<std::string, std::vector<double>> scalar_point_data;
@@ -47,6 +49,48 @@ namespace HBTK {
 			std::unordered_map<std::string, std::vector<double>> scalar_cell_data;
 			std::unordered_map<std::string, std::vector<int>> integer_cell_data;
 			std::unordered_map<std::string, std::vector<HBTK::CartesianVector3D>> vector_cell_data;
+
+			// Arrays of any type and number of components, written as they are
+			// stored. Names must not clash with the maps above.
+			VtkArrayRegistry point_arrays;
+			VtkArrayRegistry cell_arrays;
+
+			// Reorder all point or cell data. new_index is the new index of each 
+			// old point or cell.
+			void reorder_point_data(const std::vector<int> & new_index);
+			void reorder_cell_data(const std::vector<int> & new_index);
+		};
+
+		class VtkUnstructuredDataset 
+			: public VtkDataArrays
+		{
+		public:
+			
+			VtkUnstructuredMeshHolder mesh;
+
+			// Renumber the mesh points or cells (see VtkUnstructuredMeshHolder) and
+			// reorder the point or cell data to match.
+			void reorder_points(const std::vector<int> & new_index);
+			void reorder_cells(const std::vector<int> & new_index);
+
+			// Append another piece: its points and cells follow these, and its
+			// data follows the matching arrays. Both must have the same arrays.
+			void append(const VtkUnstructuredDataset & other);
+		};
+
+		// A dataset with a VtkFlatMeshHolder mesh.
+		class VtkFlatDataset
+			: public VtkDataArrays
+		{
+		public:
+			VtkFlatDataset();
+			// Pack the mesh, copying the data.
+			explicit VtkFlatDataset(const VtkUnstructuredDataset & dataset);
+
+			VtkFlatMeshHolder mesh;
+
+			void reorder_points(const std::vector<int> & new_index);
+			void reorder_cells(const std::vector<int> & new_index);
 		};
 	}
 }
\ No newline at end of file
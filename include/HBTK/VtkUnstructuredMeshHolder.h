@@ -27,7 +27,9 @@ SOFTWARE.
 
 #include <vector>
 
+#include "CartesianArray3D.h"
 #include "CartesianPoint.h"
+#include "MeshTopology.h"
 #include "VtkCellType.h"
 
 namespace HBTK {
@@ -37,6 +39,9 @@ namespace HBTK {
 			VtkUnstructuredMeshHolder();
 
 			std::vector<HBTK::CartesianPoint3D> points;
+			// Bulk operations on points in place (no copy). Invalidated
+			// if points is reallocated.
+			PointArrayView3D points_view();
 
 			struct cell_data {
 				CellType cell_type;
@@ -46,6 +51,18 @@ namespace HBTK {
 
 			std::vector<int> check_consistant_node_counts();
 			std::vector<int> check_valid_cell_nodes_ids();
+			// Merge points within tolerance of each other, keeping the first
+			// and updating cell node ids. Returns the new index of each old point.
+			std::vector<int> merge_repeated_points(double tolerance = 0);
+
+			// Cell node ids CSR style, as used by MeshReordering.h.
+			void cell_connectivity(std::vector<int> & offsets, std::vector<int> & node_ids) const;
+			// Renumber points or cells. new_index is the new index of each 
+			// old point or cell. Cell node ids are updated.
+			void reorder_points(const std::vector<int> & new_index);
+			void reorder_cells(const std::vector<int> & new_index);
+			// Node to cell and cell to cell connectivity, indexed as points and cells.
+			MeshTopology topology(int num_threads = 0) const;
 		};
 	}
 }
@@ -2,7 +2,7 @@
 /*////////////////////////////////////////////////////////////////////////////
 VtkParser.h
 
-Read Vtk files. Incomplete.
+Read Vtk XML unstructured grid (.vtu) files.
 
 Copyright 2018 HJA Bird
 
@@ -25,50 +25,57 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <functional>
+#include <ostream>
 #include <stack>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "BasicParser.h"
+#include "ByteSource.h"
+#include "VtkUnstructuredDataset.h"
 #include "VtkXmlArrayReader.h"
 #include "XmlParser.h"
 
 namespace HBTK {
 	namespace Vtk {
 		class VtkParser 
-			: BasicParser<VtkParser>
+			: public BasicParser<VtkParser>
 		{
 		public:
 			VtkParser();
 
+			// Add a function to execute for each <Piece> once it has been read. 
+			// The dataset is reused for the next piece, so move or swap out anything 
+			// that is needed later. Only one piece is held at a time: with 
+			// appended data, pieces are read once the AppendedData is reached.
+			void add_piece_function(std::function<bool(VtkUnstructuredDataset &)> func);
+
+			// Read the whole file into one dataset. Later pieces are appended to
+			// the first (see VtkUnstructuredDataset::append).
+			VtkUnstructuredDataset parse_dataset(ByteSource source);
+			VtkUnstructuredDataset parse_dataset(const std::string & file_path);
+
+			// Read point and cell data into the dataset's point_arrays and
+			// cell_arrays, keeping the file's types, instead of the scalar, integer
+			// and vector maps. Default false. Arrays with other than 1 or 3
+			// components always go to the registries.
+			bool typed_arrays;
+
 			// Inherits from BasicParser:
-			/*
-			// Parse file at path.
-			void parse(std::string file_path) {
-				if (file_path.empty()) { throw - 1; }
-				std::ifstream inpt_stream(file_path.c_str(), std::ios::binary);
-				parse(inpt_stream, std::cerr);
-			}
-
-			// Parse Ifstream
-			void parse(std::ifstream & input_stream) {
-				parse(input_stream, std::cerr);
-			}
-
-			// Parse based on both input fstream and output stream
-			void parse(std::ifstream & input_stream, std::ostream & error_stream) {
-				if (!input_stream) { throw - 1; }
-				if (!error_stream) { throw - 1; }
-				static_cast<TParentClass *>(this)->main_parser(input_stream, error_stream);
-			}
-			*/
+			// void parse(std::string file_path);
+			// void parse(ByteSource source);
+			// void parse(std::istream & input_stream);
+			// void parse(std::istream & input_stream, std::ostream & error_stream);
 
 		protected:
 			friend class BasicParser<VtkParser>;	
 			using key_val_pairs = Xml::XmlParser::key_val_pairs;
 
-			void main_parser(std::ifstream & input_stream, std::ostream & error_stream);
+			void main_parser(std::istream & input_stream, std::ostream & error_stream);
 
-			std::istream *input_stream;
+			std::ostream *m_error_stream;
 
 			// Meta info
 			double m_version;
@@ -86,13 +93,54 @@ namespace HBTK {
 			// To handle the reading of the array bits for us:
 			VtkXmlArrayReader m_array_reader;
 
+			std::vector<std::function<bool(VtkUnstructuredDataset &)>> m_piece_funcs;
+
+			// Where a DataArray's values belong.
+			enum array_section {
+				POINTS, CELLS, POINT_DATA, CELL_DATA
+			};
+			struct array_record {
+				array_section section;
+				VtkXmlArrayReader::array_info info;
+			};
+			// A piece waiting for its appended data.
+			struct piece_record {
+				int num_points, num_cells;
+				std::vector<array_record> arrays;
+			};
+
+			// The piece being read, reused between pieces.
+			VtkUnstructuredDataset m_piece;
+			int m_num_points, m_num_cells;
+			std::vector<int> m_cell_types, m_cell_offsets, m_connectivity;
+			std::vector<std::string> m_point_data_names, m_cell_data_names;
+			// Appended arrays of the current piece and earlier pieces.
+			piece_record m_piece_record;
+			std::vector<piece_record> m_appended_pieces;
+			// Arrays of the current piece given inline.
+			int m_inline_arrays;
+			// The content of the current element.
+			std::string m_content;
+			// Unused arrays are decoded to here and dropped.
+			std::vector<double> m_discarded;
+
+			// Position in the appended data.
+			std::istream *m_appended_stream;
+			bool m_appended_base64;
+			long long m_appended_position, m_appended_end;
+			std::streampos m_appended_start;
+
 			// Functions for the all your xml needs:
 			void on_tag_open(std::string tag_name,  key_val_pairs key_vals);
 			void on_tag_close(std::string tag_name);
 
 			void vtk_file_tag_handler(const key_val_pairs & params,
 				std::istream & stream);
-			void data_array_tag_handler(const key_val_pairs & params,
+			void unstructured_grid_tag_handler(const key_val_pairs & params,
+				std::istream & stream);
+			void piece_tag_handler(const key_val_pairs & params,
+				std::istream & stream);
+			void data_array_tag_handler(array_section section, const key_val_pairs & params,
 				std::istream & stream);
 			void unstructured_cells_tag_handler(const key_val_pairs & params,
 				std::istream & stream);
@@ -102,6 +150,18 @@ namespace HBTK {
 				std::istream & stream);
 			void unstructured_point_data_tag_handler(const key_val_pairs & params,
 				std::istream & stream);
+			void appended_data_tag_handler(const key_val_pairs & params,
+				std::istream & stream);
+
+			// Move to offset in the appended data.
+			void seek_appended(long long offset);
+			// Decode an array into m_piece (or the cell arrays), from m_content
+			// or the appended data.
+			void read_array(const array_record & record);
+			// Reset m_piece for a piece of the given size.
+			void begin_piece(int num_points, int num_cells);
+			// Build the cells, check the piece and pass it to the piece functions.
+			void finish_piece();
 		};
 	}
 }
\ No newline at end of file
@@ -26,10 +26,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
 #include <ostream>
 #include <string>
 #include <vector>
 
+#include "CartesianArray3D.h"
+#include "VtkArrayRegistry.h"
+#include "VtkFlatMeshHolder.h"
 #include "VtkUnstructuredDataset.h"
 #include "VtkUnstructuredMeshHolder.h"
 #include "XmlWriter.h"
@@ -51,6 +55,9 @@ namespace HBTK {
 			
 			// Write out a single 'piece' of the dataset.
 			void write_piece(std::ostream & stream, const VtkUnstructuredDataset & data);
+			// The mesh's arrays are written as they are: binary data is encoded
+			// straight from them without being repacked.
+			void write_piece(std::ostream & stream, const VtkFlatDataset & data);
 
 			// Close the VTK file. Needed otherwise it'll be incomplete!
 			void close_file(std::ostream & stream);
@@ -84,8 +91,9 @@ namespace HBTK {
 			void vtk_unstructured_piece(std::ostream & ostream, int num_points, int num_cells);
 			void vtk_unstructured_mesh(std::ostream & ostream, const VtkUnstructuredMeshHolder & mesh);
 			void vtk_unstructured_cells(std::ostream & ostream, const VtkUnstructuredMeshHolder & mesh);
-			void vtk_unstructured_point_data(std::ostream & ostream, const VtkUnstructuredDataset & data);
-			void vtk_unstructured_cell_data(std::ostream & ostream, const VtkUnstructuredDataset & data);
+			void vtk_unstructured_point_data(std::ostream & ostream, const VtkDataArrays & data);
+			void vtk_unstructured_cell_data(std::ostream & ostream, const VtkDataArrays & data);
+			void vtk_flat_mesh(std::ostream & ostream, const VtkFlatMeshHolder & mesh);
 
 			void vtk_data_array(std::ostream & ostream, std::string name, const std::vector<double> & scalars);
 			void vtk_data_array(std::ostream & ostream, std::string name, const std::vector<int> & ints);
@@ -96,6 +104,21 @@ namespace HBTK {
 			std::vector<unsigned char> vtk_data_array_generate_buffer(const std::vector<HBTK::CartesianVector3D> & vectors);
 			std::vector<unsigned char> vtk_data_array_generate_buffer(const std::vector<HBTK::CartesianPoint3D> & point);
 			std::vector<std::pair<std::string, std::string>> vtk_data_array_format_options() const;
+			// Write count values of a single component array straight from data.
+			template<typename T>
+			void vtk_direct_data_array(std::ostream & ostream, const std::string & name,
+				const std::string & type, const T * data, size_t count);
+			void vtk_direct_data_array(std::ostream & ostream, const std::string & name,
+				const PointArray3D & points);
+			void vtk_data_array_open(std::ostream & ostream, const std::string & name,
+				const std::string & type, int components);
+			// Write a registry array as it is stored, interleaving component arrays
+			// and converting to its output type as it is encoded.
+			void vtk_registry_array(std::ostream & ostream, const VtkArrayRegistry & arrays,
+				VtkArrayRegistry::handle array);
+			template<typename T>
+			void vtk_registry_values(std::ostream & ostream, const VtkArrayRegistry & arrays,
+				VtkArrayRegistry::handle array);
 
 			int appended_data_bytelength() const;
 
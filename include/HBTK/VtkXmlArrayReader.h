@@ -25,68 +25,111 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
-#include "CartesianVector.h"
 #include "XmlParser.h"
 
 namespace HBTK {
 	namespace Vtk {
+		// Decode the DataArrays of VTK XML files: ascii, base64 binary or 
+		// appended (raw or base64), optionally zlib compressed. Values are 
+		// converted straight into storage given by the caller.
 		class VtkXmlArrayReader {
 		public:
+			VtkXmlArrayReader();
+
 			enum dtype {
 				SCALAR, INTEGER, VECTOR
 			};
 
-
-			// When a new data array is encountered, refer the input steam to function.
-			// A integer is later used to match up read in arrays to location in file is returned.
-			int new_array_tag(
-				int expected_length, 
-				Xml::XmlParser::key_val_pairs,
-				Xml::XmlParser & parser);
-
-			// For when the appended data tag is encountered.
-			// Reads in appended data.
-			// void parse_appended_data(std::string appended_data_tag, std::istream & stream, Xml::XmlParser & parser);
-
-			// Get the type - ie. scalar, integer or vector - associated with an array integer tag.
-			dtype retrieve_data_type(int array_tag);
-
-			// For an integer tag, the data of an array is transfered to a target array, and the name
-			// to a target string. If the tag refers to a different type of data (eg. scalar not vector)
-			// it'll throw an argument exception.
-			void retrieve_scalar_data(int tag, std::string & name_target, std::vector<double> & data_target);
-			void retrieve_int_data(int tag, std::string & name_target, std::vector<int> & data_target);
-			void retrieve_vector_data(int tag, std::string & name_target, std::vector<HBTK::CartesianVector3D> & data_target);
-
-		protected:
-
 			enum stype {
 				INT8, INT16, INT32, INT64,
 				UINT8, UINT16, UINT32, UINT64,
 				FLOAT32, FLOAT64
 			};
 
-			// The data for once it has been read in:
-			std::vector<std::string> m_data_names;
-			std::unordered_map<int, std::vector<double>> m_scalar_data;
-			std::unordered_map<int, std::vector<int>> m_int_data;
-			std::unordered_map<int, std::vector<HBTK::CartesianVector3D>> m_vector_data;
+			enum format {
+				ASCII, BINARY, APPENDED
+			};
 
-			// Essential info for reading later:
-			std::vector<dtype> m_data_types;
-			std::vector<stype> m_storage_types;
-			std::vector<int> m_num_values;
-			std::unordered_map<int, int> m_offsets;
+			// A DataArray element's attributes.
+			struct array_info {
+				std::string name;
+				stype storage_type;
+				int components;
+				format data_format;
+				long long offset;	// Into the appended data. -1 if not appended.
+			};
 
-			// Convert at type description - eg. "Int32" - to the enum. 
-			stype type_string_to_stype(std::string desc);
+			// Options from the VTKFile element, applying to all arrays: the integer
+			// type of binary headers, byte order and whether the data is 
+			// compressed with vtkZLibDataCompressor.
+			void set_file_options(stype header_type, bool big_endian, bool compressed);
+
+			// Read a DataArray element's attributes. Throws std::invalid_argument 
+			// if they are incomplete or invalid.
+			array_info describe_array(const Xml::XmlParser::key_val_pairs & xml_tag_args) const;
+
+			// Scalar, integer or vector - what to store the array as. Throws 
+			// std::invalid_argument for other numbers of components.
+			dtype data_type(const array_info & info) const;
+
+			// Decode an array given inline as the DataArray's content (ascii or 
+			// binary). destination(n) is called with the number of values found 
+			// and returns where to put them (or throws if n is wrong).
+			void read_inline(const array_info & info, const std::string & content,
+				const std::function<double*(size_t)> & destination);
+			void read_inline(const array_info & info, const std::string & content,
+				const std::function<int*(size_t)> & destination);
+			void read_inline(const array_info & info, const std::string & content,
+				const std::function<float*(size_t)> & destination);
+			void read_inline(const array_info & info, const std::string & content,
+				const std::function<int64_t*(size_t)> & destination);
+
+			// Decode an array from the AppendedData, with stream positioned at its
+			// offset. Returns the number of characters read.
+			size_t read_appended(const array_info & info, std::istream & stream, bool base64,
+				const std::function<double*(size_t)> & destination);
+			size_t read_appended(const array_info & info, std::istream & stream, bool base64,
+				const std::function<int*(size_t)> & destination);
+			size_t read_appended(const array_info & info, std::istream & stream, bool base64,
+				const std::function<float*(size_t)> & destination);
+			size_t read_appended(const array_info & info, std::istream & stream, bool base64,
+				const std::function<int64_t*(size_t)> & destination);
+
+			// Convert a type description - eg. "Int32" - to the enum. 
+			static stype type_string_to_stype(std::string desc);
+			// Size of a value of the type in bytes.
+			static int stype_size(stype type);
 
-			// Read in an ASCII array
-			void read_ascii_data(int id, Xml::XmlParser& xml_parser);
+		protected:
+			// File options.
+			stype m_header_type;
+			bool m_big_endian;
+			bool m_compressed;
+
+			// Reused between arrays.
+			std::string m_text;
+			std::vector<unsigned char> m_bytes;
+			std::string m_inflated;
+
+			template<typename T>
+			void read_inline_impl(const array_info & info, const std::string & content,
+				const std::function<T*(size_t)> & destination);
+			template<typename T>
+			size_t read_appended_impl(const array_info & info, std::istream & stream, bool base64,
+				const std::function<T*(size_t)> & destination);
+
+			// Read a header integer from data.
+			size_t header_value(const unsigned char * data) const;
+			// Given binary data starting with its header, the data itself. Inflates 
+			// compressed data into m_inflated.
+			const unsigned char * binary_values(const unsigned char * data, size_t size, size_t & bytes);
 		};
 	}
-}
\ No newline at end of file
+}
@@ -60,11 +60,17 @@ namespace HBTK {
 			std::function<void(std::string)> on_element_close;
 
 			// Get the input stream for reading the data associated with the element.
+			// Reading it moves the parser on: stop before the next '<', or use
+			// read_element_content.
 			std::istream& xml_input_stream();
 
+			// Read the character data from the current position up to the next 
+			// tag into content, replacing its contents. For use in on_element_open.
+			void read_element_content(std::string & content);
+
 		private:
 			friend class BasicParser<XmlParser>;
-			void main_parser(std::ifstream & input_stream, std::ostream & error_stream);
+			void main_parser(std::istream & input_stream, std::ostream & error_stream);
 
 			// String encoding.
 			enum encoding {
@@ -75,27 +81,34 @@ namespace HBTK {
 
 			// FLAGS
 			bool m_reading_file;
+			// True if the '<' of the next tag has already been read.
+			bool m_at_tag;
 			encoding m_encoding;
 			// The currently used input stream - invalid if a file isn't being read.
-			std::ifstream *m_input_stream;
+			std::istream *m_input_stream;
 			// Stack of elements for checking nexting and open/close correctness.
 			std::stack<std::string> m_element_stack;
+			// The text of the current tag.
+			std::string m_tag_string;
 
 			// Parse the xml file descriptor.
 			void parse_prologue();
-			// Parse element opening. Call user function.
+			// Parse element opening. Call user function. Self closing
+			// elements (<NAME ... />) are closed immediately.
 			void parse_element_open();
 			// Parse closing of the element. Check correctness. Call user function.
 			void parse_element_close();
 			// Parse instructions to the parser rather than data.
 			void parse_parser_event();
+			// Skip comments, DOCTYPE and CDATA.
+			void parse_markup_declaration();
 			// Move to the curser to just inside the next xml tag.
 			// Returns 0 for end of file.
 			int seek_next_xml_event();
-			// Returns the number of characters inside the tag. Curser stays in same position.
-			int element_descriptor_length(); 
 			// Runs the correct xml function when called with curser just inside xml tag.
 			void act_on_xml_event();
+			// Read up to and including the '>' ending the tag into m_tag_string.
+			void read_tag_string();
 
 			// Read the next character from the input stream. Normalised to char from different
 			// encodings.
@@ -32,6 +32,29 @@ SOFTWARE.
 #include "Checks.h"
 #include "Constants.h"
 #include "Generators.h"
+#include "Parallel.h"
+
+namespace {
+	// NACA four digit thickness and camber line (all from Abbott and Doenhoff).
+	double naca_thickness(double thickness, double x)
+	{
+		return 10 * thickness *(
+			0.29690 * sqrt(x)
+			- 0.12600 * x
+			- 0.35160 * x * x
+			+ 0.28430 * x * x * x
+			- 0.10150 * x * x * x * x
+			);
+	}
+
+	double naca_camber(double m, double p, double x)
+	{
+		// Forward of the max camber and behind the max ordinate.
+		return (x < p 
+			? (m / (p * p)) * (2 * p * x - x * x)
+			: (m / ((1 - p)*(1 - p))) * ((1 - 2 * p) + 2 * p * x - x * x));
+	}
+}
 
 HBTK::AerofoilGeometry HBTK::AerofoilGenerators::joukowsky(double thickness, double camber)
 {
@@ -61,33 +84,13 @@ HBTK::AerofoilGeometry HBTK::AerofoilGenerators::naca_four_digit(double thicknes
 	assert((camber_position > 0) || (camber == 0));
 	assert(camber_position < 1);
 
-	double & m = camber;
-	double & p = camber_position;
-	// Thickness distribution function (all from Abbott and Doenhoff):
 	auto thick_fn = [=](double x)->double {
-		return 10 * thickness *(
-			0.29690 * sqrt(x)
-			- 0.12600 * x
-			- 0.35160 * x * x
-			+ 0.28430 * x * x * x
-			- 0.10150 * x * x * x * x
-			);
-	};
-	// The camber is 
-	auto mean_ln_fwd_fn = [=](double x)->double {
-		return (m / (p * p)) * (2 * p * x - x * x);
+		return naca_thickness(thickness, x);
 	};
-	// forward of the max camber and 
-	auto mean_ln_rear_fn = [=](double x)->double {
-		return (m / ((1 - p)*(1 - p))) * ((1 - 2 * p) + 2 * p * x - x * x);
-	}; // behind the max ordinate, which are combined:
-	auto mean_ln_fn = [&](double x)->double {
-		return (x < p ? mean_ln_fwd_fn(x) : mean_ln_rear_fn(x));
+	auto mean_ln_fn = [=](double x)->double {
+		return naca_camber(camber, camber_position, x);
 	};
 
-	std::vector<double> x_points = HBTK::linspace(0, HBTK::Constants::pi(), 30);
-	for (auto & point : x_points) point = (1 - cos(point)) / 2;
-
 	AerofoilGeometry foil;
 	foil.add_thickness(thick_fn);
 	foil.add_camber(mean_ln_fn);
@@ -114,6 +117,43 @@ HBTK::AerofoilGeometry HBTK::AerofoilGenerators::naca_four_digit(std::string nam
 	return naca_four_digit(thick, camber, camber_pos);
 }
 
+HBTK::AerofoilSectionSet HBTK::AerofoilGenerators::naca_four_digit(
+	const std::vector<double>& thickness, const std::vector<double>& camber, 
+	const std::vector<double>& camber_position, const std::vector<double>& x_points, int num_threads)
+{
+	if (thickness.size() != camber.size() || thickness.size() != camber_position.size()) {
+		throw std::invalid_argument("HBTK::AerofoilGenerators::naca_four_digit: "
+			"Parameter vectors differ in length. " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	const int num_sections = (int)thickness.size(), num_points = (int)x_points.size();
+	AerofoilSectionSet sections(x_points);
+	sections.add_sections(num_sections);
+	if (num_threads <= 0) { num_threads = HBTK::default_thread_count(); }
+	HBTK::parallel_blocks(0, num_sections, num_threads, [&](int begin, int end, int) {
+		for (int s = begin; s < end; s++) {
+			assert(thickness[s] > 0);
+			assert((camber_position[s] > 0) || (camber[s] == 0));
+			assert(camber_position[s] < 1);
+			double * sec_camber = sections.camber(s);
+			double * sec_thickness = sections.thickness(s);
+			for (int i = 0; i < num_points; i++) {
+				sec_camber[i] = naca_camber(camber[s], camber_position[s], x_points[i]);
+				sec_thickness[i] = naca_thickness(thickness[s], x_points[i]);
+			}
+		}
+	});
+	return sections;
+}
+
+std::vector<double> HBTK::AerofoilGenerators::cosine_chord_points(int number_of_points)
+{
+	std::vector<double> x_points = HBTK::linspace(0, HBTK::Constants::pi(), number_of_points);
+	for (auto & point : x_points) { point = (1 - cos(point)) / 2; }
+	x_points.front() = 0;
+	x_points.back() = 1;
+	return x_points;
+}
+
 HBTK::AerofoilGeometry HBTK::AerofoilGenerators::sd7003(void)
 {
 	// Coordinates taken from 
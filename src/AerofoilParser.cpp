@@ -27,6 +27,8 @@ SOFTWARE.
 
 #include <algorithm>
 
+#include "NumberParsing.h"
+
 HBTK::AerofoilParser::AerofoilParser(AerofoilGeometry & target)
 	: foil_name("UNKNOWN"),
 	m_foil(target)
@@ -52,7 +54,7 @@ void HBTK::AerofoilParser::main_parser(std::istream & input, std::ostream & erro
 				foil_name = this_line;
 				continue;
 			}
-			std::vector<std::string> substr = tokenise(this_line);
+			const FieldSplitter & substr = split_fields(this_line);
 			if (substr.size() == 0) {
 				continue;
 			}
@@ -66,8 +68,8 @@ void HBTK::AerofoilParser::main_parser(std::istream & input, std::ostream & erro
 			double x, y;
 
 			try {
-				x = stod(substr[0]);
-				y = stod(substr[1]);
+				x = HBTK::to_double(substr[0]);
+				y = HBTK::to_double(substr[1]);
 			}
 			catch (std::invalid_argument&) {
 				throw std::invalid_argument("HBTK::AerofoilParser::main_parser(...) "
@@ -0,0 +1,166 @@
+#include "AerofoilSectionSet.h"
+/*////////////////////////////////////////////////////////////////////////////
+AerofoilSectionSet.cpp
+
+Many aerofoil sections stored together, and a cache of aerofoil camber and
+thickness splines.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+
+#include "AerofoilGenerators.h"
+
+HBTK::AerofoilSectionSet::AerofoilSectionSet()
+{
+}
+
+HBTK::AerofoilSectionSet::AerofoilSectionSet(std::vector<double> x_points)
+	: m_x_points(x_points)
+{
+	assert(m_x_points.size() > 1);
+	assert(m_x_points.front() == 0);
+	assert(m_x_points.back() == 1);
+}
+
+int HBTK::AerofoilSectionSet::number_of_sections() const
+{
+	return m_x_points.empty() ? 0 : (int)(m_camber.size() / m_x_points.size());
+}
+
+int HBTK::AerofoilSectionSet::number_of_points() const
+{
+	return (int)m_x_points.size();
+}
+
+const std::vector<double>& HBTK::AerofoilSectionSet::x_points() const
+{
+	return m_x_points;
+}
+
+int HBTK::AerofoilSectionSet::add_sections(int number)
+{
+	assert(number >= 0);
+	int first = number_of_sections();
+	m_camber.resize(m_camber.size() + number * m_x_points.size(), 0.);
+	m_thickness.resize(m_thickness.size() + number * m_x_points.size(), 0.);
+	return first;
+}
+
+double * HBTK::AerofoilSectionSet::camber(int section)
+{
+	assert(section >= 0 && section < number_of_sections());
+	return m_camber.data() + section * m_x_points.size();
+}
+
+const double * HBTK::AerofoilSectionSet::camber(int section) const
+{
+	assert(section >= 0 && section < number_of_sections());
+	return m_camber.data() + section * m_x_points.size();
+}
+
+double * HBTK::AerofoilSectionSet::thickness(int section)
+{
+	assert(section >= 0 && section < number_of_sections());
+	return m_thickness.data() + section * m_x_points.size();
+}
+
+const double * HBTK::AerofoilSectionSet::thickness(int section) const
+{
+	assert(section >= 0 && section < number_of_sections());
+	return m_thickness.data() + section * m_x_points.size();
+}
+
+void HBTK::AerofoilSectionSet::z_upper(int section, double * z) const
+{
+	const double * c = camber(section), * t = thickness(section);
+	for (int i = 0; i < number_of_points(); i++) { z[i] = c[i] + 0.5 * t[i]; }
+	return;
+}
+
+void HBTK::AerofoilSectionSet::z_lower(int section, double * z) const
+{
+	const double * c = camber(section), * t = thickness(section);
+	for (int i = 0; i < number_of_points(); i++) { z[i] = c[i] - 0.5 * t[i]; }
+	return;
+}
+
+HBTK::AerofoilGeometry HBTK::AerofoilSectionSet::geometry(int section) const
+{
+	// AerofoilGeometry expects TE -> LE on the upper surface, then back to
+	// the TE on the lower surface, without repeating the LE.
+	const int n = number_of_points();
+	std::vector<double> upper(n), lower(n), x, z;
+	z_upper(section, upper.data());
+	z_lower(section, lower.data());
+	for (int i = n - 1; i >= 0; i--) {
+		x.push_back(m_x_points[i]);
+		z.push_back(upper[i]);
+	}
+	for (int i = 1; i < n; i++) {
+		x.push_back(m_x_points[i]);
+		z.push_back(lower[i]);
+	}
+	return AerofoilGeometry(x, z);
+}
+
+HBTK::AerofoilSplineCache::AerofoilSplineCache(int number_of_points)
+	: m_number_of_points(number_of_points)
+{
+	assert(number_of_points > 2);
+}
+
+HBTK::AerofoilSplineCache::Splines & HBTK::AerofoilSplineCache::naca_four_digit(
+	double thickness, double camber, double camber_position)
+{
+	std::array<double, 3> key({ thickness, camber, camber_position });
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto found = m_splines.find(key);
+	if (found != m_splines.end()) { return *found->second; }
+
+	std::vector<double> x_points = AerofoilGenerators::cosine_chord_points(m_number_of_points);
+	AerofoilSectionSet section = AerofoilGenerators::naca_four_digit(
+		{ thickness }, { camber }, { camber_position }, x_points, 1);
+	const double * c = section.camber(0), * t = section.thickness(0);
+	std::unique_ptr<Splines> splines(new Splines{
+		CubicSpline1D(x_points, std::vector<double>(c, c + m_number_of_points)),
+		CubicSpline1D(x_points, std::vector<double>(t, t + m_number_of_points)) });
+	// Fit now, rather than on the first (possibly concurrent) evaluation.
+	splines->camber(0.5);
+	splines->thickness(0.5);
+	Splines & result = *splines;
+	m_splines.emplace(key, std::move(splines));
+	return result;
+}
+
+int HBTK::AerofoilSplineCache::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return (int)m_splines.size();
+}
+
+void HBTK::AerofoilSplineCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_splines.clear();
+	return;
+}
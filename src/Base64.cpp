@@ -27,7 +27,10 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <cassert>
+#include <cctype>
 #include <cmath>
+#include <cstdint>
+#include <stdexcept>
 
 std::string HBTK::encode_base64(unsigned char * data, int n_bytes)
 {
@@ -78,34 +81,57 @@ std::string HBTK::encode_base64(unsigned char * data, int n_bytes)
 
 std::vector<unsigned char> HBTK::decode_base64(const std::string & data)
 {
-	const std::string conversion = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-		"abcdefghijklmnopqrstuvwxyz"
-		"0123456789+/";
-	int bytes = 3 * (int)ceil(data.size() / 4.0);
-	int ending_equals = 0;
-	if (data.size() && data.back() == '=') ending_equals += 1;
-	if (data.size() > 1 && data[data.size() - 2] == '=') ending_equals += 1;
-	bytes -= (int)data.size() % 4 + ending_equals;
+	std::vector<unsigned char> output(3 * (data.size() / 4 + 1));
+	output.resize(decode_base64(data.data(), data.size(), output.data()));
+	return output;
+}
 
-	std::vector<unsigned char> output(bytes);
-	unsigned char c1, c2, c3, c4;
-	
-	int end_bytes = data.size() % 4;	// Theoretically == 0
-	int bytes_pos = 0;
-	for (int i = 0; i < (int) data.size() - ending_equals; i += 4) {
-		c1 = data[i];
-		c2 = data[i + 1];
-		if (end_bytes == 0 || end_bytes >= 2) c3 = data[i + 2];
-		if (end_bytes == 0 || end_bytes == 3) c4 = data[i + 3];
-		output[bytes_pos] = ((uint8_t)conversion.find(c1) << 2) | ((uint8_t)conversion.find(c2) >> 4);
-		if ((data.size() % 4) < 2 && (c3 != '=')) {
-			output[bytes_pos + 1] = ((uint8_t)conversion.find(c2) << 4) | ((uint8_t)conversion.find(c3) >> 2);
-		}		
-		if ((data.size() % 4) < 3 && (c4 != '=')) {
-			output[bytes_pos + 2] = ((uint8_t)conversion.find(c3) << 6) | ((uint8_t)conversion.find(c4));
+size_t HBTK::decode_base64(const char * data, size_t n_chars, unsigned char * out)
+{
+	// Character to 6 bit value, -1 for whitespace, -2 for padding and -3 
+	// for anything else.
+	struct DecodeTable {
+		signed char values[256];
+		DecodeTable() {
+			const std::string conversion = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				"abcdefghijklmnopqrstuvwxyz"
+				"0123456789+/";
+			for (int i = 0; i < 256; i++) { values[i] = isspace(i) ? -1 : -3; }
+			for (int i = 0; i < 64; i++) { values[(unsigned char)conversion[i]] = (signed char)i; }
+			values['='] = -2;
+		}
+	};
+	static const DecodeTable table;
+
+	unsigned char * start = out;
+	uint32_t group = 0;
+	int count = 0;
+	for (size_t i = 0; i < n_chars; i++) {
+		int value = table.values[(unsigned char)data[i]];
+		if (value >= 0) {
+			group = group << 6 | (uint32_t)value;
+			if (++count == 4) {
+				*out++ = (unsigned char)(group >> 16);
+				*out++ = (unsigned char)(group >> 8);
+				*out++ = (unsigned char)group;
+				group = 0;
+				count = 0;
+			}
+		}
+		else if (value == -2) {
+			// Padding: flush the partial group. The next block may follow.
+			if (count >= 2) { *out++ = (unsigned char)(group >> (6 * count - 8)); }
+			if (count == 3) { *out++ = (unsigned char)(group >> (6 * count - 16)); }
+			group = 0;
+			count = 0;
+		}
+		else if (value == -3) {
+			throw std::invalid_argument("HBTK::decode_base64: Invalid character in "
+				"Base64 data. " __FILE__ ":" + std::to_string(__LINE__));
 		}
-		bytes_pos += 3;
 	}
-	
-	return output;
+	// Unpadded tail.
+	if (count >= 2) { *out++ = (unsigned char)(group >> (6 * count - 8)); }
+	if (count == 3) { *out++ = (unsigned char)(group >> (6 * count - 16)); }
+	return (size_t)(out - start);
 }
@@ -69,7 +69,7 @@ const HBTK::Token & HBTK::BasicTokeniser::next()
 
 const HBTK::Token& HBTK::BasicTokeniser::peek(int ahead) {
 	assert(ahead >= 0);
-	while ((int)m_tokens.size() > ahead + 1) {
+	while ((int)m_tokens.size() < ahead + 1) {
 		parse_another_token();
 	}
 	assert((int)m_tokens.size() >= ahead + 1);
@@ -0,0 +1,452 @@
+#include "BoundingVolumeHierarchy.h"
+/*////////////////////////////////////////////////////////////////////////////
+BoundingVolumeHierarchy.cpp
+
+A bounding volume hierarchy (BVH) of axis aligned boxes for accelerating
+proximity and ray queries, and BVHs over finite lines and rectilinear panels.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cmath>
+#include <future>
+
+#include "CartesianVector.h"
+#include "Parallel.h"
+
+namespace {
+	// Subtrees with more primitives than this may be built on another thread.
+	const int parallel_build_threshold = 4096;
+	const int sah_bins = 16;
+
+	// Distance from point p to triangle (a, b, c). From Ericson, Real-Time
+	// Collision Detection, 5.1.5.
+	double point_triangle_distance(const HBTK::CartesianPoint3D & p, const HBTK::CartesianPoint3D & a,
+		const HBTK::CartesianPoint3D & b, const HBTK::CartesianPoint3D & c)
+	{
+		HBTK::CartesianVector3D ab = b - a, ac = c - a, ap = p - a;
+		double d1 = ab.dot(ap), d2 = ac.dot(ap);
+		if (d1 <= 0 && d2 <= 0) { return (p - a).magnitude(); }
+		HBTK::CartesianVector3D bp = p - b;
+		double d3 = ab.dot(bp), d4 = ac.dot(bp);
+		if (d3 >= 0 && d4 <= d3) { return (p - b).magnitude(); }
+		double vc = d1 * d4 - d3 * d2;
+		if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+			double v = d1 / (d1 - d3);
+			return (p - (a + ab * v)).magnitude();
+		}
+		HBTK::CartesianVector3D cp = p - c;
+		double d5 = ab.dot(cp), d6 = ac.dot(cp);
+		if (d6 >= 0 && d5 <= d6) { return (p - c).magnitude(); }
+		double vb = d5 * d2 - d1 * d6;
+		if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+			double w = d2 / (d2 - d6);
+			return (p - (a + ac * w)).magnitude();
+		}
+		double va = d3 * d6 - d5 * d4;
+		if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+			double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			return (p - (b + (c - b) * w)).magnitude();
+		}
+		double denom = 1. / (va + vb + vc);
+		double v = vb * denom, w = vc * denom;
+		return (p - (a + ab * v + ac * w)).magnitude();
+	}
+
+	// Moller-Trumbore line-triangle intersection. Returns true and sets t
+	// if line(t) passes through the triangle (a, b, c).
+	bool line_triangle_intersection(const HBTK::CartesianLine3D & line, const HBTK::CartesianPoint3D & a,
+		const HBTK::CartesianPoint3D & b, const HBTK::CartesianPoint3D & c, double & t)
+	{
+		HBTK::CartesianVector3D e1 = b - a, e2 = c - a;
+		HBTK::CartesianVector3D pvec = line.direction().cross(e2);
+		double det = e1.dot(pvec);
+		if (det == 0) { return false; }
+		double inv_det = 1. / det;
+		HBTK::CartesianVector3D tvec = line.origin() - a;
+		double u = tvec.dot(pvec) * inv_det;
+		if (u < 0 || u > 1) { return false; }
+		HBTK::CartesianVector3D qvec = tvec.cross(e1);
+		double v = line.direction().dot(qvec) * inv_det;
+		if (v < 0 || u + v > 1) { return false; }
+		t = e2.dot(qvec) * inv_det;
+		return true;
+	}
+}
+
+HBTK::BoundingVolumeHierarchy3D::BoundingVolumeHierarchy3D()
+{
+}
+
+void HBTK::BoundingVolumeHierarchy3D::build(
+	const std::vector<CartesianBoundingBox3D>& primitive_boxes, int num_threads)
+{
+	int n_prims = (int)primitive_boxes.size();
+	m_nodes.clear();
+	m_indices.resize(n_prims);
+	for (int i = 0; i < n_prims; i++) { m_indices[i] = i; }
+	if (n_prims == 0) { return; }
+
+	std::vector<CartesianPoint3D> centroids(n_prims);
+	for (int i = 0; i < n_prims; i++) { centroids[i] = primitive_boxes[i].centre(); }
+
+	if (num_threads <= 0) { num_threads = default_thread_count(); }
+	int parallel_depth = 0;
+	while ((1 << parallel_depth) < num_threads) { parallel_depth++; }
+
+	// A binary tree with at least one primitive per leaf has at most
+	// 2n - 1 nodes. Nodes are claimed in pairs from node_count so that 
+	// subtrees can be built concurrently.
+	m_nodes.resize(2 * n_prims - 1);
+	std::atomic<int> node_count(1);
+	build_node(0, 0, n_prims, 0, parallel_depth, primitive_boxes, centroids, node_count);
+	m_nodes.resize(node_count.load());
+	return;
+}
+
+void HBTK::BoundingVolumeHierarchy3D::build_node(int node_idx, int begin, int end, 
+	int depth, int parallel_depth,
+	const std::vector<CartesianBoundingBox3D>& primitive_boxes, 
+	const std::vector<CartesianPoint3D>& centroids, 
+	std::atomic<int>& node_count)
+{
+	node & this_node = m_nodes[node_idx];
+	CartesianBoundingBox3D centroid_box;
+	this_node.box = CartesianBoundingBox3D();
+	for (int i = begin; i < end; i++) {
+		this_node.box.expand(primitive_boxes[m_indices[i]]);
+		centroid_box.expand(centroids[m_indices[i]]);
+	}
+	int count = end - begin;
+	this_node.first = begin;
+	this_node.count = count;
+	if (count <= max_leaf_size || depth >= max_depth) { return; }
+
+	// Binned surface area heuristic over all three axes.
+	int best_axis = -1, best_bin = -1;
+	double best_cost = std::numeric_limits<double>::infinity();
+	for (int axis = 0; axis < 3; axis++) {
+		double c_min = centroid_box.lower_corner().as_array()[axis];
+		double c_max = centroid_box.upper_corner().as_array()[axis];
+		if (c_max <= c_min) { continue; }
+		double bin_scale = sah_bins / (c_max - c_min);
+		std::array<CartesianBoundingBox3D, sah_bins> bin_boxes;
+		std::array<int, sah_bins> bin_counts;
+		bin_counts.fill(0);
+		for (int i = begin; i < end; i++) {
+			int bin = std::min(sah_bins - 1, 
+				(int)((centroids[m_indices[i]].as_array()[axis] - c_min) * bin_scale));
+			bin_counts[bin]++;
+			bin_boxes[bin].expand(primitive_boxes[m_indices[i]]);
+		}
+		// Sweep from the right to get areas of the right hand sets.
+		std::array<double, sah_bins> right_area;
+		std::array<int, sah_bins> right_count;
+		CartesianBoundingBox3D accumulated;
+		int accumulated_count = 0;
+		for (int bin = sah_bins - 1; bin > 0; bin--) {
+			accumulated.expand(bin_boxes[bin]);
+			accumulated_count += bin_counts[bin];
+			right_area[bin] = accumulated.surface_area();
+			right_count[bin] = accumulated_count;
+		}
+		accumulated = CartesianBoundingBox3D();
+		accumulated_count = 0;
+		for (int bin = 0; bin < sah_bins - 1; bin++) {
+			accumulated.expand(bin_boxes[bin]);
+			accumulated_count += bin_counts[bin];
+			double cost = accumulated.surface_area() * accumulated_count
+				+ right_area[bin + 1] * right_count[bin + 1];
+			if (accumulated_count > 0 && right_count[bin + 1] > 0 && cost < best_cost) {
+				best_cost = cost;
+				best_axis = axis;
+				best_bin = bin;
+			}
+		}
+	}
+	// All centroids coincide - nothing to split on.
+	if (best_axis == -1) { return; }
+
+	int mid;
+	double c_min = centroid_box.lower_corner().as_array()[best_axis];
+	double bin_scale = sah_bins / (centroid_box.upper_corner().as_array()[best_axis] - c_min);
+	mid = (int)(std::partition(m_indices.begin() + begin, m_indices.begin() + end,
+		[&](int prim) {
+		int bin = std::min(sah_bins - 1,
+			(int)((centroids[prim].as_array()[best_axis] - c_min) * bin_scale));
+		return bin <= best_bin;
+	}) - m_indices.begin());
+	assert(mid > begin && mid < end);
+
+	int children = node_count.fetch_add(2);
+	this_node.first = children;
+	this_node.count = 0;
+	if (depth < parallel_depth && count > parallel_build_threshold) {
+		auto left = std::async(std::launch::async, [&]() {
+			build_node(children, begin, mid, depth + 1, parallel_depth,
+				primitive_boxes, centroids, node_count);
+		});
+		build_node(children + 1, mid, end, depth + 1, parallel_depth,
+			primitive_boxes, centroids, node_count);
+		left.get();
+	}
+	else {
+		build_node(children, begin, mid, depth + 1, parallel_depth,
+			primitive_boxes, centroids, node_count);
+		build_node(children + 1, mid, end, depth + 1, parallel_depth,
+			primitive_boxes, centroids, node_count);
+	}
+	return;
+}
+
+void HBTK::BoundingVolumeHierarchy3D::refit(const std::vector<CartesianBoundingBox3D>& primitive_boxes)
+{
+	assert((int)primitive_boxes.size() == number_of_primitives());
+	// Children always follow their parents, so walking backwards updates
+	// every child before its parent.
+	for (int i = (int)m_nodes.size() - 1; i >= 0; i--) {
+		node & n = m_nodes[i];
+		n.box = CartesianBoundingBox3D();
+		if (n.count > 0) {
+			for (int j = n.first; j < n.first + n.count; j++) {
+				n.box.expand(primitive_boxes[m_indices[j]]);
+			}
+		}
+		else {
+			n.box.expand(m_nodes[n.first].box);
+			n.box.expand(m_nodes[n.first + 1].box);
+		}
+	}
+	return;
+}
+
+int HBTK::BoundingVolumeHierarchy3D::number_of_primitives() const
+{
+	return (int)m_indices.size();
+}
+
+int HBTK::BoundingVolumeHierarchy3D::number_of_nodes() const
+{
+	return (int)m_nodes.size();
+}
+
+HBTK::CartesianBoundingBox3D HBTK::BoundingVolumeHierarchy3D::bounds() const
+{
+	return (m_nodes.empty() ? CartesianBoundingBox3D() : m_nodes[0].box);
+}
+
+std::vector<int> HBTK::BoundingVolumeHierarchy3D::overlapping(const CartesianBoundingBox3D & box) const
+{
+	std::vector<int> found;
+	if (m_nodes.empty()) { return found; }
+	traversal_stack stack;
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+	while (stack_size > 0) {
+		const node & n = m_nodes[stack[--stack_size]];
+		if (!n.box.intersects(box)) { continue; }
+		if (n.count > 0) {
+			for (int i = n.first; i < n.first + n.count; i++) {
+				found.push_back(m_indices[i]);
+			}
+		}
+		else {
+			stack[stack_size++] = n.first;
+			stack[stack_size++] = n.first + 1;
+		}
+	}
+	std::sort(found.begin(), found.end());
+	return found;
+}
+
+
+HBTK::FiniteLineBVH3D::FiniteLineBVH3D()
+{
+}
+
+HBTK::FiniteLineBVH3D::FiniteLineBVH3D(const std::vector<CartesianFiniteLine3D>& lines, int num_threads)
+{
+	build(lines, num_threads);
+}
+
+void HBTK::FiniteLineBVH3D::build(const std::vector<CartesianFiniteLine3D>& lines, int num_threads)
+{
+	m_lines = lines;
+	m_bvh.build(boxes(m_lines), num_threads);
+	return;
+}
+
+void HBTK::FiniteLineBVH3D::refit(const std::vector<CartesianFiniteLine3D>& lines)
+{
+	assert(lines.size() == m_lines.size());
+	m_lines = lines;
+	m_bvh.refit(boxes(m_lines));
+	return;
+}
+
+const std::vector<HBTK::CartesianFiniteLine3D>& HBTK::FiniteLineBVH3D::lines() const
+{
+	return m_lines;
+}
+
+int HBTK::FiniteLineBVH3D::nearest(const CartesianPoint3D & point, double & distance) const
+{
+	return m_bvh.nearest(point, [&](int i, const CartesianPoint3D & p) {
+		return point_distance(m_lines[i], p); }, distance);
+}
+
+void HBTK::FiniteLineBVH3D::nearest(const std::vector<CartesianPoint3D>& points, 
+	std::vector<int>& line_indices, std::vector<double>& distances, int num_threads) const
+{
+	line_indices.resize(points.size());
+	distances.resize(points.size());
+	parallel_for(0, (int)points.size(), [&](int i) {
+		line_indices[i] = nearest(points[i], distances[i]);
+	}, num_threads);
+	return;
+}
+
+std::vector<int> HBTK::FiniteLineBVH3D::within_radius(const CartesianPoint3D & point, double radius) const
+{
+	return m_bvh.within_radius(point, radius, [&](int i, const CartesianPoint3D & p) {
+		return point_distance(m_lines[i], p); });
+}
+
+double HBTK::FiniteLineBVH3D::point_distance(const CartesianFiniteLine3D & line, const CartesianPoint3D & point)
+{
+	CartesianVector3D v = line.vector();
+	CartesianVector3D w = point - line.start();
+	double len_sq = v.dot(v);
+	double t = (len_sq > 0 ? w.dot(v) / len_sq : 0);
+	t = (t < 0 ? 0 : (t > 1 ? 1 : t));
+	return (w - v * t).magnitude();
+}
+
+std::vector<HBTK::CartesianBoundingBox3D> HBTK::FiniteLineBVH3D::boxes(const std::vector<CartesianFiniteLine3D>& lines)
+{
+	std::vector<CartesianBoundingBox3D> line_boxes(lines.size());
+	for (int i = 0; i < (int)lines.size(); i++) {
+		line_boxes[i] = CartesianBoundingBox3D(lines[i].start(), lines[i].end());
+	}
+	return line_boxes;
+}
+
+
+HBTK::RectilinearPanelBVH::RectilinearPanelBVH()
+{
+}
+
+HBTK::RectilinearPanelBVH::RectilinearPanelBVH(const std::vector<CartesianRectilinearPanel>& panels, int num_threads)
+{
+	build(panels, num_threads);
+}
+
+void HBTK::RectilinearPanelBVH::build(const std::vector<CartesianRectilinearPanel>& panels, int num_threads)
+{
+	m_panels = panels;
+	m_bvh.build(boxes(m_panels), num_threads);
+	return;
+}
+
+void HBTK::RectilinearPanelBVH::refit(const std::vector<CartesianRectilinearPanel>& panels)
+{
+	assert(panels.size() == m_panels.size());
+	m_panels = panels;
+	m_bvh.refit(boxes(m_panels));
+	return;
+}
+
+const std::vector<HBTK::CartesianRectilinearPanel>& HBTK::RectilinearPanelBVH::panels() const
+{
+	return m_panels;
+}
+
+int HBTK::RectilinearPanelBVH::nearest(const CartesianPoint3D & point, double & distance) const
+{
+	return m_bvh.nearest(point, [&](int i, const CartesianPoint3D & p) {
+		return point_distance(m_panels[i], p); }, distance);
+}
+
+void HBTK::RectilinearPanelBVH::nearest(const std::vector<CartesianPoint3D>& points, 
+	std::vector<int>& panel_indices, std::vector<double>& distances, int num_threads) const
+{
+	panel_indices.resize(points.size());
+	distances.resize(points.size());
+	parallel_for(0, (int)points.size(), [&](int i) {
+		panel_indices[i] = nearest(points[i], distances[i]);
+	}, num_threads);
+	return;
+}
+
+std::vector<int> HBTK::RectilinearPanelBVH::within_radius(const CartesianPoint3D & point, double radius) const
+{
+	return m_bvh.within_radius(point, radius, [&](int i, const CartesianPoint3D & p) {
+		return point_distance(m_panels[i], p); });
+}
+
+int HBTK::RectilinearPanelBVH::first_intersection(const CartesianLine3D & ray, double & t) const
+{
+	return m_bvh.first_hit(ray, 0, std::numeric_limits<double>::infinity(),
+		[&](int i, const CartesianLine3D & line, double & t_hit) {
+		return line_intersection(m_panels[i], line, 0, std::numeric_limits<double>::infinity(), t_hit);
+	}, t);
+}
+
+std::vector<int> HBTK::RectilinearPanelBVH::intersections(const CartesianFiniteLine3D & line) const
+{
+	CartesianLine3D infinite_line(line.start(), line.vector());
+	return m_bvh.all_hits(infinite_line, 0, 1,
+		[&](int i, const CartesianLine3D & l, double & t_hit) {
+		return line_intersection(m_panels[i], l, 0, 1, t_hit);
+	});
+}
+
+double HBTK::RectilinearPanelBVH::point_distance(const CartesianRectilinearPanel & panel, const CartesianPoint3D & point)
+{
+	const auto & c = panel.corners;
+	return std::min(point_triangle_distance(point, c[0], c[1], c[2]),
+		point_triangle_distance(point, c[0], c[2], c[3]));
+}
+
+bool HBTK::RectilinearPanelBVH::line_intersection(const CartesianRectilinearPanel & panel, 
+	const CartesianLine3D & line, double t_min, double t_max, double & t)
+{
+	const auto & c = panel.corners;
+	double t0, t1;
+	bool hit0 = line_triangle_intersection(line, c[0], c[1], c[2], t0) && t0 >= t_min && t0 <= t_max;
+	bool hit1 = line_triangle_intersection(line, c[0], c[2], c[3], t1) && t1 >= t_min && t1 <= t_max;
+	if (hit0 && hit1) { t = std::min(t0, t1); }
+	else if (hit0) { t = t0; }
+	else if (hit1) { t = t1; }
+	return hit0 || hit1;
+}
+
+std::vector<HBTK::CartesianBoundingBox3D> HBTK::RectilinearPanelBVH::boxes(const std::vector<CartesianRectilinearPanel>& panels)
+{
+	std::vector<CartesianBoundingBox3D> panel_boxes(panels.size());
+	for (int i = 0; i < (int)panels.size(); i++) {
+		for (const auto & corner : panels[i].corners) {
+			panel_boxes[i].expand(corner);
+		}
+	}
+	return panel_boxes;
+}
@@ -0,0 +1,245 @@
+#include "BufferedTokeniser.h"
+/*////////////////////////////////////////////////////////////////////////////
+BufferedTokeniser.cpp
+
+A tokeniser over an in-memory buffer.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cctype>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include "NumberParsing.h"
+
+namespace {
+	enum char_class : unsigned char {
+		OTHER, SPACE, PUNCT, DIGIT, ALPHA
+	};
+
+	// Character classes as BasicTokeniser, by table lookup.
+	struct CharClasses {
+		char_class table[256];
+		CharClasses() {
+			for (int c = 0; c < 256; c++) {
+				if (std::isspace(c)) { table[c] = SPACE; }
+				else if (std::ispunct(c)) { table[c] = PUNCT; }
+				else if (std::isdigit(c)) { table[c] = DIGIT; }
+				else if (std::isprint(c)) { table[c] = ALPHA; }
+				else { table[c] = OTHER; }
+			}
+		}
+	};
+
+	const CharClasses char_classes;
+
+	inline char_class classify(char c) {
+		return char_classes.table[(unsigned char)c];
+	}
+}
+
+constexpr int HBTK::BufferedTokeniser::max_lookahead;
+
+HBTK::BufferedTokeniser::BufferedTokeniser(std::unique_ptr<std::istream> stream, bool parse_numbers)
+	: m_cursor(0),
+	m_stream_line_no(1),
+	m_stream_char_no(0),
+	m_first(0),
+	m_count(0),
+	m_position(0),
+	m_parse_numbers(parse_numbers)
+{
+	if (!stream) {
+		throw std::invalid_argument("HBTK::BufferedTokeniser::BufferedTokeniser: "
+			"null stream. " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	m_buffer.assign(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+}
+
+HBTK::BufferedTokeniser::BufferedTokeniser(const std::string & str, bool parse_numbers)
+	: m_buffer(str),
+	m_cursor(0),
+	m_stream_line_no(1),
+	m_stream_char_no(0),
+	m_first(0),
+	m_count(0),
+	m_position(0),
+	m_parse_numbers(parse_numbers)
+{
+}
+
+const HBTK::Token & HBTK::BufferedTokeniser::current()
+{
+	return peek(0);
+}
+
+const HBTK::Token & HBTK::BufferedTokeniser::next()
+{
+	if (m_count > 0) {
+		m_first = (m_first + 1) % max_lookahead;
+		m_count--;
+		++m_position;
+	}
+	return current();
+}
+
+const HBTK::Token & HBTK::BufferedTokeniser::peek(int ahead)
+{
+	assert(ahead >= 0);
+	assert(ahead < max_lookahead);
+	while (m_count <= ahead) {
+		parse_another_token();
+	}
+	return m_ring[(m_first + ahead) % max_lookahead];
+}
+
+bool HBTK::BufferedTokeniser::eof() const
+{
+	return m_cursor >= (int)m_buffer.size();
+}
+
+int HBTK::BufferedTokeniser::line_number()
+{
+	return peek(0).line();
+}
+
+int HBTK::BufferedTokeniser::char_number()
+{
+	return peek(0).char_idx();
+}
+
+int HBTK::BufferedTokeniser::position()
+{
+	return m_position;
+}
+
+HBTK::StringView HBTK::BufferedTokeniser::view(int ahead)
+{
+	peek(ahead);
+	return m_views[(m_first + ahead) % max_lookahead];
+}
+
+void HBTK::BufferedTokeniser::parse_another_token()
+{
+	assert(m_count < max_lookahead);
+	const int slot = (m_first + m_count) % max_lookahead;
+	Token & token = m_ring[slot];
+	const char * data = m_buffer.data();
+	const int size = (int)m_buffer.size();
+	const int start = m_cursor;
+	token.m_line = m_stream_line_no;
+	token.m_char = m_stream_char_no + 1;
+	token.m_has_number = false;
+
+	if (start >= size) {
+		// Past the end: an empty token.
+		token.m_token_type = Token::type::UNKNOWN;
+	}
+	else {
+		char c = data[m_cursor++];
+		switch (classify(c)) {
+		case SPACE:
+			token.m_token_type = Token::type::WHITE_SPACE;
+			break;
+		case PUNCT:
+			token.m_token_type = Token::type::PUNCTUATION;
+			if (m_parse_numbers && c == '.' && m_cursor < size && classify(data[m_cursor]) == DIGIT) {
+				parse_number(token, start);
+			}
+			break;
+		case DIGIT:
+			token.m_token_type = Token::type::INTEGER;
+			while (m_cursor < size && classify(data[m_cursor]) == DIGIT) { m_cursor++; }
+			if (m_parse_numbers) { parse_number(token, start); }
+			break;
+		case ALPHA:
+			token.m_token_type = Token::type::WORD;
+			while (m_cursor < size) {
+				char_class cls = classify(data[m_cursor]);
+				if (cls != ALPHA && cls != DIGIT && data[m_cursor] != '_') { break; }
+				m_cursor++;
+			}
+			break;
+		default:
+			token.m_token_type = Token::type::UNKNOWN;
+		}
+		if (c == '\n') {
+			m_stream_line_no++;
+			m_stream_char_no = 0;
+		}
+		else {
+			m_stream_char_no += m_cursor - start;
+		}
+	}
+	token.m_value.assign(data + start, m_cursor - start);
+	m_views[slot] = StringView(data + start, m_cursor - start);
+	m_count++;
+	return;
+}
+
+void HBTK::BufferedTokeniser::parse_number(Token & token, int start)
+{
+	const char * data = m_buffer.data();
+	const int size = (int)m_buffer.size();
+	// m_cursor is after the leading digits, or after a '.' that is followed by a digit.
+	bool is_float = data[m_cursor - 1] == '.';
+	if (!is_float && m_cursor < size && data[m_cursor] == '.') {
+		is_float = true;
+		m_cursor++;
+	}
+	if (is_float) {
+		while (m_cursor < size && classify(data[m_cursor]) == DIGIT) { m_cursor++; }
+	}
+	// Exponent, only if digits follow.
+	if (m_cursor < size && (data[m_cursor] == 'e' || data[m_cursor] == 'E')) {
+		int exp = m_cursor + 1;
+		if (exp < size && (data[exp] == '+' || data[exp] == '-')) { exp++; }
+		if (exp < size && classify(data[exp]) == DIGIT) {
+			is_float = true;
+			m_cursor = exp;
+			while (m_cursor < size && classify(data[m_cursor]) == DIGIT) { m_cursor++; }
+		}
+	}
+
+	token.m_has_number = true;
+	if (is_float) {
+		token.m_token_type = Token::type::FLOAT;
+		HBTK::parse_number(data + start, data + m_cursor, token.m_number);
+		token.m_integer = Token::saturated_integer(token.m_number);
+	}
+	else if (m_cursor - start <= 18) {
+		long long value = 0;
+		for (int i = start; i < m_cursor; i++) { value = value * 10 + (data[i] - '0'); }
+		token.m_integer = value;
+		token.m_number = (double)value;
+	}
+	else {
+		HBTK::parse_number(data + start, data + m_cursor, token.m_number);
+		if (HBTK::parse_number(data + start, data + m_cursor, token.m_integer) == data + start) {
+			// Too large for a long long.
+			token.m_integer = std::numeric_limits<long long>::max();
+		}
+	}
+	return;
+}
@@ -0,0 +1,248 @@
+#include "ByteSource.h"
+/*////////////////////////////////////////////////////////////////////////////
+ByteSource.cpp
+
+Sources of bytes for the parsers: files, memory and streams.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+HBTK::MemoryStreamBuffer::MemoryStreamBuffer(const char * data, size_t size)
+{
+	char * begin = const_cast<char*>(data);	// Never written through.
+	setg(begin, begin, begin + size);
+}
+
+HBTK::MemoryStreamBuffer::pos_type HBTK::MemoryStreamBuffer::seekoff(
+	off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+	if (!(which & std::ios_base::in)) { return pos_type(off_type(-1)); }
+	off_type base;
+	if (dir == std::ios_base::beg) { base = 0; }
+	else if (dir == std::ios_base::cur) { base = gptr() - eback(); }
+	else { base = egptr() - eback(); }
+	off_type target = base + off;
+	if (target < 0 || target > egptr() - eback()) { return pos_type(off_type(-1)); }
+	setg(eback(), eback() + target, egptr());
+	return pos_type(target);
+}
+
+HBTK::MemoryStreamBuffer::pos_type HBTK::MemoryStreamBuffer::seekpos(
+	pos_type pos, std::ios_base::openmode which)
+{
+	return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+std::streamsize HBTK::MemoryStreamBuffer::showmanyc()
+{
+	std::streamsize remaining = egptr() - gptr();
+	return remaining > 0 ? remaining : -1;
+}
+
+std::streamsize HBTK::MemoryStreamBuffer::xsgetn(char * out, std::streamsize count)
+{
+	std::streamsize available = egptr() - gptr();
+	if (count > available) { count = available; }
+	memcpy(out, gptr(), (size_t)count);
+	setg(eback(), gptr() + count, egptr());	// gbump takes an int.
+	return count;
+}
+
+HBTK::ByteSource HBTK::ByteSource::from_file(const std::string & path)
+{
+	ByteSource source;
+#ifndef _WIN32
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		throw std::invalid_argument("HBTK::ByteSource::from_file: "
+			"Could not open " + path + ". " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	struct stat info;
+	if (fstat(file, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+		void * mapping = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapping != MAP_FAILED) {
+			close(file);
+			source.m_mapping = mapping;
+			source.m_mapping_size = (size_t)info.st_size;
+			source.view((const char*)mapping, (size_t)info.st_size);
+			return source;
+		}
+	}
+	close(file);
+#endif
+	// Fall back to reading the whole file.
+	std::ifstream file_stream(path, std::ios::binary);
+	if (!file_stream) {
+		throw std::invalid_argument("HBTK::ByteSource::from_file: "
+			"Could not open " + path + ". " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	std::ostringstream contents;
+	contents << file_stream.rdbuf();
+	return from_string(contents.str());
+}
+
+HBTK::ByteSource HBTK::ByteSource::from_memory(const char * data, size_t size)
+{
+	assert(data != nullptr || size == 0);
+	ByteSource source;
+	source.view(data, size);
+	return source;
+}
+
+HBTK::ByteSource HBTK::ByteSource::from_string(std::string contents)
+{
+	ByteSource source;
+	source.m_contents = std::move(contents);
+	source.view(source.m_contents.data(), source.m_contents.size());
+	return source;
+}
+
+HBTK::ByteSource HBTK::ByteSource::from_stream(std::istream & stream)
+{
+	ByteSource source;
+	source.m_stream = &stream;
+	return source;
+}
+
+HBTK::ByteSource HBTK::ByteSource::from_stream(std::unique_ptr<std::istream> stream)
+{
+	assert(stream);
+	ByteSource source;
+	source.m_owned_stream = std::move(stream);
+	source.m_stream = source.m_owned_stream.get();
+	return source;
+}
+
+HBTK::ByteSource::ByteSource()
+	: m_stream(nullptr),
+	m_data(nullptr),
+	m_size(0),
+	m_contiguous(false),
+	m_mapping(nullptr),
+	m_mapping_size(0)
+{
+}
+
+HBTK::ByteSource::ByteSource(ByteSource && other)
+	: ByteSource()
+{
+	*this = std::move(other);
+}
+
+HBTK::ByteSource & HBTK::ByteSource::operator=(ByteSource && other)
+{
+	if (this == &other) { return *this; }
+	release();
+	const bool owns_contents = other.m_contiguous && other.m_data == other.m_contents.data();
+	// A part read source carries on from where it was.
+	std::istream::pos_type position = 0;
+	std::ios_base::iostate state = std::ios_base::goodbit;
+	if (other.m_contiguous) {
+		state = other.m_stream->rdstate();
+		other.m_stream->clear();
+		position = other.m_stream->tellg();
+	}
+	m_owned_stream = std::move(other.m_owned_stream);
+	m_contents = std::move(other.m_contents);
+	m_mapping = other.m_mapping;
+	m_mapping_size = other.m_mapping_size;
+	other.m_mapping = nullptr;
+	other.m_mapping_size = 0;
+	if (other.m_contiguous) {
+		// Moving a short string may move its characters, so view afresh.
+		const char * data = owns_contents ? m_contents.data() : other.m_data;
+		view(data, other.m_size);
+		m_stream->seekg(position);
+		m_stream->setstate(state);
+	}
+	else {
+		m_stream = other.m_stream;
+	}
+	other.release();
+	return *this;
+}
+
+HBTK::ByteSource::~ByteSource()
+{
+	release();
+}
+
+std::istream & HBTK::ByteSource::stream()
+{
+	assert(m_stream != nullptr);
+	return *m_stream;
+}
+
+bool HBTK::ByteSource::contiguous() const
+{
+	return m_contiguous;
+}
+
+const char * HBTK::ByteSource::data() const
+{
+	assert(m_contiguous);
+	return m_data;
+}
+
+size_t HBTK::ByteSource::size() const
+{
+	assert(m_contiguous);
+	return m_size;
+}
+
+void HBTK::ByteSource::release()
+{
+	m_owned_stream.reset();
+	m_buffer.reset();
+	m_contents.clear();
+	m_stream = nullptr;
+	m_data = nullptr;
+	m_size = 0;
+	m_contiguous = false;
+#ifndef _WIN32
+	if (m_mapping != nullptr) { munmap(m_mapping, m_mapping_size); }
+#endif
+	m_mapping = nullptr;
+	m_mapping_size = 0;
+}
+
+void HBTK::ByteSource::view(const char * data, size_t size)
+{
+	m_data = data;
+	m_size = size;
+	m_contiguous = true;
+	m_buffer.reset(new MemoryStreamBuffer(data, size));
+	m_owned_stream.reset(new std::istream(m_buffer.get()));
+	m_stream = m_owned_stream.get();
+}
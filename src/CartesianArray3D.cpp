@@ -0,0 +1,687 @@
+#include "CartesianArray3D.h"
+/*////////////////////////////////////////////////////////////////////////////
+CartesianArray3D.cpp
+
+Structure-of-arrays containers for many points and vectors in 3D Cartesian
+space, with bulk geometric operations.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+
+#include "CartesianPlane.h"
+
+namespace {
+	// Calls kernel with a std::integral_constant<int, stride> for the common
+	// strides (1 for SoA, 3 for a vector of CartesianPoint3D) so that the loop
+	// indexing is known at compile time and the loops vectorise. Any other
+	// stride gets std::integral_constant<int, 0> and must use the runtime value.
+	template<typename TKernel>
+	void dispatch_stride(int stride, TKernel && kernel)
+	{
+		if (stride == 1) { kernel(std::integral_constant<int, 1>()); }
+		else if (stride == 3) { kernel(std::integral_constant<int, 3>()); }
+		else { kernel(std::integral_constant<int, 0>()); }
+		return;
+	}
+
+	// Row major rotation matrix from Rodrigues' formula.
+	std::array<std::array<double, 3>, 3> rotation_matrix(
+		HBTK::CartesianVector3D axis, double angle)
+	{
+		axis.normalise();
+		double c = cos(angle), s = sin(angle), t = 1 - c;
+		double kx = axis.x(), ky = axis.y(), kz = axis.z();
+		return std::array<std::array<double, 3>, 3>({
+			std::array<double, 3>({ c + t * kx * kx, t * kx * ky - s * kz, t * kx * kz + s * ky }),
+			std::array<double, 3>({ t * ky * kx + s * kz, c + t * ky * ky, t * ky * kz - s * kx }),
+			std::array<double, 3>({ t * kz * kx - s * ky, t * kz * ky + s * kx, c + t * kz * kz }) });
+	}
+}
+
+HBTK::PointArrayView3D::PointArrayView3D(double * x, double * y, double * z, int size, int stride)
+	: m_x(x), m_y(y), m_z(z),
+	m_size(size),
+	m_stride(stride)
+{
+	assert(size >= 0);
+	assert(stride > 0);
+}
+
+HBTK::PointArrayView3D::PointArrayView3D(std::vector<CartesianPoint3D>& points)
+	: m_x(nullptr), m_y(nullptr), m_z(nullptr),
+	m_size((int)points.size()),
+	m_stride(3)
+{
+	static_assert(sizeof(CartesianPoint3D) == 3 * sizeof(double),
+		"CartesianPoint3D must be three packed doubles to be viewed in place.");
+	if (!points.empty()) {
+		m_x = &points[0].x();
+		m_y = &points[0].y();
+		m_z = &points[0].z();
+	}
+}
+
+int HBTK::PointArrayView3D::size() const
+{
+	return m_size;
+}
+
+int HBTK::PointArrayView3D::stride() const
+{
+	return m_stride;
+}
+
+double * HBTK::PointArrayView3D::x_data() const
+{
+	return m_x;
+}
+
+double * HBTK::PointArrayView3D::y_data() const
+{
+	return m_y;
+}
+
+double * HBTK::PointArrayView3D::z_data() const
+{
+	return m_z;
+}
+
+HBTK::CartesianPoint3D HBTK::PointArrayView3D::operator[](int index) const
+{
+	assert(index >= 0 && index < m_size);
+	int i = index * m_stride;
+	return CartesianPoint3D({ m_x[i], m_y[i], m_z[i] });
+}
+
+void HBTK::PointArrayView3D::set(int index, const CartesianPoint3D & point) const
+{
+	assert(index >= 0 && index < m_size);
+	int i = index * m_stride;
+	m_x[i] = point.x();
+	m_y[i] = point.y();
+	m_z[i] = point.z();
+	return;
+}
+
+void HBTK::PointArrayView3D::translate(const CartesianVector3D & translation) const
+{
+	const double dx = translation.x(), dy = translation.y(), dz = translation.z();
+	double * x = m_x, * y = m_y, * z = m_z;
+	const int n = m_size, rt_stride = m_stride;
+	dispatch_stride(m_stride, [&](auto ct_stride) {
+		const int s = decltype(ct_stride)::value ? decltype(ct_stride)::value : rt_stride;
+		for (int i = 0; i < n; i++) {
+			x[i * s] += dx;
+			y[i * s] += dy;
+			z[i * s] += dz;
+		}
+	});
+	return;
+}
+
+void HBTK::PointArrayView3D::rotate(const CartesianVector3D & axis, double angle, 
+	const CartesianPoint3D & centre) const
+{
+	transform(rotation_matrix(axis, angle), centre);
+	return;
+}
+
+void HBTK::PointArrayView3D::transform(const std::array<std::array<double, 3>, 3>& matrix, 
+	const CartesianPoint3D & centre) const
+{
+	const double m00 = matrix[0][0], m01 = matrix[0][1], m02 = matrix[0][2];
+	const double m10 = matrix[1][0], m11 = matrix[1][1], m12 = matrix[1][2];
+	const double m20 = matrix[2][0], m21 = matrix[2][1], m22 = matrix[2][2];
+	const double cx = centre.x(), cy = centre.y(), cz = centre.z();
+	double * x = m_x, * y = m_y, * z = m_z;
+	const int n = m_size, rt_stride = m_stride;
+	dispatch_stride(m_stride, [&](auto ct_stride) {
+		const int s = decltype(ct_stride)::value ? decltype(ct_stride)::value : rt_stride;
+		for (int i = 0; i < n; i++) {
+			double px = x[i * s] - cx, py = y[i * s] - cy, pz = z[i * s] - cz;
+			x[i * s] = m00 * px + m01 * py + m02 * pz + cx;
+			y[i * s] = m10 * px + m11 * py + m12 * pz + cy;
+			z[i * s] = m20 * px + m21 * py + m22 * pz + cz;
+		}
+	});
+	return;
+}
+
+std::vector<double> HBTK::PointArrayView3D::distance(const CartesianPlane & plane) const
+{
+	std::vector<double> result;
+	distance(plane, result);
+	return result;
+}
+
+void HBTK::PointArrayView3D::distance(const CartesianPlane & plane, std::vector<double>& result) const
+{
+	const CartesianVector3D normal = plane.normal();
+	const CartesianPoint3D & origin = plane.origin();
+	const double nx = normal.x(), ny = normal.y(), nz = normal.z();
+	const double ox = origin.x(), oy = origin.y(), oz = origin.z();
+	result.resize(m_size);
+	double * res = result.data();
+	const double * x = m_x, * y = m_y, * z = m_z;
+	const int n = m_size, rt_stride = m_stride;
+	dispatch_stride(m_stride, [&](auto ct_stride) {
+		const int s = decltype(ct_stride)::value ? decltype(ct_stride)::value : rt_stride;
+		for (int i = 0; i < n; i++) {
+			res[i] = nx * (x[i * s] - ox) + ny * (y[i * s] - oy) + nz * (z[i * s] - oz);
+		}
+	});
+	return;
+}
+
+void HBTK::PointArrayView3D::projection(const CartesianPlane & plane, 
+	std::vector<double>& local_x, std::vector<double>& local_y) const
+{
+	// The plane's axes are orthonormal, so the local coordinates are the
+	// components of (point - origin) along each axis.
+	const CartesianPoint3D origin = plane.evaluate(CartesianPoint2D({ 0, 0 }));
+	const CartesianVector3D ex = plane.evaluate(CartesianPoint2D({ 1, 0 })) - origin;
+	const CartesianVector3D ey = plane.evaluate(CartesianPoint2D({ 0, 1 })) - origin;
+	const double exx = ex.x(), exy = ex.y(), exz = ex.z();
+	const double eyx = ey.x(), eyy = ey.y(), eyz = ey.z();
+	const double ox = origin.x(), oy = origin.y(), oz = origin.z();
+	local_x.resize(m_size);
+	local_y.resize(m_size);
+	double * lx = local_x.data(), * ly = local_y.data();
+	const double * x = m_x, * y = m_y, * z = m_z;
+	const int n = m_size, rt_stride = m_stride;
+	dispatch_stride(m_stride, [&](auto ct_stride) {
+		const int s = decltype(ct_stride)::value ? decltype(ct_stride)::value : rt_stride;
+		for (int i = 0; i < n; i++) {
+			double px = x[i * s] - ox, py = y[i * s] - oy, pz = z[i * s] - oz;
+			lx[i] = exx * px + exy * py + exz * pz;
+			ly[i] = eyx * px + eyy * py + eyz * pz;
+		}
+	});
+	return;
+}
+
+std::vector<HBTK::CartesianPoint3D> HBTK::PointArrayView3D::as_points() const
+{
+	std::vector<CartesianPoint3D> points(m_size);
+	for (int i = 0; i < m_size; i++) {
+		points[i] = operator[](i);
+	}
+	return points;
+}
+
+
+HBTK::PointArray3D::PointArray3D()
+{
+}
+
+HBTK::PointArray3D::PointArray3D(int size)
+	: m_x(size), m_y(size), m_z(size)
+{
+}
+
+HBTK::PointArray3D::PointArray3D(const std::vector<CartesianPoint3D>& points)
+	: m_x(points.size()), m_y(points.size()), m_z(points.size())
+{
+	for (int i = 0; i < (int)points.size(); i++) {
+		m_x[i] = points[i].x();
+		m_y[i] = points[i].y();
+		m_z[i] = points[i].z();
+	}
+}
+
+HBTK::PointArray3D::PointArray3D(const PointArrayView3D & points)
+	: m_x(points.size()), m_y(points.size()), m_z(points.size())
+{
+	const int s = points.stride();
+	for (int i = 0; i < points.size(); i++) {
+		m_x[i] = points.x_data()[i * s];
+		m_y[i] = points.y_data()[i * s];
+		m_z[i] = points.z_data()[i * s];
+	}
+}
+
+int HBTK::PointArray3D::size() const
+{
+	return (int)m_x.size();
+}
+
+void HBTK::PointArray3D::resize(int size)
+{
+	m_x.resize(size);
+	m_y.resize(size);
+	m_z.resize(size);
+	return;
+}
+
+void HBTK::PointArray3D::reserve(int size)
+{
+	m_x.reserve(size);
+	m_y.reserve(size);
+	m_z.reserve(size);
+	return;
+}
+
+void HBTK::PointArray3D::push_back(const CartesianPoint3D & point)
+{
+	m_x.push_back(point.x());
+	m_y.push_back(point.y());
+	m_z.push_back(point.z());
+	return;
+}
+
+HBTK::CartesianPoint3D HBTK::PointArray3D::operator[](int index) const
+{
+	return CartesianPoint3D({ m_x[index], m_y[index], m_z[index] });
+}
+
+void HBTK::PointArray3D::set(int index, const CartesianPoint3D & point)
+{
+	m_x[index] = point.x();
+	m_y[index] = point.y();
+	m_z[index] = point.z();
+	return;
+}
+
+std::vector<double>& HBTK::PointArray3D::x()
+{
+	return m_x;
+}
+
+const std::vector<double>& HBTK::PointArray3D::x() const
+{
+	return m_x;
+}
+
+std::vector<double>& HBTK::PointArray3D::y()
+{
+	return m_y;
+}
+
+const std::vector<double>& HBTK::PointArray3D::y() const
+{
+	return m_y;
+}
+
+std::vector<double>& HBTK::PointArray3D::z()
+{
+	return m_z;
+}
+
+const std::vector<double>& HBTK::PointArray3D::z() const
+{
+	return m_z;
+}
+
+HBTK::PointArrayView3D HBTK::PointArray3D::view()
+{
+	return PointArrayView3D(m_x.data(), m_y.data(), m_z.data(), size(), 1);
+}
+
+HBTK::PointArrayView3D HBTK::PointArray3D::const_view() const
+{
+	// The kernels used through this view do not write to the points.
+	return PointArrayView3D(const_cast<double*>(m_x.data()), const_cast<double*>(m_y.data()),
+		const_cast<double*>(m_z.data()), size(), 1);
+}
+
+HBTK::VectorArray3D HBTK::PointArray3D::operator-(const PointArray3D & other) const
+{
+	assert(size() == other.size());
+	const int n = size();
+	VectorArray3D result(n);
+	double * rx = result.x().data(), * ry = result.y().data(), * rz = result.z().data();
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * bx = other.m_x.data(), * by = other.m_y.data(), * bz = other.m_z.data();
+	for (int i = 0; i < n; i++) {
+		rx[i] = ax[i] - bx[i];
+		ry[i] = ay[i] - by[i];
+		rz[i] = az[i] - bz[i];
+	}
+	return result;
+}
+
+HBTK::VectorArray3D HBTK::PointArray3D::operator-(const CartesianPoint3D & point) const
+{
+	const int n = size();
+	const double px = point.x(), py = point.y(), pz = point.z();
+	VectorArray3D result(n);
+	double * rx = result.x().data(), * ry = result.y().data(), * rz = result.z().data();
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	for (int i = 0; i < n; i++) {
+		rx[i] = ax[i] - px;
+		ry[i] = ay[i] - py;
+		rz[i] = az[i] - pz;
+	}
+	return result;
+}
+
+void HBTK::PointArray3D::translate(const CartesianVector3D & translation)
+{
+	view().translate(translation);
+	return;
+}
+
+void HBTK::PointArray3D::translate(const VectorArray3D & translation)
+{
+	assert(size() == translation.size());
+	const int n = size();
+	double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * tx = translation.x().data(), * ty = translation.y().data(), 
+		* tz = translation.z().data();
+	for (int i = 0; i < n; i++) {
+		ax[i] += tx[i];
+		ay[i] += ty[i];
+		az[i] += tz[i];
+	}
+	return;
+}
+
+void HBTK::PointArray3D::rotate(const CartesianVector3D & axis, double angle, 
+	const CartesianPoint3D & centre)
+{
+	view().rotate(axis, angle, centre);
+	return;
+}
+
+std::vector<double> HBTK::PointArray3D::distance(const CartesianPlane & plane) const
+{
+	return const_view().distance(plane);
+}
+
+void HBTK::PointArray3D::projection(const CartesianPlane & plane, 
+	std::vector<double>& local_x, std::vector<double>& local_y) const
+{
+	const_view().projection(plane, local_x, local_y);
+	return;
+}
+
+std::vector<HBTK::CartesianPoint3D> HBTK::PointArray3D::as_points() const
+{
+	std::vector<CartesianPoint3D> points(size());
+	for (int i = 0; i < size(); i++) {
+		points[i] = operator[](i);
+	}
+	return points;
+}
+
+
+HBTK::VectorArray3D::VectorArray3D()
+{
+}
+
+HBTK::VectorArray3D::VectorArray3D(int size)
+	: m_x(size), m_y(size), m_z(size)
+{
+}
+
+HBTK::VectorArray3D::VectorArray3D(const std::vector<CartesianVector3D>& vectors)
+	: m_x(vectors.size()), m_y(vectors.size()), m_z(vectors.size())
+{
+	for (int i = 0; i < (int)vectors.size(); i++) {
+		m_x[i] = vectors[i].x();
+		m_y[i] = vectors[i].y();
+		m_z[i] = vectors[i].z();
+	}
+}
+
+int HBTK::VectorArray3D::size() const
+{
+	return (int)m_x.size();
+}
+
+void HBTK::VectorArray3D::resize(int size)
+{
+	m_x.resize(size);
+	m_y.resize(size);
+	m_z.resize(size);
+	return;
+}
+
+void HBTK::VectorArray3D::reserve(int size)
+{
+	m_x.reserve(size);
+	m_y.reserve(size);
+	m_z.reserve(size);
+	return;
+}
+
+void HBTK::VectorArray3D::push_back(const CartesianVector3D & vector)
+{
+	m_x.push_back(vector.x());
+	m_y.push_back(vector.y());
+	m_z.push_back(vector.z());
+	return;
+}
+
+HBTK::CartesianVector3D HBTK::VectorArray3D::operator[](int index) const
+{
+	return CartesianVector3D({ m_x[index], m_y[index], m_z[index] });
+}
+
+void HBTK::VectorArray3D::set(int index, const CartesianVector3D & vector)
+{
+	m_x[index] = vector.x();
+	m_y[index] = vector.y();
+	m_z[index] = vector.z();
+	return;
+}
+
+std::vector<double>& HBTK::VectorArray3D::x()
+{
+	return m_x;
+}
+
+const std::vector<double>& HBTK::VectorArray3D::x() const
+{
+	return m_x;
+}
+
+std::vector<double>& HBTK::VectorArray3D::y()
+{
+	return m_y;
+}
+
+const std::vector<double>& HBTK::VectorArray3D::y() const
+{
+	return m_y;
+}
+
+std::vector<double>& HBTK::VectorArray3D::z()
+{
+	return m_z;
+}
+
+const std::vector<double>& HBTK::VectorArray3D::z() const
+{
+	return m_z;
+}
+
+HBTK::VectorArray3D & HBTK::VectorArray3D::operator+=(const VectorArray3D & other)
+{
+	assert(size() == other.size());
+	const int n = size();
+	double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * bx = other.m_x.data(), * by = other.m_y.data(), * bz = other.m_z.data();
+	for (int i = 0; i < n; i++) {
+		ax[i] += bx[i];
+		ay[i] += by[i];
+		az[i] += bz[i];
+	}
+	return *this;
+}
+
+HBTK::VectorArray3D & HBTK::VectorArray3D::operator-=(const VectorArray3D & other)
+{
+	assert(size() == other.size());
+	const int n = size();
+	double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * bx = other.m_x.data(), * by = other.m_y.data(), * bz = other.m_z.data();
+	for (int i = 0; i < n; i++) {
+		ax[i] -= bx[i];
+		ay[i] -= by[i];
+		az[i] -= bz[i];
+	}
+	return *this;
+}
+
+HBTK::VectorArray3D & HBTK::VectorArray3D::operator*=(double multiplyer)
+{
+	const int n = size();
+	double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	for (int i = 0; i < n; i++) {
+		ax[i] *= multiplyer;
+		ay[i] *= multiplyer;
+		az[i] *= multiplyer;
+	}
+	return *this;
+}
+
+HBTK::VectorArray3D & HBTK::VectorArray3D::operator*=(const std::vector<double>& multiplyers)
+{
+	assert(size() == (int)multiplyers.size());
+	const int n = size();
+	double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * m = multiplyers.data();
+	for (int i = 0; i < n; i++) {
+		ax[i] *= m[i];
+		ay[i] *= m[i];
+		az[i] *= m[i];
+	}
+	return *this;
+}
+
+std::vector<double> HBTK::VectorArray3D::magnitude() const
+{
+	std::vector<double> result;
+	magnitude(result);
+	return result;
+}
+
+void HBTK::VectorArray3D::magnitude(std::vector<double>& result) const
+{
+	const int n = size();
+	result.resize(n);
+	double * res = result.data();
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	for (int i = 0; i < n; i++) {
+		res[i] = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+	}
+	return;
+}
+
+void HBTK::VectorArray3D::normalise()
+{
+	const int n = size();
+	double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	for (int i = 0; i < n; i++) {
+		double inv_len = 1. / std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+		ax[i] *= inv_len;
+		ay[i] *= inv_len;
+		az[i] *= inv_len;
+	}
+	return;
+}
+
+std::vector<double> HBTK::VectorArray3D::dot(const VectorArray3D & other) const
+{
+	std::vector<double> result;
+	dot(other, result);
+	return result;
+}
+
+void HBTK::VectorArray3D::dot(const VectorArray3D & other, std::vector<double>& result) const
+{
+	assert(size() == other.size());
+	const int n = size();
+	result.resize(n);
+	double * res = result.data();
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * bx = other.m_x.data(), * by = other.m_y.data(), * bz = other.m_z.data();
+	for (int i = 0; i < n; i++) {
+		res[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+	}
+	return;
+}
+
+std::vector<double> HBTK::VectorArray3D::dot(const CartesianVector3D & other) const
+{
+	const int n = size();
+	const double bx = other.x(), by = other.y(), bz = other.z();
+	std::vector<double> result(n);
+	double * res = result.data();
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	for (int i = 0; i < n; i++) {
+		res[i] = ax[i] * bx + ay[i] * by + az[i] * bz;
+	}
+	return result;
+}
+
+HBTK::VectorArray3D HBTK::VectorArray3D::cross(const VectorArray3D & other) const
+{
+	VectorArray3D result;
+	cross(other, result);
+	return result;
+}
+
+void HBTK::VectorArray3D::cross(const VectorArray3D & other, VectorArray3D & result) const
+{
+	assert(size() == other.size());
+	assert(&result != this && &result != &other);
+	const int n = size();
+	result.resize(n);
+	double * rx = result.m_x.data(), * ry = result.m_y.data(), * rz = result.m_z.data();
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	const double * bx = other.m_x.data(), * by = other.m_y.data(), * bz = other.m_z.data();
+	for (int i = 0; i < n; i++) {
+		rx[i] = ay[i] * bz[i] - az[i] * by[i];
+		ry[i] = az[i] * bx[i] - ax[i] * bz[i];
+		rz[i] = ax[i] * by[i] - ay[i] * bx[i];
+	}
+	return;
+}
+
+HBTK::VectorArray3D HBTK::VectorArray3D::cross(const CartesianVector3D & other) const
+{
+	const int n = size();
+	const double bx = other.x(), by = other.y(), bz = other.z();
+	VectorArray3D result(n);
+	double * rx = result.m_x.data(), * ry = result.m_y.data(), * rz = result.m_z.data();
+	const double * ax = m_x.data(), * ay = m_y.data(), * az = m_z.data();
+	for (int i = 0; i < n; i++) {
+		rx[i] = ay[i] * bz - az[i] * by;
+		ry[i] = az[i] * bx - ax[i] * bz;
+		rz[i] = ax[i] * by - ay[i] * bx;
+	}
+	return result;
+}
+
+std::vector<HBTK::CartesianVector3D> HBTK::VectorArray3D::as_vectors() const
+{
+	std::vector<CartesianVector3D> vectors(size());
+	for (int i = 0; i < size(); i++) {
+		vectors[i] = operator[](i);
+	}
+	return vectors;
+}
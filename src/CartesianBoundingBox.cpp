@@ -0,0 +1,183 @@
+#include "CartesianBoundingBox.h"
+/*////////////////////////////////////////////////////////////////////////////
+CartesianBoundingBox.cpp
+
+Axis aligned bounding boxes in Cartesian space.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "CartesianLine.h"
+
+HBTK::CartesianBoundingBox3D::CartesianBoundingBox3D()
+	: m_min({ std::numeric_limits<double>::infinity(),
+		std::numeric_limits<double>::infinity(), 
+		std::numeric_limits<double>::infinity() }),
+	m_max({ -std::numeric_limits<double>::infinity(),
+		-std::numeric_limits<double>::infinity(),
+		-std::numeric_limits<double>::infinity() })
+{
+}
+
+HBTK::CartesianBoundingBox3D::CartesianBoundingBox3D(const CartesianPoint3D & corner_1, 
+	const CartesianPoint3D & corner_2)
+	: CartesianBoundingBox3D()
+{
+	expand(corner_1);
+	expand(corner_2);
+}
+
+HBTK::CartesianPoint3D & HBTK::CartesianBoundingBox3D::lower_corner()
+{
+	return m_min;
+}
+
+const HBTK::CartesianPoint3D & HBTK::CartesianBoundingBox3D::lower_corner() const
+{
+	return m_min;
+}
+
+HBTK::CartesianPoint3D & HBTK::CartesianBoundingBox3D::upper_corner()
+{
+	return m_max;
+}
+
+const HBTK::CartesianPoint3D & HBTK::CartesianBoundingBox3D::upper_corner() const
+{
+	return m_max;
+}
+
+bool HBTK::CartesianBoundingBox3D::empty() const
+{
+	return m_min.x() > m_max.x() || m_min.y() > m_max.y() || m_min.z() > m_max.z();
+}
+
+HBTK::CartesianPoint3D HBTK::CartesianBoundingBox3D::centre() const
+{
+	return CartesianPoint3D({
+		0.5 * (m_min.x() + m_max.x()),
+		0.5 * (m_min.y() + m_max.y()),
+		0.5 * (m_min.z() + m_max.z()) });
+}
+
+double HBTK::CartesianBoundingBox3D::surface_area() const
+{
+	if (empty()) { return 0; }
+	double dx = m_max.x() - m_min.x();
+	double dy = m_max.y() - m_min.y();
+	double dz = m_max.z() - m_min.z();
+	return 2 * (dx * dy + dy * dz + dz * dx);
+}
+
+int HBTK::CartesianBoundingBox3D::longest_axis() const
+{
+	double dx = m_max.x() - m_min.x();
+	double dy = m_max.y() - m_min.y();
+	double dz = m_max.z() - m_min.z();
+	if (dx >= dy && dx >= dz) { return 0; }
+	return (dy >= dz ? 1 : 2);
+}
+
+void HBTK::CartesianBoundingBox3D::expand(const CartesianPoint3D & point)
+{
+	for (int i = 0; i < 3; i++) {
+		m_min.as_array()[i] = std::min(m_min.as_array()[i], point.as_array()[i]);
+		m_max.as_array()[i] = std::max(m_max.as_array()[i], point.as_array()[i]);
+	}
+	return;
+}
+
+void HBTK::CartesianBoundingBox3D::expand(const CartesianBoundingBox3D & other)
+{
+	for (int i = 0; i < 3; i++) {
+		m_min.as_array()[i] = std::min(m_min.as_array()[i], other.m_min.as_array()[i]);
+		m_max.as_array()[i] = std::max(m_max.as_array()[i], other.m_max.as_array()[i]);
+	}
+	return;
+}
+
+void HBTK::CartesianBoundingBox3D::pad(double distance)
+{
+	for (int i = 0; i < 3; i++) {
+		m_min.as_array()[i] -= distance;
+		m_max.as_array()[i] += distance;
+	}
+	return;
+}
+
+bool HBTK::CartesianBoundingBox3D::contains(const CartesianPoint3D & point) const
+{
+	for (int i = 0; i < 3; i++) {
+		if (point.as_array()[i] < m_min.as_array()[i] || point.as_array()[i] > m_max.as_array()[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool HBTK::CartesianBoundingBox3D::intersects(const CartesianBoundingBox3D & other) const
+{
+	for (int i = 0; i < 3; i++) {
+		if (other.m_max.as_array()[i] < m_min.as_array()[i] 
+			|| other.m_min.as_array()[i] > m_max.as_array()[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+double HBTK::CartesianBoundingBox3D::distance(const CartesianPoint3D & point) const
+{
+	return sqrt(distance_squared(point));
+}
+
+double HBTK::CartesianBoundingBox3D::distance_squared(const CartesianPoint3D & point) const
+{
+	double dist_sq = 0;
+	for (int i = 0; i < 3; i++) {
+		double p = point.as_array()[i];
+		double d = std::max(std::max(m_min.as_array()[i] - p, p - m_max.as_array()[i]), 0.);
+		dist_sq += d * d;
+	}
+	return dist_sq;
+}
+
+bool HBTK::CartesianBoundingBox3D::intersection(const CartesianLine3D & line, 
+	double t_min, double t_max, double & t_entry) const
+{
+	// Slab test. Division by a zero direction component gives +-inf, which
+	// gives the right answer unless the origin lies exactly on a slab face.
+	for (int i = 0; i < 3; i++) {
+		double inv_d = 1. / line.direction().as_array()[i];
+		double t0 = (m_min.as_array()[i] - line.origin().as_array()[i]) * inv_d;
+		double t1 = (m_max.as_array()[i] - line.origin().as_array()[i]) * inv_d;
+		if (inv_d < 0) { std::swap(t0, t1); }
+		t_min = (t0 > t_min ? t0 : t_min);
+		t_max = (t1 < t_max ? t1 : t_max);
+		if (t_max < t_min) { return false; }
+	}
+	t_entry = t_min;
+	return true;
+}
@@ -28,6 +28,39 @@ SOFTWARE.
 #include <cmath>
 
 #include "Constants.h"
+#include "Parallel.h"
+
+namespace {
+	// Map the polar grid with the batched transform 
+	// func(n, zeta_real, zeta_imag, z_real, z_imag), one row at a time.
+	template<typename TFunc>
+	HBTK::StructuredMeshBlock2D map_polar_grid(std::complex<double> centre, 
+		const std::vector<double> & radii, const std::vector<double> & angles, 
+		int num_threads, TFunc && func)
+	{
+		const int ni = (int)radii.size(), nj = (int)angles.size();
+		HBTK::StructuredMeshBlock2D mesh;
+		mesh.set_extent({ ni, nj });
+		std::vector<double> cos_angles(nj), sin_angles(nj);
+		for (int j = 0; j < nj; j++) {
+			cos_angles[j] = cos(angles[j]);
+			sin_angles[j] = sin(angles[j]);
+		}
+		if (num_threads <= 0) { num_threads = HBTK::default_thread_count(); }
+		HBTK::parallel_blocks(0, ni, num_threads, [&](int begin, int end, int) {
+			std::vector<double> re(nj), im(nj);
+			for (int i = begin; i < end; i++) {
+				for (int j = 0; j < nj; j++) {
+					re[j] = centre.real() + radii[i] * cos_angles[j];
+					im[j] = centre.imag() + radii[i] * sin_angles[j];
+				}
+				func(nj, re.data(), im.data(), re.data(), im.data());
+				for (int j = 0; j < nj; j++) { mesh.set_coord({ i, j }, std::array<double, 2>({ re[j], im[j] })); }
+			}
+		});
+		return mesh;
+	}
+}
 
 std::complex<double> HBTK::joukowsky_transform(std::complex<double> zeta_point)
 {
@@ -58,3 +91,86 @@ std::complex<double> HBTK::karman_trefftz_transform_derivative(std::complex<doub
 		(pow(pow(plus, n) - pow(minus, n), 2) * (zeta_point*zeta_point - 1.0));
 }
 
+
+void HBTK::joukowsky_transform(int n, const double * zeta_real, const double * zeta_imag, 
+	double * z_real, double * z_imag, double * dz_real, double * dz_imag)
+{
+	if (dz_real && dz_imag) {
+		for (int i = 0; i < n; i++) {
+			double re = zeta_real[i], im = zeta_imag[i];
+			double inv_mag_sq = 1. / (re * re + im * im);
+			// 1 / zeta and 1 / zeta^2.
+			double inv_re = re * inv_mag_sq, inv_im = -im * inv_mag_sq;
+			z_real[i] = re + inv_re;
+			z_imag[i] = im + inv_im;
+			dz_real[i] = 1. - (inv_re * inv_re - inv_im * inv_im);
+			dz_imag[i] = -2. * inv_re * inv_im;
+		}
+	}
+	else {
+		for (int i = 0; i < n; i++) {
+			double re = zeta_real[i], im = zeta_imag[i];
+			double inv_mag_sq = 1. / (re * re + im * im);
+			z_real[i] = re + re * inv_mag_sq;
+			z_imag[i] = im - im * inv_mag_sq;
+		}
+	}
+	return;
+}
+
+void HBTK::karman_trefftz_transform(int n, const double * zeta_real, const double * zeta_imag, 
+	double alpha, double * z_real, double * z_imag, double * dz_real, double * dz_imag)
+{
+	const double power = 2 - alpha / HBTK::Constants::pi();
+	for (int i = 0; i < n; i++) {
+		double re = zeta_real[i], im = zeta_imag[i];
+		double inv_mag_sq = 1. / (re * re + im * im);
+		double inv_re = re * inv_mag_sq, inv_im = -im * inv_mag_sq;
+		// (1 + 1 / zeta)^power and (1 - 1 / zeta)^power in polar form, on 
+		// the principal branch as std::pow.
+		double plus_re = 1. + inv_re, plus_im = inv_im;
+		double minus_re = 1. - inv_re, minus_im = -inv_im;
+		double plus_mag = exp(0.5 * power * log(plus_re * plus_re + plus_im * plus_im));
+		double minus_mag = exp(0.5 * power * log(minus_re * minus_re + minus_im * minus_im));
+		double plus_arg = power * atan2(plus_im, plus_re);
+		double minus_arg = power * atan2(minus_im, minus_re);
+		double p_re = plus_mag * cos(plus_arg), p_im = plus_mag * sin(plus_arg);
+		double m_re = minus_mag * cos(minus_arg), m_im = minus_mag * sin(minus_arg);
+		double num_re = p_re + m_re, num_im = p_im + m_im;
+		double den_re = p_re - m_re, den_im = p_im - m_im;
+		double inv_den_sq = 1. / (den_re * den_re + den_im * den_im);
+		double z_re = power * (num_re * den_re + num_im * den_im) * inv_den_sq;
+		double z_im = power * (num_im * den_re - num_re * den_im) * inv_den_sq;
+		if (dz_real && dz_imag) {
+			// 4 power^2 P M / ((P - M)^2 (zeta^2 - 1))
+			double pm_re = p_re * m_re - p_im * m_im, pm_im = p_re * m_im + p_im * m_re;
+			double d2_re = den_re * den_re - den_im * den_im, d2_im = 2 * den_re * den_im;
+			double zm1_re = re * re - im * im - 1., zm1_im = 2 * re * im;
+			double bot_re = d2_re * zm1_re - d2_im * zm1_im, bot_im = d2_re * zm1_im + d2_im * zm1_re;
+			double scale = 4 * power * power / (bot_re * bot_re + bot_im * bot_im);
+			dz_real[i] = scale * (pm_re * bot_re + pm_im * bot_im);
+			dz_imag[i] = scale * (pm_im * bot_re - pm_re * bot_im);
+		}
+		z_real[i] = z_re;
+		z_imag[i] = z_im;
+	}
+	return;
+}
+
+HBTK::StructuredMeshBlock2D HBTK::joukowsky_grid(std::complex<double> centre, 
+	const std::vector<double>& radii, const std::vector<double>& angles, int num_threads)
+{
+	return map_polar_grid(centre, radii, angles, num_threads,
+		[](int n, const double * zr, const double * zi, double * r, double * i) {
+		joukowsky_transform(n, zr, zi, r, i);
+	});
+}
+
+HBTK::StructuredMeshBlock2D HBTK::karman_trefftz_grid(std::complex<double> centre, 
+	const std::vector<double>& radii, const std::vector<double>& angles, double alpha, int num_threads)
+{
+	return map_polar_grid(centre, radii, angles, num_threads,
+		[alpha](int n, const double * zr, const double * zi, double * r, double * i) {
+		karman_trefftz_transform(n, zr, zi, alpha, r, i);
+	});
+}
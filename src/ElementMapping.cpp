@@ -0,0 +1,290 @@
+#include "ElementMapping.h"
+/*////////////////////////////////////////////////////////////////////////////
+ElementMapping.cpp
+
+Runtime access to element shape functions by element type, and forward 
+and inverse mapping between local and global coordinates.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "ElementShapeFunctions.h"
+#include "LagrangeShapeFunctions.h"
+
+namespace {
+	using namespace HBTK::Elements;
+
+	template<typename TFuncs>
+	void evaluate_1d(const double * local, double * values, double * derivatives)
+	{
+		TFuncs funcs;
+		auto n = funcs.shape_function(local[0]);
+		std::copy(n.begin(), n.end(), values);
+		if (derivatives) {
+			auto d0 = funcs.shape_function_d0(local[0]);
+			std::copy(d0.begin(), d0.end(), derivatives);
+		}
+	}
+
+	template<typename TFuncs>
+	void evaluate_2d(const double * local, double * values, double * derivatives)
+	{
+		TFuncs funcs;
+		auto n = funcs.shape_function(local[0], local[1]);
+		std::copy(n.begin(), n.end(), values);
+		if (derivatives) {
+			auto d0 = funcs.shape_function_d0(local[0], local[1]);
+			auto d1 = funcs.shape_function_d1(local[0], local[1]);
+			std::copy(d0.begin(), d0.end(), derivatives);
+			std::copy(d1.begin(), d1.end(), derivatives + n.size());
+		}
+	}
+
+	template<typename TFuncs>
+	void evaluate_3d(const double * local, double * values, double * derivatives)
+	{
+		TFuncs funcs;
+		auto n = funcs.shape_function(local[0], local[1], local[2]);
+		std::copy(n.begin(), n.end(), values);
+		if (derivatives) {
+			auto d0 = funcs.shape_function_d0(local[0], local[1], local[2]);
+			auto d1 = funcs.shape_function_d1(local[0], local[1], local[2]);
+			auto d2 = funcs.shape_function_d2(local[0], local[1], local[2]);
+			std::copy(d0.begin(), d0.end(), derivatives);
+			std::copy(d1.begin(), d1.end(), derivatives + n.size());
+			std::copy(d2.begin(), d2.end(), derivatives + 2 * n.size());
+		}
+	}
+
+	bool line_contains(const double * local, double tolerance)
+	{
+		return std::abs(local[0]) <= 1 + tolerance;
+	}
+
+	bool triangle_contains(const double * local, double tolerance)
+	{
+		return local[0] >= -tolerance && local[1] >= -tolerance 
+			&& local[0] + local[1] <= 1 + tolerance;
+	}
+
+	bool quadrangle_contains(const double * local, double tolerance)
+	{
+		return std::abs(local[0]) <= 1 + tolerance && std::abs(local[1]) <= 1 + tolerance;
+	}
+
+	bool tetrahedron_contains(const double * local, double tolerance)
+	{
+		return local[0] >= -tolerance && local[1] >= -tolerance && local[2] >= -tolerance
+			&& local[0] + local[1] + local[2] <= 1 + tolerance;
+	}
+
+	bool hexahedron_contains(const double * local, double tolerance)
+	{
+		return std::abs(local[0]) <= 1 + tolerance && std::abs(local[1]) <= 1 + tolerance
+			&& std::abs(local[2]) <= 1 + tolerance;
+	}
+
+	bool prism_contains(const double * local, double tolerance)
+	{
+		return triangle_contains(local, tolerance) && std::abs(local[2]) <= 1 + tolerance;
+	}
+
+	const ElementShape line2_shape = { 2, 1, 1, 
+		&evaluate_1d<LinearShapeFunctions>, &line_contains, {{ 0., 0., 0. }} };
+	const ElementShape line3_shape = { 3, 1, 2, 
+		&evaluate_1d<QuadraticShapeFunctions>, &line_contains, {{ 0., 0., 0. }} };
+	const ElementShape triangle3_shape = { 3, 2, 1, 
+		&evaluate_2d<LinearTriangle3ShapeFunctions>, &triangle_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape triangle6_shape = { 6, 2, 2, 
+		&evaluate_2d<QuadraticTriangle6ShapeFunctions>, &triangle_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape quadrangle4_shape = { 4, 2, 1, 
+		&evaluate_2d<BilinearQuad4ShapeFunctions>, &quadrangle_contains, {{ 0., 0., 0. }} };
+	const ElementShape quadrangle8_shape = { 8, 2, 2, 
+		&evaluate_2d<SerendipityQuad8ShapeFunctions>, &quadrangle_contains, {{ 0., 0., 0. }} };
+	const ElementShape tetrahedron4_shape = { 4, 3, 1, 
+		&evaluate_3d<LinearTetrahedron4ShapeFunctions>, &tetrahedron_contains, {{ 0.25, 0.25, 0.25 }} };
+	const ElementShape tetrahedron10_shape = { 10, 3, 2, 
+		&evaluate_3d<QuadraticTetrahedron10ShapeFunctions>, &tetrahedron_contains, {{ 0.25, 0.25, 0.25 }} };
+	const ElementShape hexahedron8_shape = { 8, 3, 1, 
+		&evaluate_3d<LinearHexahedron8ShapeFunctions>, &hexahedron_contains, {{ 0., 0., 0. }} };
+
+	// Higher order elements, from LagrangeShapeFunctions.h.
+	const ElementShape line4_shape = { 4, 1, 3, 
+		&CubicShapeFunctions::evaluate, &line_contains, {{ 0., 0., 0. }} };
+	const ElementShape line5_shape = { 5, 1, 4, 
+		&QuarticShapeFunctions::evaluate, &line_contains, {{ 0., 0., 0. }} };
+	const ElementShape line6_shape = { 6, 1, 5, 
+		&QuinticShapeFunctions::evaluate, &line_contains, {{ 0., 0., 0. }} };
+	const ElementShape triangle9_shape = { 9, 2, 3, 
+		&IncompleteCubicTriangle9ShapeFunctions::evaluate, &triangle_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape triangle10_shape = { 10, 2, 3, 
+		&CubicTriangle10ShapeFunctions::evaluate, &triangle_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape triangle12_shape = { 12, 2, 4, 
+		&IncompleteQuarticTriangle12ShapeFunctions::evaluate, &triangle_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape triangle15o4_shape = { 15, 2, 4, 
+		&QuarticTriangle15ShapeFunctions::evaluate, &triangle_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape triangle15o5_shape = { 15, 2, 5, 
+		&IncompleteQuinticTriangle15ShapeFunctions::evaluate, &triangle_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape triangle21_shape = { 21, 2, 5, 
+		&QuinticTriangle21ShapeFunctions::evaluate, &triangle_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape quadrangle9_shape = { 9, 2, 2, 
+		&BiquadraticQuad9ShapeFunctions::evaluate, &quadrangle_contains, {{ 0., 0., 0. }} };
+	const ElementShape quadrangle12_shape = { 12, 2, 3, 
+		&SerendipityQuad12ShapeFunctions::evaluate, &quadrangle_contains, {{ 0., 0., 0. }} };
+	const ElementShape quadrangle16_shape = { 16, 2, 3, 
+		&BicubicQuad16ShapeFunctions::evaluate, &quadrangle_contains, {{ 0., 0., 0. }} };
+	const ElementShape tetrahedron20_shape = { 20, 3, 3, 
+		&CubicTetrahedron20ShapeFunctions::evaluate, &tetrahedron_contains, {{ 0.25, 0.25, 0.25 }} };
+	const ElementShape hexahedron20_shape = { 20, 3, 2, 
+		&SerendipityHexahedron20ShapeFunctions::evaluate, &hexahedron_contains, {{ 0., 0., 0. }} };
+	const ElementShape hexahedron27_shape = { 27, 3, 2, 
+		&TriquadraticHexahedron27ShapeFunctions::evaluate, &hexahedron_contains, {{ 0., 0., 0. }} };
+	const ElementShape prism6_shape = { 6, 3, 1, 
+		&LinearPrism6ShapeFunctions::evaluate, &prism_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape prism15_shape = { 15, 3, 2, 
+		&SerendipityPrism15ShapeFunctions::evaluate, &prism_contains, {{ 1. / 3, 1. / 3, 0. }} };
+	const ElementShape prism18_shape = { 18, 3, 2, 
+		&QuadraticPrism18ShapeFunctions::evaluate, &prism_contains, {{ 1. / 3, 1. / 3, 0. }} };
+
+	// Least squares solution of jac * step = rhs, where jac is 3 x dims. 
+	// False if jac is singular.
+	bool solve_step(const double(&jac)[3][3], int dims, const double(&rhs)[3], double(&step)[3])
+	{
+		if (dims == 3) {
+			double c00 = jac[1][1] * jac[2][2] - jac[1][2] * jac[2][1];
+			double c01 = jac[1][2] * jac[2][0] - jac[1][0] * jac[2][2];
+			double c02 = jac[1][0] * jac[2][1] - jac[1][1] * jac[2][0];
+			double det = jac[0][0] * c00 + jac[0][1] * c01 + jac[0][2] * c02;
+			if (det == 0 || !std::isfinite(det)) { return false; }
+			double c10 = jac[0][2] * jac[2][1] - jac[0][1] * jac[2][2];
+			double c11 = jac[0][0] * jac[2][2] - jac[0][2] * jac[2][0];
+			double c12 = jac[0][1] * jac[2][0] - jac[0][0] * jac[2][1];
+			double c20 = jac[0][1] * jac[1][2] - jac[0][2] * jac[1][1];
+			double c21 = jac[0][2] * jac[1][0] - jac[0][0] * jac[1][2];
+			double c22 = jac[0][0] * jac[1][1] - jac[0][1] * jac[1][0];
+			step[0] = (c00 * rhs[0] + c10 * rhs[1] + c20 * rhs[2]) / det;
+			step[1] = (c01 * rhs[0] + c11 * rhs[1] + c21 * rhs[2]) / det;
+			step[2] = (c02 * rhs[0] + c12 * rhs[1] + c22 * rhs[2]) / det;
+			return true;
+		}
+		// Normal equations: (J^T J) step = J^T rhs.
+		double a[2][2] = { { 0, 0 },{ 0, 0 } }, b[2] = { 0, 0 };
+		for (int i = 0; i < dims; i++) {
+			for (int c = 0; c < 3; c++) {
+				b[i] += jac[c][i] * rhs[c];
+				for (int j = 0; j < dims; j++) { a[i][j] += jac[c][i] * jac[c][j]; }
+			}
+		}
+		if (dims == 1) {
+			if (a[0][0] == 0) { return false; }
+			step[0] = b[0] / a[0][0];
+			return true;
+		}
+		double det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+		if (det == 0 || !std::isfinite(det)) { return false; }
+		step[0] = (a[1][1] * b[0] - a[0][1] * b[1]) / det;
+		step[1] = (a[0][0] * b[1] - a[1][0] * b[0]) / det;
+		return true;
+	}
+}
+
+const HBTK::Elements::ElementShape * HBTK::Elements::gmsh_element_shape(int ele_id)
+{
+	switch (ele_id) {
+	case 1: return &line2_shape;
+	case 2: return &triangle3_shape;
+	case 3: return &quadrangle4_shape;
+	case 4: return &tetrahedron4_shape;
+	case 5: return &hexahedron8_shape;
+	case 6: return &prism6_shape;
+	case 8: return &line3_shape;
+	case 9: return &triangle6_shape;
+	case 10: return &quadrangle9_shape;
+	case 11: return &tetrahedron10_shape;
+	case 12: return &hexahedron27_shape;
+	case 13: return &prism18_shape;
+	case 16: return &quadrangle8_shape;
+	case 17: return &hexahedron20_shape;
+	case 18: return &prism15_shape;
+	case 20: return &triangle9_shape;
+	case 21: return &triangle10_shape;
+	case 22: return &triangle12_shape;
+	case 23: return &triangle15o4_shape;
+	case 24: return &triangle15o5_shape;
+	case 25: return &triangle21_shape;
+	case 26: return &line4_shape;
+	case 27: return &line5_shape;
+	case 28: return &line6_shape;
+	case 29: return &tetrahedron20_shape;
+	case 36: return &quadrangle16_shape;
+	case 39: return &quadrangle12_shape;
+	default: return nullptr;
+	}
+}
+
+HBTK::CartesianPoint3D HBTK::Elements::forward_map(const ElementShape & shape, 
+	const CartesianPoint3D * nodes, const double * local)
+{
+	double values[max_shape_nodes];
+	shape.evaluate(local, values, nullptr);
+	CartesianPoint3D result({ 0, 0, 0 });
+	for (int i = 0; i < shape.number_of_nodes; i++) {
+		result.x() += values[i] * nodes[i].x();
+		result.y() += values[i] * nodes[i].y();
+		result.z() += values[i] * nodes[i].z();
+	}
+	return result;
+}
+
+bool HBTK::Elements::inverse_map(const ElementShape & shape, const CartesianPoint3D * nodes, 
+	const CartesianPoint3D & point, double * local, double tolerance, int max_iterations)
+{
+	const int n = shape.number_of_nodes, dims = shape.local_dimensions;
+	if (dims == 0) { return true; }
+	double values[max_shape_nodes], derivatives[3 * max_shape_nodes];
+	for (int iter = 0; iter < max_iterations; iter++) {
+		shape.evaluate(local, values, derivatives);
+		// jac[c][d] = dx_c / dlocal_d
+		double residual[3] = { point.x(), point.y(), point.z() };
+		double jac[3][3] = { { 0, 0, 0 },{ 0, 0, 0 },{ 0, 0, 0 } };
+		for (int i = 0; i < n; i++) {
+			const double coord[3] = { nodes[i].x(), nodes[i].y(), nodes[i].z() };
+			for (int c = 0; c < 3; c++) {
+				residual[c] -= values[i] * coord[c];
+				for (int d = 0; d < dims; d++) { 
+					jac[c][d] += derivatives[d * n + i] * coord[c]; 
+				}
+			}
+		}
+		double step[3];
+		if (!solve_step(jac, dims, residual, step)) { return false; }
+		double step_sq = 0;
+		for (int d = 0; d < dims; d++) {
+			local[d] += step[d];
+			step_sq += step[d] * step[d];
+		}
+		if (step_sq <= tolerance * tolerance) { return true; }
+	}
+	return false;
+}
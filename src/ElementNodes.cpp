@@ -0,0 +1,59 @@
+#include "ElementNodes.h"
+/*////////////////////////////////////////////////////////////////////////////
+ElementNodes.cpp
+
+Defines the nodal position of elements in their local coordinate system.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+// Definitions of the static node tables, required when they are odr-used.
+constexpr std::array<std::array<double, 0>, 0> HBTK::Elements::Point1::nodes;
+constexpr std::array<std::array<double, 1>, 2> HBTK::Elements::Line2::nodes;
+constexpr std::array<std::array<double, 1>, 3> HBTK::Elements::Line3::nodes;
+constexpr std::array<std::array<double, 1>, 4> HBTK::Elements::Line4::nodes;
+constexpr std::array<std::array<double, 1>, 5> HBTK::Elements::Line5::nodes;
+constexpr std::array<std::array<double, 1>, 6> HBTK::Elements::Line6::nodes;
+constexpr std::array<std::array<double, 2>, 3> HBTK::Elements::Triangle3::nodes;
+constexpr std::array<std::array<double, 2>, 6> HBTK::Elements::Triangle6::nodes;
+constexpr std::array<std::array<double, 2>, 9> HBTK::Elements::Triangle9::nodes;
+constexpr std::array<std::array<double, 2>, 10> HBTK::Elements::Triangle10::nodes;
+constexpr std::array<std::array<double, 2>, 12> HBTK::Elements::Triangle12::nodes;
+constexpr std::array<std::array<double, 2>, 15> HBTK::Elements::Triangle15O4::nodes;
+constexpr std::array<std::array<double, 2>, 15> HBTK::Elements::Triangle15O5::nodes;
+constexpr std::array<std::array<double, 2>, 21> HBTK::Elements::Triangle21::nodes;
+constexpr std::array<std::array<double, 2>, 4> HBTK::Elements::Quadrangle4::nodes;
+constexpr std::array<std::array<double, 2>, 8> HBTK::Elements::Quadrangle8::nodes;
+constexpr std::array<std::array<double, 2>, 9> HBTK::Elements::Quadrangle9::nodes;
+constexpr std::array<std::array<double, 2>, 12> HBTK::Elements::Quadrangle12::nodes;
+constexpr std::array<std::array<double, 2>, 16> HBTK::Elements::Quadrangle16::nodes;
+constexpr std::array<std::array<double, 3>, 4> HBTK::Elements::Tetrahedron4::nodes;
+constexpr std::array<std::array<double, 3>, 10> HBTK::Elements::Tetrahedron10::nodes;
+constexpr std::array<std::array<double, 3>, 20> HBTK::Elements::Tetrahedron20::nodes;
+constexpr std::array<std::array<double, 3>, 8> HBTK::Elements::Hexahedron8::nodes;
+constexpr std::array<std::array<double, 3>, 20> HBTK::Elements::Hexahedron20::nodes;
+constexpr std::array<std::array<double, 3>, 27> HBTK::Elements::Hexahedron27::nodes;
+constexpr std::array<std::array<double, 3>, 6> HBTK::Elements::Prism6::nodes;
+constexpr std::array<std::array<double, 3>, 15> HBTK::Elements::Prism15::nodes;
+constexpr std::array<std::array<double, 3>, 18> HBTK::Elements::Prism18::nodes;
+constexpr std::array<std::array<double, 3>, 5> HBTK::Elements::Pyramid5::nodes;
+constexpr std::array<std::array<double, 3>, 13> HBTK::Elements::Pyramid13::nodes;
+constexpr std::array<std::array<double, 3>, 14> HBTK::Elements::Pyramid14::nodes;
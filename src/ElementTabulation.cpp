@@ -0,0 +1,258 @@
+#include "ElementTabulation.h"
+/*////////////////////////////////////////////////////////////////////////////
+ElementTabulation.cpp
+
+Cubature rules over reference elements, and shape functions tabulated at
+the points of a cubature rule.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "GaussLegendre.h"
+
+namespace {
+	// Gauss-Legendre rule that is exact to degree order on [0, 1].
+	void unit_gauss_legendre(int order, std::vector<double> & points, std::vector<double> & weights)
+	{
+		int n = order / 2 + 1;
+		points.resize(n);
+		weights.resize(n);
+		HBTK::gauss_legendre<double>(n, points, weights);
+		for (int i = 0; i < n; i++) {
+			points[i] = 0.5 * (points[i] + 1);
+			weights[i] *= 0.5;
+		}
+	}
+}
+
+HBTK::Elements::ElementCubature HBTK::Elements::gmsh_element_cubature(int ele_id, int order)
+{
+	const ElementShape * shape = gmsh_element_shape(ele_id);
+	if (!shape || order < 0) {
+		throw std::invalid_argument("HBTK::Elements::gmsh_element_cubature: "
+			"No cubature for element type " + std::to_string(ele_id) + " and order " 
+			+ std::to_string(order) + ". " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	ElementCubature rule;
+	rule.local_dimensions = shape->local_dimensions;
+	std::vector<double> p, w, pc, wc, pcc, wcc;
+	unit_gauss_legendre(order, p, w);
+	// The Jacobian of the collapse adds one (triangle) or two (tetrahedron) 
+	// to the degree in the collapsed directions.
+	unit_gauss_legendre(order + 1, pc, wc);
+	unit_gauss_legendre(order + 2, pcc, wcc);
+	const int n = (int)p.size();
+	switch (ele_id) {
+	case 1: case 8: case 26: case 27: case 28:
+		for (int i = 0; i < n; i++) {
+			rule.points.push_back({ { 2 * p[i] - 1, 0, 0 } });
+			rule.weights.push_back(2 * w[i]);
+		}
+		break;
+	case 3: case 10: case 16: case 36: case 39:
+		for (int j = 0; j < n; j++) {
+			for (int i = 0; i < n; i++) {
+				rule.points.push_back({ { 2 * p[i] - 1, 2 * p[j] - 1, 0 } });
+				rule.weights.push_back(4 * w[i] * w[j]);
+			}
+		}
+		break;
+	case 5: case 12: case 17:
+		for (int k = 0; k < n; k++) {
+			for (int j = 0; j < n; j++) {
+				for (int i = 0; i < n; i++) {
+					rule.points.push_back({ { 2 * p[i] - 1, 2 * p[j] - 1, 2 * p[k] - 1 } });
+					rule.weights.push_back(8 * w[i] * w[j] * w[k]);
+				}
+			}
+		}
+		break;
+	case 2: case 9: case 20: case 21: case 22: case 23: case 24: case 25:
+		// x = a (1 - b), y = b.
+		for (int j = 0; j < (int)pc.size(); j++) {
+			for (int i = 0; i < n; i++) {
+				rule.points.push_back({ { p[i] * (1 - pc[j]), pc[j], 0 } });
+				rule.weights.push_back(w[i] * wc[j] * (1 - pc[j]));
+			}
+		}
+		break;
+	case 4: case 11: case 29:
+		// x = a (1 - b)(1 - c), y = b (1 - c), z = c.
+		for (int k = 0; k < (int)pcc.size(); k++) {
+			for (int j = 0; j < (int)pc.size(); j++) {
+				for (int i = 0; i < n; i++) {
+					rule.points.push_back({ { p[i] * (1 - pc[j]) * (1 - pcc[k]), 
+						pc[j] * (1 - pcc[k]), pcc[k] } });
+					rule.weights.push_back(w[i] * wc[j] * wcc[k] 
+						* (1 - pc[j]) * (1 - pcc[k]) * (1 - pcc[k]));
+				}
+			}
+		}
+		break;
+	case 6: case 13: case 18:
+		// Triangle as above, extruded in z.
+		for (int k = 0; k < n; k++) {
+			for (int j = 0; j < (int)pc.size(); j++) {
+				for (int i = 0; i < n; i++) {
+					rule.points.push_back({ { p[i] * (1 - pc[j]), pc[j], 2 * p[k] - 1 } });
+					rule.weights.push_back(2 * w[i] * wc[j] * w[k] * (1 - pc[j]));
+				}
+			}
+		}
+		break;
+	default:
+		throw std::invalid_argument("HBTK::Elements::gmsh_element_cubature: "
+			"No cubature for element type " + std::to_string(ele_id) + ". "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	return rule;
+}
+
+HBTK::Elements::ShapeFunctionTable::ShapeFunctionTable(const ElementShape & shape, 
+	const ElementCubature & cubature)
+	: m_number_of_nodes(shape.number_of_nodes),
+	m_local_dimensions(shape.local_dimensions),
+	m_points(cubature.points),
+	m_weights(cubature.weights)
+{
+	if (cubature.local_dimensions != shape.local_dimensions) {
+		throw std::invalid_argument("HBTK::Elements::ShapeFunctionTable::ShapeFunctionTable: "
+			"Cubature is for a different number of dimensions to the element. "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	const int n = m_number_of_nodes, dims = m_local_dimensions;
+	m_values.resize(m_points.size() * n);
+	m_derivatives.resize(m_points.size() * dims * n);
+	std::vector<double> derivatives(3 * n);
+	for (int q = 0; q < (int)m_points.size(); q++) {
+		shape.evaluate(m_points[q].data(), &m_values[q * n], derivatives.data());
+		std::copy(derivatives.begin(), derivatives.begin() + dims * n, 
+			m_derivatives.begin() + q * dims * n);
+	}
+}
+
+int HBTK::Elements::ShapeFunctionTable::number_of_points() const
+{
+	return (int)m_weights.size();
+}
+
+int HBTK::Elements::ShapeFunctionTable::number_of_nodes() const
+{
+	return m_number_of_nodes;
+}
+
+int HBTK::Elements::ShapeFunctionTable::local_dimensions() const
+{
+	return m_local_dimensions;
+}
+
+const std::vector<double>& HBTK::Elements::ShapeFunctionTable::weights() const
+{
+	return m_weights;
+}
+
+const std::vector<std::array<double, 3>>& HBTK::Elements::ShapeFunctionTable::points() const
+{
+	return m_points;
+}
+
+const std::vector<double>& HBTK::Elements::ShapeFunctionTable::values() const
+{
+	return m_values;
+}
+
+const std::vector<double>& HBTK::Elements::ShapeFunctionTable::derivatives() const
+{
+	return m_derivatives;
+}
+
+void HBTK::Elements::ShapeFunctionTable::interpolate(const double * nodal, double * at_points) const
+{
+	interpolate(1, nodal, at_points);
+	return;
+}
+
+void HBTK::Elements::ShapeFunctionTable::interpolate(int num_elements, 
+	const double * nodal, double * at_points) const
+{
+	const int n = m_number_of_nodes, nq = number_of_points();
+	const double * values = m_values.data();
+	for (int e = 0; e < num_elements; e++) {
+		const double * ele_nodal = nodal + e * n;
+		double * ele_out = at_points + e * nq;
+		for (int q = 0; q < nq; q++) {
+			const double * row = values + q * n;
+			double sum = 0;
+			for (int i = 0; i < n; i++) { sum += row[i] * ele_nodal[i]; }
+			ele_out[q] = sum;
+		}
+	}
+	return;
+}
+
+void HBTK::Elements::ShapeFunctionTable::map(const CartesianPoint3D * nodes, 
+	CartesianPoint3D * points, double * jacobian_weights) const
+{
+	const int n = m_number_of_nodes, dims = m_local_dimensions, nq = number_of_points();
+	for (int q = 0; q < nq; q++) {
+		const double * values = &m_values[q * n];
+		const double * derivs = &m_derivatives[q * dims * n];
+		double x[3] = { 0, 0, 0 };
+		// jac[d][c] = dx_c / dlocal_d
+		double jac[3][3] = { { 0, 0, 0 },{ 0, 0, 0 },{ 0, 0, 0 } };
+		for (int i = 0; i < n; i++) {
+			const double coord[3] = { nodes[i].x(), nodes[i].y(), nodes[i].z() };
+			for (int c = 0; c < 3; c++) {
+				x[c] += values[i] * coord[c];
+				for (int d = 0; d < dims; d++) { jac[d][c] += derivs[d * n + i] * coord[c]; }
+			}
+		}
+		double scale;
+		switch (dims) {
+		case 3:
+			scale = std::abs(
+				jac[0][0] * (jac[1][1] * jac[2][2] - jac[1][2] * jac[2][1])
+				- jac[0][1] * (jac[1][0] * jac[2][2] - jac[1][2] * jac[2][0])
+				+ jac[0][2] * (jac[1][0] * jac[2][1] - jac[1][1] * jac[2][0]));
+			break;
+		case 2: {
+			double cx = jac[0][1] * jac[1][2] - jac[0][2] * jac[1][1];
+			double cy = jac[0][2] * jac[1][0] - jac[0][0] * jac[1][2];
+			double cz = jac[0][0] * jac[1][1] - jac[0][1] * jac[1][0];
+			scale = std::sqrt(cx * cx + cy * cy + cz * cz);
+			break;
+		}
+		case 1:
+			scale = std::sqrt(jac[0][0] * jac[0][0] + jac[0][1] * jac[0][1] + jac[0][2] * jac[0][2]);
+			break;
+		default:
+			scale = 1;
+		}
+		points[q] = CartesianPoint3D({ x[0], x[1], x[2] });
+		jacobian_weights[q] = m_weights[q] * scale;
+	}
+	return;
+}
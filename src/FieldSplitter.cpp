@@ -0,0 +1,101 @@
+#include "FieldSplitter.h"
+/*////////////////////////////////////////////////////////////////////////////
+FieldSplitter.cpp
+
+Split lines into whitespace separated fields without allocation.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+	inline bool is_space(char c)
+	{
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+
+	// True if none of the eight bytes at p are <= ' ', so none can be 
+	// whitespace. Lets the scan step over most of a field eight characters
+	// at a time.
+	inline bool no_space_in_eight(const char * p)
+	{
+		uint64_t chunk;
+		memcpy(&chunk, p, sizeof(uint64_t));
+		return !((chunk - 0x2121212121212121ULL) & ~chunk & 0x8080808080808080ULL);
+	}
+}
+
+HBTK::FieldSplitter::FieldSplitter()
+	: m_size(0)
+{
+}
+
+int HBTK::FieldSplitter::split(StringView line)
+{
+	const char * p = line.begin();
+	const char * const last = line.end();
+	m_size = 0;
+	while (true) {
+		while (p < last && is_space(*p)) { p++; }
+		if (p == last) { break; }
+		const char * start = p;
+		while (last - p >= 8 && no_space_in_eight(p)) { p += 8; }
+		while (p < last && !is_space(*p)) { p++; }
+		if (m_size == (int)m_fields.size()) {
+			m_fields.emplace_back(start, (int)(p - start));
+		}
+		else {
+			m_fields[m_size] = StringView(start, (int)(p - start));
+		}
+		m_size++;
+	}
+	return m_size;
+}
+
+int HBTK::FieldSplitter::size() const
+{
+	return m_size;
+}
+
+bool HBTK::FieldSplitter::empty() const
+{
+	return m_size == 0;
+}
+
+HBTK::StringView HBTK::FieldSplitter::operator[](int index) const
+{
+	assert(index >= 0);
+	assert(index < m_size);
+	return m_fields[index];
+}
+
+const HBTK::StringView * HBTK::FieldSplitter::begin() const
+{
+	return m_fields.data();
+}
+
+const HBTK::StringView * HBTK::FieldSplitter::end() const
+{
+	return m_fields.data() + m_size;
+}
@@ -39,7 +39,7 @@ HBTK::FortranSequentialInputStream::~FortranSequentialInputStream()
 {
 }
 
-int HBTK::FortranSequentialInputStream::record_open(std::ifstream & input_stream)
+int HBTK::FortranSequentialInputStream::record_open(std::istream & input_stream)
 {
 	assert(m_last_record_start == -1);  // If the last record was not ended, assert fails.
 	assert(m_record_length == -1);		// If when not in record, this should be -1.
@@ -51,7 +51,7 @@ int HBTK::FortranSequentialInputStream::record_open(std::ifstream & input_stream
 	return m_record_length;
 }
 
-int HBTK::FortranSequentialInputStream::record_open_reverse(std::ifstream & input_stream)
+int HBTK::FortranSequentialInputStream::record_open_reverse(std::istream & input_stream)
 {
 	assert(m_last_record_start == -1);  // If the last record was not ended, assert fails.
 	assert(m_record_length == -1);		// If when not in record, this should be -1.
@@ -67,7 +67,7 @@ int HBTK::FortranSequentialInputStream::record_open_reverse(std::ifstream & inpu
 	return m_record_length;
 }
 
-void HBTK::FortranSequentialInputStream::record_close(std::ifstream & input_stream)
+void HBTK::FortranSequentialInputStream::record_close(std::istream & input_stream)
 {
 	assert(m_record_length != -1);
 	assert(m_last_record_start != -1);
@@ -87,7 +87,7 @@ void HBTK::FortranSequentialInputStream::record_close(std::ifstream & input_stre
 	return;
 }
 
-void HBTK::FortranSequentialInputStream::record_close_reverse(std::ifstream & input_stream)
+void HBTK::FortranSequentialInputStream::record_close_reverse(std::istream & input_stream)
 {
 	assert(m_record_length != -1);
 	assert(m_last_record_start != -1);
@@ -106,7 +106,7 @@ void HBTK::FortranSequentialInputStream::record_close_reverse(std::ifstream & in
 	return;
 }
 
-int HBTK::FortranSequentialInputStream::seek_record_start(std::ifstream & input_stream)
+int HBTK::FortranSequentialInputStream::seek_record_start(std::istream & input_stream)
 {
 	assert(m_record_length != -1);
 	assert(m_last_record_start != -1);
@@ -117,7 +117,7 @@ int HBTK::FortranSequentialInputStream::seek_record_start(std::ifstream & input_
 	return m_record_length;
 }
 
-int HBTK::FortranSequentialInputStream::seek_record_end(std::ifstream & input_stream)
+int HBTK::FortranSequentialInputStream::seek_record_end(std::istream & input_stream)
 {
 	assert(m_record_length != -1);
 	assert(m_last_record_start != -1);
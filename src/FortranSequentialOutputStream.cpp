@@ -40,7 +40,7 @@ HBTK::FortranSequentialOutputStream::~FortranSequentialOutputStream()
 }
 
 
-void HBTK::FortranSequentialOutputStream::record_start(std::ofstream & output_stream)
+void HBTK::FortranSequentialOutputStream::record_start(std::ostream & output_stream)
 {
 	assert(m_last_record_start == -1);
 	// Skip over the header - we'll fill that in once we've written the record.
@@ -51,7 +51,7 @@ void HBTK::FortranSequentialOutputStream::record_start(std::ofstream & output_st
 }
 
 
-void HBTK::FortranSequentialOutputStream::record_end(std::ofstream & output_stream)
+void HBTK::FortranSequentialOutputStream::record_end(std::ostream & output_stream)
 {
 	assert(m_last_record_start != -1);
 	int record_end = (int)output_stream.tellp();
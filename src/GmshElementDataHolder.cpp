@@ -24,13 +24,17 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
 #include <cassert>
 #include <exception>
+#include <stdexcept>
 
 #include "GmshMeshHolder.h"
 
 HBTK::Gmsh::GmshElementDataHolder::GmshElementDataHolder()
-	: m_element_data_type(scalar)
+	: m_time(0),
+	m_time_step(0),
+	m_element_data_type(scalar)
 {
 }
 
@@ -75,23 +79,30 @@ const double & HBTK::Gmsh::GmshElementDataHolder::time() const
 }
 
 /// \brief Returns the number of elements data recorded.
-int HBTK::Gmsh::GmshElementDataHolder::number_of_element_data_points()
+int HBTK::Gmsh::GmshElementDataHolder::number_of_element_data_points() const
 {
-	return (int)m_element_data.size();
+	return (int)m_tags.size();
 }
 
 /// \brief Returns true if element data for a element donated by element_tag 
 /// has been set.
-bool HBTK::Gmsh::GmshElementDataHolder::element_data_exists(int element_tag)
+bool HBTK::Gmsh::GmshElementDataHolder::element_data_exists(int element_tag) const
 {
-	return m_element_data.count(element_tag);
+	return slot(element_tag) >= 0;
 }
 
-/// \brief Returns the data associated with a given element.
-std::vector<double>& HBTK::Gmsh::GmshElementDataHolder::element_data(int element_tag)
+/// \brief Returns the data associated with a given element: components() values.
+double * HBTK::Gmsh::GmshElementDataHolder::element_data(int element_tag)
 {
 	assert(element_data_exists(element_tag));
-	return m_element_data[element_tag];
+	return m_values.data() + (size_t)slot(element_tag) * data_len();
+}
+
+/// \brief Returns the data associated with a given element: components() values.
+const double * HBTK::Gmsh::GmshElementDataHolder::element_data(int element_tag) const
+{
+	assert(element_data_exists(element_tag));
+	return m_values.data() + (size_t)slot(element_tag) * data_len();
 }
 
 /// \brief Add data to element donated by element_tag to the data set. element_data
@@ -101,47 +112,112 @@ std::vector<double>& HBTK::Gmsh::GmshElementDataHolder::element_data(int element
 /// asserts if element data already exists.
 void HBTK::Gmsh::GmshElementDataHolder::add_element_data(int element_tag, std::vector<double> element_data)
 {
-	assert(!element_data_exists(element_tag));
 	if ((int)element_data.size() != data_len()) {
 		throw std::domain_error(
 			"HBTK::Gmsh::GmshElementDataHolder the size of the element data vector ("
 			+ std::to_string((int)element_data.size()) + ") did not corespond "
 			"to the data type (" + data_type_str() + ") expecting length "
-			+ std::to_string(data_len()) + ". " __FILE__
+			+ std::to_string(data_len()) + ". " __FILE__ 
 			+ " : " + std::to_string(__LINE__)
 		);
 	}
-	m_element_data[element_tag] = element_data;
+	add_element_data(element_tag, element_data.data());
+}
+
+/// \brief Add data to element donated by element_tag to the data set. element_data
+/// points to components() values.
+/// asserts if element data already exists.
+void HBTK::Gmsh::GmshElementDataHolder::add_element_data(int element_tag, const double * element_data)
+{
+	assert(element_tag >= 0);
+	assert(!element_data_exists(element_tag));
+	if (element_tag >= (int)m_slots.size()) {
+		m_slots.resize(std::max((size_t)element_tag + 1, 2 * m_slots.size()), -1);
+	}
+	m_slots[element_tag] = (int)m_tags.size();
+	m_tags.push_back(element_tag);
+	m_values.insert(m_values.end(), element_data, element_data + data_len());
 }
 
-/// \brief Remove element data associate with element_tag.
+/// \brief Remove element data associate with element_tag. The last element added
+/// takes its place in element_tags().
 void HBTK::Gmsh::GmshElementDataHolder::remove_element_data(int element_tag)
 {
 	assert(element_data_exists(element_tag));
-	m_element_data.erase(element_tag);
+	const int removed = slot(element_tag), last = (int)m_tags.size() - 1;
+	const int len = data_len();
+	if (removed != last) {
+		m_tags[removed] = m_tags[last];
+		m_slots[m_tags[removed]] = removed;
+		std::copy(m_values.begin() + (size_t)last * len, m_values.end(), 
+			m_values.begin() + (size_t)removed * len);
+	}
+	m_slots[element_tag] = -1;
+	m_tags.pop_back();
+	m_values.resize(m_values.size() - len);
+}
+
+/// \brief The element tags with data, in the order of values().
+const std::vector<int> & HBTK::Gmsh::GmshElementDataHolder::element_tags() const
+{
+	return m_tags;
+}
+
+/// \brief All the values, components() per element in the order of element_tags().
+const std::vector<double> & HBTK::Gmsh::GmshElementDataHolder::values() const
+{
+	return m_values;
+}
+
+/// \brief Change the tag of every element to new_tags[old tag]. Throws
+/// std::out_of_range if a element has no new tag.
+void HBTK::Gmsh::GmshElementDataHolder::renumber_element_tags(const std::unordered_map<int, int> & new_tags)
+{
+	for (int tag : m_tags) { m_slots[tag] = -1; }
+	for (int & tag : m_tags) { tag = new_tags.at(tag); }
+	for (int i = 0; i < (int)m_tags.size(); i++) {
+		const int tag = m_tags[i];
+		assert(tag >= 0);
+		if (tag >= (int)m_slots.size()) { m_slots.resize((size_t)tag + 1, -1); }
+		assert(m_slots[tag] == -1);
+		m_slots[tag] = i;
+	}
+}
+
+/// \brief Remove all element data. The storage is kept, so refilling the holder
+/// with the next time step of a similar dataset doesn't allocate.
+void HBTK::Gmsh::GmshElementDataHolder::clear()
+{
+	for (int tag : m_tags) { m_slots[tag] = -1; }
+	m_tags.clear();
+	m_values.clear();
+}
+
+/// \brief Allocate space for count elements with tags up to max_tag.
+void HBTK::Gmsh::GmshElementDataHolder::reserve(int max_tag, int count)
+{
+	if (max_tag >= (int)m_slots.size()) { m_slots.resize((size_t)max_tag + 1, -1); }
+	m_tags.reserve(count);
+	m_values.reserve((size_t)count * data_len());
 }
 
 /// \brief Returns a vector of element_tags for which the corresponding data 
-/// vector is of the incorrect size of the selected data type.
+/// vector is of the incorrect size of the selected data type. Always empty:
+/// storage is sized by the data type.
 std::vector<int> HBTK::Gmsh::GmshElementDataHolder::check_correct_element_data_length()
 {
-	std::vector<int> problem_element_tags;
-	for (auto & element : m_element_data) {
-		if ((int)element.second.size() != data_len()) {
-			problem_element_tags.push_back(element.first);
-		}
-	}
+	assert(m_values.size() == m_tags.size() * data_len());
 	return std::vector<int>();
 }
 
 /// \brief Returns a vector of element tags used by this dataset that
 /// are not present in the mesh object.
 std::vector<int> HBTK::Gmsh::GmshElementDataHolder::check_consistant(GmshMeshHolder & mesh)
-{
+{ 
 	std::vector<int> problem_elements;
-	for (auto & element : m_element_data) {
-		if (!mesh.element_tag_exists(element.first)) {
-			problem_elements.push_back(element.first);
+	for (int tag : m_tags) {
+		if (!mesh.element_tag_exists(tag)) {
+			problem_elements.push_back(tag);
 		}
 	}
 	return problem_elements;
@@ -150,14 +226,41 @@ std::vector<int> HBTK::Gmsh::GmshElementDataHolder::check_consistant(GmshMeshHol
 /// \brief returns the element data type.
 ///
 /// Set to scalar (1 component), vector (3 component) or second order tensor (9
-/// component).
+/// component). Set this before adding data.
 HBTK::Gmsh::GmshElementDataHolder::data_type & HBTK::Gmsh::GmshElementDataHolder::element_data_type()
 {
 	return m_element_data_type;
 }
 
+const HBTK::Gmsh::GmshElementDataHolder::data_type & HBTK::Gmsh::GmshElementDataHolder::element_data_type() const
+{
+	return m_element_data_type;
+}
+
+int HBTK::Gmsh::GmshElementDataHolder::components() const
+{
+	return data_len();
+}
+
+HBTK::Gmsh::GmshElementDataHolder::data_type HBTK::Gmsh::GmshElementDataHolder::data_type_with_components(int n)
+{
+	switch (n) {
+	case 1: return scalar;
+	case 3: return vector;
+	case 9: return tensor2;
+	default:
+		throw std::domain_error(
+			"HBTK::Gmsh::GmshElementDataHolder no data type has " + std::to_string(n) 
+			+ " components. " __FILE__ " : " + std::to_string(__LINE__));
+	}
+}
+
+int HBTK::Gmsh::GmshElementDataHolder::slot(int element_tag) const
+{
+	return element_tag >= 0 && element_tag < (int)m_slots.size() ? m_slots[element_tag] : -1;
+}
 
-int HBTK::Gmsh::GmshElementDataHolder::data_len()
+int HBTK::Gmsh::GmshElementDataHolder::data_len() const
 {
 	int len;
 	switch (m_element_data_type) {
@@ -176,7 +279,7 @@ int HBTK::Gmsh::GmshElementDataHolder::data_len()
 	return len;
 }
 
-std::string HBTK::Gmsh::GmshElementDataHolder::data_type_str()
+std::string HBTK::Gmsh::GmshElementDataHolder::data_type_str() const
 {
 	std::string str;
 	switch (m_element_data_type) {
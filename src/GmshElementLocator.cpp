@@ -0,0 +1,136 @@
+#include "GmshElementLocator.h"
+/*////////////////////////////////////////////////////////////////////////////
+GmshElementLocator.cpp
+
+Find the element of a Gmsh mesh containing a point, and the point's local
+coordinate within that element.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "GmshInfo.h"
+#include "Parallel.h"
+
+constexpr double HBTK::Gmsh::GmshElementLocator::local_tolerance;
+
+HBTK::Gmsh::GmshElementLocator::GmshElementLocator()
+	: m_node_offsets(1, 0),
+	m_distance_tolerance(1e-8)
+{
+}
+
+HBTK::Gmsh::GmshElementLocator::GmshElementLocator(GmshMeshHolder & mesh, int num_threads)
+	: GmshElementLocator()
+{
+	std::vector<int> all_tags = mesh.get_all_element_tags();
+	int max_dims = 0;
+	for (int tag : all_tags) {
+		int ele_id = mesh.element_id(tag);
+		if (Elements::gmsh_element_shape(ele_id)) {
+			max_dims = std::max(max_dims, element_dimensions(ele_id));
+		}
+	}
+	std::vector<int> tags;
+	for (int tag : all_tags) {
+		if (element_dimensions(mesh.element_id(tag)) == max_dims) { tags.push_back(tag); }
+	}
+	build(mesh, tags, 1e-8, num_threads);
+}
+
+void HBTK::Gmsh::GmshElementLocator::build(GmshMeshHolder & mesh, 
+	const std::vector<int>& element_tags, double distance_tolerance, int num_threads)
+{
+	m_distance_tolerance = distance_tolerance;
+	m_element_tags.clear();
+	m_shapes.clear();
+	m_nodes.clear();
+	m_boxes.clear();
+	m_node_offsets.assign(1, 0);
+
+	std::vector<int> tags = element_tags;
+	std::sort(tags.begin(), tags.end());
+	for (int tag : tags) {
+		const Elements::ElementShape * shape = Elements::gmsh_element_shape(mesh.element_id(tag));
+		if (!shape) { continue; }
+		CartesianBoundingBox3D box;
+		for (int node_tag : mesh.element_node_tags(tag)) {
+			m_nodes.push_back(mesh.node(node_tag));
+			box.expand(m_nodes.back());
+		}
+		// The edges of higher order elements can bulge beyond their nodes.
+		CartesianVector3D diagonal = box.upper_corner() - box.lower_corner();
+		double extent = std::max(diagonal.x(), std::max(diagonal.y(), diagonal.z()));
+		box.pad(m_distance_tolerance + extent * (shape->order > 1 ? 0.25 : local_tolerance));
+		m_boxes.push_back(box);
+		m_element_tags.push_back(tag);
+		m_shapes.push_back(shape);
+		m_node_offsets.push_back((int)m_nodes.size());
+	}
+	m_bvh.build(m_boxes, num_threads);
+	return;
+}
+
+int HBTK::Gmsh::GmshElementLocator::number_of_elements() const
+{
+	return (int)m_element_tags.size();
+}
+
+bool HBTK::Gmsh::GmshElementLocator::in_element(int element, 
+	const CartesianPoint3D & point, double * local) const
+{
+	if (!m_boxes[element].contains(point)) { return false; }
+	const Elements::ElementShape & shape = *m_shapes[element];
+	const CartesianPoint3D * nodes = m_nodes.data() + m_node_offsets[element];
+	std::copy(shape.centre.begin(), shape.centre.end(), local);
+	if (!Elements::inverse_map(shape, nodes, point, local)) { return false; }
+	if (!shape.contains(local, local_tolerance)) { return false; }
+	if (shape.local_dimensions < 3) {
+		CartesianVector3D offset = Elements::forward_map(shape, nodes, local) - point;
+		return offset.magnitude() <= m_distance_tolerance;
+	}
+	return true;
+}
+
+int HBTK::Gmsh::GmshElementLocator::locate(const CartesianPoint3D & point, 
+	std::array<double, 3>& local) const
+{
+	std::array<double, 3> trial;
+	int element = m_bvh.first_containing(point, [&](int ele, const CartesianPoint3D & pnt) {
+		return in_element(ele, pnt, trial.data());
+	});
+	if (element < 0) { return -1; }
+	local = trial;
+	return m_element_tags[element];
+}
+
+void HBTK::Gmsh::GmshElementLocator::locate(const std::vector<CartesianPoint3D>& points, 
+	std::vector<int>& element_tags, std::vector<std::array<double, 3>>& locals, int num_threads) const
+{
+	element_tags.resize(points.size());
+	locals.resize(points.size());
+	parallel_for(0, (int)points.size(), [&](int i) {
+		element_tags[i] = locate(points[i], locals[i]);
+	}, num_threads);
+	return;
+}
@@ -126,6 +126,12 @@ const std::string HBTK::Gmsh::element_name(int ele_id)
 	case 32:
 		res = "64 node third order hexahedron";
 		break;
+	case 36:
+		res = "16 node third order quadrangle";
+		break;
+	case 39:
+		res = "12 node third order incomplete quadrangle";
+		break;
 	case 93:
 		res = "125 node fourth order hexahedron";
 		break;
@@ -237,6 +243,12 @@ const int HBTK::Gmsh::element_node_count(int ele_id)
 	case 32:
 		res = 64;
 		break;
+	case 36:
+		res = 16;
+		break;
+	case 39:
+		res = 12;
+		break;
 	case 93:
 		res = 125;
 		break;
@@ -348,6 +360,12 @@ const int HBTK::Gmsh::element_dimensions(int ele_id)
 	case 32:
 		res = 3;
 		break;
+	case 36:
+		res = 2;
+		break;
+	case 39:
+		res = 2;
+		break;
 	case 93:
 		res = 3;
 		break;
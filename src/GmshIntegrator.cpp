@@ -0,0 +1,116 @@
+#include "GmshIntegrator.h"
+/*////////////////////////////////////////////////////////////////////////////
+GmshIntegrator.cpp
+
+Integration of functions over the elements of a Gmsh mesh.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "ElementTabulation.h"
+
+HBTK::Gmsh::GmshIntegrator::GmshIntegrator()
+	: m_point_offsets(1, 0)
+{
+}
+
+HBTK::Gmsh::GmshIntegrator::GmshIntegrator(GmshMeshHolder & mesh, int group_tag, int order, int num_threads)
+	: GmshIntegrator()
+{
+	const std::unordered_set<int> & group = mesh.group_elements(group_tag);
+	build(mesh, std::vector<int>(group.begin(), group.end()), order, num_threads);
+}
+
+void HBTK::Gmsh::GmshIntegrator::build(GmshMeshHolder & mesh, 
+	const std::vector<int>& element_tags, int order, int num_threads)
+{
+	m_element_tags = element_tags;
+	std::sort(m_element_tags.begin(), m_element_tags.end());
+	m_point_offsets.assign(1, 0);
+
+	// One table per element type, and a copy of each element's nodes.
+	std::unordered_map<int, Elements::ShapeFunctionTable> tables;
+	std::vector<const Elements::ShapeFunctionTable *> element_tables;
+	std::vector<int> node_offsets(1, 0);
+	std::vector<CartesianPoint3D> nodes;
+	element_tables.reserve(m_element_tags.size());
+	for (int tag : m_element_tags) {
+		const int ele_id = mesh.element_id(tag);
+		auto table = tables.find(ele_id);
+		if (table == tables.end()) {
+			const Elements::ElementShape * shape = Elements::gmsh_element_shape(ele_id);
+			if (!shape) {
+				throw std::invalid_argument("HBTK::Gmsh::GmshIntegrator::build: "
+					"No shape functions for element " + std::to_string(tag) + " of type "
+					+ std::to_string(ele_id) + ". " __FILE__ ":" + std::to_string(__LINE__));
+			}
+			table = tables.emplace(ele_id, Elements::ShapeFunctionTable(*shape,
+				Elements::gmsh_element_cubature(ele_id, order))).first;
+		}
+		element_tables.push_back(&table->second);
+		for (int node_tag : mesh.element_node_tags(tag)) { nodes.push_back(mesh.node(node_tag)); }
+		node_offsets.push_back((int)nodes.size());
+		m_point_offsets.push_back(m_point_offsets.back() + table->second.number_of_points());
+	}
+
+	m_points.resize(m_point_offsets.back());
+	m_weights.resize(m_point_offsets.back());
+	parallel_for(0, number_of_elements(), [&](int ele) {
+		element_tables[ele]->map(nodes.data() + node_offsets[ele], 
+			m_points.data() + m_point_offsets[ele], m_weights.data() + m_point_offsets[ele]);
+	}, num_threads);
+	return;
+}
+
+int HBTK::Gmsh::GmshIntegrator::number_of_elements() const
+{
+	return (int)m_element_tags.size();
+}
+
+int HBTK::Gmsh::GmshIntegrator::number_of_points() const
+{
+	return (int)m_points.size();
+}
+
+const std::vector<int>& HBTK::Gmsh::GmshIntegrator::element_tags() const
+{
+	return m_element_tags;
+}
+
+int HBTK::Gmsh::GmshIntegrator::point_offset(int element) const
+{
+	return m_point_offsets[element];
+}
+
+const std::vector<HBTK::CartesianPoint3D>& HBTK::Gmsh::GmshIntegrator::points() const
+{
+	return m_points;
+}
+
+const std::vector<double>& HBTK::Gmsh::GmshIntegrator::weights() const
+{
+	return m_weights;
+}
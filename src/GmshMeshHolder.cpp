@@ -25,9 +25,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
+#include <string>
 
 #include "GmshInfo.h"
+#include "KdTree3D.h"
+#include "SpatialHash3D.h"
 
 HBTK::Gmsh::GmshMeshHolder::GmshMeshHolder()
 {
@@ -82,6 +87,24 @@ void HBTK::Gmsh::GmshMeshHolder::remove_node(int node_tag)
 	m_nodes.erase(node_tag);
 }
 
+/// \brief Gather the coordinates of the nodes given by node_tags into a
+/// structure-of-arrays container, in the order of node_tags. Nodes are 
+/// held in a hash map, so this is a copy.
+HBTK::PointArray3D HBTK::Gmsh::GmshMeshHolder::node_coordinates(const std::vector<int>& node_tags)
+{
+	PointArray3D coords((int)node_tags.size());
+	for (int i = 0; i < (int)node_tags.size(); i++) {
+		auto node = m_nodes.find(node_tags[i]);
+		if (node == m_nodes.end()) {
+			throw std::invalid_argument("HBTK::Gmsh::GmshMeshHolder::node_coordinates: "
+				"Node tag " + std::to_string(node_tags[i]) + " does not exist. "
+				__FILE__ ":" + std::to_string(__LINE__));
+		}
+		coords.set(i, node->second);
+	}
+	return coords;
+}
+
 /// \brief Returns the number of elements in container.
 int HBTK::Gmsh::GmshMeshHolder::number_of_elements()
 {
@@ -315,6 +338,132 @@ std::vector<int> HBTK::Gmsh::GmshMeshHolder::check_element_nodes_exist()
 	return problem_elements;
 }
 
+/// \brief Merge nodes within tolerance of each other into the node with 
+/// the lowest tag. Elements referring to merged nodes are updated. Returns 
+/// the number of nodes removed.
+int HBTK::Gmsh::GmshMeshHolder::merge_coincident_nodes(double tolerance)
+{
+	std::vector<int> tags = get_all_node_tags();
+	std::sort(tags.begin(), tags.end());
+	std::vector<CartesianPoint3D> coords(tags.size());
+	for (int i = 0; i < (int)tags.size(); i++) coords[i] = m_nodes[tags[i]];
+	std::vector<int> merge_map = coincident_point_map(coords, tolerance);
+
+	std::unordered_map<int, int> replacements;
+	for (int i = 0; i < (int)tags.size(); i++) {
+		if (merge_map[i] != i) {
+			replacements[tags[i]] = tags[merge_map[i]];
+			m_nodes.erase(tags[i]);
+		}
+	}
+	if (replacements.empty()) return 0;
+	for (auto & element : m_elements) {
+		for (int & node_tag : element.second.node_tags) {
+			auto replacement = replacements.find(node_tag);
+			if (replacement != replacements.end()) node_tag = replacement->second;
+		}
+	}
+	return (int)replacements.size();
+}
+
+/// \brief For each of points, the tag of the nearest node in the 
+/// container. Builds a k-d tree over the nodes each call, so batch queries.
+std::vector<int> HBTK::Gmsh::GmshMeshHolder::nearest_node_tags(
+	const std::vector<CartesianPoint3D>& points)
+{
+	std::vector<int> tags = get_all_node_tags();
+	std::vector<CartesianPoint3D> coords(tags.size());
+	for (int i = 0; i < (int)tags.size(); i++) coords[i] = m_nodes[tags[i]];
+	KdTree3D tree(coords);
+	std::vector<int> indices;
+	std::vector<double> distances;
+	tree.nearest(points, indices, distances);
+	for (int & index : indices) {
+		if (index >= 0) index = tags[index];
+	}
+	return indices;
+}
+
+/// \brief Dense indexing of the mesh for algorithms that work on arrays, 
+/// such as those in MeshReordering.h. node_tags and element_tags are sorted,
+/// and element i has nodes with tags 
+/// node_tags[element_nodes[element_offsets[i], element_offsets[i + 1])].
+void HBTK::Gmsh::GmshMeshHolder::dense_connectivity(std::vector<int> & node_tags, 
+	std::vector<int> & element_tags, std::vector<int> & element_offsets, 
+	std::vector<int> & element_nodes)
+{
+	node_tags = get_all_node_tags();
+	std::sort(node_tags.begin(), node_tags.end());
+	element_tags = get_all_element_tags();
+	std::sort(element_tags.begin(), element_tags.end());
+	std::unordered_map<int, int> node_index;
+	node_index.reserve(node_tags.size());
+	for (int i = 0; i < (int)node_tags.size(); i++) { node_index[node_tags[i]] = i; }
+	element_offsets.assign(1, 0);
+	element_nodes.clear();
+	for (int tag : element_tags) {
+		for (int node_tag : m_elements[tag].node_tags) {
+			element_nodes.push_back(node_index.at(node_tag));
+		}
+		element_offsets.push_back((int)element_nodes.size());
+	}
+}
+
+/// \brief Change the tag of every node to new_tags[old tag], updating 
+/// elements. Throws std::out_of_range if a node has no new tag.
+void HBTK::Gmsh::GmshMeshHolder::renumber_nodes(const std::unordered_map<int, int> & new_tags)
+{
+	std::unordered_map<int, CartesianPoint3D> nodes;
+	nodes.reserve(m_nodes.size());
+	for (auto & node : m_nodes) {
+		nodes.emplace(new_tags.at(node.first), node.second);
+	}
+	assert(nodes.size() == m_nodes.size());
+	m_nodes.swap(nodes);
+	for (auto & element : m_elements) {
+		for (int & node_tag : element.second.node_tags) {
+			node_tag = new_tags.at(node_tag);
+		}
+	}
+}
+
+/// \brief Change the tag of every element to new_tags[old tag], updating 
+/// groups. Throws std::out_of_range if an element has no new tag.
+void HBTK::Gmsh::GmshMeshHolder::renumber_elements(const std::unordered_map<int, int> & new_tags)
+{
+	std::unordered_map<int, struct element> elements;
+	elements.reserve(m_elements.size());
+	for (auto & element : m_elements) {
+		elements.emplace(new_tags.at(element.first), std::move(element.second));
+	}
+	assert(elements.size() == m_elements.size());
+	m_elements.swap(elements);
+	for (auto & group : m_groups) {
+		std::unordered_set<int> element_tags;
+		for (int tag : group.second.element_tags) {
+			element_tags.insert(new_tags.at(tag));
+		}
+		group.second.element_tags.swap(element_tags);
+	}
+}
+
+/// \brief Node to element and element to element connectivity of the mesh.
+/// Nodes and elements are numbered by their position in node_tags and 
+/// element_tags, which are sorted.
+HBTK::MeshTopology HBTK::Gmsh::GmshMeshHolder::topology(std::vector<int> & node_tags,
+	std::vector<int> & element_tags, int num_threads)
+{
+	std::vector<int> element_offsets, element_nodes;
+	dense_connectivity(node_tags, element_tags, element_offsets, element_nodes);
+	std::vector<MeshTopology::element_geometry> geometries;
+	geometries.reserve(element_tags.size());
+	for (int tag : element_tags) {
+		geometries.push_back(MeshTopology::gmsh_geometry(m_elements[tag].element_id));
+	}
+	return MeshTopology((int)node_tags.size(), geometries, element_offsets, element_nodes,
+		num_threads);
+}
+
 /// \brief returns a GmshParser that has been initialised to read to
 /// this GmshMeshHolder object.
 HBTK::Gmsh::GmshParser HBTK::Gmsh::GmshMeshHolder::get_parser()
@@ -24,13 +24,17 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
 #include <cassert>
 #include <exception>
+#include <stdexcept>
 
 #include "GmshMeshHolder.h"
 
 HBTK::Gmsh::GmshNodeDataHolder::GmshNodeDataHolder()
-	: m_node_data_type(scalar)
+	: m_time(0),
+	m_time_step(0),
+	m_node_data_type(scalar)
 {
 }
 
@@ -75,23 +79,30 @@ const double & HBTK::Gmsh::GmshNodeDataHolder::time() const
 }
 
 /// \brief Returns the number of nodes data recorded.
-int HBTK::Gmsh::GmshNodeDataHolder::number_of_node_data_points()
+int HBTK::Gmsh::GmshNodeDataHolder::number_of_node_data_points() const
 {
-	return (int)m_node_data.size();
+	return (int)m_tags.size();
 }
 
 /// \brief Returns true if node data for a node donated by node_tag 
 /// has been set.
-bool HBTK::Gmsh::GmshNodeDataHolder::node_data_exists(int node_tag)
+bool HBTK::Gmsh::GmshNodeDataHolder::node_data_exists(int node_tag) const
 {
-	return m_node_data.count(node_tag);
+	return slot(node_tag) >= 0;
 }
 
-/// \brief Returns the data associated with a given node.
-std::vector<double>& HBTK::Gmsh::GmshNodeDataHolder::node_data(int node_tag)
+/// \brief Returns the data associated with a given node: components() values.
+double * HBTK::Gmsh::GmshNodeDataHolder::node_data(int node_tag)
 {
 	assert(node_data_exists(node_tag));
-	return m_node_data[node_tag];
+	return m_values.data() + (size_t)slot(node_tag) * data_len();
+}
+
+/// \brief Returns the data associated with a given node: components() values.
+const double * HBTK::Gmsh::GmshNodeDataHolder::node_data(int node_tag) const
+{
+	assert(node_data_exists(node_tag));
+	return m_values.data() + (size_t)slot(node_tag) * data_len();
 }
 
 /// \brief Add data to node donated by node_tag to the data set. node_data
@@ -101,7 +112,6 @@ std::vector<double>& HBTK::Gmsh::GmshNodeDataHolder::node_data(int node_tag)
 /// asserts if node data already exists.
 void HBTK::Gmsh::GmshNodeDataHolder::add_node_data(int node_tag, std::vector<double> node_data)
 {
-	assert(!node_data_exists(node_tag));
 	if ((int)node_data.size() != data_len()) {
 		throw std::domain_error(
 			"HBTK::Gmsh::GmshNodeDataHolder the size of the node data vector ("
@@ -111,26 +121,92 @@ void HBTK::Gmsh::GmshNodeDataHolder::add_node_data(int node_tag, std::vector<dou
 			+ " : " + std::to_string(__LINE__)
 		);
 	}
-	m_node_data[node_tag] = node_data;
+	add_node_data(node_tag, node_data.data());
+}
+
+/// \brief Add data to node donated by node_tag to the data set. node_data
+/// points to components() values.
+/// asserts if node data already exists.
+void HBTK::Gmsh::GmshNodeDataHolder::add_node_data(int node_tag, const double * node_data)
+{
+	assert(node_tag >= 0);
+	assert(!node_data_exists(node_tag));
+	if (node_tag >= (int)m_slots.size()) {
+		m_slots.resize(std::max((size_t)node_tag + 1, 2 * m_slots.size()), -1);
+	}
+	m_slots[node_tag] = (int)m_tags.size();
+	m_tags.push_back(node_tag);
+	m_values.insert(m_values.end(), node_data, node_data + data_len());
 }
 
-/// \brief Remove node data associate with node_tag.
+/// \brief Remove node data associate with node_tag. The last node added
+/// takes its place in node_tags().
 void HBTK::Gmsh::GmshNodeDataHolder::remove_node_data(int node_tag)
 {
 	assert(node_data_exists(node_tag));
-	m_node_data.erase(node_tag);
+	const int removed = slot(node_tag), last = (int)m_tags.size() - 1;
+	const int len = data_len();
+	if (removed != last) {
+		m_tags[removed] = m_tags[last];
+		m_slots[m_tags[removed]] = removed;
+		std::copy(m_values.begin() + (size_t)last * len, m_values.end(), 
+			m_values.begin() + (size_t)removed * len);
+	}
+	m_slots[node_tag] = -1;
+	m_tags.pop_back();
+	m_values.resize(m_values.size() - len);
+}
+
+/// \brief The node tags with data, in the order of values().
+const std::vector<int> & HBTK::Gmsh::GmshNodeDataHolder::node_tags() const
+{
+	return m_tags;
+}
+
+/// \brief All the values, components() per node in the order of node_tags().
+const std::vector<double> & HBTK::Gmsh::GmshNodeDataHolder::values() const
+{
+	return m_values;
+}
+
+/// \brief Change the tag of every node to new_tags[old tag]. Throws
+/// std::out_of_range if a node has no new tag.
+void HBTK::Gmsh::GmshNodeDataHolder::renumber_node_tags(const std::unordered_map<int, int> & new_tags)
+{
+	for (int tag : m_tags) { m_slots[tag] = -1; }
+	for (int & tag : m_tags) { tag = new_tags.at(tag); }
+	for (int i = 0; i < (int)m_tags.size(); i++) {
+		const int tag = m_tags[i];
+		assert(tag >= 0);
+		if (tag >= (int)m_slots.size()) { m_slots.resize((size_t)tag + 1, -1); }
+		assert(m_slots[tag] == -1);
+		m_slots[tag] = i;
+	}
+}
+
+/// \brief Remove all node data. The storage is kept, so refilling the holder
+/// with the next time step of a similar dataset doesn't allocate.
+void HBTK::Gmsh::GmshNodeDataHolder::clear()
+{
+	for (int tag : m_tags) { m_slots[tag] = -1; }
+	m_tags.clear();
+	m_values.clear();
+}
+
+/// \brief Allocate space for count nodes with tags up to max_tag.
+void HBTK::Gmsh::GmshNodeDataHolder::reserve(int max_tag, int count)
+{
+	if (max_tag >= (int)m_slots.size()) { m_slots.resize((size_t)max_tag + 1, -1); }
+	m_tags.reserve(count);
+	m_values.reserve((size_t)count * data_len());
 }
 
 /// \brief Returns a vector of node_tags for which the corresponding data 
-/// vector is of the incorrect size of the selected data type.
+/// vector is of the incorrect size of the selected data type. Always empty:
+/// storage is sized by the data type.
 std::vector<int> HBTK::Gmsh::GmshNodeDataHolder::check_correct_node_data_length()
 {
-	std::vector<int> problem_node_tags;
-	for (auto & node : m_node_data) {
-		if ((int)node.second.size() != data_len()) {
-			problem_node_tags.push_back(node.first);
-		}
-	}
+	assert(m_values.size() == m_tags.size() * data_len());
 	return std::vector<int>();
 }
 
@@ -139,9 +215,9 @@ std::vector<int> HBTK::Gmsh::GmshNodeDataHolder::check_correct_node_data_length(
 std::vector<int> HBTK::Gmsh::GmshNodeDataHolder::check_consistant(GmshMeshHolder & mesh)
 { 
 	std::vector<int> problem_nodes;
-	for (auto & node : m_node_data) {
-		if (!mesh.node_tag_exists(node.first)) {
-			problem_nodes.push_back(node.first);
+	for (int tag : m_tags) {
+		if (!mesh.node_tag_exists(tag)) {
+			problem_nodes.push_back(tag);
 		}
 	}
 	return problem_nodes;
@@ -150,14 +226,41 @@ std::vector<int> HBTK::Gmsh::GmshNodeDataHolder::check_consistant(GmshMeshHolder
 /// \brief returns the node data type.
 ///
 /// Set to scalar (1 component), vector (3 component) or second order tensor (9
-/// component).
+/// component). Set this before adding data.
 HBTK::Gmsh::GmshNodeDataHolder::data_type & HBTK::Gmsh::GmshNodeDataHolder::node_data_type()
 {
 	return m_node_data_type;
 }
 
+const HBTK::Gmsh::GmshNodeDataHolder::data_type & HBTK::Gmsh::GmshNodeDataHolder::node_data_type() const
+{
+	return m_node_data_type;
+}
+
+int HBTK::Gmsh::GmshNodeDataHolder::components() const
+{
+	return data_len();
+}
+
+HBTK::Gmsh::GmshNodeDataHolder::data_type HBTK::Gmsh::GmshNodeDataHolder::data_type_with_components(int n)
+{
+	switch (n) {
+	case 1: return scalar;
+	case 3: return vector;
+	case 9: return tensor2;
+	default:
+		throw std::domain_error(
+			"HBTK::Gmsh::GmshNodeDataHolder no data type has " + std::to_string(n) 
+			+ " components. " __FILE__ " : " + std::to_string(__LINE__));
+	}
+}
+
+int HBTK::Gmsh::GmshNodeDataHolder::slot(int node_tag) const
+{
+	return node_tag >= 0 && node_tag < (int)m_slots.size() ? m_slots[node_tag] : -1;
+}
 
-int HBTK::Gmsh::GmshNodeDataHolder::data_len()
+int HBTK::Gmsh::GmshNodeDataHolder::data_len() const
 {
 	int len;
 	switch (m_node_data_type) {
@@ -176,7 +279,7 @@ int HBTK::Gmsh::GmshNodeDataHolder::data_len()
 	return len;
 }
 
-std::string HBTK::Gmsh::GmshNodeDataHolder::data_type_str()
+std::string HBTK::Gmsh::GmshNodeDataHolder::data_type_str() const
 {
 	std::string str;
 	switch (m_node_data_type) {
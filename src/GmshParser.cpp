@@ -29,6 +29,50 @@ SOFTWARE.
 #include <cctype>
 #include <algorithm>
 #include <array>
+#include <cstring>
+
+#include "NumberParsing.h"
+
+namespace {
+	// The holders differ only in names, so these let one parser fill either.
+	void set_header(HBTK::Gmsh::GmshNodeDataHolder & holder, int components)
+	{
+		holder.node_data_type() = HBTK::Gmsh::GmshNodeDataHolder::data_type_with_components(components);
+	}
+
+	void set_header(HBTK::Gmsh::GmshElementDataHolder & holder, int components)
+	{
+		holder.element_data_type() = HBTK::Gmsh::GmshElementDataHolder::data_type_with_components(components);
+	}
+
+	void add_data(HBTK::Gmsh::GmshNodeDataHolder & holder, int tag, const double * values)
+	{
+		holder.add_node_data(tag, values);
+	}
+
+	void add_data(HBTK::Gmsh::GmshElementDataHolder & holder, int tag, const double * values)
+	{
+		holder.add_element_data(tag, values);
+	}
+
+	bool data_exists(const HBTK::Gmsh::GmshNodeDataHolder & holder, int tag)
+	{
+		return holder.node_data_exists(tag);
+	}
+
+	bool data_exists(const HBTK::Gmsh::GmshElementDataHolder & holder, int tag)
+	{
+		return holder.element_data_exists(tag);
+	}
+
+	// String tags are written "in quotes".
+	std::string unquote(const std::string & line)
+	{
+		size_t first = line.find('"'), last = line.rfind('"');
+		if (first == std::string::npos || first == last) { throw -1; }
+		return line.substr(first + 1, last - first - 1);
+	}
+}
 
 /// \param func Function to be executed on finding physical name.
 ///
@@ -203,6 +247,40 @@ void HBTK::Gmsh::GmshParser::add_elem_function(std::function<bool(int, int, std:
 	elem_funcs.emplace_back(func);
 }
 
+/// \param func Function to be executed on parsing a $NodeData section.
+///
+/// \brief Define a function to be executed for every $NodeData section.
+///
+/// Each section is one dataset at one time step. It is read into a 
+/// GmshNodeDataHolder which is passed to the function and then reused for the
+/// next section, so a file with many time steps only ever holds one of them
+/// in memory. Functions should copy out what they need to keep. 
+///
+/// For example
+/// \code
+/// Gmsh::GmshParser my_parser;
+/// std::vector<double> max_pressure;
+/// my_parser.add_node_data_function([&](const Gmsh::GmshNodeDataHolder & data)->bool {
+///		if (data.data_description() != "Pressure") { return true; }
+///		max_pressure.push_back(*std::max_element(data.values().begin(), data.values().end()));
+///		return true;
+///	});
+/// my_parser.parse(<MY_MSH_FILE>);
+/// \endcode 
+void HBTK::Gmsh::GmshParser::add_node_data_function(std::function<bool(const GmshNodeDataHolder &)> func)
+{
+	node_data_funcs.emplace_back(func);
+}
+
+/// \param func Function to be executed on parsing a $ElementData section.
+///
+/// \brief Define a function to be executed for every $ElementData section.
+/// See add_node_data_function.
+void HBTK::Gmsh::GmshParser::add_element_data_function(std::function<bool(const GmshElementDataHolder &)> func)
+{
+	element_data_funcs.emplace_back(func);
+}
+
 /// \param file_path the absolute path to file to be parsed.
 /// 
 /// \brief Set the parser going on file defined by file_path
@@ -230,7 +308,7 @@ void HBTK::Gmsh::GmshParser::add_elem_function(std::function<bool(int, int, std:
 
 
 
-void HBTK::Gmsh::GmshParser::main_parser(std::ifstream & input_stream, std::ostream & error_stream)
+void HBTK::Gmsh::GmshParser::main_parser(std::istream & input_stream, std::ostream & error_stream)
 {
 	if (!input_stream) { throw -1; }
 	if (!error_stream) { throw -1; }
@@ -302,13 +380,26 @@ void HBTK::Gmsh::GmshParser::main_parser(std::ifstream & input_stream, std::ostr
 				throw line_count;
 			}
 			section_start_line = line_count;
+			if (current_section == node_data || current_section == element_data) {
+				try {
+					parse_data_section(input_stream, current_section, f_info, line_count);
+				}
+				catch (...) {
+					error_stream << "ERROR:\tInvalid ";
+					print_section_name(current_section, error_stream);
+					error_stream << " section starting at line " << section_start_line << ".\n";
+					error_stream << "ERROR:\tFailed at or before line " << line_count << ".\n";
+					throw line_count;
+				}
+				current_section = no_section;
+			}
 			continue;
 		}
 		// End of working on section header.
 
 		// Get expected number of objects.
 		if (expecting_object_count(current_section, line_count - section_start_line)) {
-			expect_lines_to_next_section = std::stoi(this_line);
+			expect_lines_to_next_section = HBTK::to_int(this_line);
 			if (current_section == nodes && f_info.binary ) {
 				b_info.parsing_binary = true;
 				b_info.count_var = expect_lines_to_next_section;
@@ -340,8 +431,7 @@ void HBTK::Gmsh::GmshParser::main_parser(std::ifstream & input_stream, std::ostr
 				expect_lines_to_next_section -= 1;
 				break;
 			default:
-				auto substrings = tokenise(this_line);
-				if (substrings.size() != 0 && substrings[0] != "") {
+				if (!split_fields(this_line).empty()) {
 					throw line_count;
 					// We have nonsection data, outside a section.
 				}
@@ -366,10 +456,10 @@ HBTK::Gmsh::GmshParser::file_section HBTK::Gmsh::GmshParser::parse_file_section(
 	(void)current_section; // Make this look used - we might want to improve our error messages at some point.
 	// Expects "$<section-name>" or "$End<section-name>"
 	file_section section = invalid;
-	auto strings = tokenise(input_string);
-	if (strings.size() > 1) { throw -2; }
+	const FieldSplitter & strings = split_fields(input_string);
+	if (strings.size() != 1) { throw -2; }
 
-	if (strings[0].substr(0, 4) == "$End") {
+	if (strings[0].starts_with("$End")) {
 		section = no_section;
 	}
 	else 
@@ -378,9 +468,9 @@ HBTK::Gmsh::GmshParser::file_section HBTK::Gmsh::GmshParser::parse_file_section(
 		else if (strings[0] == "$Elements") { section = elements; }
 		else if (strings[0] == "$MeshFormat") { section = file_info; }
 		else if (strings[0] == "$PhysicalNames") { section = physical_names; }
-		else if (strings[0] == "$NodeData"
-			|| strings[0] == "$ElementData"
-			|| strings[0] == "$InterpolationScheme"
+		else if (strings[0] == "$NodeData") { section = node_data; }
+		else if (strings[0] == "$ElementData") { section = element_data; }
+		else if (strings[0] == "$InterpolationScheme"
 			|| strings[0] == "$ElementNodeData"
 			|| strings[0] == "$Periodic")
 		{
@@ -393,17 +483,17 @@ HBTK::Gmsh::GmshParser::file_section HBTK::Gmsh::GmshParser::parse_file_section(
 
 void HBTK::Gmsh::GmshParser::parse_node_line(std::string line)
 {
-	auto strings = tokenise(line);
+	const FieldSplitter & strings = split_fields(line);
 	if (strings.size() != 4) {
 		throw -1;
 	};
 	int tag;
 	double x, y, z;
 
-	tag = std::stoi(strings[0]);
-	x = std::stod(strings[1]);
-	y = std::stod(strings[2]);
-	z = std::stod(strings[3]);
+	tag = HBTK::to_int(strings[0]);
+	x = HBTK::to_double(strings[1]);
+	y = HBTK::to_double(strings[2]);
+	z = HBTK::to_double(strings[3]);
 
 	for (auto func = node_funcs.begin(); func != node_funcs.end(); func++) {
 		if (!(*func)(tag, x, y, z)) { break; };
@@ -412,7 +502,7 @@ void HBTK::Gmsh::GmshParser::parse_node_line(std::string line)
 }
 
 
-void HBTK::Gmsh::GmshParser::parse_node_line_binary(std::ifstream & input_stream, binary_parse_info & b_info)
+void HBTK::Gmsh::GmshParser::parse_node_line_binary(std::istream & input_stream, binary_parse_info & b_info)
 {
 #pragma pack(1)
 	struct node_data {
@@ -435,13 +525,15 @@ void HBTK::Gmsh::GmshParser::parse_node_line_binary(std::ifstream & input_stream
 
 void HBTK::Gmsh::GmshParser::parse_elem_line(std::string input_string)
 {
-	auto strings = tokenise(input_string);
+	const FieldSplitter & strings = split_fields(input_string);
 	std::vector<int> values;
 	int id, type, n_tags;
 
-	for (auto string = strings.begin(); string != strings.end(); string++) {
-		values.emplace_back(std::stoi(*string));
+	values.reserve(strings.size());
+	for (StringView string : strings) {
+		values.emplace_back(HBTK::to_int(string));
 	}
+	if (values.size() < 3 || (int)values.size() < 3 + values[2]) { throw -1; }
 
 	id = values[0];
 	type = values[1];
@@ -456,7 +548,7 @@ void HBTK::Gmsh::GmshParser::parse_elem_line(std::string input_string)
 }
 
 
-void HBTK::Gmsh::GmshParser::parse_elem_binary_spec(std::ifstream & input_stream, struct binary_parse_info & b_info)
+void HBTK::Gmsh::GmshParser::parse_elem_binary_spec(std::istream & input_stream, struct binary_parse_info & b_info)
 {
 	// Expects 3 ints: ele_type, num_elem_to_follow, num_tags
 	assert(b_info.parsing_binary);
@@ -476,12 +568,12 @@ void HBTK::Gmsh::GmshParser::parse_elem_binary_spec(std::ifstream & input_stream
 }
 
 
-void HBTK::Gmsh::GmshParser::parse_elem_binary(std::ifstream & input_stream, struct binary_parse_info & b_info)
+void HBTK::Gmsh::GmshParser::parse_elem_binary(std::istream & input_stream, struct binary_parse_info & b_info)
 {
 	// Expect tag(int) n_tags*physTag(int) n_nodes*node_tag(int)
 	assert(b_info.parsing_binary);
 	assert(b_info.ele_nodes > 0);
-	assert(b_info.ele_tag_count > 0);
+	assert(b_info.ele_tag_count >= 0);
 	assert(input_stream.good());
 
 	int len = (1 + b_info.ele_tag_count + b_info.ele_nodes) * sizeof(int);
@@ -507,16 +599,17 @@ void HBTK::Gmsh::GmshParser::parse_elem_binary(std::ifstream & input_stream, str
 void HBTK::Gmsh::GmshParser::parse_phys_name_line(std::string inpt_string)
 {
 	// Expects <dimensions> <tag-id-thing> "<name>"
-	auto strings = tokenise(inpt_string);
+	const FieldSplitter & strings = split_fields(inpt_string);
+	if (strings.size() < 3) { throw -1; }
 
 	int dimension, phys_num;
 	std::string name;
 
-	dimension = std::stoi(strings[0]);
-	phys_num = std::stoi(strings[1]);
-	name = strings[2];
+	dimension = HBTK::to_int(strings[0]);
+	phys_num = HBTK::to_int(strings[1]);
+	name = strings[2].to_string();
 	for (auto i = strings.begin() + 3; i != strings.end(); i++) {
-		name += *i;
+		name += i->to_string();
 	}
 	name = name.substr(1, name.length() - 2);	//Remove quote marks.
 
@@ -527,17 +620,142 @@ void HBTK::Gmsh::GmshParser::parse_phys_name_line(std::string inpt_string)
 }
 
 
+void HBTK::Gmsh::GmshParser::parse_data_section(std::istream & input_stream, file_section section,
+	const file_format_info & f_info, int & line_count)
+{
+	// Expects:
+	//	<n string tags> then n lines of "<string tag>" - the first is the name.
+	//	<n real tags> then n lines of <real tag> - the first is the time.
+	//	<n int tags> then n lines of <int tag> - time step, components, count
+	//		and possibly partition.
+	//	count lines of <tag> <value> * components, or the same as binary int
+	//		and doubles.
+	//	$EndNodeData or $EndElementData
+	assert(section == node_data || section == element_data);
+	std::string line;
+	auto next_line = [&]() {
+		do {
+			if (!std::getline(input_stream, line)) { throw -1; }
+			line_count++;
+		} while (split_fields(line).empty());
+	};
+	auto next_number_line = [&]() -> StringView {
+		next_line();
+		const FieldSplitter & fields = split_fields(line);
+		if (fields.size() != 1) { throw -1; }
+		return fields[0];
+	};
+
+	std::string name;
+	int n_tags = HBTK::to_int(next_number_line());
+	for (int i = 0; i < n_tags; i++) {
+		next_line();
+		if (i == 0) { name = unquote(line); }
+	}
+	double time = 0;
+	n_tags = HBTK::to_int(next_number_line());
+	for (int i = 0; i < n_tags; i++) {
+		double value = HBTK::to_double(next_number_line());
+		if (i == 0) { time = value; }
+	}
+	int int_tags[3] = { 0, 1, 0 };
+	n_tags = HBTK::to_int(next_number_line());
+	if (n_tags < 3) { throw -1; }
+	for (int i = 0; i < n_tags; i++) {
+		int value = HBTK::to_int(next_number_line());
+		if (i < 3) { int_tags[i] = value; }
+	}
+	const int time_step = int_tags[0], components = int_tags[1], count = int_tags[2];
+	if (count < 0) { throw -1; }
+
+	if (section == node_data) {
+		m_node_data.clear();
+		set_header(m_node_data, components);
+		m_node_data.data_description() = name;
+		m_node_data.time() = time;
+		m_node_data.time_step() = time_step;
+		parse_data_values(input_stream, m_node_data, count, f_info.binary, line_count);
+		for (auto & func : node_data_funcs) {
+			if (!func(m_node_data)) { break; }
+		}
+	}
+	else {
+		m_element_data.clear();
+		set_header(m_element_data, components);
+		m_element_data.data_description() = name;
+		m_element_data.time() = time;
+		m_element_data.time_step() = time_step;
+		parse_data_values(input_stream, m_element_data, count, f_info.binary, line_count);
+		for (auto & func : element_data_funcs) {
+			if (!func(m_element_data)) { break; }
+		}
+	}
+
+	next_line();
+	const FieldSplitter & fields = split_fields(line);
+	if (fields.size() != 1 || !fields[0].starts_with("$End")) { throw -1; }
+}
+
+
+template<typename Holder>
+void HBTK::Gmsh::GmshParser::parse_data_values(std::istream & input_stream, Holder & holder, 
+	int count, bool binary, int & line_count)
+{
+	const int components = holder.components();
+	holder.reserve(0, count);
+	double values[9];
+	if (!binary) {
+		std::string line;
+		for (int i = 0; i < count; i++) {
+			do {
+				if (!std::getline(input_stream, line)) { throw -1; }
+				line_count++;
+			} while (split_fields(line).empty());
+			const FieldSplitter & fields = split_fields(line);
+			if ((int)fields.size() != 1 + components) { throw -1; }
+			for (int j = 0; j < components; j++) {
+				values[j] = HBTK::to_double(fields[j + 1]);
+			}
+			const int tag = HBTK::to_int(fields[0]);
+			if (tag < 0 || data_exists(holder, tag)) { throw line_count; }
+			add_data(holder, tag, values);
+		}
+		return;
+	}
+
+	// Binary records are <int tag><double value> * components, read in blocks.
+	const size_t record_size = sizeof(int) + components * sizeof(double);
+	const int block_records = 4096;
+	m_data_buffer.resize(record_size * block_records);
+	for (int done = 0; done < count;) {
+		const int records = std::min(block_records, count - done);
+		input_stream.read(m_data_buffer.data(), (std::streamsize)(records * record_size));
+		if (input_stream.gcount() != (std::streamsize)(records * record_size)) { throw -1; }
+		const char * record = m_data_buffer.data();
+		for (int i = 0; i < records; i++, record += record_size) {
+			int tag;
+			memcpy(&tag, record, sizeof(int));
+			memcpy(values, record + sizeof(int), components * sizeof(double));
+			if (tag < 0 || data_exists(holder, tag)) { throw line_count; }
+			add_data(holder, tag, values);
+		}
+		done += records;
+	}
+}
+
+
 void HBTK::Gmsh::GmshParser::parse_file_info(std::string this_line, binary_parse_info & b_info, file_format_info & f_info)
 {
-	auto strings = tokenise(this_line);
-	f_info.version = std::stod(strings[0]);
-	f_info.binary = (bool)std::stoi(strings[1]);
-	f_info.data_size = (size_t)std::stoi(strings[2]);
+	const FieldSplitter & strings = split_fields(this_line);
+	if (strings.size() != 3) { throw -1; }
+	f_info.version = HBTK::to_double(strings[0]);
+	f_info.binary = (bool)HBTK::to_int(strings[1]);
+	f_info.data_size = (size_t)HBTK::to_int(strings[2]);
 	if (f_info.binary) { b_info.parsing_binary = true; }
 	return;
 }
 
-void HBTK::Gmsh::GmshParser::parse_file_binary_endian(std::ifstream & input_stream, binary_parse_info & b_info, file_format_info & f_info)
+void HBTK::Gmsh::GmshParser::parse_file_binary_endian(std::istream & input_stream, binary_parse_info & b_info, file_format_info & f_info)
 {
 	int test_integer;
 	unpack_binary_to_struct(input_stream, test_integer);
@@ -581,6 +799,8 @@ int HBTK::Gmsh::GmshParser::element_type_node_count(int type)
 		case 29: { nc = 20; break; }
 		case 30: { nc = 35; break; }
 		case 31: { nc = 56; break; }
+		case 36: { nc = 16; break; }
+		case 39: { nc = 12; break; }
 		case 92: { nc = 64; break; }
 		case 93: { nc = 125; break; }
 		default: { nc = -1; break; }
@@ -619,6 +839,10 @@ void HBTK::Gmsh::GmshParser::print_section_name(file_section sect, std::ostream
 		break;
 	case physical_names: output << "PhysicalNames";
 		break;
+	case node_data: output << "NodeData";
+		break;
+	case element_data: output << "ElementData";
+		break;
 	case unsupported: output << "Unsupported file section (sorry)";
 		break;
 	case invalid: output << "[INVALID]";
@@ -25,11 +25,75 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <fstream>
+#include <limits>
 #include <memory>
 
 #include "GmshInfo.h"
+#include "Gzip.h"
+
+namespace {
+	// Shared by $NodeData and $ElementData, which differ only in name.
+	bool write_data_section(std::ostream & output_stream, const std::string & section,
+		const std::string & name, double time, int time_step, int components,
+		const std::vector<int> & tags, const std::vector<double> & values, bool binary)
+	{
+		if (!output_stream) { return false; }
+		auto precision = output_stream.precision(std::numeric_limits<double>::max_digits10);
+		output_stream << "$" << section << "\n";
+		output_stream << "1\n\"" << name << "\"\n";
+		output_stream << "1\n" << time << "\n";
+		output_stream << "3\n" << time_step << "\n" << components << "\n" << tags.size() << "\n";
+		if (binary) {
+			// Records of <int tag><double value> * components, in blocks.
+			const size_t record_size = sizeof(int) + components * sizeof(double);
+			const size_t block_records = 4096;
+			std::vector<char> buffer(record_size * std::min(block_records, tags.size()));
+			for (size_t done = 0; done < tags.size();) {
+				const size_t records = std::min(block_records, tags.size() - done);
+				char * record = buffer.data();
+				for (size_t i = done; i < done + records; i++, record += record_size) {
+					memcpy(record, &tags[i], sizeof(int));
+					memcpy(record + sizeof(int), &values[i * components], components * sizeof(double));
+				}
+				output_stream.write(buffer.data(), records * record_size);
+				done += records;
+			}
+			output_stream << "\n";
+		}
+		else {
+			for (size_t i = 0; i < tags.size(); i++) {
+				output_stream << tags[i];
+				for (int j = 0; j < components; j++) {
+					output_stream << " " << values[i * components + j];
+				}
+				output_stream << "\n";
+			}
+		}
+		output_stream << "$End" << section << "\n";
+		output_stream.precision(precision);
+		return output_stream.good();
+	}
+}
+
+
+HBTK::Gmsh::GmshWriter::GmshWriter()
+	: m_binary(false),
+	m_element_offsets(1, 0),
+	m_element_count(0),
+	m_stream(nullptr),
+	m_section(no_section),
+	m_section_remaining(0),
+	m_stream_ok(true),
+	m_block_type(-1),
+	m_block_tags(-1),
+	m_block_count(0),
+	m_block_start(0)
+{
+}
 
 
 int HBTK::Gmsh::GmshWriter::add_physical_group(int id, int dimensions, std::string name)
@@ -46,13 +110,25 @@ int HBTK::Gmsh::GmshWriter::add_physical_group(int id, int dimensions, std::stri
 
 int HBTK::Gmsh::GmshWriter::add_node(int id, double x, double y, double z)
 {
-	if (m_nodes.find(id) == m_nodes.end()) {
-		m_nodes.emplace(id, node_coordinate{ x, y, z });
+	const double coords[3] = { x, y, z };
+	if (m_stream) {
+		if (m_section != nodes || m_section_remaining < 1) { return -1; }
+		write_node(*m_stream, id, coords);
+		m_section_remaining--;
 		return 0;
 	}
-	else {
-		return -1;
+	// Appending in tag order is the fast path. Otherwise insert in place.
+	if (m_node_tags.empty() || id > m_node_tags.back()) {
+		m_node_tags.push_back(id);
+		m_node_coords.insert(m_node_coords.end(), coords, coords + 3);
+		return 0;
 	}
+	auto position = std::lower_bound(m_node_tags.begin(), m_node_tags.end(), id);
+	if (*position == id) { return -1; }
+	size_t index = position - m_node_tags.begin();
+	m_node_tags.insert(position, id);
+	m_node_coords.insert(m_node_coords.begin() + 3 * index, coords, coords + 3);
+	return 0;
 }
 
 
@@ -65,64 +141,267 @@ int HBTK::Gmsh::GmshWriter::add_element(int ele_type, const std::vector<int> & n
 int HBTK::Gmsh::GmshWriter::add_element(int ele_type, const std::vector<int> & node_ids, const std::vector<int> & phys_groups)
 {
 	assert((int)node_ids.size() == Gmsh::element_node_count(ele_type));
+	return add_element(ele_type, node_ids.data(), (int)phys_groups.size(), phys_groups.data());
+}
+
+
+int HBTK::Gmsh::GmshWriter::add_element(int ele_type, const int * node_ids, int n_groups, const int * phys_groups)
+{
+	const int node_count = Gmsh::element_node_count(ele_type);
+	if (node_count < 1 || n_groups < 0) { return -1; }
+	if (m_stream) {
+		if (m_section != elements || m_section_remaining < 1) { return -1; }
+		write_element(*m_stream, m_element_count, ele_type, n_groups, phys_groups, node_count, node_ids);
+		m_section_remaining--;
+		return m_element_count++;
+	}
+	m_element_types.push_back(ele_type);
+	m_element_ints.push_back(n_groups);
+	m_element_ints.insert(m_element_ints.end(), phys_groups, phys_groups + n_groups);
+	m_element_ints.insert(m_element_ints.end(), node_ids, node_ids + node_count);
+	m_element_offsets.push_back(m_element_ints.size());
+	return m_element_count++;
+}
 
-	int id = m_elements.size();
-	m_elements.emplace(id, element{ ele_type,
-		std::vector<int>(node_ids),
-		std::vector<int>(phys_groups) });
-	return id;
+
+void HBTK::Gmsh::GmshWriter::reserve(int nodes, int elements, int element_nodes)
+{
+	m_node_tags.reserve(nodes);
+	m_node_coords.reserve(3 * (size_t)nodes);
+	m_element_types.reserve(elements);
+	m_element_offsets.reserve((size_t)elements + 1);
+	m_element_ints.reserve((size_t)elements + element_nodes);
+}
+
+
+bool & HBTK::Gmsh::GmshWriter::binary()
+{
+	return m_binary;
 }
 
+
+const bool & HBTK::Gmsh::GmshWriter::binary() const
+{
+	return m_binary;
+}
+
+
 bool HBTK::Gmsh::GmshWriter::write(std::string path) {
-	std::ofstream output_stream(path);
+	std::ofstream output_stream(path, std::ios::binary);
+	if (has_gzip_extension(path) && output_stream) {
+		GzipOutputStream compressed_stream(output_stream);
+		bool written = write(compressed_stream);
+		compressed_stream.finish();
+		return written && output_stream.good();
+	}
 	return write(output_stream);
 }
 
 
-bool HBTK::Gmsh::GmshWriter::write(std::ofstream & output_stream)
+bool HBTK::Gmsh::GmshWriter::write(std::ostream & output_stream)
+{
+	if (!output_stream || m_stream) { return false; }
+
+	write_header(output_stream);
+	write_physical_groups(output_stream);
+	if (m_node_tags.size()) {
+		output_stream << "$Nodes\n" << m_node_tags.size() << "\n";
+		m_section = nodes;
+		for (size_t i = 0; i < m_node_tags.size(); i++) {
+			write_node(output_stream, m_node_tags[i], &m_node_coords[3 * i]);
+		}
+		end_section(output_stream);
+	}
+	if (m_element_types.size()) {
+		output_stream << "$Elements\n" << m_element_types.size() << "\n";
+		m_section = elements;
+		for (size_t i = 0; i < m_element_types.size(); i++) {
+			const int * ints = &m_element_ints[m_element_offsets[i]];
+			const int n_groups = ints[0];
+			const int node_count = (int)(m_element_offsets[i + 1] - m_element_offsets[i]) - 1 - n_groups;
+			write_element(output_stream, (int)i, m_element_types[i], n_groups, ints + 1, 
+				node_count, ints + 1 + n_groups);
+		}
+		end_section(output_stream);
+	}
+
+	output_stream.flush();
+	return output_stream.good();
+}
+
+
+bool HBTK::Gmsh::GmshWriter::begin(std::ostream & output_stream)
 {
-	if (!output_stream) { return false; }
+	if (m_stream || !output_stream) { return false; }
+	m_stream = &output_stream;
+	m_stream_ok = true;
+	write_header(output_stream);
+	write_physical_groups(output_stream);
+	return output_stream.good();
+}
 
-	// Write header
-	output_stream << "$MeshFormat\n2.2 0 0\n$EndMeshFormat\n";
-	// Write physical names
+
+bool HBTK::Gmsh::GmshWriter::begin_nodes(int count)
+{
+	if (!m_stream) { return false; }
+	if (m_section != no_section) {
+		m_stream_ok = m_stream_ok && m_section_remaining == 0;
+		end_section(*m_stream);
+	}
+	*m_stream << "$Nodes\n" << count << "\n";
+	m_section = nodes;
+	m_section_remaining = count;
+	return m_stream->good();
+}
+
+
+bool HBTK::Gmsh::GmshWriter::begin_elements(int count)
+{
+	if (!m_stream) { return false; }
+	if (m_section != no_section) {
+		m_stream_ok = m_stream_ok && m_section_remaining == 0;
+		end_section(*m_stream);
+	}
+	*m_stream << "$Elements\n" << count << "\n";
+	m_section = elements;
+	m_section_remaining = count;
+	return m_stream->good();
+}
+
+
+bool HBTK::Gmsh::GmshWriter::end()
+{
+	if (!m_stream) { return false; }
+	if (m_section != no_section) {
+		m_stream_ok = m_stream_ok && m_section_remaining == 0;
+		end_section(*m_stream);
+	}
+	m_stream->flush();
+	bool ok = m_stream_ok && m_stream->good();
+	m_stream = nullptr;
+	return ok;
+}
+
+
+void HBTK::Gmsh::GmshWriter::write_header(std::ostream & output_stream)
+{
+	output_stream << "$MeshFormat\n2.2 " << (m_binary ? 1 : 0) << " " << sizeof(double) << "\n";
+	if (m_binary) {
+		// Lets the reader check endianness.
+		const int one = 1;
+		output_stream.write(reinterpret_cast<const char*>(&one), sizeof(int));
+		output_stream << "\n";
+	}
+	output_stream << "$EndMeshFormat\n";
+}
+
+
+void HBTK::Gmsh::GmshWriter::write_physical_groups(std::ostream & output_stream)
+{
 	if (m_physical_groups.size()) {
-		output_stream << "$PhysicalNames\n";
+		output_stream << "$PhysicalNames\n" << m_physical_groups.size() << "\n";
 		for (auto const & phy_grp: m_physical_groups) {
-			output_stream << phy_grp.first << " "; // key - physical group id.
 			output_stream << phy_grp.second.dimensions << " ";
+			output_stream << phy_grp.first << " "; // key - physical group id.
 			output_stream << "\"" << phy_grp.second.name << "\"\n";
 		}
 		output_stream << "$EndPhysicalNames\n";
 	}
-	// Write nodes
-	if (m_nodes.size()) {
-		output_stream << "$Nodes\n";
-		for (auto const & node: m_nodes) {
-			output_stream << node.first << " "; // key - node number
-			output_stream << node.second.x << " " << node.second.y << " "
-				<< node.second.z << "\n";
+}
+
+
+void HBTK::Gmsh::GmshWriter::write_node(std::ostream & output_stream, int id, const double * coords)
+{
+	if (m_binary) {
+		// <int id><double x><double y><double z>, gathered into blocks.
+		size_t size = m_buffer.size();
+		m_buffer.resize(size + sizeof(int) + 3 * sizeof(double));
+		memcpy(&m_buffer[size], &id, sizeof(int));
+		memcpy(&m_buffer[size + sizeof(int)], coords, 3 * sizeof(double));
+		if (m_buffer.size() >= (1 << 16)) { flush_buffer(output_stream); }
+	}
+	else {
+		output_stream << id << " " << coords[0] << " " << coords[1] << " " << coords[2] << "\n";
+	}
+}
+
+
+void HBTK::Gmsh::GmshWriter::write_element(std::ostream & output_stream, int id, int ele_type,
+	int n_groups, const int * phys_groups, int node_count, const int * node_ids)
+{
+	if (m_binary) {
+		// Blocks of elements of one type and tag count, each preceded by 
+		// <int type><int count><int tag count>. The count is filled in when the
+		// block is closed.
+		if (m_block_count > 0 && (ele_type != m_block_type || n_groups != m_block_tags)) {
+			close_element_block();
 		}
-		output_stream << "$EndNodes\n";
-	}
-	// Write elements
-	if (m_elements.size()) {
-		output_stream << "$Elements\n";
-		for (auto const & elem : m_elements) {
-			output_stream << elem.first << " "; // key - element number
-			output_stream << elem.second.element_type << " ";
-			output_stream << (int)elem.second.phys_groups.size() << " "; // Number of physical groups
-			for (int const & grp_id : elem.second.phys_groups) {
-				output_stream << grp_id << " ";
-			}
-			for (int const & node_id : elem.second.nodes) {
-				output_stream << node_id << " ";
-			}
-			output_stream << "\n";
+		if (m_block_count == 0) {
+			m_block_start = m_buffer.size();
+			m_block_type = ele_type;
+			m_block_tags = n_groups;
+			const int header[3] = { ele_type, 0, n_groups };
+			m_buffer.resize(m_block_start + sizeof(header));
+			memcpy(&m_buffer[m_block_start], header, sizeof(header));
+		}
+		size_t size = m_buffer.size();
+		m_buffer.resize(size + (1 + n_groups + node_count) * sizeof(int));
+		memcpy(&m_buffer[size], &id, sizeof(int));
+		if (n_groups > 0) {	// phys_groups may be null.
+			memcpy(&m_buffer[size + sizeof(int)], phys_groups, n_groups * sizeof(int));
 		}
-		output_stream << "$EndElements\n";
+		memcpy(&m_buffer[size + (1 + n_groups) * sizeof(int)], node_ids, node_count * sizeof(int));
+		m_block_count++;
+		if (m_buffer.size() >= (1 << 16)) { flush_buffer(output_stream); }
 	}
+	else {
+		output_stream << id << " " << ele_type << " " << n_groups;
+		for (int i = 0; i < n_groups; i++) { output_stream << " " << phys_groups[i]; }
+		for (int i = 0; i < node_count; i++) { output_stream << " " << node_ids[i]; }
+		output_stream << "\n";
+	}
+}
+
+
+void HBTK::Gmsh::GmshWriter::close_element_block()
+{
+	if (m_block_count > 0) {
+		memcpy(&m_buffer[m_block_start + sizeof(int)], &m_block_count, sizeof(int));
+		m_block_count = 0;
+	}
+}
+
 
-	output_stream.close();
-	return true;
+void HBTK::Gmsh::GmshWriter::flush_buffer(std::ostream & output_stream)
+{
+	close_element_block();
+	output_stream.write(m_buffer.data(), m_buffer.size());
+	m_buffer.clear();
+}
+
+
+void HBTK::Gmsh::GmshWriter::end_section(std::ostream & output_stream)
+{
+	flush_buffer(output_stream);
+	if (m_binary) { output_stream << "\n"; }
+	output_stream << (m_section == nodes ? "$EndNodes\n" : "$EndElements\n");
+	m_section = no_section;
+}
+
+
+bool HBTK::Gmsh::GmshWriter::write_node_data(std::ostream & output_stream,
+	const GmshNodeDataHolder & data, bool binary)
+{
+	return write_data_section(output_stream, "NodeData", data.data_description(),
+		data.time(), data.time_step(), data.components(), data.node_tags(), data.values(),
+		binary);
+}
+
+
+bool HBTK::Gmsh::GmshWriter::write_element_data(std::ostream & output_stream,
+	const GmshElementDataHolder & data, bool binary)
+{
+	return write_data_section(output_stream, "ElementData", data.data_description(),
+		data.time(), data.time_step(), data.components(), data.element_tags(), data.values(),
+		binary);
 }
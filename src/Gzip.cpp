@@ -0,0 +1,962 @@
+#include "Gzip.h"
+/*////////////////////////////////////////////////////////////////////////////
+Gzip.cpp
+
+Reading and writing gzip compressed data.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "Parallel.h"
+
+namespace {
+	// Input per BGZF member, as in samtools, so members stay under 64 KiB.
+	const size_t bgzf_block_input = 65280;
+	// An empty BGZF member, marking the end of a BGZF file.
+	const unsigned char bgzf_eof[28] = { 0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff, 6, 0,
+		'B', 'C', 2, 0, 0x1b, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	const int window_size = 32768;
+
+	std::invalid_argument corrupt(const std::string & why, int line)
+	{
+		return std::invalid_argument("HBTK::gzip_decompress: Corrupt gzip data: " + why + ". "
+			__FILE__ ":" + std::to_string(line));
+	}
+
+	inline uint32_t read32(const unsigned char * p)
+	{
+		return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+	}
+
+	inline void append32(std::string & out, uint32_t value)
+	{
+		for (int i = 0; i < 4; i++) { out.push_back((char)((value >> (8 * i)) & 0xFF)); }
+	}
+
+	bool all_zero(const unsigned char * p, size_t size)
+	{
+		for (size_t i = 0; i < size; i++) {
+			if (p[i] != 0) { return false; }
+		}
+		return true;
+	}
+
+	// CRC-32, four bytes at a time.
+	struct Crc32Table {
+		uint32_t table[4][256];
+		Crc32Table() {
+			for (uint32_t i = 0; i < 256; i++) {
+				uint32_t crc = i;
+				for (int k = 0; k < 8; k++) { crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1; }
+				table[0][i] = crc;
+			}
+			for (int k = 1; k < 4; k++) {
+				for (int i = 0; i < 256; i++) {
+					table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+				}
+			}
+		}
+	};
+	const Crc32Table crc32_table;
+
+	uint32_t crc32(uint32_t crc, const char * data, size_t size)
+	{
+		const unsigned char * p = (const unsigned char*)data;
+		const uint32_t (&t)[4][256] = crc32_table.table;
+		crc = ~crc;
+		for (; size >= 4; size -= 4, p += 4) {
+			crc ^= read32(p);
+			crc = t[3][crc & 0xFF] ^ t[2][(crc >> 8) & 0xFF] ^ t[1][(crc >> 16) & 0xFF] ^ t[0][crc >> 24];
+		}
+		for (; size > 0; size--, p++) { crc = t[0][(crc ^ *p) & 0xFF] ^ (crc >> 8); }
+		return ~crc;
+	}
+
+	uint32_t adler32(const char * data, size_t size)
+	{
+		const unsigned char * p = (const unsigned char*)data;
+		uint32_t a = 1, b = 0;
+		while (size > 0) {
+			// Largest run before b can overflow.
+			size_t run = std::min(size, (size_t)5552);
+			size -= run;
+			for (; run > 0; run--, p++) {
+				a += *p;
+				b += a;
+			}
+			a %= 65521;
+			b %= 65521;
+		}
+		return b << 16 | a;
+	}
+
+	// DEFLATE length and distance codes.
+	const int length_base[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const int length_extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const int dist_base[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const int dist_extra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	// Order code length code lengths are stored in.
+	const int code_length_order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	inline int reverse_bits(int code, int length)
+	{
+		int reversed = 0;
+		for (int b = 0; b < length; b++) { reversed |= ((code >> b) & 1) << (length - 1 - b); }
+		return reversed;
+	}
+
+	// Canonical Huffman decoding. Codes of up to fast_bits are found with 
+	// one table lookup, longer ones bit by bit.
+	const int fast_bits = 10;
+
+	struct HuffmanDecoder {
+		uint16_t count[16];
+		uint16_t symbol[288];
+		uint16_t fast[1 << fast_bits];	// symbol | length << 9, or 0 if longer.
+
+		// False if the lengths over-subscribe the code.
+		bool build(const unsigned char * lengths, int n) {
+			memset(count, 0, sizeof(count));
+			for (int i = 0; i < n; i++) { count[lengths[i]]++; }
+			count[0] = 0;
+			int left = 1;
+			for (int len = 1; len < 16; len++) {
+				left = (left << 1) - count[len];
+				if (left < 0) { return false; }
+			}
+			uint16_t offsets[16];
+			offsets[1] = 0;
+			for (int len = 1; len < 15; len++) { offsets[len + 1] = offsets[len] + count[len]; }
+			for (int i = 0; i < n; i++) {
+				if (lengths[i]) { symbol[offsets[lengths[i]]++] = (uint16_t)i; }
+			}
+			memset(fast, 0, sizeof(fast));
+			int code = 0, index = 0;
+			for (int len = 1; len <= fast_bits; len++) {
+				for (int k = 0; k < count[len]; k++, code++) {
+					uint16_t entry = (uint16_t)(symbol[index++] | len << 9);
+					for (int fill = reverse_bits(code, len); fill < (1 << fast_bits); fill += 1 << len) {
+						fast[fill] = entry;
+					}
+				}
+				code <<= 1;
+			}
+			return true;
+		}
+	};
+
+	struct FixedDecoders {
+		HuffmanDecoder lit, dist;
+		FixedDecoders() {
+			unsigned char lengths[288];
+			for (int i = 0; i < 288; i++) { lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8; }
+			lit.build(lengths, 288);
+			for (int i = 0; i < 30; i++) { lengths[i] = 5; }
+			dist.build(lengths, 30);
+		}
+	};
+
+	const FixedDecoders & fixed_decoders()
+	{
+		static const FixedDecoders decoders;
+		return decoders;
+	}
+
+	// Decodes a DEFLATE stream a block at a time. Output is appended to a 
+	// string whose existing contents are the history back references use.
+	class Inflater {
+	public:
+		Inflater(const unsigned char * data, size_t size)
+			: m_data(data), m_size(size), m_pos(0), m_padding(0), m_bits(0), m_count(0), m_final(false)
+		{}
+
+		// Decode the next block onto out. False once the final block is done.
+		bool next_block(std::string & out) {
+			if (m_final) { return false; }
+			m_final = bits(1) == 1;
+			int type = (int)bits(2);
+			if (type == 0) { stored(out); }
+			else if (type == 1) { codes(out, fixed_decoders().lit, fixed_decoders().dist); }
+			else if (type == 2) { dynamic(out); }
+			else { throw corrupt("invalid block type", __LINE__); }
+			if (position() > m_size) { throw corrupt("truncated", __LINE__); }
+			return true;
+		}
+
+		// Bytes used so far, counting a partly used byte as used.
+		size_t position() const {
+			return m_pos + m_padding - m_count / 8;
+		}
+
+	private:
+		const unsigned char * m_data;
+		size_t m_size, m_pos, m_padding;
+		uint64_t m_bits;
+		int m_count;
+		bool m_final;
+
+		void refill() {
+			while (m_count <= 56) {
+				uint64_t byte = 0;
+				if (m_pos < m_size) { byte = m_data[m_pos++]; }
+				else if (++m_padding > 8) { throw corrupt("truncated", __LINE__); }
+				m_bits |= byte << m_count;
+				m_count += 8;
+			}
+		}
+
+		uint32_t bits(int n) {
+			if (m_count < n) { refill(); }
+			uint32_t value = (uint32_t)(m_bits & ((1ULL << n) - 1));
+			m_bits >>= n;
+			m_count -= n;
+			return value;
+		}
+
+		int decode(const HuffmanDecoder & h) {
+			if (m_count < 15) { refill(); }
+			uint16_t entry = h.fast[m_bits & ((1 << fast_bits) - 1)];
+			if (entry) {
+				int len = entry >> 9;
+				m_bits >>= len;
+				m_count -= len;
+				return entry & 511;
+			}
+			int code = 0, first = 0, index = 0;
+			for (int len = 1; len < 16; len++) {
+				code |= (int)(m_bits & 1);
+				m_bits >>= 1;
+				m_count--;
+				int count = h.count[len];
+				if (code - count < first) { return h.symbol[index + (code - first)]; }
+				index += count;
+				first = (first + count) << 1;
+				code <<= 1;
+			}
+			throw corrupt("invalid Huffman code", __LINE__);
+		}
+
+		void stored(std::string & out) {
+			bits(m_count % 8);
+			uint32_t len = bits(16), nlen = bits(16);
+			if (len != (~nlen & 0xFFFF)) { throw corrupt("stored block length mismatch", __LINE__); }
+			size_t pos = position();
+			if (pos > m_size || m_size - pos < len) { throw corrupt("truncated", __LINE__); }
+			out.append((const char*)m_data + pos, len);
+			m_pos = pos + len;
+			m_padding = 0;
+			m_bits = 0;
+			m_count = 0;
+		}
+
+		void dynamic(std::string & out) {
+			int nlen = (int)bits(5) + 257, ndist = (int)bits(5) + 1, ncode = (int)bits(4) + 4;
+			if (nlen > 286 || ndist > 30) { throw corrupt("too many codes", __LINE__); }
+			unsigned char lengths[316] = { 0 };
+			for (int i = 0; i < ncode; i++) { lengths[code_length_order[i]] = (unsigned char)bits(3); }
+			HuffmanDecoder length_decoder;
+			if (!length_decoder.build(lengths, 19)) { throw corrupt("invalid code lengths", __LINE__); }
+			memset(lengths, 0, 19);
+			int index = 0;
+			while (index < nlen + ndist) {
+				int sym = decode(length_decoder);
+				if (sym < 16) {
+					lengths[index++] = (unsigned char)sym;
+					continue;
+				}
+				unsigned char len = 0;
+				int repeat;
+				if (sym == 16) {
+					if (index == 0) { throw corrupt("repeat with no previous length", __LINE__); }
+					len = lengths[index - 1];
+					repeat = 3 + (int)bits(2);
+				}
+				else if (sym == 17) { repeat = 3 + (int)bits(3); }
+				else { repeat = 11 + (int)bits(7); }
+				if (index + repeat > nlen + ndist) { throw corrupt("too many code lengths", __LINE__); }
+				while (repeat--) { lengths[index++] = len; }
+			}
+			if (lengths[256] == 0) { throw corrupt("no end of block code", __LINE__); }
+			HuffmanDecoder lit, dist;
+			if (!lit.build(lengths, nlen) || !dist.build(lengths + nlen, ndist)) {
+				throw corrupt("invalid code lengths", __LINE__);
+			}
+			codes(out, lit, dist);
+		}
+
+		void codes(std::string & out, const HuffmanDecoder & lit, const HuffmanDecoder & dist) {
+			size_t n = out.size();
+			while (true) {
+				if (out.size() < n + 258) { out.resize(std::max(2 * out.size(), n + 65536)); }
+				char * o = &out[0];
+				int sym = decode(lit);
+				if (sym < 256) {
+					o[n++] = (char)sym;
+					continue;
+				}
+				if (sym == 256) { break; }
+				sym -= 257;
+				if (sym >= 29) { throw corrupt("invalid length code", __LINE__); }
+				int len = length_base[sym] + (int)bits(length_extra[sym]);
+				int dsym = decode(dist);
+				if (dsym >= 30) { throw corrupt("invalid distance code", __LINE__); }
+				size_t d = dist_base[dsym] + bits(dist_extra[dsym]);
+				if (d > n) { throw corrupt("distance too far back", __LINE__); }
+				const char * from = o + n - d;
+				if (d >= (size_t)len) { memcpy(o + n, from, len); }
+				else {
+					for (int k = 0; k < len; k++) { o[n + k] = from[k]; }
+				}
+				n += len;
+			}
+			out.resize(n);
+		}
+	};
+
+	struct MemberHeader {
+		size_t deflate_start;	// Offset of the DEFLATE stream.
+		size_t bgzf_size;		// Whole member size from a BGZF field, or 0.
+	};
+
+	MemberHeader read_header(const unsigned char * data, size_t size, size_t pos)
+	{
+		if (size - pos < 18) { throw corrupt("truncated", __LINE__); }
+		if (data[pos] != 0x1F || data[pos + 1] != 0x8B || data[pos + 2] != 8) {
+			throw corrupt("bad member header", __LINE__);
+		}
+		const int flags = data[pos + 3];
+		size_t p = pos + 10;
+		MemberHeader header = { 0, 0 };
+		if (flags & 4) {
+			size_t end = p + 2 + (data[p] | data[p + 1] << 8);
+			if (end > size) { throw corrupt("truncated", __LINE__); }
+			for (p += 2; p + 4 <= end; p += 4 + (data[p + 2] | data[p + 3] << 8)) {
+				if (data[p] == 'B' && data[p + 1] == 'C' && data[p + 2] == 2 && data[p + 3] == 0 && p + 6 <= end) {
+					header.bgzf_size = (size_t)(data[p + 4] | data[p + 5] << 8) + 1;
+				}
+			}
+			p = end;
+		}
+		for (int flag : { 8, 16 }) {	// File name, comment.
+			if (flags & flag) {
+				while (p < size && data[p]) { p++; }
+				p++;
+			}
+		}
+		if (flags & 2) { p += 2; }	// Header CRC.
+		if (p > size) { throw corrupt("truncated", __LINE__); }
+		header.deflate_start = p;
+		return header;
+	}
+
+	// Check the CRC and size of the member's output, out[start:], against 
+	// the trailer at data[pos]. Returns the position after the trailer.
+	size_t check_trailer(const unsigned char * data, size_t size, size_t pos, const char * out, size_t out_size)
+	{
+		if (pos > size || size - pos < 8) { throw corrupt("truncated", __LINE__); }
+		if (crc32(0, out, out_size) != read32(data + pos) || (uint32_t)out_size != read32(data + pos + 4)) {
+			throw corrupt("checksum mismatch", __LINE__);
+		}
+		return pos + 8;
+	}
+
+	// Append the member at pos to out. Returns the position after it.
+	size_t inflate_member(const unsigned char * data, size_t size, size_t pos, std::string & out)
+	{
+		MemberHeader header = read_header(data, size, pos);
+		const size_t start = out.size();
+		Inflater inflater(data + header.deflate_start, size - header.deflate_start);
+		while (inflater.next_block(out)) {}
+		return check_trailer(data, size, header.deflate_start + inflater.position(),
+			out.data() + start, out.size() - start);
+	}
+
+	// Greedy LZ77 over hash chains, then one dynamic Huffman block (or a 
+	// stored block if that is smaller).
+	class Deflater {
+	public:
+		std::string deflate(const unsigned char * data, int size);
+
+	private:
+		struct Symbol {
+			uint16_t value;		// Literal byte or match length.
+			uint16_t distance;	// 0 for literals.
+		};
+
+		static const int hash_bits = 15;
+		static const int max_chain = 32;
+
+		std::vector<int> m_head, m_prev;
+		std::vector<Symbol> m_symbols;
+
+		void find_matches(const unsigned char * data, int size);
+	};
+
+	struct SymbolTables {
+		unsigned char length_symbol[259];
+		unsigned char dist_symbol[window_size + 1];
+		SymbolTables() {
+			for (int s = 0; s < 29; s++) {
+				for (int len = length_base[s]; len < (s == 28 ? 259 : length_base[s + 1]); len++) {
+					length_symbol[len] = (unsigned char)s;
+				}
+			}
+			for (int s = 0; s < 30; s++) {
+				for (int d = dist_base[s]; d < (s == 29 ? window_size + 1 : dist_base[s + 1]); d++) {
+					dist_symbol[d] = (unsigned char)s;
+				}
+			}
+		}
+	};
+	const SymbolTables symbol_tables;
+
+	class BitWriter {
+	public:
+		BitWriter(std::string & out) : m_out(out), m_bits(0), m_count(0) {}
+		void put(uint32_t value, int n) {
+			m_bits |= (uint64_t)value << m_count;
+			m_count += n;
+			while (m_count >= 8) {
+				m_out.push_back((char)(m_bits & 0xFF));
+				m_bits >>= 8;
+				m_count -= 8;
+			}
+		}
+		void flush() {
+			if (m_count > 0) { m_out.push_back((char)(m_bits & 0xFF)); }
+			m_bits = 0;
+			m_count = 0;
+		}
+	private:
+		std::string & m_out;
+		uint64_t m_bits;
+		int m_count;
+	};
+
+	// Huffman code lengths of at most max_length for freqs. Frequencies are 
+	// flattened until the tree is shallow enough.
+	void huffman_lengths(std::vector<uint32_t> freqs, int max_length, unsigned char * lengths)
+	{
+		const int n = (int)freqs.size();
+		typedef std::pair<uint64_t, int> Node;
+		std::vector<int> parent(2 * n), depth(2 * n);
+		while (true) {
+			std::priority_queue<Node, std::vector<Node>, std::greater<Node>> heap;
+			for (int i = 0; i < n; i++) {
+				lengths[i] = 0;
+				if (freqs[i]) { heap.push(Node(freqs[i], i)); }
+			}
+			if (heap.size() < 2) {
+				if (!heap.empty()) { lengths[heap.top().second] = 1; }
+				return;
+			}
+			int next = n;
+			while (heap.size() > 1) {
+				Node a = heap.top(); heap.pop();
+				Node b = heap.top(); heap.pop();
+				parent[a.second] = next;
+				parent[b.second] = next;
+				heap.push(Node(a.first + b.first, next++));
+			}
+			// Children always come before their parents.
+			depth[next - 1] = 0;
+			for (int i = next - 2; i >= n; i--) { depth[i] = depth[parent[i]] + 1; }
+			int deepest = 0;
+			for (int i = 0; i < n; i++) {
+				if (freqs[i]) {
+					lengths[i] = (unsigned char)(depth[parent[i]] + 1);
+					deepest = std::max(deepest, (int)lengths[i]);
+				}
+			}
+			if (deepest <= max_length) { return; }
+			for (auto & f : freqs) {
+				if (f) { f = (f >> 1) | 1; }
+			}
+		}
+	}
+
+	void canonical_codes(const unsigned char * lengths, int n, uint16_t * codes)
+	{
+		int count[16] = { 0 }, next[16] = { 0 };
+		for (int i = 0; i < n; i++) { count[lengths[i]]++; }
+		count[0] = 0;
+		for (int len = 1, code = 0; len < 16; len++) {
+			code = (code + count[len - 1]) << 1;
+			next[len] = code;
+		}
+		for (int i = 0; i < n; i++) {
+			if (lengths[i]) { codes[i] = (uint16_t)reverse_bits(next[lengths[i]]++, lengths[i]); }
+		}
+	}
+
+	// Make sure a code has at least two symbols, as some decoders require.
+	void at_least_two(std::vector<uint32_t> & freqs)
+	{
+		int used = (int)std::count_if(freqs.begin(), freqs.end(), [](uint32_t f) { return f > 0; });
+		for (int i = 0; used < 2; i++) {
+			if (!freqs[i]) {
+				freqs[i] = 1;
+				used++;
+			}
+		}
+	}
+
+	void Deflater::find_matches(const unsigned char * data, int size)
+	{
+		const int min_match = 3, max_match = 258;
+		m_head.assign(1 << hash_bits, -1);
+		m_prev.resize(size);
+		m_symbols.clear();
+		auto hash = [data](int i) {
+			uint32_t v = (uint32_t)data[i] | (uint32_t)data[i + 1] << 8 | (uint32_t)data[i + 2] << 16;
+			return (int)((v * 2654435761u) >> (32 - hash_bits));
+		};
+		auto insert = [&](int i) {
+			int h = hash(i);
+			m_prev[i] = m_head[h];
+			m_head[h] = i;
+		};
+		int i = 0;
+		while (i < size) {
+			int best_len = 0, best_dist = 0;
+			if (i + min_match <= size) {
+				const int limit = std::min(max_match, size - i);
+				int candidate = m_head[hash(i)];
+				for (int chain = max_chain; candidate >= 0 && i - candidate <= window_size && chain > 0; chain--) {
+					if (data[candidate + best_len] == data[i + best_len]) {
+						int len = 0;
+						while (len < limit && data[candidate + len] == data[i + len]) { len++; }
+						if (len > best_len) {
+							best_len = len;
+							best_dist = i - candidate;
+							if (len == limit) { break; }
+						}
+					}
+					candidate = m_prev[candidate];
+				}
+				insert(i);
+			}
+			if (best_len >= min_match) {
+				m_symbols.push_back({ (uint16_t)best_len, (uint16_t)best_dist });
+				for (int k = i + 1; k < i + best_len && k + min_match <= size; k++) { insert(k); }
+				i += best_len;
+			}
+			else {
+				m_symbols.push_back({ data[i], 0 });
+				i++;
+			}
+		}
+	}
+
+	std::string Deflater::deflate(const unsigned char * data, int size)
+	{
+		assert(size < 65536);
+		find_matches(data, size);
+
+		std::vector<uint32_t> lit_freqs(286, 0), dist_freqs(30, 0);
+		for (const Symbol & s : m_symbols) {
+			if (s.distance == 0) { lit_freqs[s.value]++; }
+			else {
+				lit_freqs[257 + symbol_tables.length_symbol[s.value]]++;
+				dist_freqs[symbol_tables.dist_symbol[s.distance]]++;
+			}
+		}
+		lit_freqs[256] = 1;
+		at_least_two(lit_freqs);
+		at_least_two(dist_freqs);
+		unsigned char lengths[316];
+		unsigned char * lit_lengths = lengths, dist_lengths[30];
+		uint16_t lit_codes[286], dist_codes[30];
+		huffman_lengths(lit_freqs, 15, lit_lengths);
+		huffman_lengths(dist_freqs, 15, dist_lengths);
+		canonical_codes(lit_lengths, 286, lit_codes);
+		canonical_codes(dist_lengths, 30, dist_codes);
+		int nlen = 286, ndist = 30;
+		while (lit_lengths[nlen - 1] == 0) { nlen--; }
+		while (ndist > 1 && dist_lengths[ndist - 1] == 0) { ndist--; }
+		memcpy(lengths + nlen, dist_lengths, ndist);
+
+		// Run length code the code lengths: (symbol, extra bits value).
+		std::vector<std::pair<int, int>> runs;
+		std::vector<uint32_t> run_freqs(19, 0);
+		for (int i = 0; i < nlen + ndist;) {
+			int value = lengths[i], run = 1;
+			while (i + run < nlen + ndist && lengths[i + run] == value) { run++; }
+			i += run;
+			if (value == 0) {
+				for (; run >= 11; run -= std::min(run, 138)) { runs.push_back({ 18, std::min(run, 138) - 11 }); }
+				if (run >= 3) {
+					runs.push_back({ 17, run - 3 });
+					run = 0;
+				}
+			}
+			else {
+				runs.push_back({ value, 0 });
+				for (run--; run >= 3; run -= std::min(run, 6)) { runs.push_back({ 16, std::min(run, 6) - 3 }); }
+			}
+			for (; run > 0; run--) { runs.push_back({ value, 0 }); }
+		}
+		for (auto & run : runs) { run_freqs[run.first]++; }
+		at_least_two(run_freqs);
+		unsigned char run_lengths[19];
+		uint16_t run_codes[19];
+		huffman_lengths(run_freqs, 7, run_lengths);
+		canonical_codes(run_lengths, 19, run_codes);
+		int ncode = 19;
+		while (ncode > 4 && run_lengths[code_length_order[ncode - 1]] == 0) { ncode--; }
+
+		std::string out;
+		out.reserve(size / 2 + 64);
+		BitWriter writer(out);
+		writer.put(1, 1);	// Final block,
+		writer.put(2, 2);	// dynamic Huffman codes.
+		writer.put(nlen - 257, 5);
+		writer.put(ndist - 1, 5);
+		writer.put(ncode - 4, 4);
+		for (int i = 0; i < ncode; i++) { writer.put(run_lengths[code_length_order[i]], 3); }
+		const int run_extra[3] = { 2, 3, 7 };
+		for (auto & run : runs) {
+			writer.put(run_codes[run.first], run_lengths[run.first]);
+			if (run.first >= 16) { writer.put(run.second, run_extra[run.first - 16]); }
+		}
+		for (const Symbol & s : m_symbols) {
+			if (s.distance == 0) {
+				writer.put(lit_codes[s.value], lit_lengths[s.value]);
+				continue;
+			}
+			int ls = symbol_tables.length_symbol[s.value], ds = symbol_tables.dist_symbol[s.distance];
+			writer.put(lit_codes[257 + ls], lit_lengths[257 + ls]);
+			writer.put(s.value - length_base[ls], length_extra[ls]);
+			writer.put(dist_codes[ds], dist_lengths[ds]);
+			writer.put(s.distance - dist_base[ds], dist_extra[ds]);
+		}
+		writer.put(lit_codes[256], lit_lengths[256]);
+		writer.flush();
+
+		if (out.size() > (size_t)size + 5) {
+			// Incompressible: store.
+			out.clear();
+			out.push_back(1);
+			out.push_back((char)(size & 0xFF));
+			out.push_back((char)(size >> 8));
+			out.push_back((char)(~size & 0xFF));
+			out.push_back((char)((~size >> 8) & 0xFF));
+			out.append((const char*)data, size);
+		}
+		return out;
+	}
+
+	std::string bgzf_member(const char * data, size_t size)
+	{
+		assert(size <= bgzf_block_input);
+		Deflater deflater;
+		std::string deflated = deflater.deflate((const unsigned char*)data, (int)size);
+		const size_t block_size = 18 + deflated.size() + 8 - 1;
+		std::string member(bgzf_eof, bgzf_eof + 16);
+		member.push_back((char)(block_size & 0xFF));
+		member.push_back((char)(block_size >> 8));
+		member += deflated;
+		append32(member, crc32(0, data, size));
+		append32(member, (uint32_t)size);
+		return member;
+	}
+}
+
+bool HBTK::is_gzip(const char * data, size_t size)
+{
+	return size >= 2 && (unsigned char)data[0] == 0x1F && (unsigned char)data[1] == 0x8B;
+}
+
+std::string HBTK::gzip_decompress(const char * data, size_t size, int num_threads)
+{
+	const unsigned char * bytes = (const unsigned char*)data;
+	if (!is_gzip(data, size)) { throw corrupt("not gzip", __LINE__); }
+
+	// If every member records its size (BGZF), they can be found without
+	// decompressing and decompressed in parallel.
+	std::vector<size_t> members;
+	size_t total = 0, pos = 0;
+	bool bgzf = true;
+	while (pos < size && !all_zero(bytes + pos, size - pos)) {
+		MemberHeader header = read_header(bytes, size, pos);
+		if (header.bgzf_size == 0 || header.bgzf_size > size - pos) {
+			bgzf = false;
+			break;
+		}
+		members.push_back(pos);
+		pos += header.bgzf_size;
+		total += read32(bytes + pos - 4);
+	}
+
+	std::string out;
+	if (bgzf) {
+		const int count = (int)members.size();
+		std::vector<std::string> parts(count);
+		parallel_for(0, count, [&](int i) {
+			const size_t end = i + 1 < count ? members[i + 1] : pos;
+			parts[i].reserve(read32(bytes + end - 4) + 258);
+			if (inflate_member(bytes, end, members[i], parts[i]) != end) {
+				throw corrupt("BGZF block size mismatch", __LINE__);
+			}
+		}, num_threads);
+		out.reserve(total);
+		for (auto & part : parts) { out += part; }
+	}
+	else {
+		pos = 0;
+		while (pos < size && !all_zero(bytes + pos, size - pos)) {
+			pos = inflate_member(bytes, size, pos, out);
+		}
+	}
+	return out;
+}
+
+std::string HBTK::gzip_compress(const char * data, size_t size, int num_threads)
+{
+	const int count = (int)((size + bgzf_block_input - 1) / bgzf_block_input);
+	std::vector<std::string> members(count);
+	parallel_for(0, count, [&](int i) {
+		size_t start = i * bgzf_block_input;
+		members[i] = bgzf_member(data + start, std::min(bgzf_block_input, size - start));
+	}, num_threads);
+	std::string out;
+	for (auto & member : members) { out += member; }
+	out.append(bgzf_eof, bgzf_eof + sizeof(bgzf_eof));
+	return out;
+}
+
+void HBTK::zlib_decompress(const char * data, size_t size, std::string & out)
+{
+	const unsigned char * bytes = (const unsigned char*)data;
+	if (size < 6) { throw corrupt("truncated zlib stream", __LINE__); }
+	if ((bytes[0] & 0x0F) != 8 || (bytes[0] << 8 | bytes[1]) % 31 != 0) {
+		throw corrupt("bad zlib header", __LINE__);
+	}
+	if (bytes[1] & 0x20) { throw corrupt("zlib preset dictionaries are not supported", __LINE__); }
+	const size_t start = out.size();
+	Inflater inflater(bytes + 2, size - 2);
+	while (inflater.next_block(out)) {}
+	const size_t trailer = 2 + inflater.position();
+	if (trailer + 4 > size) { throw corrupt("truncated zlib stream", __LINE__); }
+	const uint32_t expected = (uint32_t)bytes[trailer] << 24 | (uint32_t)bytes[trailer + 1] << 16
+		| (uint32_t)bytes[trailer + 2] << 8 | (uint32_t)bytes[trailer + 3];
+	if (adler32(out.data() + start, out.size() - start) != expected) {
+		throw corrupt("checksum mismatch", __LINE__);
+	}
+}
+
+std::string HBTK::zlib_compress(const char * data, size_t size)
+{
+	assert(size <= bgzf_block_input);
+	Deflater deflater;
+	std::string out("\x78\x9c", 2);
+	out += deflater.deflate((const unsigned char*)data, (int)size);
+	const uint32_t check = adler32(data, size);
+	for (int i = 3; i >= 0; i--) { out.push_back((char)((check >> (8 * i)) & 0xFF)); }
+	return out;
+}
+
+bool HBTK::has_gzip_extension(const std::string & path)
+{
+	return path.size() >= 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+}
+
+HBTK::ByteSource HBTK::decompressed(ByteSource source, int num_threads)
+{
+	if (!source.contiguous()) {
+		std::ostringstream contents;
+		contents << source.stream().rdbuf();
+		source = ByteSource::from_string(contents.str());
+	}
+	if (!is_gzip(source.data(), source.size())) { return source; }
+	return ByteSource::from_string(gzip_decompress(source.data(), source.size(), num_threads));
+}
+
+class HBTK::GzipInputStream::Buffer
+	: public std::streambuf
+{
+public:
+	Buffer(ByteSource source)
+		: m_source(decompressed_input(std::move(source))),
+		m_data((const unsigned char*)m_source.data()),
+		m_size(m_source.size()),
+		m_pos(0), m_deflate_start(0), m_crc(0), m_member_size(0)
+	{}
+
+protected:
+	int_type underflow() override {
+		if (gptr() < egptr()) { return traits_type::to_int_type(*gptr()); }
+		while (true) {
+			if (!m_inflater) {
+				if (m_pos >= m_size || all_zero(m_data + m_pos, m_size - m_pos)) {
+					return traits_type::eof();
+				}
+				MemberHeader header = read_header(m_data, m_size, m_pos);
+				m_deflate_start = header.deflate_start;
+				m_inflater.reset(new Inflater(m_data + m_deflate_start, m_size - m_deflate_start));
+				m_out.clear();
+				m_crc = 0;
+				m_member_size = 0;
+			}
+			// Keep only the window back references can reach.
+			if (m_out.size() > (size_t)window_size) { m_out.erase(0, m_out.size() - window_size); }
+			const size_t old_size = m_out.size();
+			if (m_inflater->next_block(m_out)) {
+				if (m_out.size() == old_size) { continue; }
+				m_crc = crc32(m_crc, m_out.data() + old_size, m_out.size() - old_size);
+				m_member_size += (uint32_t)(m_out.size() - old_size);
+				char * base = &m_out[0];
+				setg(base, base + old_size, base + m_out.size());
+				return traits_type::to_int_type(*gptr());
+			}
+			const size_t trailer = m_deflate_start + m_inflater->position();
+			if (trailer > m_size || m_size - trailer < 8) { throw corrupt("truncated", __LINE__); }
+			if (m_crc != read32(m_data + trailer) || m_member_size != read32(m_data + trailer + 4)) {
+				throw corrupt("checksum mismatch", __LINE__);
+			}
+			m_pos = trailer + 8;
+			m_inflater.reset();
+		}
+	}
+
+private:
+	ByteSource m_source;
+	const unsigned char * m_data;
+	size_t m_size, m_pos, m_deflate_start;
+	std::unique_ptr<Inflater> m_inflater;
+	std::string m_out;
+	uint32_t m_crc, m_member_size;
+
+	// The compressed bytes, in memory.
+	static ByteSource decompressed_input(ByteSource source) {
+		if (source.contiguous()) { return source; }
+		std::ostringstream contents;
+		contents << source.stream().rdbuf();
+		return ByteSource::from_string(contents.str());
+	}
+};
+
+HBTK::GzipInputStream::GzipInputStream(ByteSource source)
+	: std::istream(nullptr),
+	m_buffer(new Buffer(std::move(source)))
+{
+	rdbuf(m_buffer.get());
+}
+
+HBTK::GzipInputStream::~GzipInputStream()
+{
+}
+
+class HBTK::GzipOutputStream::Buffer
+	: public std::streambuf
+{
+public:
+	Buffer(std::ostream & destination, int num_threads)
+		: m_destination(destination),
+		m_num_threads(num_threads > 0 ? num_threads : default_thread_count()),
+		m_block(bgzf_block_input),
+		m_finished(false)
+	{
+		setp(m_block.data(), m_block.data() + m_block.size());
+	}
+
+	void finish() {
+		if (m_finished) { return; }
+		if (pptr() > pbase()) { store_block(); }
+		compress_pending();
+		m_destination.write((const char*)bgzf_eof, sizeof(bgzf_eof));
+		m_destination.flush();
+		m_finished = true;
+	}
+
+protected:
+	int_type overflow(int_type c) override {
+		assert(!m_finished);
+		store_block();
+		if (!traits_type::eq_int_type(c, traits_type::eof())) {
+			*pptr() = traits_type::to_char_type(c);
+			pbump(1);
+		}
+		return traits_type::not_eof(c);
+	}
+
+	// Only whole blocks are written, so frequent flushes don't make tiny
+	// members.
+	int sync() override {
+		compress_pending();
+		m_destination.flush();
+		return m_destination ? 0 : -1;
+	}
+
+private:
+	std::ostream & m_destination;
+	int m_num_threads;
+	std::vector<char> m_block;
+	std::vector<std::string> m_pending;
+	bool m_finished;
+
+	void store_block() {
+		m_pending.emplace_back(pbase(), pptr());
+		setp(m_block.data(), m_block.data() + m_block.size());
+		if ((int)m_pending.size() >= m_num_threads) { compress_pending(); }
+	}
+
+	void compress_pending() {
+		std::vector<std::string> members(m_pending.size());
+		parallel_for(0, (int)m_pending.size(), [&](int i) {
+			members[i] = bgzf_member(m_pending[i].data(), m_pending[i].size());
+		}, m_num_threads);
+		for (auto & member : members) { m_destination.write(member.data(), member.size()); }
+		m_pending.clear();
+	}
+};
+
+HBTK::GzipOutputStream::GzipOutputStream(std::ostream & destination, int num_threads)
+	: std::ostream(nullptr),
+	m_buffer(new Buffer(destination, num_threads))
+{
+	rdbuf(m_buffer.get());
+}
+
+HBTK::GzipOutputStream::~GzipOutputStream()
+{
+	try { finish(); }
+	catch (...) {}
+}
+
+void HBTK::GzipOutputStream::finish()
+{
+	m_buffer->finish();
+}
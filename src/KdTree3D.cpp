@@ -0,0 +1,303 @@
+#include "KdTree3D.h"
+/*////////////////////////////////////////////////////////////////////////////
+KdTree3D.cpp
+
+A static k-d tree over a set of points in 3D for nearest neighbour and
+radius searches.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <utility>
+
+#include "Parallel.h"
+
+namespace {
+	// Ranges larger than this may be built on another thread.
+	const int parallel_build_threshold = 1 << 14;
+}
+
+// The k best candidates so far as a max-heap on (squared distance, index),
+// so ties in distance go to the lower index.
+struct HBTK::KdTree3D::query_state {
+	double px, py, pz;
+	int k;
+	std::vector<std::pair<double, int>> heap;
+
+	double worst() const {
+		return ((int)heap.size() < k ? std::numeric_limits<double>::infinity() : heap.front().first);
+	}
+
+	void offer(double dist_sq, int index) {
+		std::pair<double, int> candidate(dist_sq, index);
+		if ((int)heap.size() < k) {
+			heap.push_back(candidate);
+			std::push_heap(heap.begin(), heap.end());
+		}
+		else if (candidate < heap.front()) {
+			std::pop_heap(heap.begin(), heap.end());
+			heap.back() = candidate;
+			std::push_heap(heap.begin(), heap.end());
+		}
+	}
+};
+
+HBTK::KdTree3D::KdTree3D()
+{
+}
+
+HBTK::KdTree3D::KdTree3D(const std::vector<CartesianPoint3D>& points, int num_threads)
+{
+	build(points, num_threads);
+}
+
+void HBTK::KdTree3D::build(const std::vector<CartesianPoint3D>& points, int num_threads)
+{
+	int n = (int)points.size();
+	m_index.resize(n);
+	m_split.assign(n, 0);
+	for (int i = 0; i < n; i++) { m_index[i] = i; }
+
+	if (num_threads <= 0) { num_threads = default_thread_count(); }
+	int parallel_depth = 0;
+	while ((1 << parallel_depth) < num_threads) { parallel_depth++; }
+	build_range(0, n, 0, parallel_depth, points);
+
+	m_x.resize(n);
+	m_y.resize(n);
+	m_z.resize(n);
+	for (int i = 0; i < n; i++) {
+		const CartesianPoint3D & p = points[m_index[i]];
+		m_x[i] = p.x();
+		m_y[i] = p.y();
+		m_z[i] = p.z();
+	}
+	return;
+}
+
+void HBTK::KdTree3D::build_range(int begin, int end, int depth, int parallel_depth,
+	const std::vector<CartesianPoint3D>& points)
+{
+	if (end - begin <= leaf_size) { return; }
+	// Split on the dimension of greatest spread.
+	std::array<double, 3> lower, upper;
+	lower = upper = points[m_index[begin]].as_array();
+	for (int i = begin + 1; i < end; i++) {
+		const std::array<double, 3> & p = points[m_index[i]].as_array();
+		for (int d = 0; d < 3; d++) {
+			lower[d] = std::min(lower[d], p[d]);
+			upper[d] = std::max(upper[d], p[d]);
+		}
+	}
+	int dim = 0;
+	for (int d = 1; d < 3; d++) {
+		if (upper[d] - lower[d] > upper[dim] - lower[dim]) { dim = d; }
+	}
+	int mid = (begin + end) / 2;
+	std::nth_element(m_index.begin() + begin, m_index.begin() + mid, m_index.begin() + end,
+		[&](int a, int b) { 
+		double pa = points[a].as_array()[dim], pb = points[b].as_array()[dim];
+		return pa < pb || (pa == pb && a < b);
+	});
+	m_split[mid] = (unsigned char)dim;
+
+	if (depth < parallel_depth && end - begin > parallel_build_threshold) {
+		auto left = std::async(std::launch::async, [&]() {
+			build_range(begin, mid, depth + 1, parallel_depth, points); });
+		build_range(mid + 1, end, depth + 1, parallel_depth, points);
+		left.get();
+	}
+	else {
+		build_range(begin, mid, depth + 1, parallel_depth, points);
+		build_range(mid + 1, end, depth + 1, parallel_depth, points);
+	}
+	return;
+}
+
+int HBTK::KdTree3D::size() const
+{
+	return (int)m_index.size();
+}
+
+void HBTK::KdTree3D::search_range(int begin, int end, query_state & state) const
+{
+	if (end - begin <= leaf_size) {
+		for (int i = begin; i < end; i++) {
+			double dx = m_x[i] - state.px, dy = m_y[i] - state.py, dz = m_z[i] - state.pz;
+			state.offer(dx * dx + dy * dy + dz * dz, m_index[i]);
+		}
+		return;
+	}
+	int mid = (begin + end) / 2;
+	double dx = m_x[mid] - state.px, dy = m_y[mid] - state.py, dz = m_z[mid] - state.pz;
+	state.offer(dx * dx + dy * dy + dz * dz, m_index[mid]);
+	int dim = m_split[mid];
+	double diff = (dim == 0 ? dx : (dim == 1 ? dy : dz));
+	// diff > 0 means the query point is on the lower side of the split.
+	if (diff > 0) {
+		search_range(begin, mid, state);
+		if (diff * diff <= state.worst()) { search_range(mid + 1, end, state); }
+	}
+	else {
+		search_range(mid + 1, end, state);
+		if (diff * diff <= state.worst()) { search_range(begin, mid, state); }
+	}
+	return;
+}
+
+void HBTK::KdTree3D::radius_range(int begin, int end, double px, double py, double pz,
+	double radius_sq, std::vector<int>& found) const
+{
+	if (end - begin <= leaf_size) {
+		for (int i = begin; i < end; i++) {
+			double dx = m_x[i] - px, dy = m_y[i] - py, dz = m_z[i] - pz;
+			if (dx * dx + dy * dy + dz * dz <= radius_sq) { found.push_back(m_index[i]); }
+		}
+		return;
+	}
+	int mid = (begin + end) / 2;
+	double dx = m_x[mid] - px, dy = m_y[mid] - py, dz = m_z[mid] - pz;
+	if (dx * dx + dy * dy + dz * dz <= radius_sq) { found.push_back(m_index[mid]); }
+	int dim = m_split[mid];
+	double diff = (dim == 0 ? dx : (dim == 1 ? dy : dz));
+	if (diff >= 0 || diff * diff <= radius_sq) { radius_range(begin, mid, px, py, pz, radius_sq, found); }
+	if (diff <= 0 || diff * diff <= radius_sq) { radius_range(mid + 1, end, px, py, pz, radius_sq, found); }
+	return;
+}
+
+void HBTK::KdTree3D::nearest_range(int begin, int end, double px, double py, double pz,
+	double & best_sq, int & best) const
+{
+	// As search_range with k = 1, ties going to the lower index.
+	if (end - begin <= leaf_size) {
+		for (int i = begin; i < end; i++) {
+			double dx = m_x[i] - px, dy = m_y[i] - py, dz = m_z[i] - pz;
+			double dist_sq = dx * dx + dy * dy + dz * dz;
+			if (dist_sq < best_sq || (dist_sq == best_sq && m_index[i] < best)) {
+				best_sq = dist_sq;
+				best = m_index[i];
+			}
+		}
+		return;
+	}
+	int mid = (begin + end) / 2;
+	double dx = m_x[mid] - px, dy = m_y[mid] - py, dz = m_z[mid] - pz;
+	double dist_sq = dx * dx + dy * dy + dz * dz;
+	if (dist_sq < best_sq || (dist_sq == best_sq && m_index[mid] < best)) {
+		best_sq = dist_sq;
+		best = m_index[mid];
+	}
+	int dim = m_split[mid];
+	double diff = (dim == 0 ? dx : (dim == 1 ? dy : dz));
+	if (diff > 0) {
+		nearest_range(begin, mid, px, py, pz, best_sq, best);
+		if (diff * diff <= best_sq) { nearest_range(mid + 1, end, px, py, pz, best_sq, best); }
+	}
+	else {
+		nearest_range(mid + 1, end, px, py, pz, best_sq, best);
+		if (diff * diff <= best_sq) { nearest_range(begin, mid, px, py, pz, best_sq, best); }
+	}
+	return;
+}
+
+int HBTK::KdTree3D::nearest(const CartesianPoint3D & point, double & distance) const
+{
+	int best = -1;
+	double best_sq = std::numeric_limits<double>::infinity();
+	nearest_range(0, size(), point.x(), point.y(), point.z(), best_sq, best);
+	distance = std::sqrt(best_sq);
+	return best;
+}
+
+void HBTK::KdTree3D::k_nearest(const CartesianPoint3D & point, int k, 
+	std::vector<int>& indices, std::vector<double>& distances) const
+{
+	assert(k >= 0);
+	query_state state;
+	state.px = point.x();
+	state.py = point.y();
+	state.pz = point.z();
+	state.k = k;
+	state.heap.reserve(k);
+	if (k > 0) { search_range(0, size(), state); }
+	std::sort_heap(state.heap.begin(), state.heap.end());
+	indices.resize(state.heap.size());
+	distances.resize(state.heap.size());
+	for (int i = 0; i < (int)state.heap.size(); i++) {
+		indices[i] = state.heap[i].second;
+		distances[i] = std::sqrt(state.heap[i].first);
+	}
+	return;
+}
+
+std::vector<int> HBTK::KdTree3D::within_radius(const CartesianPoint3D & point, double radius) const
+{
+	std::vector<int> found;
+	radius_range(0, size(), point.x(), point.y(), point.z(), radius * radius, found);
+	std::sort(found.begin(), found.end());
+	return found;
+}
+
+void HBTK::KdTree3D::nearest(const std::vector<CartesianPoint3D>& points, 
+	std::vector<int>& indices, std::vector<double>& distances, int num_threads) const
+{
+	indices.resize(points.size());
+	distances.resize(points.size());
+	parallel_for(0, (int)points.size(), [&](int i) {
+		indices[i] = nearest(points[i], distances[i]);
+	}, num_threads);
+	return;
+}
+
+void HBTK::KdTree3D::k_nearest(const std::vector<CartesianPoint3D>& points, int k, 
+	std::vector<int>& indices, std::vector<double>& distances, int num_threads) const
+{
+	indices.assign(points.size() * k, -1);
+	distances.assign(points.size() * k, std::numeric_limits<double>::infinity());
+	parallel_blocks(0, (int)points.size(),
+		(num_threads > 0 ? num_threads : default_thread_count()),
+		[&](int begin, int end, int) {
+		std::vector<int> idxs;
+		std::vector<double> dists;
+		for (int i = begin; i < end; i++) {
+			k_nearest(points[i], k, idxs, dists);
+			std::copy(idxs.begin(), idxs.end(), indices.begin() + i * k);
+			std::copy(dists.begin(), dists.end(), distances.begin() + i * k);
+		}
+	});
+	return;
+}
+
+std::vector<std::vector<int>> HBTK::KdTree3D::within_radius(const std::vector<CartesianPoint3D>& points, 
+	double radius, int num_threads) const
+{
+	std::vector<std::vector<int>> found(points.size());
+	parallel_for(0, (int)points.size(), [&](int i) {
+		found[i] = within_radius(points[i], radius);
+	}, num_threads);
+	return found;
+}
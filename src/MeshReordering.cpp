@@ -0,0 +1,302 @@
+#include "MeshReordering.h"
+/*////////////////////////////////////////////////////////////////////////////
+MeshReordering.cpp
+
+Renumbering mesh nodes and elements to improve memory locality.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+namespace {
+	// Bits per axis of space filling curve keys.
+	const int sfc_bits = 21;
+
+	// Node adjacency in CSR form: nodes sharing an element are adjacent.
+	void node_adjacency(int number_of_nodes, const std::vector<int> & element_offsets,
+		const std::vector<int> & element_nodes, std::vector<int> & offsets, 
+		std::vector<int> & adjacent)
+	{
+		const int number_of_elements = (int)element_offsets.size() - 1;
+		std::vector<int> node_element_offsets(number_of_nodes + 1, 0);
+		for (int node : element_nodes) { node_element_offsets[node + 1]++; }
+		std::partial_sum(node_element_offsets.begin(), node_element_offsets.end(), 
+			node_element_offsets.begin());
+		std::vector<int> node_elements(element_nodes.size());
+		std::vector<int> fill(node_element_offsets.begin(), node_element_offsets.end() - 1);
+		for (int e = 0; e < number_of_elements; e++) {
+			for (int i = element_offsets[e]; i < element_offsets[e + 1]; i++) {
+				node_elements[fill[element_nodes[i]]++] = e;
+			}
+		}
+
+		std::vector<int> marker(number_of_nodes, -1);
+		offsets.assign(1, 0);
+		offsets.reserve(number_of_nodes + 1);
+		adjacent.clear();
+		for (int node = 0; node < number_of_nodes; node++) {
+			marker[node] = node;
+			for (int j = node_element_offsets[node]; j < node_element_offsets[node + 1]; j++) {
+				const int e = node_elements[j];
+				for (int i = element_offsets[e]; i < element_offsets[e + 1]; i++) {
+					const int other = element_nodes[i];
+					if (marker[other] != node) {
+						marker[other] = node;
+						adjacent.push_back(other);
+					}
+				}
+			}
+			offsets.push_back((int)adjacent.size());
+		}
+	}
+
+	// Breadth first search from root. Returns the number of levels and puts 
+	// the nodes of the last level in last_level. visited must be unique to
+	// this call for the nodes reached.
+	int level_structure(int root, const std::vector<int> & offsets, 
+		const std::vector<int> & adjacent, std::vector<int> & visited, int stamp,
+		std::vector<int> & last_level)
+	{
+		std::vector<int> level(1, root), next;
+		visited[root] = stamp;
+		int levels = 0;
+		while (!level.empty()) {
+			levels++;
+			next.clear();
+			for (int node : level) {
+				for (int j = offsets[node]; j < offsets[node + 1]; j++) {
+					if (visited[adjacent[j]] != stamp) {
+						visited[adjacent[j]] = stamp;
+						next.push_back(adjacent[j]);
+					}
+				}
+			}
+			if (next.empty()) { last_level = level; }
+			level.swap(next);
+		}
+		return levels;
+	}
+
+	uint64_t spread_bits(uint64_t x)
+	{
+		// Put two zero bits between each of the low 21 bits of x.
+		x &= 0x1fffff;
+		x = (x | x << 32) & 0x1f00000000ffffULL;
+		x = (x | x << 16) & 0x1f0000ff0000ffULL;
+		x = (x | x << 8) & 0x100f00f00f00f00fULL;
+		x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+		x = (x | x << 2) & 0x1249249249249249ULL;
+		return x;
+	}
+
+	uint64_t morton_key(uint32_t x[3])
+	{
+		return spread_bits(x[0]) << 2 | spread_bits(x[1]) << 1 | spread_bits(x[2]);
+	}
+
+	uint64_t hilbert_key(uint32_t x[3])
+	{
+		// Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707 (2004):
+		// transform coordinates to the transposed Hilbert index in place.
+		const uint32_t m = 1u << (sfc_bits - 1);
+		for (uint32_t q = m; q > 1; q >>= 1) {
+			const uint32_t p = q - 1;
+			for (int i = 0; i < 3; i++) {
+				if (x[i] & q) { x[0] ^= p; }
+				else {
+					uint32_t t = (x[0] ^ x[i]) & p;
+					x[0] ^= t;
+					x[i] ^= t;
+				}
+			}
+		}
+		x[1] ^= x[0];
+		x[2] ^= x[1];
+		uint32_t t = 0;
+		for (uint32_t q = m; q > 1; q >>= 1) {
+			if (x[2] & q) { t ^= q - 1; }
+		}
+		for (int i = 0; i < 3; i++) { x[i] ^= t; }
+		// Interleaving the transposed index gives the key.
+		return morton_key(x);
+	}
+
+	template<typename TKey>
+	std::vector<int> space_filling_curve_order(const std::vector<HBTK::CartesianPoint3D> & points,
+		TKey && key_function)
+	{
+		const int n = (int)points.size();
+		if (n == 0) { return std::vector<int>(); }
+		std::array<double, 3> lower = points[0].as_array(), upper = lower;
+		for (const auto & point : points) {
+			for (int i = 0; i < 3; i++) {
+				lower[i] = std::min(lower[i], point.as_array()[i]);
+				upper[i] = std::max(upper[i], point.as_array()[i]);
+			}
+		}
+		// One scale for all axes, so the curve runs through a cube.
+		double extent = std::max(upper[0] - lower[0], std::max(upper[1] - lower[1], upper[2] - lower[2]));
+		double scale = extent > 0 ? ((1 << sfc_bits) - 1) / extent : 0;
+
+		std::vector<uint64_t> keys(n);
+		for (int i = 0; i < n; i++) {
+			uint32_t x[3];
+			for (int j = 0; j < 3; j++) {
+				x[j] = (uint32_t)std::min((double)((1 << sfc_bits) - 1), 
+					std::floor((points[i].as_array()[j] - lower[j]) * scale));
+			}
+			keys[i] = key_function(x);
+		}
+		std::vector<int> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), 
+			[&](int a, int b) { return keys[a] < keys[b]; });
+		return HBTK::inverse_ordering(order);
+	}
+}
+
+/// \brief Reverse Cuthill-McKee node ordering. Returns the new index of each
+/// node.
+std::vector<int> HBTK::reverse_cuthill_mckee(int number_of_nodes,
+	const std::vector<int> & element_offsets, const std::vector<int> & element_nodes)
+{
+	assert(number_of_nodes >= 0);
+	assert(!element_offsets.empty());
+	std::vector<int> offsets, adjacent;
+	node_adjacency(number_of_nodes, element_offsets, element_nodes, offsets, adjacent);
+	auto degree = [&](int node) { return offsets[node + 1] - offsets[node]; };
+
+	std::vector<int> order;
+	order.reserve(number_of_nodes);
+	std::vector<int> visited(number_of_nodes, -1), placed(number_of_nodes, 0);
+	std::vector<int> last_level, neighbours;
+	int stamp = 0;
+	for (int start = 0; start < number_of_nodes; start++) {
+		if (placed[start]) { continue; }
+		// George and Liu's pseudo-peripheral node finder: move to a low degree
+		// node of the last level while doing so increases the eccentricity.
+		int root = start;
+		int levels = level_structure(root, offsets, adjacent, visited, stamp++, last_level);
+		while (true) {
+			int candidate = *std::min_element(last_level.begin(), last_level.end(),
+				[&](int a, int b) { return degree(a) < degree(b); });
+			std::vector<int> candidate_last_level;
+			int candidate_levels = level_structure(candidate, offsets, adjacent, 
+				visited, stamp++, candidate_last_level);
+			if (candidate_levels <= levels) { break; }
+			root = candidate;
+			levels = candidate_levels;
+			last_level.swap(candidate_last_level);
+		}
+
+		// Cuthill-McKee: breadth first, neighbours in order of increasing degree.
+		size_t head = order.size();
+		order.push_back(root);
+		placed[root] = 1;
+		while (head < order.size()) {
+			const int node = order[head++];
+			neighbours.clear();
+			for (int j = offsets[node]; j < offsets[node + 1]; j++) {
+				if (!placed[adjacent[j]]) {
+					placed[adjacent[j]] = 1;
+					neighbours.push_back(adjacent[j]);
+				}
+			}
+			std::stable_sort(neighbours.begin(), neighbours.end(),
+				[&](int a, int b) { return degree(a) < degree(b); });
+			order.insert(order.end(), neighbours.begin(), neighbours.end());
+		}
+	}
+	std::reverse(order.begin(), order.end());
+	return inverse_ordering(order);
+}
+
+/// \brief Order points along a Hilbert curve. Returns the new index of each
+/// point.
+std::vector<int> HBTK::hilbert_order(const std::vector<CartesianPoint3D> & points)
+{
+	return space_filling_curve_order(points, hilbert_key);
+}
+
+/// \brief Order points along a Morton (Z order) curve. Returns the new index
+/// of each point.
+std::vector<int> HBTK::morton_order(const std::vector<CartesianPoint3D> & points)
+{
+	return space_filling_curve_order(points, morton_key);
+}
+
+/// \brief Order elements by their lowest numbered node. Returns the new index
+/// of each element.
+std::vector<int> HBTK::element_order_by_nodes(const std::vector<int> & element_offsets,
+	const std::vector<int> & element_nodes)
+{
+	assert(!element_offsets.empty());
+	const int number_of_elements = (int)element_offsets.size() - 1;
+	std::vector<int> lowest(number_of_elements, 0);
+	for (int e = 0; e < number_of_elements; e++) {
+		if (element_offsets[e] != element_offsets[e + 1]) {
+			lowest[e] = *std::min_element(element_nodes.begin() + element_offsets[e],
+				element_nodes.begin() + element_offsets[e + 1]);
+		}
+	}
+	std::vector<int> order(number_of_elements);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+		[&](int a, int b) { return lowest[a] < lowest[b]; });
+	return inverse_ordering(order);
+}
+
+std::vector<int> HBTK::inverse_ordering(const std::vector<int> & new_index)
+{
+	std::vector<int> inverse(new_index.size());
+	for (int i = 0; i < (int)new_index.size(); i++) {
+		assert(new_index[i] >= 0 && new_index[i] < (int)new_index.size());
+		inverse[new_index[i]] = i;
+	}
+	return inverse;
+}
+
+HBTK::LocalityReport HBTK::locality_report(const std::vector<int> & element_offsets,
+	const std::vector<int> & element_nodes)
+{
+	assert(!element_offsets.empty());
+	const int number_of_elements = (int)element_offsets.size() - 1;
+	LocalityReport report{ 0, 0, 0 };
+	int last_lowest = 0;
+	for (int e = 0; e < number_of_elements; e++) {
+		if (element_offsets[e] == element_offsets[e + 1]) { continue; }
+		auto range = std::minmax_element(element_nodes.begin() + element_offsets[e],
+			element_nodes.begin() + element_offsets[e + 1]);
+		const int span = *range.second - *range.first;
+		report.bandwidth = std::max(report.bandwidth, span);
+		report.mean_element_span += span;
+		if (e > 0) { report.mean_element_jump += std::abs(*range.first - last_lowest); }
+		last_lowest = *range.first;
+	}
+	if (number_of_elements > 0) { report.mean_element_span /= number_of_elements; }
+	if (number_of_elements > 1) { report.mean_element_jump /= number_of_elements - 1; }
+	return report;
+}
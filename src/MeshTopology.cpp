@@ -0,0 +1,350 @@
+#include "MeshTopology.h"
+/*////////////////////////////////////////////////////////////////////////////
+MeshTopology.cpp
+
+Node to element and element to element connectivity of unstructured meshes.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "Parallel.h"
+
+namespace {
+	// Corner node indices of each face, ordered around the face. -1 pads.
+	typedef std::array<int, 4> face_corners;
+
+	const std::vector<face_corners> & face_table(HBTK::MeshTopology::element_geometry geometry)
+	{
+		static const std::vector<face_corners> none;
+		static const std::vector<face_corners> line = { 
+			{ { 0, -1, -1, -1 } }, { { 1, -1, -1, -1 } } };
+		static const std::vector<face_corners> triangle = { 
+			{ { 0, 1, -1, -1 } }, { { 1, 2, -1, -1 } }, { { 2, 0, -1, -1 } } };
+		static const std::vector<face_corners> quadrangle = { 
+			{ { 0, 1, -1, -1 } }, { { 1, 2, -1, -1 } }, { { 2, 3, -1, -1 } }, { { 3, 0, -1, -1 } } };
+		static const std::vector<face_corners> tetrahedron = {
+			{ { 0, 2, 1, -1 } }, { { 0, 1, 3, -1 } }, { { 0, 3, 2, -1 } }, { { 1, 2, 3, -1 } } };
+		static const std::vector<face_corners> hexahedron = {
+			{ { 0, 3, 2, 1 } }, { { 0, 1, 5, 4 } }, { { 0, 4, 7, 3 } },
+			{ { 1, 2, 6, 5 } }, { { 2, 3, 7, 6 } }, { { 4, 5, 6, 7 } } };
+		static const std::vector<face_corners> prism = {
+			{ { 0, 2, 1, -1 } }, { { 3, 4, 5, -1 } }, { { 0, 1, 4, 3 } },
+			{ { 0, 3, 5, 2 } }, { { 1, 2, 5, 4 } } };
+		static const std::vector<face_corners> pyramid = {
+			{ { 0, 3, 2, 1 } }, { { 0, 1, 4, -1 } }, { { 1, 2, 4, -1 } },
+			{ { 2, 3, 4, -1 } }, { { 3, 0, 4, -1 } } };
+		switch (geometry) {
+		case HBTK::MeshTopology::line: return line;
+		case HBTK::MeshTopology::triangle: return triangle;
+		case HBTK::MeshTopology::quadrangle: return quadrangle;
+		case HBTK::MeshTopology::tetrahedron: return tetrahedron;
+		case HBTK::MeshTopology::hexahedron: return hexahedron;
+		case HBTK::MeshTopology::prism: return prism;
+		case HBTK::MeshTopology::pyramid: return pyramid;
+		default: return none;
+		}
+	}
+
+	int corner_count(HBTK::MeshTopology::element_geometry geometry)
+	{
+		switch (geometry) {
+		case HBTK::MeshTopology::point: return 1;
+		case HBTK::MeshTopology::line: return 2;
+		case HBTK::MeshTopology::triangle: return 3;
+		case HBTK::MeshTopology::quadrangle: return 4;
+		case HBTK::MeshTopology::tetrahedron: return 4;
+		case HBTK::MeshTopology::hexahedron: return 8;
+		case HBTK::MeshTopology::prism: return 6;
+		case HBTK::MeshTopology::pyramid: return 5;
+		default: return 0;
+		}
+	}
+
+	uint64_t face_hash(const face_corners & key)
+	{
+		// Mix of the sorted corner nodes. The top bits choose the partition and
+		// the low bits the slot within it, so both need to be well mixed.
+		uint64_t h = 0x9e3779b97f4a7c15ULL;
+		for (int node : key) {
+			h ^= (uint32_t)node;
+			h *= 0xff51afd7ed558ccdULL;
+			h ^= h >> 32;
+		}
+		return h;
+	}
+}
+
+HBTK::MeshTopology::MeshTopology()
+{
+	m_node_element_offsets.assign(1, 0);
+	m_face_offsets.assign(1, 0);
+	m_element_offsets.assign(1, 0);
+	m_neighbour_offsets.assign(1, 0);
+}
+
+HBTK::MeshTopology::MeshTopology(int number_of_nodes, const std::vector<element_geometry> & geometries,
+	const std::vector<int> & element_offsets, const std::vector<int> & element_nodes,
+	int num_threads)
+{
+	build(number_of_nodes, geometries, element_offsets, element_nodes, num_threads);
+}
+
+void HBTK::MeshTopology::build(int number_of_nodes, const std::vector<element_geometry> & geometries,
+	const std::vector<int> & element_offsets, const std::vector<int> & element_nodes,
+	int num_threads)
+{
+	if (num_threads <= 0) { num_threads = default_thread_count(); }
+	const int number_of_elements = (int)geometries.size();
+	if ((int)element_offsets.size() != number_of_elements + 1) {
+		throw std::invalid_argument("HBTK::MeshTopology::build: element_offsets must "
+			"have one more entry than geometries. " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	for (int e = 0; e < number_of_elements; e++) {
+		if (element_offsets[e + 1] - element_offsets[e] < corner_count(geometries[e])) {
+			throw std::invalid_argument("HBTK::MeshTopology::build: element " + std::to_string(e)
+				+ " has too few nodes for its geometry. " __FILE__ ":" + std::to_string(__LINE__));
+		}
+	}
+	m_geometries = geometries;
+	m_element_offsets = element_offsets;
+	m_element_nodes = element_nodes;
+
+	// Node to element: counting sort by node, which leaves elements ascending.
+	m_node_element_offsets.assign(number_of_nodes + 1, 0);
+	for (int node : element_nodes) {
+		assert(node >= 0 && node < number_of_nodes);
+		m_node_element_offsets[node + 1]++;
+	}
+	std::partial_sum(m_node_element_offsets.begin(), m_node_element_offsets.end(),
+		m_node_element_offsets.begin());
+	m_node_elements.resize(element_nodes.size());
+	{
+		std::vector<int> fill(m_node_element_offsets.begin(), m_node_element_offsets.end() - 1);
+		for (int e = 0; e < number_of_elements; e++) {
+			for (int i = element_offsets[e]; i < element_offsets[e + 1]; i++) {
+				m_node_elements[fill[element_nodes[i]]++] = e;
+			}
+		}
+	}
+
+	// Faces and their keys: sorted corner nodes, padded with INT_MAX.
+	m_face_offsets.resize(number_of_elements + 1);
+	m_face_offsets[0] = 0;
+	for (int e = 0; e < number_of_elements; e++) {
+		m_face_offsets[e + 1] = m_face_offsets[e] + number_of_faces(geometries[e]);
+	}
+	const int total_faces = m_face_offsets.back();
+	m_face_elements.resize(total_faces);
+	m_face_neighbours.assign(total_faces, -1);
+	std::vector<face_corners> keys(total_faces);
+	std::vector<uint64_t> hashes(total_faces);
+	parallel_for(0, number_of_elements, [&](int e) {
+		const std::vector<face_corners> & table = face_table(geometries[e]);
+		const int * nodes = element_nodes.data() + element_offsets[e];
+		for (int f = 0; f < (int)table.size(); f++) {
+			const int face = m_face_offsets[e] + f;
+			face_corners & key = keys[face];
+			for (int i = 0; i < 4; i++) {
+				key[i] = table[f][i] >= 0 ? nodes[table[f][i]] : INT_MAX;
+			}
+			std::sort(key.begin(), key.end());
+			hashes[face] = face_hash(key);
+			m_face_elements[face] = e;
+		}
+	}, num_threads);
+
+	// Partition faces by hash so that partitions can be matched independently.
+	const int partition_bits = 10, partitions = 1 << partition_bits;
+	std::vector<int> partition_offsets(partitions + 1, 0);
+	for (uint64_t hash : hashes) { partition_offsets[(hash >> (64 - partition_bits)) + 1]++; }
+	std::partial_sum(partition_offsets.begin(), partition_offsets.end(), partition_offsets.begin());
+	std::vector<int> partitioned(total_faces);
+	{
+		std::vector<int> fill(partition_offsets.begin(), partition_offsets.end() - 1);
+		for (int face = 0; face < total_faces; face++) {
+			partitioned[fill[hashes[face] >> (64 - partition_bits)]++] = face;
+		}
+	}
+	parallel_blocks(0, partitions, num_threads, [&](int begin, int end, int) {
+		std::vector<int> table;
+		for (int p = begin; p < end; p++) {
+			const int count = partition_offsets[p + 1] - partition_offsets[p];
+			if (count < 2) { continue; }
+			// Open addressing with linear probing, at most half full.
+			size_t size = 4;
+			while (size < 2 * (size_t)count) { size *= 2; }
+			table.assign(size, -1);
+			for (int i = partition_offsets[p]; i < partition_offsets[p + 1]; i++) {
+				const int face = partitioned[i];
+				size_t slot = hashes[face] & (size - 1);
+				while (true) {
+					const int other = table[slot];
+					if (other < 0) {
+						table[slot] = face;
+						break;
+					}
+					if (hashes[other] == hashes[face] && keys[other] == keys[face]) {
+						if (m_face_neighbours[other] < 0) {
+							m_face_neighbours[other] = m_face_elements[face];
+							m_face_neighbours[face] = m_face_elements[other];
+						}
+						break;
+					}
+					slot = (slot + 1) & (size - 1);
+				}
+			}
+		}
+	});
+
+	// Element to element, without repeats.
+	m_neighbour_offsets.assign(1, 0);
+	m_neighbour_offsets.reserve(number_of_elements + 1);
+	m_neighbours.clear();
+	m_neighbours.reserve(total_faces);
+	for (int e = 0; e < number_of_elements; e++) {
+		const size_t first = m_neighbours.size();
+		for (int face = m_face_offsets[e]; face < m_face_offsets[e + 1]; face++) {
+			const int other = m_face_neighbours[face];
+			if (other >= 0 && std::find(m_neighbours.begin() + first, m_neighbours.end(), other) 
+				== m_neighbours.end()) {
+				m_neighbours.push_back(other);
+			}
+		}
+		m_neighbour_offsets.push_back((int)m_neighbours.size());
+	}
+}
+
+int HBTK::MeshTopology::number_of_nodes() const
+{
+	return (int)m_node_element_offsets.size() - 1;
+}
+
+int HBTK::MeshTopology::number_of_elements() const
+{
+	return (int)m_face_offsets.size() - 1;
+}
+
+int HBTK::MeshTopology::number_of_faces() const
+{
+	return (int)m_face_neighbours.size();
+}
+
+const std::vector<int> & HBTK::MeshTopology::node_element_offsets() const
+{
+	return m_node_element_offsets;
+}
+
+const std::vector<int> & HBTK::MeshTopology::node_elements() const
+{
+	return m_node_elements;
+}
+
+const std::vector<int> & HBTK::MeshTopology::face_offsets() const
+{
+	return m_face_offsets;
+}
+
+const std::vector<int> & HBTK::MeshTopology::face_neighbours() const
+{
+	return m_face_neighbours;
+}
+
+int HBTK::MeshTopology::face_element(int face) const
+{
+	assert(face >= 0 && face < number_of_faces());
+	return m_face_elements[face];
+}
+
+std::vector<int> HBTK::MeshTopology::face_nodes(int face) const
+{
+	const int element = face_element(face);
+	const face_corners & corners = face_table(m_geometries[element])[face - m_face_offsets[element]];
+	std::vector<int> nodes;
+	for (int corner : corners) {
+		if (corner >= 0) { nodes.push_back(m_element_nodes[m_element_offsets[element] + corner]); }
+	}
+	return nodes;
+}
+
+std::vector<int> HBTK::MeshTopology::boundary_faces() const
+{
+	std::vector<int> faces;
+	for (int face = 0; face < number_of_faces(); face++) {
+		if (m_face_neighbours[face] < 0) { faces.push_back(face); }
+	}
+	return faces;
+}
+
+const std::vector<int> & HBTK::MeshTopology::element_neighbour_offsets() const
+{
+	return m_neighbour_offsets;
+}
+
+const std::vector<int> & HBTK::MeshTopology::element_neighbours() const
+{
+	return m_neighbours;
+}
+
+int HBTK::MeshTopology::number_of_faces(element_geometry geometry)
+{
+	return (int)face_table(geometry).size();
+}
+
+HBTK::MeshTopology::element_geometry HBTK::MeshTopology::gmsh_geometry(int gmsh_element_type)
+{
+	switch (gmsh_element_type) {
+	case 15: return point;
+	case 1: case 8: case 26: case 27: case 28: return line;
+	case 2: case 9: case 20: case 21: case 22: case 23: case 24: case 25: return triangle;
+	case 3: case 10: case 16: case 36: case 39: return quadrangle;
+	case 4: case 11: case 29: case 30: case 31: return tetrahedron;
+	case 5: case 12: case 17: case 92: case 93: return hexahedron;
+	case 6: case 13: case 18: return prism;
+	case 7: case 14: case 19: return pyramid;
+	default: return unknown;
+	}
+}
+
+HBTK::MeshTopology::element_geometry HBTK::MeshTopology::vtk_geometry(int vtk_cell_type)
+{
+	// VTK_PIXEL and VTK_VOXEL number their corners differently, so aren't 
+	// supported.
+	switch (vtk_cell_type) {
+	case 1: return point;
+	case 3: case 21: case 35: case 68: return line;
+	case 5: case 22: case 69: return triangle;
+	case 9: case 23: case 70: return quadrangle;
+	case 10: case 24: case 71: return tetrahedron;
+	case 12: case 25: case 72: return hexahedron;
+	case 13: case 73: return prism;
+	case 14: case 74: return pyramid;
+	default: return unknown;
+	}
+}
@@ -29,6 +29,7 @@ SOFTWARE.
 #include <fstream>
 
 #include "FortranSequentialInputStream.h"
+#include "NumberParsing.h"
 
 HBTK::Plot3D::Plot3DParser::Plot3DParser()
 	: single_block(false),
@@ -59,7 +60,7 @@ void HBTK::Plot3D::Plot3DParser::add_3D_block_function(std::function<bool(HBTK::
 }
 
 
-void HBTK::Plot3D::Plot3DParser::main_parser(std::ifstream & input_stream, std::ostream & error_stream)
+void HBTK::Plot3D::Plot3DParser::main_parser(std::istream & input_stream, std::ostream & error_stream)
 {
 	if (!input_stream) { throw - 1; }
 	if (!error_stream) { throw - 1; }
@@ -78,7 +79,7 @@ void HBTK::Plot3D::Plot3DParser::main_parser(std::ifstream & input_stream, std::
 }
 
 
-void HBTK::Plot3D::Plot3DParser::parse_2d(std::ifstream & input_stream, std::ostream & error_stream)
+void HBTK::Plot3D::Plot3DParser::parse_2d(std::istream & input_stream, std::ostream & error_stream)
 {
 	if (parse_as_binary) {
 		parse_binary(input_stream, error_stream, 2);
@@ -88,7 +89,7 @@ void HBTK::Plot3D::Plot3DParser::parse_2d(std::ifstream & input_stream, std::ost
 	}
 }
 
-void HBTK::Plot3D::Plot3DParser::parse_3d(std::ifstream & input_stream, std::ostream & error_stream)
+void HBTK::Plot3D::Plot3DParser::parse_3d(std::istream & input_stream, std::ostream & error_stream)
 {
 	if (parse_as_binary) {
 		parse_binary(input_stream, error_stream, 3);
@@ -99,7 +100,7 @@ void HBTK::Plot3D::Plot3DParser::parse_3d(std::ifstream & input_stream, std::ost
 }
 
 
-void HBTK::Plot3D::Plot3DParser::parse_ascii(std::ifstream & input_stream, std::ostream & error_stream, int dimensions)
+void HBTK::Plot3D::Plot3DParser::parse_ascii(std::istream & input_stream, std::ostream & error_stream, int dimensions)
 {
 	assert(dimensions <= 3);
 	assert(dimensions >= 2);
@@ -116,7 +117,7 @@ void HBTK::Plot3D::Plot3DParser::parse_ascii(std::ifstream & input_stream, std::
 		else {
 			std::getline(input_stream, this_line);
 			line_number++;
-			number_of_blocks = std::atoi(this_line.data());
+			number_of_blocks = HBTK::to_int(this_line);
 		}
 
 		for (auto &vect : extents) { vect.resize(number_of_blocks); }
@@ -124,10 +125,10 @@ void HBTK::Plot3D::Plot3DParser::parse_ascii(std::ifstream & input_stream, std::
 		for (int n = 0; n < number_of_blocks; n++) {
 			std::getline(input_stream, this_line);
 			line_number++;
-			auto strings = tokenise(this_line);
-			if ((int)strings.size() < dimensions) throw line_number;
+			const FieldSplitter & strings = split_fields(this_line);
+			if (strings.size() < dimensions) throw line_number;
 			for (int m = 0; m < dimensions; m++) {
-				extents[m][n] = std::stoi(strings[m]);
+				extents[m][n] = HBTK::to_int(strings[m]);
 			}
 		}
 
@@ -138,24 +139,24 @@ void HBTK::Plot3D::Plot3DParser::parse_ascii(std::ifstream & input_stream, std::
 			int k_ext = (dimensions == 3 ? extents[2][n] : 1);
 			mesh.set_extent({ i_ext, j_ext, k_ext } );
 
-			auto read_bin = [&](int i, int j, int k, std::ifstream & input, int xyz_idx) {
+			auto read_bin = [&](int i, int j, int k, std::istream & input, int xyz_idx) {
 				double tmp_val = 0;
-				input_stream >> tmp_val;
+				if (!HBTK::read_number(input_stream, tmp_val)) { throw line_number; }
 				auto coord = mesh.coord({ i, j, k });
 				coord[xyz_idx] = tmp_val;
 				mesh.set_coord({ i, j, k }, coord);
 			};
 
 			apply_function_to_input_array(i_ext, j_ext, k_ext,
-				[&](int i, int j, int k, std::ifstream & input) { read_bin(i, j, k, input, 0); },
+				[&](int i, int j, int k, std::istream & input) { read_bin(i, j, k, input, 0); },
 				input_stream);
 			apply_function_to_input_array(i_ext, j_ext, k_ext,
-				[&](int i, int j, int k, std::ifstream & input) { read_bin(i, j, k, input, 1); },
+				[&](int i, int j, int k, std::istream & input) { read_bin(i, j, k, input, 1); },
 				input_stream);
 
 			if (dimensions == 3) {
 				apply_function_to_input_array(i_ext, j_ext, k_ext,
-					[&](int i, int j, int k, std::ifstream & input) { read_bin(i, j, k, input, 2); },
+					[&](int i, int j, int k, std::istream & input) { read_bin(i, j, k, input, 2); },
 					input_stream);
 				for (auto & function : m_mesh_3d_functions) {
 					if (!function(mesh)) break;
@@ -179,7 +180,7 @@ void HBTK::Plot3D::Plot3DParser::parse_ascii(std::ifstream & input_stream, std::
 	catch (...) { throw line_number; }
 }
 
-void HBTK::Plot3D::Plot3DParser::parse_binary(std::ifstream & input_stream, std::ostream & error_stream, int dimensions)
+void HBTK::Plot3D::Plot3DParser::parse_binary(std::istream & input_stream, std::ostream & error_stream, int dimensions)
 {
 	assert(dimensions > 1);
 	assert(dimensions <= 3);
@@ -226,7 +227,7 @@ void HBTK::Plot3D::Plot3DParser::parse_binary(std::ifstream & input_stream, std:
 			mesh.set_extent({ i_ext, j_ext, k_ext });
 
 
-			auto read_bin = [&](int i, int j, int k, std::ifstream & input, int xyz_idx) {
+			auto read_bin = [&](int i, int j, int k, std::istream & input, int xyz_idx) {
 				unpack_binary_to_struct(input_stream, double_buffer);
 				auto coord = mesh.coord({ i, j, k });
 				coord[xyz_idx] = double_buffer.value;
@@ -236,15 +237,15 @@ void HBTK::Plot3D::Plot3DParser::parse_binary(std::ifstream & input_stream, std:
 
 			fortran_input.record_open(input_stream);
 			apply_function_to_input_array(i_ext, j_ext, k_ext,
-				[&](int i, int j, int k, std::ifstream & input) { read_bin(i, j, k, input, 0); },
+				[&](int i, int j, int k, std::istream & input) { read_bin(i, j, k, input, 0); },
 				input_stream);
 			apply_function_to_input_array(i_ext, j_ext, k_ext,
-				[&](int i, int j, int k, std::ifstream & input) { read_bin(i, j, k, input, 1); },
+				[&](int i, int j, int k, std::istream & input) { read_bin(i, j, k, input, 1); },
 				input_stream);
 
 			if (dimensions == 3) {
 				apply_function_to_input_array(i_ext, j_ext, k_ext,
-					[&](int i, int j, int k, std::ifstream & input) { read_bin(i, j, k, input, 2); },
+					[&](int i, int j, int k, std::istream & input) { read_bin(i, j, k, input, 2); },
 					input_stream);
 				for (auto & function : m_mesh_3d_functions) {
 					if (!function(mesh)) break;
@@ -272,7 +273,7 @@ void HBTK::Plot3D::Plot3DParser::parse_binary(std::ifstream & input_stream, std:
 }
 
 void HBTK::Plot3D::Plot3DParser::apply_function_to_input_array(int i_ext, int j_ext, int k_ext, 
-	std::function<void(int, int, int, std::ifstream&)> func, std::ifstream & input_stream)
+	std::function<void(int, int, int, std::istream &)> func, std::istream & input_stream)
 {
 	for (int k = 0; k < k_ext; k++) {
 		for (int j = 0; j < j_ext; j++) {
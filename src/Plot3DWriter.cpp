@@ -25,10 +25,13 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 #include <cassert>
+#include <fstream>
 #include <iomanip>
+#include <sstream>
 #include <tuple>
 
 #include "FortranSequentialOutputStream.h"
+#include "Gzip.h"
 
 HBTK::Plot3D::Plot3DWriter::Plot3DWriter()
 	: write_binary(true),
@@ -56,11 +59,21 @@ void HBTK::Plot3D::Plot3DWriter::add_mesh_block3d(HBTK::StructuredMeshBlock3D me
 bool HBTK::Plot3D::Plot3DWriter::write(std::string path)
 {
 	std::ofstream output_stream(path, std::ios::binary);
+	if (has_gzip_extension(path) && output_stream) {
+		// Fortran record markers are written by seeking back, so build 
+		// the file in memory before compressing it.
+		std::ostringstream uncompressed(std::ios::binary);
+		if (!write(uncompressed)) { return false; }
+		const std::string data = uncompressed.str();
+		const std::string compressed = gzip_compress(data.data(), data.size());
+		output_stream.write(compressed.data(), compressed.size());
+		return output_stream.good();
+	}
 	return write(output_stream);
 }
 
 
-bool HBTK::Plot3D::Plot3DWriter::write(std::ofstream & output_stream)
+bool HBTK::Plot3D::Plot3DWriter::write(std::ostream & output_stream)
 {
 	HBTK::FortranSequentialOutputStream fortran_output;
 	if (!output_stream) { return false; }
@@ -90,7 +103,7 @@ bool HBTK::Plot3D::Plot3DWriter::write(std::ofstream & output_stream)
 }
 
 
-void HBTK::Plot3D::Plot3DWriter::write_block_extent(int block, std::ofstream & output_stream)
+void HBTK::Plot3D::Plot3DWriter::write_block_extent(int block, std::ostream & output_stream)
 {
 	assert(block >= 0);
 	if (three_dimensional) {
@@ -128,7 +141,7 @@ void HBTK::Plot3D::Plot3DWriter::write_block_extent(int block, std::ofstream & o
 }
 
 
-void HBTK::Plot3D::Plot3DWriter::write_nodes(int block, std::ofstream & output_stream)
+void HBTK::Plot3D::Plot3DWriter::write_nodes(int block, std::ostream & output_stream)
 {
 	assert(block >= 0);
 	if (three_dimensional) {
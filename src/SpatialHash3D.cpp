@@ -0,0 +1,228 @@
+#include "SpatialHash3D.h"
+/*////////////////////////////////////////////////////////////////////////////
+SpatialHash3D.cpp
+
+A uniform grid spatial hash over a set of points in 3D for fixed radius
+searches, and merging of coincident points.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "CartesianVector.h"
+#include "Parallel.h"
+
+HBTK::SpatialHash3D::SpatialHash3D()
+	: m_cell_size(1.)
+{
+}
+
+HBTK::SpatialHash3D::SpatialHash3D(const std::vector<CartesianPoint3D>& points, 
+	double cell_size, int num_threads)
+	: m_cell_size(1.)
+{
+	build(points, cell_size, num_threads);
+}
+
+void HBTK::SpatialHash3D::build(const std::vector<CartesianPoint3D>& points, 
+	double cell_size, int num_threads)
+{
+	if (!(cell_size > 0)) {
+		throw std::invalid_argument("HBTK::SpatialHash3D::build: cell_size must be "
+			"greater than zero. Given " + std::to_string(cell_size) + ". "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	m_cell_size = cell_size;
+	int n = (int)points.size();
+	std::vector<std::pair<long long, int>> keys(n);
+	parallel_for(0, n, [&](int i) {
+		keys[i] = std::make_pair(cell_key(cell_coordinate(points[i].x()), 
+			cell_coordinate(points[i].y()), cell_coordinate(points[i].z())), i);
+	}, num_threads);
+	std::sort(keys.begin(), keys.end());
+
+	m_points.resize(n);
+	m_index.resize(n);
+	m_cells.clear();
+	for (int i = 0; i < n; i++) {
+		m_points[i] = points[keys[i].second];
+		m_index[i] = keys[i].second;
+		if (i == 0 || keys[i].first != keys[i - 1].first) {
+			m_cells[keys[i].first] = std::make_pair(i, i + 1);
+		}
+		else {
+			m_cells[keys[i].first].second = i + 1;
+		}
+	}
+	return;
+}
+
+int HBTK::SpatialHash3D::size() const
+{
+	return (int)m_points.size();
+}
+
+double HBTK::SpatialHash3D::cell_size() const
+{
+	return m_cell_size;
+}
+
+long long HBTK::SpatialHash3D::cell_key(long long ix, long long iy, long long iz) const
+{
+	// 21 bits per coordinate. Cells far apart may share a key. That only 
+	// makes the bucket bigger, since every candidate's distance is checked.
+	const long long mask = (1LL << 21) - 1;
+	return ((ix & mask) << 42) | ((iy & mask) << 21) | (iz & mask);
+}
+
+long long HBTK::SpatialHash3D::cell_coordinate(double x) const
+{
+	// Clamped so that far away (or non-finite) points convert safely. Clamped
+	// points share cells, which again only costs distance checks.
+	const double limit = 4611686018427387904.;	// 2^62
+	const double c = std::floor(x / m_cell_size);
+	if (!(c > -limit)) { return c < 0 ? -(long long)limit : 0; }
+	if (!(c < limit)) { return (long long)limit; }
+	return (long long)c;
+}
+
+template<typename TFunc>
+void HBTK::SpatialHash3D::for_each_in_range(const CartesianPoint3D & point, 
+	double radius, TFunc && func) const
+{
+	const double radius_sq = radius * radius;
+	long long lx = cell_coordinate(point.x() - radius), ux = cell_coordinate(point.x() + radius);
+	long long ly = cell_coordinate(point.y() - radius), uy = cell_coordinate(point.y() + radius);
+	long long lz = cell_coordinate(point.z() - radius), uz = cell_coordinate(point.z() + radius);
+	for (long long ix = lx; ix <= ux; ix++) {
+		for (long long iy = ly; iy <= uy; iy++) {
+			for (long long iz = lz; iz <= uz; iz++) {
+				auto cell = m_cells.find(cell_key(ix, iy, iz));
+				if (cell == m_cells.end()) { continue; }
+				for (int i = cell->second.first; i < cell->second.second; i++) {
+					double dist_sq = (m_points[i] - point).dot(m_points[i] - point);
+					if (dist_sq <= radius_sq) { func(m_index[i], dist_sq); }
+				}
+			}
+		}
+	}
+	return;
+}
+
+std::vector<int> HBTK::SpatialHash3D::within_radius(const CartesianPoint3D & point, double radius) const
+{
+	std::vector<int> found;
+	for_each_in_range(point, radius, [&](int index, double) { found.push_back(index); });
+	// Distinct cells can share a key, so a bucket may be visited twice.
+	std::sort(found.begin(), found.end());
+	found.erase(std::unique(found.begin(), found.end()), found.end());
+	return found;
+}
+
+int HBTK::SpatialHash3D::nearest(const CartesianPoint3D & point, double max_radius, double & distance) const
+{
+	int best = -1;
+	double best_sq = std::numeric_limits<double>::infinity();
+	for_each_in_range(point, max_radius, [&](int index, double dist_sq) {
+		if (dist_sq < best_sq || (dist_sq == best_sq && index < best)) {
+			best_sq = dist_sq;
+			best = index;
+		}
+	});
+	distance = std::sqrt(best_sq);
+	return best;
+}
+
+std::vector<std::vector<int>> HBTK::SpatialHash3D::within_radius(
+	const std::vector<CartesianPoint3D>& points, double radius, int num_threads) const
+{
+	std::vector<std::vector<int>> found(points.size());
+	parallel_for(0, (int)points.size(), [&](int i) {
+		found[i] = within_radius(points[i], radius);
+	}, num_threads);
+	return found;
+}
+
+std::vector<int> HBTK::coincident_point_map(const std::vector<CartesianPoint3D>& points, 
+	double tolerance, int num_threads)
+{
+	int n = (int)points.size();
+	std::vector<int> map(n);
+	for (int i = 0; i < n; i++) { map[i] = i; }
+	if (n == 0 || tolerance < 0) { return map; }
+	if (tolerance == 0) {
+		// Exact matches: sort by coordinate, lowest index first in each run.
+		std::vector<int> order;
+		order.reserve(n);
+		for (int i = 0; i < n; i++) {
+			if (points[i] == points[i]) { order.push_back(i); }	// NaNs never match.
+		}
+		auto less = [&](int a, int b) {
+			const CartesianPoint3D & p = points[a], & q = points[b];
+			if (p.x() != q.x()) { return p.x() < q.x(); }
+			if (p.y() != q.y()) { return p.y() < q.y(); }
+			if (p.z() != q.z()) { return p.z() < q.z(); }
+			return a < b;
+		};
+		std::sort(order.begin(), order.end(), less);
+		for (int i = 1; i < (int)order.size(); i++) {
+			if (points[order[i]] == points[order[i - 1]]) { map[order[i]] = map[order[i - 1]]; }
+		}
+		return map;
+	}
+	// Cells no smaller than about 1e-12 of the largest coordinate, so that 
+	// cell coordinates stay well within range.
+	double scale = 0;
+	for (auto & point : points) {
+		for (int i = 0; i < 3; i++) {
+			if (std::abs(point.as_array()[i]) < std::numeric_limits<double>::infinity()) {
+				scale = std::max(scale, std::abs(point.as_array()[i]));
+			}
+		}
+	}
+	double cell_size = std::max(tolerance, 1e-12 * scale);
+	SpatialHash3D hash(points, cell_size, num_threads);
+	std::vector<std::vector<int>> neighbours = hash.within_radius(points, tolerance, num_threads);
+
+	// Union-find where the root of each set is its lowest index.
+	auto find_root = [&](int i) {
+		while (map[i] != i) {
+			map[i] = map[map[i]];
+			i = map[i];
+		}
+		return i;
+	};
+	for (int i = 0; i < n; i++) {
+		for (int j : neighbours[i]) {
+			int ri = find_root(i), rj = find_root(j);
+			if (ri < rj) { map[rj] = ri; }
+			else if (rj < ri) { map[ri] = rj; }
+		}
+	}
+	for (int i = 0; i < n; i++) { map[i] = find_root(i); }
+	return map;
+}
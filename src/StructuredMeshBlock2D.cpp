@@ -45,12 +45,20 @@ namespace HBTK {
 
 	void StructuredMeshBlock2D::set_coord(std::array<int, 2> indexes, std::array<int, 3> coordinate)
 	{
-		for (int i = 0; i < 3; i++) {
+		for (int i = 0; i < 2; i++) {
 			m_coordinates[i].value(indexes) = coordinate[i];
 		}
 		return;
 	}
 
+	void StructuredMeshBlock2D::set_coord(std::array<int, 2> indexes, std::array<double, 2> coord)
+	{
+		for (int i = 0; i < 2; i++) {
+			m_coordinates[i].value(indexes) = coord[i];
+		}
+		return;
+	}
+
 
 	std::array<int, 2> StructuredMeshBlock2D::extent()
 	{
@@ -66,7 +74,7 @@ namespace HBTK {
 	void StructuredMeshBlock2D::swap_internal_coordinates_ij()
 	{
 		for (auto &block : m_coordinates) {
-			block.swap(1, 2);
+			block.swap(0, 1);
 		}
 		return;
 	}
@@ -25,6 +25,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <cassert>
+#include <limits>
 
 const std::string & HBTK::Token::value() const {
 	return m_value;
@@ -156,3 +158,24 @@ bool HBTK::Token::isnewline() const
 	return m_token_type == WHITE_SPACE && m_value[0] == '\n';
 }
 
+double HBTK::Token::number() const
+{
+	assert(isnum());
+	if (m_has_number) { return m_number; }
+	return std::stod(m_value);
+}
+
+long long HBTK::Token::integer() const
+{
+	assert(isnum());
+	if (m_has_number) { return m_integer; }
+	return m_token_type == INTEGER ? std::stoll(m_value) : saturated_integer(std::stod(m_value));
+}
+
+long long HBTK::Token::saturated_integer(double value)
+{
+	const double limit = 9223372036854775808.;	// 2^63
+	if (value >= limit) { return std::numeric_limits<long long>::max(); }
+	if (value < -limit) { return std::numeric_limits<long long>::min(); }
+	return value == value ? (long long)value : 0;
+}
@@ -0,0 +1,345 @@
+#include "VtkArrayRegistry.h"
+/*////////////////////////////////////////////////////////////////////////////
+VtkArrayRegistry.cpp
+
+Named, typed data arrays for VTK datasets.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+
+#include "MeshReordering.h"
+
+namespace {
+	// Reorder tuples stored as one array per component.
+	template<typename T>
+	void reorder_components(std::vector<T> & data, const std::vector<int> & new_index, int components)
+	{
+		const size_t tuples = new_index.size();
+		assert(data.size() == tuples * components);
+		std::vector<T> reordered(data.size());
+		for (int j = 0; j < components; j++) {
+			for (size_t i = 0; i < tuples; i++) {
+				reordered[j * tuples + new_index[i]] = data[j * tuples + i];
+			}
+		}
+		data.swap(reordered);
+	}
+
+	// Resize or append to tuples stored as one array per component. 
+	template<typename T>
+	void resize_components(std::vector<T> & data, int old_tuples, int new_tuples, int components,
+		const T * more = nullptr)
+	{
+		std::vector<T> resized((size_t)new_tuples * components, T(0));
+		const int kept = std::min(old_tuples, new_tuples);
+		for (int j = 0; j < components; j++) {
+			std::copy(data.begin() + (size_t)j * old_tuples, data.begin() + (size_t)j * old_tuples + kept,
+				resized.begin() + (size_t)j * new_tuples);
+			if (more) {
+				const int extra = new_tuples - old_tuples;
+				std::copy(more + (size_t)j * extra, more + (size_t)(j + 1) * extra,
+					resized.begin() + (size_t)j * new_tuples + old_tuples);
+			}
+		}
+		data.swap(resized);
+	}
+}
+
+HBTK::Vtk::VtkArrayRegistry::VtkArrayRegistry()
+{
+}
+
+HBTK::Vtk::VtkArrayRegistry::handle HBTK::Vtk::VtkArrayRegistry::add(const std::string & name,
+	value_type type, int components, int tuples, storage_layout layout)
+{
+	if (m_names.count(name)) {
+		throw std::invalid_argument("HBTK::Vtk::VtkArrayRegistry::add: Array " + name
+			+ " already exists. " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	if (components < 1 || tuples < 0) {
+		throw std::invalid_argument("HBTK::Vtk::VtkArrayRegistry::add: Array " + name
+			+ " must have at least one component and a non-negative number of tuples. "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	entry e;
+	e.name = name;
+	e.type = type;
+	e.output = type;
+	e.components = components;
+	e.tuples = 0;
+	e.layout = layout;
+	e.in_use = true;
+	m_arrays.push_back(std::move(e));
+	const handle array = (handle)m_arrays.size() - 1;
+	m_names[name] = array;
+	resize(array, tuples);
+	return array;
+}
+
+HBTK::Vtk::VtkArrayRegistry::handle HBTK::Vtk::VtkArrayRegistry::find(const std::string & name) const
+{
+	auto it = m_names.find(name);
+	return it == m_names.end() ? -1 : it->second;
+}
+
+void HBTK::Vtk::VtkArrayRegistry::remove(handle array)
+{
+	entry & e = checked(array);
+	m_names.erase(e.name);
+	e = entry();
+	e.in_use = false;
+}
+
+void HBTK::Vtk::VtkArrayRegistry::clear()
+{
+	m_arrays.clear();
+	m_names.clear();
+}
+
+std::vector<HBTK::Vtk::VtkArrayRegistry::handle> HBTK::Vtk::VtkArrayRegistry::handles() const
+{
+	std::vector<handle> result;
+	for (int i = 0; i < (int)m_arrays.size(); i++) {
+		if (m_arrays[i].in_use) { result.push_back(i); }
+	}
+	return result;
+}
+
+int HBTK::Vtk::VtkArrayRegistry::size() const
+{
+	return (int)m_names.size();
+}
+
+const std::string & HBTK::Vtk::VtkArrayRegistry::name(handle array) const
+{
+	return checked(array).name;
+}
+
+HBTK::Vtk::VtkArrayRegistry::value_type HBTK::Vtk::VtkArrayRegistry::type(handle array) const
+{
+	return checked(array).type;
+}
+
+int HBTK::Vtk::VtkArrayRegistry::components(handle array) const
+{
+	return checked(array).components;
+}
+
+int HBTK::Vtk::VtkArrayRegistry::tuples(handle array) const
+{
+	return checked(array).tuples;
+}
+
+HBTK::Vtk::VtkArrayRegistry::storage_layout HBTK::Vtk::VtkArrayRegistry::layout(handle array) const
+{
+	return checked(array).layout;
+}
+
+HBTK::Vtk::VtkArrayRegistry::value_type HBTK::Vtk::VtkArrayRegistry::output_type(handle array) const
+{
+	return checked(array).output;
+}
+
+void HBTK::Vtk::VtkArrayRegistry::set_output_type(handle array, value_type type)
+{
+	entry & e = checked(array);
+	if (type != e.type && !(e.type == FLOAT64 && type == FLOAT32)) {
+		throw std::invalid_argument("HBTK::Vtk::VtkArrayRegistry::set_output_type: "
+			"Only Float64 arrays can be written as another type (Float32). "
+			__FILE__ ":" + std::to_string(__LINE__));
+	}
+	e.output = type;
+}
+
+double HBTK::Vtk::VtkArrayRegistry::value(handle array, int tuple, int component) const
+{
+	const entry & e = checked(array);
+	assert(tuple >= 0 && tuple < e.tuples);
+	assert(component >= 0 && component < e.components);
+	const size_t idx = e.layout == INTERLEAVED
+		? (size_t)tuple * e.components + component
+		: (size_t)component * e.tuples + tuple;
+	switch (e.type) {
+	case FLOAT32: return e.float32[idx];
+	case FLOAT64: return e.float64[idx];
+	case INT32: return (double)e.int32[idx];
+	default: return (double)e.int64[idx];
+	}
+}
+
+void HBTK::Vtk::VtkArrayRegistry::set_value(handle array, int tuple, int component, double value)
+{
+	entry & e = checked(array);
+	assert(tuple >= 0 && tuple < e.tuples);
+	assert(component >= 0 && component < e.components);
+	const size_t idx = e.layout == INTERLEAVED
+		? (size_t)tuple * e.components + component
+		: (size_t)component * e.tuples + tuple;
+	switch (e.type) {
+	case FLOAT32: e.float32[idx] = (float)value; break;
+	case FLOAT64: e.float64[idx] = value; break;
+	case INT32: e.int32[idx] = (int32_t)value; break;
+	default: e.int64[idx] = (int64_t)value;
+	}
+}
+
+void HBTK::Vtk::VtkArrayRegistry::resize(handle array, int tuples)
+{
+	entry & e = checked(array);
+	if (e.layout == INTERLEAVED) {
+		visit(e, [&](auto & data) { data.resize((size_t)tuples * e.components); });
+	}
+	else {
+		visit(e, [&](auto & data) { resize_components(data, e.tuples, tuples, e.components); });
+	}
+	e.tuples = tuples;
+}
+
+void HBTK::Vtk::VtkArrayRegistry::reorder(const std::vector<int> & new_index)
+{
+	for (auto & e : m_arrays) {
+		if (!e.in_use) { continue; }
+		if (e.tuples != (int)new_index.size()) {
+			throw std::invalid_argument("HBTK::Vtk::VtkArrayRegistry::reorder: Array " + e.name
+				+ " has a different number of tuples to new_index. " __FILE__ ":" + std::to_string(__LINE__));
+		}
+		if (e.layout == INTERLEAVED) {
+			visit(e, [&](auto & data) { HBTK::apply_ordering(data, new_index, e.components); });
+		}
+		else {
+			visit(e, [&](auto & data) { reorder_components(data, new_index, e.components); });
+		}
+	}
+}
+
+void HBTK::Vtk::VtkArrayRegistry::append(const VtkArrayRegistry & other)
+{
+	if (!same_arrays(other)) {
+		throw std::invalid_argument("HBTK::Vtk::VtkArrayRegistry::append: "
+			"Registries have different arrays. " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	for (auto & e : m_arrays) {
+		if (!e.in_use) { continue; }
+		entry & more = const_cast<VtkArrayRegistry&>(other).checked(other.find(e.name));
+		const int tuples = e.tuples + more.tuples;
+		visit(e, [&](auto & data) {
+			auto & more_data = storage(more, data.data());
+			if (e.layout == INTERLEAVED && more.layout == INTERLEAVED) {
+				data.insert(data.end(), more_data.begin(), more_data.end());
+			}
+			else if (e.layout == COMPONENT_ARRAYS && more.layout == COMPONENT_ARRAYS) {
+				resize_components(data, e.tuples, tuples, e.components, more_data.data());
+			}
+			else {
+				// Layouts differ: copy value by value.
+				if (e.layout == INTERLEAVED) { data.resize((size_t)tuples * e.components); }
+				else { resize_components(data, e.tuples, tuples, e.components); }
+				for (int i = 0; i < more.tuples; i++) {
+					for (int j = 0; j < e.components; j++) {
+						const auto value = more.layout == INTERLEAVED
+							? more_data[(size_t)i * e.components + j]
+							: more_data[(size_t)j * more.tuples + i];
+						if (e.layout == INTERLEAVED) { data[(size_t)(e.tuples + i) * e.components + j] = value; }
+						else { data[(size_t)j * tuples + e.tuples + i] = value; }
+					}
+				}
+			}
+		});
+		e.tuples = tuples;
+	}
+}
+
+HBTK::Vtk::VtkArrayRegistry HBTK::Vtk::VtkArrayRegistry::select(const std::vector<int> & tuples) const
+{
+	VtkArrayRegistry selected;
+	for (auto & e : m_arrays) {
+		if (!e.in_use) { continue; }
+		const handle array = selected.add(e.name, e.type, e.components, (int)tuples.size(), e.layout);
+		entry & to = selected.m_arrays[array];
+		to.output = e.output;
+		const size_t n = tuples.size();
+		visit(to, [&](auto & data) {
+			const auto & from = storage(const_cast<entry&>(e), data.data());
+			for (size_t i = 0; i < n; i++) {
+				for (int j = 0; j < e.components; j++) {
+					if (e.layout == INTERLEAVED) { data[i * e.components + j] = from[(size_t)tuples[i] * e.components + j]; }
+					else { data[j * n + i] = from[(size_t)j * e.tuples + tuples[i]]; }
+				}
+			}
+		});
+	}
+	return selected;
+}
+
+bool HBTK::Vtk::VtkArrayRegistry::same_arrays(const VtkArrayRegistry & other) const
+{
+	bool same = size() == other.size();
+	for (auto & name_handle : m_names) {
+		const handle theirs = other.find(name_handle.first);
+		same = same && theirs >= 0
+			&& other.type(theirs) == type(name_handle.second)
+			&& other.components(theirs) == components(name_handle.second);
+	}
+	return same;
+}
+
+const char * HBTK::Vtk::VtkArrayRegistry::type_name(value_type type)
+{
+	switch (type) {
+	case FLOAT32: return "Float32";
+	case FLOAT64: return "Float64";
+	case INT32: return "Int32";
+	default: return "Int64";
+	}
+}
+
+int HBTK::Vtk::VtkArrayRegistry::type_size(value_type type)
+{
+	return type == FLOAT32 || type == INT32 ? 4 : 8;
+}
+
+HBTK::Vtk::VtkArrayRegistry::entry & HBTK::Vtk::VtkArrayRegistry::checked(handle array)
+{
+	if (array < 0 || array >= (int)m_arrays.size() || !m_arrays[array].in_use) {
+		throw std::invalid_argument("HBTK::Vtk::VtkArrayRegistry: Invalid array handle "
+			+ std::to_string(array) + ". " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	return m_arrays[array];
+}
+
+const HBTK::Vtk::VtkArrayRegistry::entry & HBTK::Vtk::VtkArrayRegistry::checked(handle array) const
+{
+	return const_cast<VtkArrayRegistry*>(this)->checked(array);
+}
+
+template<typename F>
+void HBTK::Vtk::VtkArrayRegistry::visit(entry & e, F f)
+{
+	switch (e.type) {
+	case FLOAT32: f(e.float32); break;
+	case FLOAT64: f(e.float64); break;
+	case INT32: f(e.int32); break;
+	default: f(e.int64);
+	}
+}
@@ -0,0 +1,185 @@
+#include "VtkFlatMeshHolder.h"
+/*////////////////////////////////////////////////////////////////////////////
+VtkFlatMeshHolder.cpp
+
+A dataless VTK unstructured mesh stored as VTK's own arrays.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+
+#include "MeshReordering.h"
+#include "VtkInfo.h"
+
+HBTK::Vtk::VtkFlatMeshHolder::VtkFlatMeshHolder()
+	: offsets(1, 0)
+{
+}
+
+HBTK::Vtk::VtkFlatMeshHolder::VtkFlatMeshHolder(const VtkUnstructuredMeshHolder & mesh)
+	: points(mesh.points)
+{
+	mesh.cell_connectivity(offsets, connectivity);
+	types.reserve(mesh.cells.size());
+	for (const auto & cell : mesh.cells) { types.push_back((unsigned char)cell.cell_type); }
+}
+
+int HBTK::Vtk::VtkFlatMeshHolder::number_of_points() const
+{
+	return points.size();
+}
+
+int HBTK::Vtk::VtkFlatMeshHolder::number_of_cells() const
+{
+	return (int)types.size();
+}
+
+void HBTK::Vtk::VtkFlatMeshHolder::reserve(int num_points, int num_cells, int num_connectivity)
+{
+	points.reserve(num_points);
+	offsets.reserve(num_cells + 1);
+	types.reserve(num_cells);
+	connectivity.reserve(num_connectivity);
+}
+
+void HBTK::Vtk::VtkFlatMeshHolder::clear()
+{
+	points.resize(0);
+	connectivity.clear();
+	offsets.assign(1, 0);
+	types.clear();
+}
+
+int HBTK::Vtk::VtkFlatMeshHolder::add_point(const CartesianPoint3D & point)
+{
+	points.push_back(point);
+	return points.size() - 1;
+}
+
+int HBTK::Vtk::VtkFlatMeshHolder::add_cell(CellType type, const int * node_ids, int num_nodes)
+{
+	assert(num_nodes >= 0);
+	connectivity.insert(connectivity.end(), node_ids, node_ids + num_nodes);
+	offsets.push_back((int)connectivity.size());
+	types.push_back((unsigned char)type);
+	return (int)types.size() - 1;
+}
+
+int HBTK::Vtk::VtkFlatMeshHolder::add_cell(CellType type, std::initializer_list<int> node_ids)
+{
+	return add_cell(type, node_ids.begin(), (int)node_ids.size());
+}
+
+HBTK::Vtk::CellType HBTK::Vtk::VtkFlatMeshHolder::cell_type(int cell) const
+{
+	assert(cell >= 0 && cell < number_of_cells());
+	return (CellType)types[cell];
+}
+
+int HBTK::Vtk::VtkFlatMeshHolder::cell_size(int cell) const
+{
+	assert(cell >= 0 && cell < number_of_cells());
+	return offsets[cell + 1] - offsets[cell];
+}
+
+const int * HBTK::Vtk::VtkFlatMeshHolder::cell_nodes(int cell) const
+{
+	assert(cell >= 0 && cell < number_of_cells());
+	return connectivity.data() + offsets[cell];
+}
+
+std::vector<int> HBTK::Vtk::VtkFlatMeshHolder::check_consistant_node_counts() const
+{
+	std::vector<int> problem_cells;
+	for (int i = 0; i < number_of_cells(); i++) {
+		if (element_node_count(cell_type(i)) != cell_size(i)) {
+			problem_cells.push_back(i);
+		}
+	}
+	return problem_cells;
+}
+
+std::vector<int> HBTK::Vtk::VtkFlatMeshHolder::check_valid_cell_nodes_ids() const
+{
+	std::vector<int> problem_cells;
+	const int num_points = number_of_points();
+	for (int i = 0; i < number_of_cells(); i++) {
+		for (int j = offsets[i]; j < offsets[i + 1]; j++) {
+			if (connectivity[j] < 0 || connectivity[j] >= num_points) {
+				problem_cells.push_back(i);
+				break;
+			}
+		}
+	}
+	return problem_cells;
+}
+
+void HBTK::Vtk::VtkFlatMeshHolder::reorder_points(const std::vector<int> & new_index)
+{
+	assert((int)new_index.size() == number_of_points());
+	apply_ordering(points.x(), new_index);
+	apply_ordering(points.y(), new_index);
+	apply_ordering(points.z(), new_index);
+	for (int & node_id : connectivity) {
+		node_id = new_index[node_id];
+	}
+}
+
+void HBTK::Vtk::VtkFlatMeshHolder::reorder_cells(const std::vector<int> & new_index)
+{
+	assert((int)new_index.size() == number_of_cells());
+	const std::vector<int> old_index = inverse_ordering(new_index);
+	std::vector<int> new_offsets(offsets.size()), new_connectivity(connectivity.size());
+	new_offsets[0] = 0;
+	for (int i = 0; i < number_of_cells(); i++) {
+		const int cell = old_index[i];
+		std::copy(connectivity.begin() + offsets[cell], connectivity.begin() + offsets[cell + 1],
+			new_connectivity.begin() + new_offsets[i]);
+		new_offsets[i + 1] = new_offsets[i] + offsets[cell + 1] - offsets[cell];
+	}
+	offsets.swap(new_offsets);
+	connectivity.swap(new_connectivity);
+	apply_ordering(types, new_index);
+}
+
+HBTK::MeshTopology HBTK::Vtk::VtkFlatMeshHolder::topology(int num_threads) const
+{
+	std::vector<MeshTopology::element_geometry> geometries;
+	geometries.reserve(types.size());
+	for (unsigned char type : types) {
+		geometries.push_back(MeshTopology::vtk_geometry(type));
+	}
+	return MeshTopology(number_of_points(), geometries, offsets, connectivity, num_threads);
+}
+
+HBTK::Vtk::VtkUnstructuredMeshHolder HBTK::Vtk::VtkFlatMeshHolder::to_unstructured() const
+{
+	VtkUnstructuredMeshHolder mesh;
+	mesh.points = points.as_points();
+	mesh.cells.resize(types.size());
+	for (int i = 0; i < number_of_cells(); i++) {
+		mesh.cells[i].cell_type = cell_type(i);
+		mesh.cells[i].node_ids.assign(connectivity.begin() + offsets[i], connectivity.begin() + offsets[i + 1]);
+	}
+	return mesh;
+}
@@ -26,6 +26,30 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 
+bool HBTK::Vtk::is_cell_type(int ele_id)
+{
+	switch (ele_id) {
+	case VTK_VERTEX: case VTK_POLY_VERTEX: case VTK_LINE: case VTK_POLY_LINE:
+	case VTK_TRIANGLE: case VTK_TRIANGLE_STRIP: case VTK_POLYGON: case VTK_PIXEL:
+	case VTK_QUAD: case VTK_TETRA: case VTK_VOXEL: case VTK_HEXAHEDRON:
+	case VTK_WEDGE: case VTK_PYRAMID: case VTK_PENTAGONAL_PRISM: case VTK_HEXAGONAL_PRISM:
+	case VTK_QUADRATIC_EDGE: case VTK_QUADRATIC_TRIANGLE: case VTK_QUADRATIC_QUAD:
+	case VTK_QUADRATIC_TETRA: case VTK_QUADRATIC_HEXAHEDRON: case VTK_CUBIC_LINE:
+	case VTK_POLYHEDRON: case VTK_PARAMETRIC_CURVE: case VTK_PARAMETRIC_SURFACE:
+	case VTK_PARAMETRIC_TRI_SURFACE: case VTK_PARAMETRIC_QUAD_SURFACE:	// == VTK_PARAMETRIC_TETRA_REGION
+	case VTK_PARAMETRIC_HEX_REGION:
+	case VTK_HIGHER_ORDER_EDGE: case VTK_HIGHER_ORDER_TRIANGLE: case VTK_HIGHER_ORDER_QUAD:
+	case VTK_HIGHER_ORDER_POLYGON: case VTK_HIGHER_ORDER_TETRAHEDRON: case VTK_HIGHER_ORDER_WEDGE:
+	case VTK_HIGHER_ORDER_PYRAMID: case VTK_HIGHER_ORDER_HEXAHEDRON:
+	case VTK_LAGRANGE_CURVE: case VTK_LAGRANGE_TRIANGLE: case VTK_LAGRANGE_QUADRILATERAL:
+	case VTK_LAGRANGE_TETRAHEDRON: case VTK_LAGRANGE_HEXAHEDRON: case VTK_LAGRANGE_WEDGE:
+	case VTK_LAGRANGE_PYRAMID:
+		return true;
+	default:
+		return false;
+	}
+}
+
 const std::string HBTK::Vtk::element_name(int ele_id)
 {
 	std::string descriptor;
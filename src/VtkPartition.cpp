@@ -0,0 +1,184 @@
+#include "VtkPartition.h"
+/*////////////////////////////////////////////////////////////////////////////
+VtkPartition.cpp
+
+Splitting VTK datasets into pieces.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "MeshTopology.h"
+#include "Parallel.h"
+
+namespace {
+	void check_parts(int parts, const char * where)
+	{
+		if (parts < 1) {
+			throw std::invalid_argument(std::string("HBTK::Vtk::") + where 
+				+ ": Need at least one part. " __FILE__ ":" + std::to_string(__LINE__));
+		}
+	}
+
+	// Give cells, in order, to parts of near equal total cell size.
+	std::vector<int> split_order(const HBTK::Vtk::VtkUnstructuredMeshHolder & mesh,
+		const std::vector<int> & order, int parts)
+	{
+		long long total = 0;
+		for (auto & cell : mesh.cells) { total += cell.node_ids.size(); }
+		std::vector<int> cell_part(mesh.cells.size());
+		long long sum = 0;
+		int part = 0;
+		for (int cell : order) {
+			// A cell goes to the part holding the middle of its nodes.
+			const long long middle = 2 * sum + (long long)mesh.cells[cell].node_ids.size();
+			while (part < parts - 1 && middle * parts >= 2 * total * (part + 1)) { part++; }
+			cell_part[cell] = part;
+			sum += mesh.cells[cell].node_ids.size();
+		}
+		return cell_part;
+	}
+
+	// Breadth first order of cells from start, marking cells visited with
+	// mark. Returns the last cell reached.
+	int breadth_first(const HBTK::MeshTopology & topology, int start,
+		std::vector<int> & visited, int mark, std::vector<int> & order)
+	{
+		const std::vector<int> & offsets = topology.element_neighbour_offsets();
+		const std::vector<int> & neighbours = topology.element_neighbours();
+		size_t next = order.size();
+		order.push_back(start);
+		visited[start] = mark;
+		while (next < order.size()) {
+			const int cell = order[next++];
+			for (int i = offsets[cell]; i < offsets[cell + 1]; i++) {
+				if (visited[neighbours[i]] != mark) {
+					visited[neighbours[i]] = mark;
+					order.push_back(neighbours[i]);
+				}
+			}
+		}
+		return order.back();
+	}
+}
+
+std::vector<int> HBTK::Vtk::contiguous_partition(const VtkUnstructuredMeshHolder & mesh, int parts)
+{
+	check_parts(parts, "contiguous_partition");
+	std::vector<int> order(mesh.cells.size());
+	for (int i = 0; i < (int)order.size(); i++) { order[i] = i; }
+	return split_order(mesh, order, parts);
+}
+
+std::vector<int> HBTK::Vtk::graph_partition(const VtkUnstructuredMeshHolder & mesh, int parts,
+	int num_threads)
+{
+	check_parts(parts, "graph_partition");
+	const MeshTopology topology = mesh.topology(num_threads);
+	const int num_cells = (int)mesh.cells.size();
+	std::vector<int> visited(num_cells, 0), seen(num_cells, -1);
+	std::vector<int> order, scratch;
+	order.reserve(num_cells);
+	for (int start = 0; start < num_cells; start++) {
+		if (visited[start]) { continue; }
+		// The last cell reached from any cell is far from it - a good start.
+		scratch.clear();
+		const int peripheral = breadth_first(topology, start, seen, start, scratch);
+		breadth_first(topology, peripheral, visited, 1, order);
+	}
+	return split_order(mesh, order, parts);
+}
+
+std::vector<std::vector<int>> HBTK::Vtk::part_cells(const std::vector<int> & cell_part, int parts)
+{
+	check_parts(parts, "part_cells");
+	std::vector<std::vector<int>> cells(parts);
+	for (int i = 0; i < (int)cell_part.size(); i++) {
+		if (cell_part[i] < 0 || cell_part[i] >= parts) {
+			throw std::invalid_argument("HBTK::Vtk::part_cells: Cell " + std::to_string(i)
+				+ " is in part " + std::to_string(cell_part[i]) + " of " + std::to_string(parts)
+				+ ". " __FILE__ ":" + std::to_string(__LINE__));
+		}
+		cells[cell_part[i]].push_back(i);
+	}
+	return cells;
+}
+
+HBTK::Vtk::VtkUnstructuredDataset HBTK::Vtk::extract_cells(const VtkUnstructuredDataset & dataset,
+	const std::vector<int> & cells)
+{
+	std::vector<int> point_map(dataset.mesh.points.size(), -1);
+	return extract_cells(dataset, cells, point_map);
+}
+
+HBTK::Vtk::VtkUnstructuredDataset HBTK::Vtk::extract_cells(const VtkUnstructuredDataset & dataset,
+	const std::vector<int> & cells, std::vector<int> & point_map)
+{
+	VtkUnstructuredDataset piece;
+	std::vector<int> points;
+	piece.mesh.cells.reserve(cells.size());
+	for (int cell : cells) {
+		piece.mesh.cells.push_back(dataset.mesh.cells[cell]);
+		for (int & id : piece.mesh.cells.back().node_ids) {
+			if (point_map[id] < 0) {
+				point_map[id] = (int)points.size();
+				points.push_back(id);
+			}
+			id = point_map[id];
+		}
+	}
+	for (int id : points) { point_map[id] = -1; }
+
+	auto gather = [](const auto & data, auto & into, const std::vector<int> & indices) {
+		for (auto & array : data) {
+			auto & selected = into[array.first];
+			selected.reserve(indices.size());
+			for (int i : indices) { selected.push_back(array.second[i]); }
+		}
+	};
+	piece.mesh.points.reserve(points.size());
+	for (int id : points) { piece.mesh.points.push_back(dataset.mesh.points[id]); }
+	gather(dataset.scalar_point_data, piece.scalar_point_data, points);
+	gather(dataset.integer_point_data, piece.integer_point_data, points);
+	gather(dataset.vector_point_data, piece.vector_point_data, points);
+	gather(dataset.scalar_cell_data, piece.scalar_cell_data, cells);
+	gather(dataset.integer_cell_data, piece.integer_cell_data, cells);
+	gather(dataset.vector_cell_data, piece.vector_cell_data, cells);
+	piece.point_arrays = dataset.point_arrays.select(points);
+	piece.cell_arrays = dataset.cell_arrays.select(cells);
+	return piece;
+}
+
+std::vector<HBTK::Vtk::VtkUnstructuredDataset> HBTK::Vtk::split_dataset(const VtkUnstructuredDataset & dataset,
+	const std::vector<int> & cell_part, int parts, int num_threads)
+{
+	const std::vector<std::vector<int>> cells = part_cells(cell_part, parts);
+	std::vector<VtkUnstructuredDataset> pieces(parts);
+	if (num_threads <= 0) { num_threads = default_thread_count(); }
+	parallel_blocks(0, parts, num_threads, [&](int begin, int end, int) {
+		std::vector<int> point_map(dataset.mesh.points.size(), -1);
+		for (int i = begin; i < end; i++) { pieces[i] = extract_cells(dataset, cells[i], point_map); }
+	});
+	return pieces;
+}
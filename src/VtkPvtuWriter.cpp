@@ -0,0 +1,187 @@
+#include "VtkPvtuWriter.h"
+/*////////////////////////////////////////////////////////////////////////////
+VtkPvtuWriter.cpp
+
+Parallel VTK unstructured grid (.pvtu) files.
+
+Copyright 2018 HJA Bird
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "Parallel.h"
+#include "VtkPartition.h"
+#include "VtkWriter.h"
+
+namespace {
+	std::ofstream open_output(const std::string & path)
+	{
+		std::ofstream output_stream(path, std::ios::binary);
+		if (!output_stream.good()) {
+			throw std::runtime_error("HBTK::Vtk::VtkPvtuWriter::write: Could not write to " + path
+				+ ". Bad stream. " __FILE__ ":" + std::to_string(__LINE__));
+		}
+		return output_stream;
+	}
+
+	template<typename T>
+	bool same_names(const std::unordered_map<std::string, T> & a, const std::unordered_map<std::string, T> & b)
+	{
+		bool same = a.size() == b.size();
+		for (auto & array : a) { same = same && b.count(array.first); }
+		return same;
+	}
+
+	bool same_arrays(const HBTK::Vtk::VtkDataArrays & a, const HBTK::Vtk::VtkDataArrays & b)
+	{
+		return same_names(a.scalar_point_data, b.scalar_point_data)
+			&& same_names(a.integer_point_data, b.integer_point_data)
+			&& same_names(a.vector_point_data, b.vector_point_data)
+			&& same_names(a.scalar_cell_data, b.scalar_cell_data)
+			&& same_names(a.integer_cell_data, b.integer_cell_data)
+			&& same_names(a.vector_cell_data, b.vector_cell_data)
+			&& a.point_arrays.same_arrays(b.point_arrays)
+			&& a.cell_arrays.same_arrays(b.cell_arrays);
+	}
+}
+
+HBTK::Vtk::VtkPvtuWriter::VtkPvtuWriter()
+	: ascii(false),
+	appended(true),
+	write_precision(6),
+	num_threads(0)
+{
+}
+
+void HBTK::Vtk::VtkPvtuWriter::write(const std::string & pvtu_path,
+	const std::vector<VtkUnstructuredDataset> & pieces)
+{
+	for (auto & piece : pieces) {
+		if (!same_arrays(piece, pieces[0])) {
+			throw std::invalid_argument("HBTK::Vtk::VtkPvtuWriter::write: "
+				"Pieces have different arrays. " __FILE__ ":" + std::to_string(__LINE__));
+		}
+	}
+	parallel_for(0, (int)pieces.size(), [&](int i) {
+		write_piece_file(piece_path(pvtu_path, i), pieces[i]);
+	}, num_threads);
+	const VtkDataArrays no_arrays;
+	write_pvtu(pvtu_path, pieces.empty() ? no_arrays : pieces[0], (int)pieces.size());
+}
+
+void HBTK::Vtk::VtkPvtuWriter::write(const std::string & pvtu_path, const VtkUnstructuredDataset & dataset,
+	const std::vector<int> & cell_part, int parts)
+{
+	const std::vector<std::vector<int>> cells = part_cells(cell_part, parts);
+	parallel_blocks(0, parts, num_threads > 0 ? num_threads : default_thread_count(),
+		[&](int begin, int end, int) {
+		std::vector<int> point_map(dataset.mesh.points.size(), -1);
+		for (int i = begin; i < end; i++) {
+			write_piece_file(piece_path(pvtu_path, i), extract_cells(dataset, cells[i], point_map));
+		}
+	});
+	write_pvtu(pvtu_path, dataset, parts);
+}
+
+std::string HBTK::Vtk::VtkPvtuWriter::piece_path(const std::string & pvtu_path, int piece)
+{
+	std::string stem = pvtu_path;
+	const size_t dot = stem.find_last_of('.');
+	const size_t slash = stem.find_last_of("/\\");
+	if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) { stem.erase(dot); }
+	return stem + "_" + std::to_string(piece) + ".vtu";
+}
+
+void HBTK::Vtk::VtkPvtuWriter::write_piece_file(const std::string & path, const VtkUnstructuredDataset & piece) const
+{
+	std::ofstream output_stream = open_output(path);
+	VtkWriter writer;
+	writer.ascii = ascii;
+	writer.appended = appended;
+	writer.write_precision = write_precision;
+	writer.open_file(output_stream, VtkWriter::UnstructuredGrid);
+	writer.write_piece(output_stream, piece);
+	writer.close_file(output_stream);
+	if (!output_stream.good()) {
+		throw std::runtime_error("HBTK::Vtk::VtkPvtuWriter::write: Failed writing " + path
+			+ ". " __FILE__ ":" + std::to_string(__LINE__));
+	}
+}
+
+void HBTK::Vtk::VtkPvtuWriter::write_pvtu(const std::string & pvtu_path, const VtkDataArrays & arrays, int pieces)
+{
+	std::ofstream output_stream = open_output(pvtu_path);
+	m_xml_writer.header(output_stream, "1.0", "UTF-8");
+	m_xml_writer.open_tag(output_stream, "VTKFile",
+		{ std::make_pair("type", "PUnstructuredGrid"),
+		std::make_pair("version", "1.0"),
+		std::make_pair("byte_order", "LittleEndian"),
+		std::make_pair("header_type", "UInt64") });
+	m_xml_writer.open_tag(output_stream, "PUnstructuredGrid", { std::make_pair("GhostLevel", "0") });
+
+	// Array types as written by VtkWriter.
+	m_xml_writer.open_tag(output_stream, "PPointData", {});
+	for (auto & array : arrays.integer_point_data) p_data_array(output_stream, array.first, "Int64", 1);
+	for (auto & array : arrays.scalar_point_data) p_data_array(output_stream, array.first, "Float64", 1);
+	for (auto & array : arrays.vector_point_data) p_data_array(output_stream, array.first, "Float64", 3);
+	for (auto array : arrays.point_arrays.handles()) {
+		p_data_array(output_stream, arrays.point_arrays.name(array),
+			VtkArrayRegistry::type_name(arrays.point_arrays.output_type(array)), arrays.point_arrays.components(array));
+	}
+	m_xml_writer.close_tag(output_stream);
+	m_xml_writer.open_tag(output_stream, "PCellData", {});
+	for (auto & array : arrays.integer_cell_data) p_data_array(output_stream, array.first, "Int64", 1);
+	for (auto & array : arrays.scalar_cell_data) p_data_array(output_stream, array.first, "Float64", 1);
+	for (auto & array : arrays.vector_cell_data) p_data_array(output_stream, array.first, "Float64", 3);
+	for (auto array : arrays.cell_arrays.handles()) {
+		p_data_array(output_stream, arrays.cell_arrays.name(array),
+			VtkArrayRegistry::type_name(arrays.cell_arrays.output_type(array)), arrays.cell_arrays.components(array));
+	}
+	m_xml_writer.close_tag(output_stream);
+	m_xml_writer.open_tag(output_stream, "PPoints", {});
+	p_data_array(output_stream, "Points", "Float64", 3);
+	m_xml_writer.close_tag(output_stream);
+
+	// Pieces are found relative to the .pvtu.
+	for (int i = 0; i < pieces; i++) {
+		std::string source = piece_path(pvtu_path, i);
+		const size_t slash = source.find_last_of("/\\");
+		if (slash != std::string::npos) { source.erase(0, slash + 1); }
+		m_xml_writer.open_tag(output_stream, "Piece", { std::make_pair("Source", source) });
+		m_xml_writer.close_tag(output_stream);
+	}
+	m_xml_writer.close_tag(output_stream); // PUnstructuredGrid
+	m_xml_writer.close_tag(output_stream); // VTKFile
+}
+
+void HBTK::Vtk::VtkPvtuWriter::p_data_array(std::ostream & stream, const std::string & name,
+	const std::string & type, int components)
+{
+	m_xml_writer.open_tag(stream, "PDataArray", {
+		std::make_pair("type", type),
+		std::make_pair("Name", name),
+		std::make_pair("NumberOfComponents", std::to_string(components)) });
+	m_xml_writer.close_tag(stream);
+}
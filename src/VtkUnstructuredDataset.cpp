@@ -0,0 +1,109 @@
+#include "VtkUnstructuredDataset.h"
+
+#include <stdexcept>
+
+#include "MeshReordering.h"
+
+namespace {
+	template<typename T>
+	void check_same_arrays(const std::unordered_map<std::string, std::vector<T>> & data,
+		const std::unordered_map<std::string, std::vector<T>> & other)
+	{
+		bool same = data.size() == other.size();
+		for (auto & array : data) { same = same && other.count(array.first); }
+		if (!same) {
+			throw std::invalid_argument("HBTK::Vtk::VtkUnstructuredDataset::append: "
+				"Datasets have different arrays. " __FILE__ ":" + std::to_string(__LINE__));
+		}
+	}
+
+	template<typename T>
+	void append_data(std::unordered_map<std::string, std::vector<T>> & data,
+		const std::unordered_map<std::string, std::vector<T>> & other)
+	{
+		for (auto & array : data) {
+			const std::vector<T> & more = other.at(array.first);
+			array.second.insert(array.second.end(), more.begin(), more.end());
+		}
+	}
+}
+
+void HBTK::Vtk::VtkDataArrays::reorder_point_data(const std::vector<int> & new_index)
+{
+	for (auto & data : scalar_point_data) { apply_ordering(data.second, new_index); }
+	for (auto & data : integer_point_data) { apply_ordering(data.second, new_index); }
+	for (auto & data : vector_point_data) { apply_ordering(data.second, new_index); }
+	point_arrays.reorder(new_index);
+}
+
+void HBTK::Vtk::VtkDataArrays::reorder_cell_data(const std::vector<int> & new_index)
+{
+	for (auto & data : scalar_cell_data) { apply_ordering(data.second, new_index); }
+	for (auto & data : integer_cell_data) { apply_ordering(data.second, new_index); }
+	for (auto & data : vector_cell_data) { apply_ordering(data.second, new_index); }
+	cell_arrays.reorder(new_index);
+}
+
+void HBTK::Vtk::VtkUnstructuredDataset::reorder_points(const std::vector<int> & new_index)
+{
+	mesh.reorder_points(new_index);
+	reorder_point_data(new_index);
+}
+
+void HBTK::Vtk::VtkUnstructuredDataset::reorder_cells(const std::vector<int> & new_index)
+{
+	mesh.reorder_cells(new_index);
+	reorder_cell_data(new_index);
+}
+
+void HBTK::Vtk::VtkUnstructuredDataset::append(const VtkUnstructuredDataset & other)
+{
+	check_same_arrays(scalar_point_data, other.scalar_point_data);
+	check_same_arrays(integer_point_data, other.integer_point_data);
+	check_same_arrays(vector_point_data, other.vector_point_data);
+	check_same_arrays(scalar_cell_data, other.scalar_cell_data);
+	check_same_arrays(integer_cell_data, other.integer_cell_data);
+	check_same_arrays(vector_cell_data, other.vector_cell_data);
+	if (!point_arrays.same_arrays(other.point_arrays) || !cell_arrays.same_arrays(other.cell_arrays)) {
+		throw std::invalid_argument("HBTK::Vtk::VtkUnstructuredDataset::append: "
+			"Datasets have different arrays. " __FILE__ ":" + std::to_string(__LINE__));
+	}
+	append_data(scalar_point_data, other.scalar_point_data);
+	append_data(integer_point_data, other.integer_point_data);
+	append_data(vector_point_data, other.vector_point_data);
+	append_data(scalar_cell_data, other.scalar_cell_data);
+	append_data(integer_cell_data, other.integer_cell_data);
+	append_data(vector_cell_data, other.vector_cell_data);
+	point_arrays.append(other.point_arrays);
+	cell_arrays.append(other.cell_arrays);
+
+	const int point_offset = (int)mesh.points.size();
+	mesh.points.insert(mesh.points.end(), other.mesh.points.begin(), other.mesh.points.end());
+	const size_t first_cell = mesh.cells.size();
+	mesh.cells.insert(mesh.cells.end(), other.mesh.cells.begin(), other.mesh.cells.end());
+	for (size_t i = first_cell; i < mesh.cells.size(); i++) {
+		for (auto & id : mesh.cells[i].node_ids) { id += point_offset; }
+	}
+}
+
+HBTK::Vtk::VtkFlatDataset::VtkFlatDataset()
+{
+}
+
+HBTK::Vtk::VtkFlatDataset::VtkFlatDataset(const VtkUnstructuredDataset & dataset)
+	: VtkDataArrays(dataset),
+	mesh(dataset.mesh)
+{
+}
+
+void HBTK::Vtk::VtkFlatDataset::reorder_points(const std::vector<int> & new_index)
+{
+	mesh.reorder_points(new_index);
+	reorder_point_data(new_index);
+}
+
+void HBTK::Vtk::VtkFlatDataset::reorder_cells(const std::vector<int> & new_index)
+{
+	mesh.reorder_cells(new_index);
+	reorder_cell_data(new_index);
+}
@@ -2,14 +2,22 @@
 
 #include "CartesianPoint.h"
 #include "Checks.h"
+#include "MeshReordering.h"
+#include "SpatialHash3D.h"
 #include "VtkInfo.h"
 
+#include <cassert>
 #include <unordered_map>
 
 HBTK::Vtk::VtkUnstructuredMeshHolder::VtkUnstructuredMeshHolder()
 {
 }
 
+HBTK::PointArrayView3D HBTK::Vtk::VtkUnstructuredMeshHolder::points_view()
+{
+	return PointArrayView3D(points);
+}
+
 std::vector<int> HBTK::Vtk::VtkUnstructuredMeshHolder::check_consistant_node_counts()
 {
 	std::vector<int> problem_cells;
@@ -37,37 +45,69 @@ std::vector<int> HBTK::Vtk::VtkUnstructuredMeshHolder::check_valid_cell_nodes_id
 	}
 	return problem_cells;
 }
-/*
-std::vector<int> HBTK::Vtk::VtkUnstructuredMeshHolder::merge_repeated_points()
+std::vector<int> HBTK::Vtk::VtkUnstructuredMeshHolder::merge_repeated_points(double tolerance)
 {
+	std::vector<int> merge_map = coincident_point_map(points, tolerance);
 	std::vector<int> new_positions(points.size());
-	std::unordered_map<HBTK::CartesianPoint3D, int> encountered;
 	int count = 0;
 	for (int i = 0; i < (int)points.size(); i++) {
-		if (encountered.count(points[i])) {
-			new_positions[i] = encountered[points[i]];
-		}
-		else {
-			encountered[points[i]] = count;
+		if (merge_map[i] == i) {
 			new_positions[i] = count;
+			points[count] = points[i];
 			count += 1;
 		}
+		else {
+			// merge_map[i] < i, so is already placed.
+			new_positions[i] = new_positions[merge_map[i]];
+		}
 	}
-	encountered.clear();
-	
-	std::vector<HBTK::CartesianPoint3D> new_points(count);
-	for (int i = 0; i < (int)new_positions.size(); i++) {
-		new_points[new_positions[i]] = points[i];
-	}
-	points = new_points;
-	new_points.clear();
+	points.resize(count);
 
 	for (auto & cell : cells) {
 		for (int & node_id : cell.node_ids) {
 			node_id = new_positions[node_id];
 		}
 	}
-
 	return new_positions;
 }
-*/
+
+void HBTK::Vtk::VtkUnstructuredMeshHolder::cell_connectivity(std::vector<int> & offsets, 
+	std::vector<int> & node_ids) const
+{
+	offsets.assign(1, 0);
+	offsets.reserve(cells.size() + 1);
+	node_ids.clear();
+	for (const auto & cell : cells) {
+		node_ids.insert(node_ids.end(), cell.node_ids.begin(), cell.node_ids.end());
+		offsets.push_back((int)node_ids.size());
+	}
+}
+
+void HBTK::Vtk::VtkUnstructuredMeshHolder::reorder_points(const std::vector<int> & new_index)
+{
+	assert(new_index.size() == points.size());
+	apply_ordering(points, new_index);
+	for (auto & cell : cells) {
+		for (int & node_id : cell.node_ids) {
+			node_id = new_index[node_id];
+		}
+	}
+}
+
+void HBTK::Vtk::VtkUnstructuredMeshHolder::reorder_cells(const std::vector<int> & new_index)
+{
+	assert(new_index.size() == cells.size());
+	apply_ordering(cells, new_index);
+}
+
+HBTK::MeshTopology HBTK::Vtk::VtkUnstructuredMeshHolder::topology(int num_threads) const
+{
+	std::vector<int> offsets, node_ids;
+	cell_connectivity(offsets, node_ids);
+	std::vector<MeshTopology::element_geometry> geometries;
+	geometries.reserve(cells.size());
+	for (const auto & cell : cells) {
+		geometries.push_back(MeshTopology::vtk_geometry(cell.cell_type));
+	}
+	return MeshTopology((int)points.size(), geometries, offsets, node_ids, num_threads);
+}
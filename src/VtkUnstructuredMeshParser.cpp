@@ -1,92 +1,482 @@
 #include "VtkUnstructuredMeshParser.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Gzip.h"
+#include "NumberParsing.h"
+#include "VtkInfo.h"
+
+namespace {
+	std::invalid_argument bad_file(const std::string & why, int line)
+	{
+		return std::invalid_argument("HBTK::Vtk::VtkParser: " + why + " "
+			__FILE__ ":" + std::to_string(line));
+	}
+
+	void check_count(size_t count, size_t expected, const std::string & name)
+	{
+		if (count != expected) {
+			throw bad_file("Array " + name + " has " + std::to_string(count)
+				+ " values. Expected " + std::to_string(expected) + ".", __LINE__);
+		}
+	}
+
+	// Erase arrays left from an earlier piece.
+	template<typename T>
+	void remove_unread(std::unordered_map<std::string, T> & data, const std::vector<std::string> & read)
+	{
+		for (auto it = data.begin(); it != data.end();) {
+			if (std::find(read.begin(), read.end(), it->first) == read.end()) { it = data.erase(it); }
+			else { ++it; }
+		}
+	}
+
+	void remove_unread(HBTK::Vtk::VtkArrayRegistry & arrays, const std::vector<std::string> & read)
+	{
+		for (auto array : arrays.handles()) {
+			if (std::find(read.begin(), read.end(), arrays.name(array)) == read.end()) { arrays.remove(array); }
+		}
+	}
+
+	// Registry type able to hold values of type.
+	HBTK::Vtk::VtkArrayRegistry::value_type registry_type(HBTK::Vtk::VtkXmlArrayReader::stype type)
+	{
+		using R = HBTK::Vtk::VtkXmlArrayReader;
+		using A = HBTK::Vtk::VtkArrayRegistry;
+		switch (type) {
+		case R::FLOAT32: return A::FLOAT32;
+		case R::FLOAT64: return A::FLOAT64;
+		case R::INT64: case R::UINT32: case R::UINT64: return A::INT64;
+		default: return A::INT32;
+		}
+	}
+}
 
 HBTK::Vtk::VtkParser::VtkParser()
-	: m_version(0.1),
+	: typed_arrays(false),
+	m_error_stream(NULL),
+	m_version(0.1),
 	m_fmap_stack(),
-	input_stream(NULL)
+	m_num_points(0),
+	m_num_cells(0),
+	m_inline_arrays(0),
+	m_appended_stream(NULL),
+	m_appended_base64(false),
+	m_appended_position(0),
+	m_appended_end(0),
+	m_appended_start(-1)
 {
-	m_fmap_stack.push
-	(function_map({ {"VTKFile", 
-		[&](const key_val_pairs & p, std::istream & s) {vtk_file_tag_handler(p,s); } } }));
+	m_xml_parser.on_element_open = [this](std::string name, key_val_pairs key_vals) {
+		on_tag_open(name, key_vals);
+	};
+	m_xml_parser.on_element_close = [this](std::string name) { on_tag_close(name); };
 }
 
-void HBTK::Vtk::VtkParser::main_parser(std::ifstream & input_stream, std::ostream & error_stream)
+void HBTK::Vtk::VtkParser::add_piece_function(std::function<bool(VtkUnstructuredDataset&)> func)
 {
-
-	
+	m_piece_funcs.emplace_back(func);
 }
 
-void HBTK::Vtk::VtkParser::on_tag_open(std::string tag_name, key_val_pairs key_vals)
-{	
-	// Evaluates whatever is on top of the function map stack pretty much.
-	std::function<void(const key_val_pairs &, std::istream & stream)> func;
+HBTK::Vtk::VtkUnstructuredDataset HBTK::Vtk::VtkParser::parse_dataset(ByteSource source)
+{
+	VtkUnstructuredDataset dataset;
+	bool first = true;
+	std::vector<std::function<bool(VtkUnstructuredDataset &)>> funcs({
+		[&](VtkUnstructuredDataset & piece)->bool {
+			if (first) { std::swap(dataset, piece); }
+			else { dataset.append(piece); }
+			first = false;
+			return true;
+		} });
+	m_piece_funcs.swap(funcs);
 	try {
-		func = m_fmap_stack.top().at(tag_name);
-		func(key_vals, *input_stream);
+		parse(std::move(source));
 	}
 	catch (...) {
+		m_piece_funcs.swap(funcs);
 		throw;
 	}
+	m_piece_funcs.swap(funcs);
+	return dataset;
+}
+
+HBTK::Vtk::VtkUnstructuredDataset HBTK::Vtk::VtkParser::parse_dataset(const std::string & file_path)
+{
+	return parse_dataset(decompressed(ByteSource::from_file(file_path)));
+}
+
+void HBTK::Vtk::VtkParser::main_parser(std::istream & input_stream, std::ostream & error_stream)
+{
+	m_error_stream = &error_stream;
+	m_fmap_stack = std::stack<function_map>();
+	m_fmap_stack.push
+	(function_map({ {"VTKFile",
+		[&](const key_val_pairs & p, std::istream & s) {vtk_file_tag_handler(p,s); } } }));
+	m_appended_pieces.clear();
+	m_array_reader.set_file_options(VtkXmlArrayReader::UINT32, false, false);
+
+	m_xml_parser.parse(input_stream, error_stream);
+	if (!m_appended_pieces.empty()) {
+		throw bad_file("Appended arrays, but no AppendedData.", __LINE__);
+	}
+	m_error_stream = NULL;
+}
+
+void HBTK::Vtk::VtkParser::on_tag_open(std::string tag_name, key_val_pairs key_vals)
+{
+	// Evaluates whatever is on top of the function map stack pretty much.
+	auto it = m_fmap_stack.top().find(tag_name);
+	if (it == m_fmap_stack.top().end()) {
+		if (m_fmap_stack.size() == 1) { throw bad_file("Not a VTK XML file.", __LINE__); }
+		// Elements we don't use (eg. FieldData) and everything in them are skipped.
+		m_fmap_stack.push(function_map());
+		return;
+	}
+	std::function<void(const key_val_pairs &, std::istream & stream)> func = it->second;
+	func(key_vals, m_xml_parser.xml_input_stream());
 }
 
 void HBTK::Vtk::VtkParser::on_tag_close(std::string tag_name)
 {
 	m_fmap_stack.pop();
+	if (tag_name == "Piece") {
+		if (m_piece_record.arrays.empty()) {
+			finish_piece();
+		}
+		else if (m_inline_arrays == 0) {
+			m_appended_pieces.emplace_back(std::move(m_piece_record));
+		}
+		else {
+			throw bad_file("Pieces mixing inline and appended arrays are not supported.", __LINE__);
+		}
+	}
 }
 
 void HBTK::Vtk::VtkParser::vtk_file_tag_handler(
 	const key_val_pairs & params, std::istream & stream)
 {
+	VtkXmlArrayReader::stype header_type = VtkXmlArrayReader::UINT32;
+	bool big_endian = false, compressed = false;
 	for (const auto & pair : params) {
 		if (pair.first == "type") {
 			if (pair.second != "UnstructuredGrid") {
-				throw;
+				throw bad_file("Only UnstructuredGrid files can be read. File type is " + pair.second + ".", __LINE__);
 			}
 		}
 		else if(pair.first == "version") {
-			; // Sort out later.
+			m_version = to_double(pair.second);
 		}
 		else if (pair.first == "byte_order") {
-			; // Sort out later.
+			if (pair.second == "BigEndian") { big_endian = true; }
+			else if (pair.second != "LittleEndian") {
+				throw bad_file("Bad byte_order " + pair.second + ".", __LINE__);
+			}
 		}
-		else if (pair.first == "compressor") {
-			throw;
+		else if (pair.first == "header_type") {
+			header_type = VtkXmlArrayReader::type_string_to_stype(pair.second);
 		}
-		else {
-			throw;
+		else if (pair.first == "compressor") {
+			if (pair.second != "vtkZLibDataCompressor") {
+				throw bad_file("Unsupported compressor " + pair.second + ". Only "
+					"vtkZLibDataCompressor can be read.", __LINE__);
+			}
+			compressed = true;
 		}
 	}
+	m_array_reader.set_file_options(header_type, big_endian, compressed);
 
 	m_fmap_stack.push(function_map({
-		{ "Cells", [&](const key_val_pairs & p, std::istream & s) {unstructured_cells_tag_handler(p,s); } },
-		{ "Points", [&](const key_val_pairs & p, std::istream & s) {unstructured_points_tag_handler(p,s); } },
-		{ "CellData", [&](const key_val_pairs & p, std::istream & s) {unstructured_cell_data_tag_handler(p,s); } },
-		{ "Points", [&](const key_val_pairs & p, std::istream & s) {unstructured_point_data_tag_handler(p,s); } } }));
+		{ "UnstructuredGrid", [&](const key_val_pairs & p, std::istream & s) {unstructured_grid_tag_handler(p,s); } },
+		{ "AppendedData", [&](const key_val_pairs & p, std::istream & s) {appended_data_tag_handler(p,s); } } }));
 	return;
 }
 
-void HBTK::Vtk::VtkParser::data_array_tag_handler(const key_val_pairs & params, std::istream & stream)
+void HBTK::Vtk::VtkParser::unstructured_grid_tag_handler(const key_val_pairs & params, std::istream & stream)
 {
-	int expected_len, tag;
-	tag = m_array_reader.new_array_tag(expected_len, params, m_xml_parser);
+	m_fmap_stack.push(function_map({
+		{ "Piece", [&](const key_val_pairs & p, std::istream & s) {piece_tag_handler(p,s); } } }));
+}
+
+void HBTK::Vtk::VtkParser::piece_tag_handler(const key_val_pairs & params, std::istream & stream)
+{
+	int num_points = 0, num_cells = 0;
+	for (const auto & pair : params) {
+		if (pair.first == "NumberOfPoints") { num_points = to_int(pair.second); }
+		else if (pair.first == "NumberOfCells") { num_cells = to_int(pair.second); }
+	}
+	if (num_points < 0 || num_cells < 0) { throw bad_file("Negative piece size.", __LINE__); }
+	begin_piece(num_points, num_cells);
+	m_piece_record.num_points = num_points;
+	m_piece_record.num_cells = num_cells;
+	m_piece_record.arrays.clear();
+	m_inline_arrays = 0;
+
+	m_fmap_stack.push(function_map({
+		{ "Points", [&](const key_val_pairs & p, std::istream & s) {unstructured_points_tag_handler(p,s); } },
+		{ "Cells", [&](const key_val_pairs & p, std::istream & s) {unstructured_cells_tag_handler(p,s); } },
+		{ "PointData", [&](const key_val_pairs & p, std::istream & s) {unstructured_point_data_tag_handler(p,s); } },
+		{ "CellData", [&](const key_val_pairs & p, std::istream & s) {unstructured_cell_data_tag_handler(p,s); } } }));
+}
+
+void HBTK::Vtk::VtkParser::data_array_tag_handler(array_section section,
+	const key_val_pairs & params, std::istream & stream)
+{
+	array_record record = { section, m_array_reader.describe_array(params) };
+	if (record.info.data_format == VtkXmlArrayReader::APPENDED) {
+		m_piece_record.arrays.push_back(record);
+	}
+	else {
+		m_xml_parser.read_element_content(m_content);
+		read_array(record);
+		m_inline_arrays++;
+	}
+	m_fmap_stack.push(function_map());
 }
 
 void HBTK::Vtk::VtkParser::unstructured_cells_tag_handler(const key_val_pairs & params, std::istream & stream)
 {
+	m_fmap_stack.push(function_map({
+		{ "DataArray", [&](const key_val_pairs & p, std::istream & s) {data_array_tag_handler(CELLS, p, s); } } }));
 }
 
 void HBTK::Vtk::VtkParser::unstructured_points_tag_handler(const key_val_pairs & params, std::istream & stream)
 {
+	m_fmap_stack.push(function_map({
+		{ "DataArray", [&](const key_val_pairs & p, std::istream & s) {data_array_tag_handler(POINTS, p, s); } } }));
 }
 
 void HBTK::Vtk::VtkParser::unstructured_cell_data_tag_handler(const key_val_pairs & params, std::istream & stream)
 {
+	m_fmap_stack.push(function_map({
+		{ "DataArray", [&](const key_val_pairs & p, std::istream & s) {data_array_tag_handler(CELL_DATA, p, s); } } }));
 }
 
 void HBTK::Vtk::VtkParser::unstructured_point_data_tag_handler(const key_val_pairs & params, std::istream & stream)
 {
+	m_fmap_stack.push(function_map({
+		{ "DataArray", [&](const key_val_pairs & p, std::istream & s) {data_array_tag_handler(POINT_DATA, p, s); } } }));
 }
 
+void HBTK::Vtk::VtkParser::appended_data_tag_handler(const key_val_pairs & params, std::istream & stream)
+{
+	m_appended_base64 = false;
+	for (const auto & pair : params) {
+		if (pair.first == "encoding") {
+			if (pair.second == "base64") { m_appended_base64 = true; }
+			else if (pair.second != "raw") {
+				throw bad_file("Unsupported AppendedData encoding " + pair.second + ".", __LINE__);
+			}
+		}
+	}
+	// The data starts after an underscore.
+	char c = ' ';
+	while (stream.get(c) && isspace((unsigned char)c)) {}
+	if (c != '_') { throw bad_file("AppendedData does not start with '_'.", __LINE__); }
+	m_appended_stream = &stream;
+	m_appended_start = stream.tellg();
+	m_appended_position = 0;
+	m_appended_end = 0;
+
+	for (auto & piece : m_appended_pieces) {
+		begin_piece(piece.num_points, piece.num_cells);
+		for (auto & record : piece.arrays) { read_array(record); }
+		finish_piece();
+	}
+	m_appended_pieces.clear();
+	// Skip any arrays that were never read, then the whitespace before the close tag.
+	seek_appended(m_appended_end);
+	m_appended_stream = NULL;
+	m_xml_parser.read_element_content(m_content);
+	m_fmap_stack.push(function_map());
+}
+
+void HBTK::Vtk::VtkParser::seek_appended(long long offset)
+{
+	assert(m_appended_stream);
+	if (offset >= m_appended_position) {
+		if (!m_appended_stream->ignore(offset - m_appended_position)) {
+			throw bad_file("AppendedData is truncated.", __LINE__);
+		}
+	}
+	else if (m_appended_start != std::streampos(-1)) {
+		m_appended_stream->seekg(m_appended_start + std::streamoff(offset));
+	}
+	else {
+		throw bad_file("Appended arrays are out of order and the stream cannot seek.", __LINE__);
+	}
+	m_appended_position = offset;
+}
 
+void HBTK::Vtk::VtkParser::read_array(const array_record & record)
+{
+	static_assert(sizeof(CartesianPoint3D) == 3 * sizeof(double)
+		&& sizeof(CartesianVector3D) == 3 * sizeof(double),
+		"HBTK::Vtk::VtkParser::read_array: points and vectors are decoded as arrays of doubles.");
+	const VtkXmlArrayReader::array_info & info = record.info;
+	// Values go straight from the decoder into the dataset.
+	auto read = [&](const auto & destination) {
+		if (info.data_format == VtkXmlArrayReader::APPENDED) {
+			seek_appended(info.offset);
+			m_appended_position += m_array_reader.read_appended(
+				info, *m_appended_stream, m_appended_base64, destination);
+			m_appended_end = std::max(m_appended_end, m_appended_position);
+		}
+		else {
+			m_array_reader.read_inline(info, m_content, destination);
+		}
+	};
+	auto into_ints = [&](std::vector<int> & target, long long expected) {
+		read(std::function<int*(size_t)>([&](size_t n) {
+			if (expected >= 0) { check_count(n, (size_t)expected, info.name); }
+			target.resize(n);
+			return target.data();
+		}));
+	};
+	auto discard = [&]() {
+		*m_error_stream << "HBTK::Vtk::VtkParser: Skipped array " << info.name
+			<< " of " << info.components << " components.\n";
+		read(std::function<double*(size_t)>([&](size_t n) {
+			m_discarded.resize(n);
+			return m_discarded.data();
+		}));
+	};
+
+	switch (record.section) {
+	case POINTS: {
+		if (info.components != 3) { throw bad_file("Points must have 3 components.", __LINE__); }
+		std::vector<CartesianPoint3D> & points = m_piece.mesh.points;
+		read(std::function<double*(size_t)>([&](size_t n) {
+			check_count(n, 3 * (size_t)m_num_points, info.name);
+			points.resize(m_num_points);
+			return points.empty() ? (double*)NULL : points[0].as_array().data();
+		}));
+		break;
+	}
+	case CELLS:
+		if (info.name == "connectivity") { into_ints(m_connectivity, -1); }
+		else if (info.name == "offsets") { into_ints(m_cell_offsets, m_num_cells); }
+		else if (info.name == "types") { into_ints(m_cell_types, m_num_cells); }
+		else { discard(); }
+		break;
+	case POINT_DATA:
+	case CELL_DATA: {
+		const bool point = record.section == POINT_DATA;
+		const int expected = point ? m_num_points : m_num_cells;
+		(point ? m_point_data_names : m_cell_data_names).push_back(info.name);
+		if (typed_arrays || (info.components != 1 && info.components != 3)) {
+			VtkArrayRegistry & arrays = point ? m_piece.point_arrays : m_piece.cell_arrays;
+			const VtkArrayRegistry::value_type type = registry_type(info.storage_type);
+			VtkArrayRegistry::handle array = arrays.find(info.name);
+			if (array >= 0 && (arrays.type(array) != type || arrays.components(array) != info.components
+				|| arrays.layout(array) != VtkArrayRegistry::INTERLEAVED)) {
+				arrays.remove(array);
+				array = -1;
+			}
+			if (array < 0) { array = arrays.add(info.name, type, info.components, 0); }
+			auto into_registry = [&](auto * type_tag) {
+				using T = typename std::remove_pointer<decltype(type_tag)>::type;
+				read(std::function<T*(size_t)>([&](size_t n) {
+					check_count(n, (size_t)info.components * expected, info.name);
+					arrays.resize(array, expected);
+					return arrays.data<T>(array);
+				}));
+			};
+			switch (type) {
+			case VtkArrayRegistry::FLOAT32: into_registry((float*)NULL); break;
+			case VtkArrayRegistry::FLOAT64: into_registry((double*)NULL); break;
+			case VtkArrayRegistry::INT32: into_registry((int32_t*)NULL); break;
+			case VtkArrayRegistry::INT64: into_registry((int64_t*)NULL); break;
+			}
+			break;
+		}
+		switch (m_array_reader.data_type(info)) {
+		case VtkXmlArrayReader::SCALAR: {
+			std::vector<double> & target = point ?
+				m_piece.scalar_point_data[info.name] : m_piece.scalar_cell_data[info.name];
+			read(std::function<double*(size_t)>([&](size_t n) {
+				check_count(n, expected, info.name);
+				target.resize(n);
+				return target.data();
+			}));
+			break;
+		}
+		case VtkXmlArrayReader::INTEGER:
+			into_ints(point ? m_piece.integer_point_data[info.name] : m_piece.integer_cell_data[info.name], expected);
+			break;
+		case VtkXmlArrayReader::VECTOR: {
+			std::vector<CartesianVector3D> & target = point ?
+				m_piece.vector_point_data[info.name] : m_piece.vector_cell_data[info.name];
+			read(std::function<double*(size_t)>([&](size_t n) {
+				check_count(n, 3 * (size_t)expected, info.name);
+				target.resize(expected);
+				return target.empty() ? (double*)NULL : target[0].as_array().data();
+			}));
+			break;
+		}
+		}
+		break;
+	}
+	}
+}
+
+void HBTK::Vtk::VtkParser::begin_piece(int num_points, int num_cells)
+{
+	m_num_points = num_points;
+	m_num_cells = num_cells;
+	m_piece.mesh.points.clear();
+	m_cell_types.clear();
+	m_cell_offsets.clear();
+	m_connectivity.clear();
+	m_point_data_names.clear();
+	m_cell_data_names.clear();
+}
+
+void HBTK::Vtk::VtkParser::finish_piece()
+{
+	check_count(m_piece.mesh.points.size(), m_num_points, "Points");
+	check_count(m_cell_types.size(), m_num_cells, "types");
+	check_count(m_cell_offsets.size(), m_num_cells, "offsets");
+
+	// Cells keep their node id storage between pieces.
+	std::vector<VtkUnstructuredMeshHolder::cell_data> & cells = m_piece.mesh.cells;
+	cells.resize(m_num_cells);
+	int begin = 0;
+	for (int i = 0; i < m_num_cells; i++) {
+		const int end = m_cell_offsets[i];
+		if (end < begin || end > (int)m_connectivity.size()) {
+			throw bad_file("Bad cell offsets.", __LINE__);
+		}
+		if (!is_cell_type(m_cell_types[i])) {
+			throw bad_file("Unknown cell type " + std::to_string(m_cell_types[i]) + ".", __LINE__);
+		}
+		for (int j = begin; j < end; j++) {
+			if (m_connectivity[j] < 0 || m_connectivity[j] >= m_num_points) {
+				throw bad_file("Cell node id " + std::to_string(m_connectivity[j]) 
+					+ " is not a point.", __LINE__);
+			}
+		}
+		cells[i].cell_type = (CellType)m_cell_types[i];
+		cells[i].node_ids.assign(m_connectivity.begin() + begin, m_connectivity.begin() + end);
+		begin = end;
+	}
+
+	remove_unread(m_piece.scalar_point_data, m_point_data_names);
+	remove_unread(m_piece.integer_point_data, m_point_data_names);
+	remove_unread(m_piece.vector_point_data, m_point_data_names);
+	remove_unread(m_piece.scalar_cell_data, m_cell_data_names);
+	remove_unread(m_piece.integer_cell_data, m_cell_data_names);
+	remove_unread(m_piece.vector_cell_data, m_cell_data_names);
+	remove_unread(m_piece.point_arrays, m_point_data_names);
+	remove_unread(m_piece.cell_arrays, m_cell_data_names);
+
+	for (auto & func : m_piece_funcs) {
+		if (!func(m_piece)) { break; }
+	}
+}
@@ -28,13 +28,109 @@ SOFTWARE.
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 #include "Base64.h"
 
+namespace {
+	// Base64 encodes everything written to it as one stream, a block at a
+	// time, onto destination (or into text() if destination is NULL).
+	class Base64Stream {
+	public:
+		Base64Stream(std::ostream * destination)
+			: m_destination(destination)
+		{
+			m_raw.reserve(block_size);
+		}
+
+		void write(const void * data, size_t bytes) {
+			const unsigned char * p = (const unsigned char*)data;
+			while (bytes > 0) {
+				size_t n = std::min(bytes, block_size - m_raw.size());
+				m_raw.insert(m_raw.end(), p, p + n);
+				p += n;
+				bytes -= n;
+				if (m_raw.size() == block_size) { encode(); }
+			}
+		}
+
+		// Encode the rest, padded.
+		void finish() {
+			encode();
+			flush();
+		}
+
+		std::string & text() { return m_text; }
+
+	private:
+		// A multiple of 3 bytes, so blocks are not padded.
+		static const size_t block_size = 3 * 16384;
+		std::ostream * m_destination;
+		std::vector<unsigned char> m_raw;
+		std::string m_text;
+
+		void encode() {
+			if (m_raw.empty()) { return; }
+			m_text += HBTK::encode_base64(m_raw.data(), (int)m_raw.size());
+			m_raw.clear();
+			if (m_text.size() >= 4 * block_size) { flush(); }
+		}
+
+		void flush() {
+			if (!m_destination) { return; }
+			m_destination->write(m_text.data(), m_text.size());
+			m_text.clear();
+		}
+	};
+
+	// Print unsigned char as a number.
+	inline int printable(unsigned char value) { return value; }
+	inline int printable(int value) { return value; }
+	inline double printable(double value) { return value; }
+	inline float printable(float value) { return value; }
+	inline int64_t printable(int64_t value) { return value; }
+
+	// Call f with each value converted to D in VTK's interleaved order.
+	template<typename D, typename S, typename F>
+	void for_each_interleaved(const S * data, int tuples, int components, bool interleaved, F f)
+	{
+		if (interleaved) {
+			for (size_t i = 0; i < (size_t)tuples * components; i++) { f((D)data[i]); }
+		}
+		else {
+			for (int i = 0; i < tuples; i++) {
+				for (int j = 0; j < components; j++) { f((D)data[(size_t)j * tuples + i]); }
+			}
+		}
+	}
+
+	template<typename D, typename S>
+	void encode_values(Base64Stream & encoder, const S * data, int tuples, int components, bool interleaved)
+	{
+		uint64_t bytes = sizeof(D) * (size_t)tuples * components;
+		encoder.write(&bytes, sizeof(bytes));
+		if (interleaved && std::is_same<D, S>::value) {
+			encoder.write(data, (size_t)bytes);
+			return;
+		}
+		D buffer[1024];
+		size_t n = 0;
+		for_each_interleaved<D>(data, tuples, components, interleaved, [&](D value) {
+			buffer[n++] = value;
+			if (n == 1024) {
+				encoder.write(buffer, sizeof(buffer));
+				n = 0;
+			}
+		});
+		encoder.write(buffer, n * sizeof(D));
+	}
+}
+
 HBTK::Vtk::VtkWriter::VtkWriter()
 	: m_written_xml_header(false),
 	m_file_type(None),
@@ -82,6 +178,26 @@ void HBTK::Vtk::VtkWriter::write_piece(std::ostream & stream, const VtkUnstructu
 	return;
 }
 
+void HBTK::Vtk::VtkWriter::write_piece(std::ostream & stream, const VtkFlatDataset & data)
+{
+	assert(m_file_type != None); // Have you used open_file()?
+	assert(!(ascii && appended)); // Not correct options!
+	if (m_file_type != UnstructuredGrid) {
+		throw std::runtime_error(
+			"HBTK::Vtk::VtkWriter::write_piece(..., VtkFlatDataset): "
+			"VtkFileType is not unstructured grid! " + std::to_string(__LINE__)
+			+ " : " __FILE__
+		);
+	}
+	vtk_unstructured_piece(stream, data.mesh.number_of_points(), data.mesh.number_of_cells());
+	vtk_flat_mesh(stream, data.mesh);
+	vtk_unstructured_point_data(stream, data);
+	vtk_unstructured_cell_data(stream, data);
+
+	m_xml_writer.close_tag(stream); // piece
+	return;
+}
+
 void HBTK::Vtk::VtkWriter::close_file(std::ostream & stream)
 {
 	m_xml_writer.close_tag(stream); // Grid
@@ -167,21 +283,39 @@ void HBTK::Vtk::VtkWriter::vtk_unstructured_cells(std::ostream & ostream, const
 	m_xml_writer.close_tag(ostream);
 }
 
-void HBTK::Vtk::VtkWriter::vtk_unstructured_point_data(std::ostream & ostream, const VtkUnstructuredDataset & data)
+void HBTK::Vtk::VtkWriter::vtk_flat_mesh(std::ostream & ostream, const VtkFlatMeshHolder & mesh)
+{
+	static_assert(sizeof(int) == 4, "HBTK::Vtk::VtkWriter::vtk_flat_mesh: Cell arrays are written as Int32.");
+	m_xml_writer.open_tag(ostream, "Points", {});
+	vtk_direct_data_array(ostream, "Points", mesh.points);
+	m_xml_writer.close_tag(ostream);
+
+	m_xml_writer.open_tag(ostream, "Cells", {});
+	const size_t num_cells = mesh.types.size();
+	vtk_direct_data_array(ostream, "connectivity", "Int32", mesh.connectivity.data(), mesh.connectivity.size());
+	// VTK's offsets are the ends of each cell.
+	vtk_direct_data_array(ostream, "offsets", "Int32", mesh.offsets.data() + 1, num_cells);
+	vtk_direct_data_array(ostream, "types", "UInt8", mesh.types.data(), num_cells);
+	m_xml_writer.close_tag(ostream);
+}
+
+void HBTK::Vtk::VtkWriter::vtk_unstructured_point_data(std::ostream & ostream, const VtkDataArrays & data)
 {
 	m_xml_writer.open_tag(ostream, "PointData", {});
 	for (auto & subset : data.integer_point_data) vtk_data_array(ostream, subset.first, subset.second);
 	for (auto & subset : data.scalar_point_data) vtk_data_array(ostream, subset.first, subset.second);
 	for (auto & subset : data.vector_point_data) vtk_data_array(ostream, subset.first, subset.second);
+	for (auto array : data.point_arrays.handles()) vtk_registry_array(ostream, data.point_arrays, array);
 	m_xml_writer.close_tag(ostream);
 }
 
-void HBTK::Vtk::VtkWriter::vtk_unstructured_cell_data(std::ostream & ostream, const VtkUnstructuredDataset & data)
+void HBTK::Vtk::VtkWriter::vtk_unstructured_cell_data(std::ostream & ostream, const VtkDataArrays & data)
 {
 	m_xml_writer.open_tag(ostream, "CellData", {});
 	for (auto & subset : data.integer_cell_data) vtk_data_array(ostream, subset.first, subset.second);
 	for (auto & subset : data.scalar_cell_data) vtk_data_array(ostream, subset.first, subset.second);
 	for (auto & subset : data.vector_cell_data) vtk_data_array(ostream, subset.first, subset.second);
+	for (auto array : data.cell_arrays.handles()) vtk_registry_array(ostream, data.cell_arrays, array);
 	m_xml_writer.close_tag(ostream);
 }
 
@@ -419,6 +553,110 @@ std::vector<std::pair<std::string, std::string>> HBTK::Vtk::VtkWriter::vtk_data_
 	}
 }
 
+void HBTK::Vtk::VtkWriter::vtk_data_array_open(std::ostream & ostream, const std::string & name,
+	const std::string & type, int components)
+{
+	std::vector<std::pair<std::string, std::string>> xml_params =
+	{ std::make_pair("type", type),
+		std::make_pair("Name", name),
+		std::make_pair("NumberOfComponents", std::to_string(components)) };
+	auto format_params = vtk_data_array_format_options();
+	xml_params.insert(xml_params.end(), format_params.begin(), format_params.end());
+	m_xml_writer.open_tag(ostream, "DataArray", xml_params);
+}
+
+template<typename T>
+void HBTK::Vtk::VtkWriter::vtk_direct_data_array(std::ostream & ostream, const std::string & name,
+	const std::string & type, const T * data, size_t count)
+{
+	vtk_data_array_open(ostream, name, type, 1);
+	if (ascii) {
+		std::streamsize precision = ostream.precision(write_precision);
+		for (size_t i = 0; i < count; i++) { ostream << printable(data[i]) << '\n'; }
+		ostream.precision(precision);
+	}
+	else {
+		Base64Stream encoder(appended ? NULL : &ostream);
+		uint64_t bytes = sizeof(T) * count;
+		encoder.write(&bytes, sizeof(bytes));
+		encoder.write(data, bytes);
+		encoder.finish();
+		if (appended) {
+			m_appended_data.emplace_back(encoder.text().begin(), encoder.text().end());
+		}
+	}
+	m_xml_writer.close_tag(ostream);
+}
+
+void HBTK::Vtk::VtkWriter::vtk_direct_data_array(std::ostream & ostream, const std::string & name,
+	const PointArray3D & points)
+{
+	vtk_data_array_open(ostream, name, "Float64", 3);
+	const std::vector<double> & x = points.x(), & y = points.y(), & z = points.z();
+	if (ascii) {
+		std::streamsize precision = ostream.precision(write_precision);
+		for (int i = 0; i < points.size(); i++) { ostream << x[i] << ' ' << y[i] << ' ' << z[i] << '\n'; }
+		ostream.precision(precision);
+	}
+	else {
+		// VTK points are interleaved: the coordinates are interleaved as they are encoded.
+		Base64Stream encoder(appended ? NULL : &ostream);
+		uint64_t bytes = 3 * sizeof(double) * points.size();
+		encoder.write(&bytes, sizeof(bytes));
+		for (int i = 0; i < points.size(); i++) {
+			const double xyz[3] = { x[i], y[i], z[i] };
+			encoder.write(xyz, sizeof(xyz));
+		}
+		encoder.finish();
+		if (appended) {
+			m_appended_data.emplace_back(encoder.text().begin(), encoder.text().end());
+		}
+	}
+	m_xml_writer.close_tag(ostream);
+}
+
+void HBTK::Vtk::VtkWriter::vtk_registry_array(std::ostream & ostream, const VtkArrayRegistry & arrays,
+	VtkArrayRegistry::handle array)
+{
+	switch (arrays.type(array)) {
+	case VtkArrayRegistry::FLOAT32: vtk_registry_values<float>(ostream, arrays, array); break;
+	case VtkArrayRegistry::FLOAT64: vtk_registry_values<double>(ostream, arrays, array); break;
+	case VtkArrayRegistry::INT32: vtk_registry_values<int32_t>(ostream, arrays, array); break;
+	case VtkArrayRegistry::INT64: vtk_registry_values<int64_t>(ostream, arrays, array); break;
+	}
+}
+
+template<typename T>
+void HBTK::Vtk::VtkWriter::vtk_registry_values(std::ostream & ostream, const VtkArrayRegistry & arrays,
+	VtkArrayRegistry::handle array)
+{
+	const T * data = arrays.data<T>(array);
+	const int tuples = arrays.tuples(array), components = arrays.components(array);
+	const bool interleaved = arrays.layout(array) == VtkArrayRegistry::INTERLEAVED;
+	const bool to_float = arrays.output_type(array) != arrays.type(array);
+	vtk_data_array_open(ostream, arrays.name(array), VtkArrayRegistry::type_name(arrays.output_type(array)), components);
+	if (ascii) {
+		std::streamsize precision = ostream.precision(write_precision);
+		int column = 0;
+		auto print = [&](auto value) {
+			ostream << printable(value) << (++column % components ? ' ' : '\n');
+		};
+		if (to_float) { for_each_interleaved<float>(data, tuples, components, interleaved, print); }
+		else { for_each_interleaved<T>(data, tuples, components, interleaved, print); }
+		ostream.precision(precision);
+	}
+	else {
+		Base64Stream encoder(appended ? NULL : &ostream);
+		if (to_float) { encode_values<float>(encoder, data, tuples, components, interleaved); }
+		else { encode_values<T>(encoder, data, tuples, components, interleaved); }
+		encoder.finish();
+		if (appended) {
+			m_appended_data.emplace_back(encoder.text().begin(), encoder.text().end());
+		}
+	}
+	m_xml_writer.close_tag(ostream);
+}
+
 int HBTK::Vtk::VtkWriter::appended_data_bytelength() const
 {
 	int acc = 0;
@@ -25,130 +25,247 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 
-int HBTK::Vtk::VtkXmlArrayReader::new_array_tag(
-	int expected_length, 
-	Xml::XmlParser::key_val_pairs xml_tag_args,
-	Xml::XmlParser & parser)
+#include "Base64.h"
+#include "Gzip.h"
+#include "NumberParsing.h"
+
+namespace {
+	std::invalid_argument bad_array(const std::string & where, const std::string & why, int line)
+	{
+		return std::invalid_argument("HBTK::Vtk::VtkXmlArrayReader::" + where + ": " + why + " "
+			__FILE__ ":" + std::to_string(line));
+	}
+
+	// Base64 characters for size bytes.
+	inline size_t base64_length(size_t size)
+	{
+		return (size + 2) / 3 * 4;
+	}
+
+	// parse_number, including types it has no overload for.
+	inline const char * parse_value(const char * first, const char * last, double & value)
+	{
+		return HBTK::parse_number(first, last, value);
+	}
+
+	inline const char * parse_value(const char * first, const char * last, int & value)
+	{
+		return HBTK::parse_number(first, last, value);
+	}
+
+	inline const char * parse_value(const char * first, const char * last, float & value)
+	{
+		double parsed;
+		const char * end = HBTK::parse_number(first, last, parsed);
+		value = (float)parsed;
+		return end;
+	}
+
+	inline const char * parse_value(const char * first, const char * last, int64_t & value)
+	{
+		long long parsed;
+		const char * end = HBTK::parse_number(first, last, parsed);
+		value = (int64_t)parsed;
+		return end;
+	}
+
+	template<typename S>
+	inline S load(const unsigned char * raw, bool swap)
+	{
+		unsigned char bytes[sizeof(S)];
+		if (swap) { std::reverse_copy(raw, raw + sizeof(S), bytes); }
+		else { std::memcpy(bytes, raw, sizeof(S)); }
+		S value;
+		std::memcpy(&value, bytes, sizeof(S));
+		return value;
+	}
+
+	template<typename S, typename T>
+	void convert_as(const unsigned char * raw, size_t n, bool swap, T * out)
+	{
+		if (n == 0) { return; }
+		if (std::is_same<S, T>::value && !swap) {
+			std::memcpy(out, raw, n * sizeof(T));
+			return;
+		}
+		for (size_t i = 0; i < n; i++) {
+			out[i] = (T)load<S>(raw + i * sizeof(S), swap);
+		}
+	}
+
+	// n values of type from raw to out.
+	template<typename T>
+	void convert(const unsigned char * raw, HBTK::Vtk::VtkXmlArrayReader::stype type,
+		size_t n, bool swap, T * out)
+	{
+		typedef HBTK::Vtk::VtkXmlArrayReader R;
+		switch (type) {
+		case R::INT8: convert_as<int8_t>(raw, n, swap, out); break;
+		case R::INT16: convert_as<int16_t>(raw, n, swap, out); break;
+		case R::INT32: convert_as<int32_t>(raw, n, swap, out); break;
+		case R::INT64: convert_as<int64_t>(raw, n, swap, out); break;
+		case R::UINT8: convert_as<uint8_t>(raw, n, swap, out); break;
+		case R::UINT16: convert_as<uint16_t>(raw, n, swap, out); break;
+		case R::UINT32: convert_as<uint32_t>(raw, n, swap, out); break;
+		case R::UINT64: convert_as<uint64_t>(raw, n, swap, out); break;
+		case R::FLOAT32: convert_as<float>(raw, n, swap, out); break;
+		case R::FLOAT64: convert_as<double>(raw, n, swap, out); break;
+		}
+	}
+
+	void read_chars(std::istream & stream, size_t n, std::string & text)
+	{
+		size_t start = text.size();
+		text.resize(start + n);
+		if (n > 0 && !stream.read(&text[start], n)) {
+			throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
+		}
+	}
+
+	// Characters left in stream, or the largest streamsize if it can't seek.
+	size_t remaining_chars(std::istream & stream)
+	{
+		const size_t unknown = (size_t)std::numeric_limits<std::streamsize>::max();
+		const std::istream::pos_type here = stream.tellg();
+		if (here == std::istream::pos_type(-1)) { return unknown; }
+		stream.seekg(0, std::ios_base::end);
+		const std::istream::pos_type end = stream.tellg();
+		stream.clear();
+		stream.seekg(here);
+		if (end == std::istream::pos_type(-1) || end < here) { return unknown; }
+		return (size_t)(end - here);
+	}
+}
+
+HBTK::Vtk::VtkXmlArrayReader::VtkXmlArrayReader()
+	: m_header_type(UINT32),
+	m_big_endian(false),
+	m_compressed(false)
 {
-	std::string name;
-	dtype type_num = SCALAR;
-	stype type_comp = FLOAT64;
-	bool type_known(false), name_known(false), stype_known(false);
-	bool appended(false), ascii(false), binary(false);
-	int offset(-1);
+}
+
+void HBTK::Vtk::VtkXmlArrayReader::set_file_options(stype header_type, bool big_endian, bool compressed)
+{
+	if (header_type != UINT32 && header_type != UINT64) {
+		throw bad_array("set_file_options", "header_type must be UInt32 or UInt64.", __LINE__);
+	}
+	m_header_type = header_type;
+	m_big_endian = big_endian;
+	m_compressed = compressed;
+}
 
-	if(expected_length < 0) { throw std::invalid_argument("Bad expected array length: " + std::to_string(expected_length)); }
+HBTK::Vtk::VtkXmlArrayReader::array_info HBTK::Vtk::VtkXmlArrayReader::describe_array(
+	const Xml::XmlParser::key_val_pairs & xml_tag_args) const
+{
+	array_info info;
+	info.storage_type = FLOAT64;
+	info.components = 1;
+	info.data_format = ASCII;
+	info.offset = -1;
+	bool type_known(false), format_known(false);
 	for (auto & p : xml_tag_args) {
 		if (p.first == "Name" || p.first == "name") {
-			name = p.second;
-			name_known = true;
+			info.name = p.second;
 		}
 		else if (p.first == "type" || p.first == "Type") {
-			type_comp = type_string_to_stype(p.second);
-			stype_known = true;
+			info.storage_type = type_string_to_stype(p.second);
+			type_known = true;
 		}
 		else if (p.first == "NumberOfComponents") {
-			if (p.second == "1") type_num = SCALAR;
-			else if (p.second == "3") type_num = VECTOR;
-			else throw std::invalid_argument("Bad NumberOfComponents: " + p.second);
-			type_known = true;
+			info.components = to_int(p.second);
+			if (info.components < 1) { throw bad_array("describe_array", "Bad NumberOfComponents: " + p.second, __LINE__); }
 		}
 		else if (p.first == "format") {
-			if (p.second == "appended") {
-				appended = true;
-			} else if (p.second == "binary") {
-				binary = true;
-			}
-			else if (p.second == "ascii") {
-				ascii = true;
-			}
-			else throw std::invalid_argument("Bad format: " + p.second);
+			if (p.second == "appended") { info.data_format = APPENDED; }
+			else if (p.second == "binary") { info.data_format = BINARY; }
+			else if (p.second == "ascii") { info.data_format = ASCII; }
+			else { throw bad_array("describe_array", "Bad format: " + p.second, __LINE__); }
+			format_known = true;
 		}
-		else if (p.first == "offset"){
-			p.second = atoi(p.second.c_str());
+		else if (p.first == "offset" || p.first == "Offset") {
+			info.offset = to_integer(p.second);
 		}
 	}
-	
-	// Now check that we have something workable:
-	if(!(appended || ascii || binary)) throw std::invalid_argument("Format (appended, binary, ascii) unknown.");
-	if ((appended && ascii) || (binary && ascii) || (appended && binary)) {
-		throw std::invalid_argument("Multiple formats specified.");
+	if (!format_known) { throw bad_array("describe_array", "Format (appended, binary, ascii) unknown.", __LINE__); }
+	if (!type_known) { throw bad_array("describe_array", "Type (ie. Int32, Float64 etc) unknown.", __LINE__); }
+	if (info.data_format == APPENDED && info.offset < 0) {
+		throw bad_array("describe_array", "Offset not specified for appended array " + info.name + ".", __LINE__);
+	}
+	return info;
+}
+
+HBTK::Vtk::VtkXmlArrayReader::dtype HBTK::Vtk::VtkXmlArrayReader::data_type(const array_info & info) const
+{
+	if (info.components == 3) { return VECTOR; }
+	if (info.components != 1) {
+		throw bad_array("data_type", "Arrays of " + std::to_string(info.components)
+			+ " components are not supported (" + info.name + ").", __LINE__);
 	}
-	if(appended && (offset == -1)){ throw std::invalid_argument("Offset not specified."); }
-	if(!type_known){ throw std::invalid_argument("NumberOfComponents unknown."); }
-	if(!stype_known) { throw std::invalid_argument("Type (ie. Int32, Float64 etc) unknown."); }
-	int i_tag = (int)m_data_types.size();
-	if (!name_known) { name = std::to_string(i_tag); name_known = true; }
+	return info.storage_type == FLOAT32 || info.storage_type == FLOAT64 ? SCALAR : INTEGER;
+}
 
-	int id = (int)m_data_names.size();
-	m_data_names.push_back(name);
-	m_data_types.push_back(type_num);
-	m_storage_types.push_back(type_comp);
-	m_num_values.push_back(expected_length);
+void HBTK::Vtk::VtkXmlArrayReader::read_inline(const array_info & info, const std::string & content,
+	const std::function<double*(size_t)>& destination)
+{
+	read_inline_impl(info, content, destination);
+}
 
+void HBTK::Vtk::VtkXmlArrayReader::read_inline(const array_info & info, const std::string & content,
+	const std::function<int*(size_t)>& destination)
+{
+	read_inline_impl(info, content, destination);
+}
 
-	if (appended) {
-		m_offsets[id] = offset;
-	} else if (ascii) 
-	{
-		read_ascii_data(id, parser);
-	}
-	else if (binary)
-	{
-		// read_base64_data(id);
-	}
-	return id;
+void HBTK::Vtk::VtkXmlArrayReader::read_inline(const array_info & info, const std::string & content,
+	const std::function<float*(size_t)>& destination)
+{
+	read_inline_impl(info, content, destination);
 }
 
-HBTK::Vtk::VtkXmlArrayReader::dtype HBTK::Vtk::VtkXmlArrayReader::retrieve_data_type(int array_tag)
+void HBTK::Vtk::VtkXmlArrayReader::read_inline(const array_info & info, const std::string & content,
+	const std::function<int64_t*(size_t)>& destination)
 {
-	assert(array_tag >= 0);
-	assert(array_tag < (int)m_data_names.size());
-	return m_data_types[array_tag];
+	read_inline_impl(info, content, destination);
 }
 
-void HBTK::Vtk::VtkXmlArrayReader::retrieve_scalar_data(int tag, std::string & name_target, std::vector<double>& data_target)
+size_t HBTK::Vtk::VtkXmlArrayReader::read_appended(const array_info & info, std::istream & stream,
+	bool base64, const std::function<double*(size_t)>& destination)
 {
-	assert(tag >= 0);
-	assert(tag < (int)m_data_names.size());
-	if (m_scalar_data.count(tag) == 0) {
-		throw std::invalid_argument(m_data_names[tag] + " is not of scalar type.");
-	}
-	data_target = m_scalar_data[tag];
-	name_target = m_data_names[tag];
-	return;
+	return read_appended_impl(info, stream, base64, destination);
 }
 
-void HBTK::Vtk::VtkXmlArrayReader::retrieve_int_data(int tag, std::string & name_target, std::vector<int>& data_target)
+size_t HBTK::Vtk::VtkXmlArrayReader::read_appended(const array_info & info, std::istream & stream,
+	bool base64, const std::function<int*(size_t)>& destination)
 {
-	assert(tag >= 0);
-	assert(tag < (int)m_data_names.size());
-	if (m_int_data.count(tag) == 0) {
-		throw std::invalid_argument(m_data_names[tag] + " is not of int type.");
-	}
-	data_target = m_int_data[tag];
-	name_target = m_data_names[tag];
-	return;
+	return read_appended_impl(info, stream, base64, destination);
 }
 
-void HBTK::Vtk::VtkXmlArrayReader::retrieve_vector_data(int tag, std::string & name_target, std::vector<HBTK::CartesianVector3D>& data_target)
+size_t HBTK::Vtk::VtkXmlArrayReader::read_appended(const array_info & info, std::istream & stream,
+	bool base64, const std::function<float*(size_t)>& destination)
 {
-	assert(tag >= 0);
-	assert(tag < (int)m_data_names.size());
-	if (m_vector_data.count(tag) == 0) {
-		throw std::invalid_argument(m_data_names[tag] + " is not of vector type.");
-	}
-	data_target = m_vector_data[tag];
-	name_target = m_data_names[tag];
-	return;
+	return read_appended_impl(info, stream, base64, destination);
+}
+
+size_t HBTK::Vtk::VtkXmlArrayReader::read_appended(const array_info & info, std::istream & stream,
+	bool base64, const std::function<int64_t*(size_t)>& destination)
+{
+	return read_appended_impl(info, stream, base64, destination);
 }
 
 HBTK::Vtk::VtkXmlArrayReader::stype HBTK::Vtk::VtkXmlArrayReader::type_string_to_stype(std::string desc)
 {
-	const std::unordered_map<std::string, stype> mapping({
+	static const std::unordered_map<std::string, stype> mapping({
 		{"Int8", INT8},
 		{ "Int16", INT16 },
 		{ "Int32", INT32 },
@@ -160,61 +277,200 @@ HBTK::Vtk::VtkXmlArrayReader::stype HBTK::Vtk::VtkXmlArrayReader::type_string_to
 		{ "Float32", FLOAT32 },
 		{ "Float64", FLOAT64 }
 		});
-	stype t;
-	if (mapping.count(desc) == 0) {
-		throw std::invalid_argument("Bad type description string. Given " + desc);
+	auto it = mapping.find(desc);
+	if (it == mapping.end()) {
+		throw bad_array("type_string_to_stype", "Bad type description string. Given " + desc, __LINE__);
+	}
+	return it->second;
+}
+
+int HBTK::Vtk::VtkXmlArrayReader::stype_size(stype type)
+{
+	switch (type) {
+	case INT8: case UINT8: return 1;
+	case INT16: case UINT16: return 2;
+	case INT32: case UINT32: case FLOAT32: return 4;
+	default: return 8;
+	}
+}
+
+template<typename T>
+void HBTK::Vtk::VtkXmlArrayReader::read_inline_impl(const array_info & info, const std::string & content,
+	const std::function<T*(size_t)>& destination)
+{
+	if (info.data_format == ASCII) {
+		const char * first = content.data(), * last = first + content.size();
+		size_t n = 0;
+		bool in_word = false;
+		for (const char * c = first; c != last; c++) {
+			bool space = isspace((unsigned char)*c) != 0;
+			if (!space && !in_word) { n++; }
+			in_word = !space;
+		}
+		T * out = destination(n);
+		for (size_t i = 0; i < n; i++) {
+			while (isspace((unsigned char)*first)) { first++; }
+			const char * end = parse_value(first, last, out[i]);
+			if (end == first) {
+				throw bad_array("read_inline", "Bad number in ascii array " + info.name + ".", __LINE__);
+			}
+			first = end;
+		}
+	}
+	else if (info.data_format == BINARY) {
+		m_bytes.resize(3 * (content.size() / 4 + 1));
+		size_t size = decode_base64(content.data(), content.size(), m_bytes.data());
+		size_t bytes;
+		const unsigned char * values = binary_values(m_bytes.data(), size, bytes);
+		const size_t value_size = stype_size(info.storage_type);
+		if (bytes % value_size != 0) {
+			throw bad_array("read_inline", "Byte count of " + info.name + " is not a whole number of values.", __LINE__);
+		}
+		T * out = destination(bytes / value_size);
+		convert(values, info.storage_type, bytes / value_size, m_big_endian, out);
 	}
 	else {
-		t = mapping.at(desc);
+		throw bad_array("read_inline", "Array " + info.name + " is appended, not inline.", __LINE__);
 	}
-	return t;
 }
 
-void HBTK::Vtk::VtkXmlArrayReader::read_ascii_data(int id, Xml::XmlParser& xml_parser)
+template<typename T>
+size_t HBTK::Vtk::VtkXmlArrayReader::read_appended_impl(const array_info & info, std::istream & stream,
+	bool base64, const std::function<T*(size_t)>& destination)
 {
-	std::istream & istream = xml_parser.xml_input_stream();
-	int n_val = m_num_values[id];
-	dtype dt = m_data_types[id];
-	stype st = m_storage_types[id];
-	if (dt == SCALAR) {
-		std::vector<double> data(n_val);
-		for (int i = 0; i < n_val; i++) {
-			try {
-				istream >> data[i];
+	const size_t hs = stype_size(m_header_type);
+	size_t used, size;
+	if (base64) {
+		// The header and data may be encoded together or separately.
+		m_text.clear();
+		m_bytes.resize(3 * hs + 3);
+		if (m_compressed) {
+			read_chars(stream, 4 * hs, m_text);	// Three values, no padding.
+			decode_base64(m_text.data(), m_text.size(), m_bytes.data());
+			// Base64 is longer than the bytes it encodes, so neither the
+			// header nor the data can be longer than what is left.
+			size_t left = remaining_chars(stream);
+			const size_t blocks = header_value(m_bytes.data());
+			if (blocks > left / hs) {
+				throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
 			}
-			catch (...) {
-				std::invalid_argument("Encountered problem reading input stream.");
+			const size_t header = (3 + blocks) * hs;
+			read_chars(stream, base64_length(header) - m_text.size(), m_text);
+			m_bytes.resize(header + 3);
+			decode_base64(m_text.data(), m_text.size(), m_bytes.data());
+			left = remaining_chars(stream);
+			size_t data_bytes = 0;
+			for (size_t i = 3 * hs; i < header; i += hs) {
+				const size_t block_bytes = header_value(m_bytes.data() + i);
+				if (block_bytes > left - data_bytes) {
+					throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
+				}
+				data_bytes += block_bytes;
 			}
+			read_chars(stream, base64_length(data_bytes), m_text);
 		}
-		m_scalar_data[id] = data;
-	}
-	else if (dt == INTEGER) {
-		std::vector<int> data(n_val);
-		for (int i = 0; i < n_val; i++) {
-			try {
-				istream >> data[i];
+		else {
+			read_chars(stream, base64_length(hs), m_text);
+			decode_base64(m_text.data(), m_text.size(), m_bytes.data());
+			const size_t data_bytes = header_value(m_bytes.data());
+			if (data_bytes > remaining_chars(stream)) {
+				throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
+			}
+			if (m_text.back() == '=') {
+				read_chars(stream, base64_length(data_bytes), m_text);
 			}
-			catch (...) {
-				std::invalid_argument("Encountered problem reading input stream.");
+			else {
+				read_chars(stream, base64_length(hs + data_bytes) - m_text.size(), m_text);
 			}
 		}
-		m_int_data[id] = data;
-	}
-	else if (dt == VECTOR) {
-		std::vector<CartesianVector3D> data(n_val * 3);
-		for (int i = 0; i < n_val; i++) {
-			double x, y, z;
-			try {
-				istream >> x;
-				istream >> y;
-				istream >> z;
-				data[i] = CartesianVector3D({ x, y, z });
+		used = m_text.size();
+		m_bytes.resize(3 * (m_text.size() / 4 + 1));
+		size = decode_base64(m_text.data(), m_text.size(), m_bytes.data());
+	}
+	else {
+		m_bytes.resize(3 * hs);
+		if (!stream.read((char*)m_bytes.data(), (m_compressed ? 3 : 1) * hs)) {
+			throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
+		}
+		size_t left = remaining_chars(stream);
+		size_t header = hs, data_bytes = header_value(m_bytes.data());
+		if (m_compressed) {
+			const size_t blocks = header_value(m_bytes.data());
+			if (blocks > left / hs) {
+				throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
 			}
-			catch (...) {
-				std::invalid_argument("Encountered problem reading input stream.");
+			header = (3 + blocks) * hs;
+			m_bytes.resize(header);
+			if (!stream.read((char*)m_bytes.data() + 3 * hs, header - 3 * hs)) {
+				throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
 			}
+			left -= header - 3 * hs;
+			data_bytes = 0;
+			for (size_t i = 3 * hs; i < header; i += hs) {
+				const size_t block_bytes = header_value(m_bytes.data() + i);
+				if (block_bytes > left - data_bytes) {
+					throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
+				}
+				data_bytes += block_bytes;
+			}
+		}
+		if (data_bytes > left) {
+			throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
+		}
+		m_bytes.resize(header + data_bytes);
+		if (data_bytes > 0 && !stream.read((char*)m_bytes.data() + header, data_bytes)) {
+			throw bad_array("read_appended", "Appended data is truncated.", __LINE__);
+		}
+		used = size = m_bytes.size();
+	}
+
+	size_t bytes;
+	const unsigned char * values = binary_values(m_bytes.data(), size, bytes);
+	const size_t value_size = stype_size(info.storage_type);
+	if (bytes % value_size != 0) {
+		throw bad_array("read_appended", "Byte count of " + info.name + " is not a whole number of values.", __LINE__);
+	}
+	T * out = destination(bytes / value_size);
+	convert(values, info.storage_type, bytes / value_size, m_big_endian, out);
+	return used;
+}
+
+size_t HBTK::Vtk::VtkXmlArrayReader::header_value(const unsigned char * data) const
+{
+	if (m_header_type == UINT64) { return (size_t)load<uint64_t>(data, m_big_endian); }
+	return (size_t)load<uint32_t>(data, m_big_endian);
+}
+
+const unsigned char * HBTK::Vtk::VtkXmlArrayReader::binary_values(
+	const unsigned char * data, size_t size, size_t & bytes)
+{
+	const size_t hs = stype_size(m_header_type);
+	if (!m_compressed) {
+		if (size < hs || header_value(data) > size - hs) {
+			throw bad_array("binary_values", "Binary array is truncated.", __LINE__);
+		}
+		bytes = header_value(data);
+		return data + hs;
+	}
+	// [number of blocks, block size, last block size, compressed block sizes...]
+	if (size < 3 * hs) { throw bad_array("binary_values", "Compressed array header is truncated.", __LINE__); }
+	const size_t blocks = header_value(data), block_size = header_value(data + hs);
+	const size_t last_size = header_value(data + 2 * hs);
+	if (blocks > size / hs - 3) { throw bad_array("binary_values", "Compressed array header is truncated.", __LINE__); }
+	size_t pos = (3 + blocks) * hs;
+	m_inflated.clear();
+	m_inflated.reserve(blocks == 0 ? 0 : (blocks - 1) * block_size + (last_size ? last_size : block_size));
+	for (size_t i = 0; i < blocks; i++) {
+		size_t compressed = header_value(data + (3 + i) * hs);
+		if (compressed > size - pos) { throw bad_array("binary_values", "Compressed array is truncated.", __LINE__); }
+		size_t before = m_inflated.size();
+		zlib_decompress((const char*)data + pos, compressed, m_inflated);
+		size_t expected = (i + 1 == blocks && last_size) ? last_size : block_size;
+		if (m_inflated.size() - before != expected) {
+			throw bad_array("binary_values", "Compressed block has the wrong size.", __LINE__);
 		}
-		m_vector_data[id] = data;
+		pos += compressed;
 	}
-	return;
+	bytes = m_inflated.size();
+	return (const unsigned char*)m_inflated.data();
 }
@@ -27,9 +27,12 @@ SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
 #include <cassert>
+#include <cctype>
+#include <limits>
 
 HBTK::Xml::XmlParser::XmlParser()
 	: m_reading_file(false),
+	m_at_tag(false),
 	m_encoding(UTF8),
 	m_input_stream(NULL),
 	m_element_stack()
@@ -48,10 +51,21 @@ std::istream & HBTK::Xml::XmlParser::xml_input_stream()
 	return *m_input_stream;
 }
 
-void HBTK::Xml::XmlParser::main_parser(std::ifstream & input_stream, std::ostream & error_stream)
+void HBTK::Xml::XmlParser::read_element_content(std::string & content)
+{
+	assert(m_input_stream != NULL);
+	content.clear();
+	std::getline(*m_input_stream, content, '<');
+	m_at_tag = !m_input_stream->eof();
+	return;
+}
+
+void HBTK::Xml::XmlParser::main_parser(std::istream & input_stream, std::ostream & error_stream)
 {
 	m_input_stream = &input_stream;
 	m_reading_file = true;
+	m_at_tag = false;
+	m_element_stack = std::stack<std::string>();
 	parse_prologue();
 	while (m_input_stream->good()) {
 		if (!seek_next_xml_event()) {
@@ -61,6 +75,7 @@ void HBTK::Xml::XmlParser::main_parser(std::ifstream & input_stream, std::ostrea
 	}
 	m_reading_file = false;
 	m_input_stream = NULL;
+	if (!m_element_stack.empty()) { throw - 6; } // Unclosed elements.
 	return;
 }
 
@@ -71,55 +86,83 @@ void HBTK::Xml::XmlParser::parse_prologue()
 
 void HBTK::Xml::XmlParser::parse_element_open()
 {
-	int tag_length = element_descriptor_length();
-	std::string tag_string;
-	for (int i = 0; i < tag_length; i++) {
-		tag_string += normalised_next_char();
-	}
-	auto str_vector = tokenise(tag_string);
-	std::string element_name = str_vector[0];
-	// Reassemble strings with spaces.
-	std::vector<std::pair<std::string, std::string>> parameters;
-	for (int i = 1; i < (int)str_vector.size(); i++) {
-		int eq_pos = str_vector[i].find('=', 0);
-		if (eq_pos == (int)str_vector[i].size()) { throw - 2; };
-		std::string name, value;
-		name = str_vector[i].substr(0, eq_pos);
-		if (str_vector[i][eq_pos + 1] != '\"') { throw - 3; }
-		value = str_vector[i].substr(eq_pos + 1, str_vector[i].size() - eq_pos - 1);
-		while (value.back() != '\"') {
-			i++;
-			if (i >= (int)str_vector.size()) throw - 4;
-			value += str_vector[i];
-		}
-		value = value.substr(1, value.size() - 2);
-		parameters.push_back({ name, value });
+	read_tag_string();
+	bool self_closing = !m_tag_string.empty() && m_tag_string.back() == '/';
+	if (self_closing) { m_tag_string.pop_back(); }
+
+	const int length = (int)m_tag_string.size();
+	int pos = 0;
+	while (pos < length && !isspace((unsigned char)m_tag_string[pos])) { pos++; }
+	std::string element_name = m_tag_string.substr(0, pos);
+	if (element_name.empty()) { throw - 1; }
+
+	// name="value" or name='value', with optional whitespace around the '='.
+	key_val_pairs parameters;
+	while (true) {
+		while (pos < length && isspace((unsigned char)m_tag_string[pos])) { pos++; }
+		if (pos == length) { break; }
+		int name_begin = pos;
+		while (pos < length && m_tag_string[pos] != '=' && !isspace((unsigned char)m_tag_string[pos])) { pos++; }
+		std::string name = m_tag_string.substr(name_begin, pos - name_begin);
+		while (pos < length && isspace((unsigned char)m_tag_string[pos])) { pos++; }
+		if (pos == length || m_tag_string[pos] != '=') { throw - 2; }
+		pos++;
+		while (pos < length && isspace((unsigned char)m_tag_string[pos])) { pos++; }
+		if (pos == length || (m_tag_string[pos] != '\"' && m_tag_string[pos] != '\'')) { throw - 3; }
+		char quote = m_tag_string[pos++];
+		int value_begin = pos;
+		while (pos < length && m_tag_string[pos] != quote) { pos++; }
+		if (pos == length) { throw - 4; }
+		parameters.emplace_back(name, m_tag_string.substr(value_begin, pos - value_begin));
+		pos++;
 	}
 	m_element_stack.push(element_name);
-	normalised_next_char(); // We know this exists from element_desc length.
 	on_element_open(element_name, parameters);
+	if (self_closing) {
+		m_element_stack.pop();
+		on_element_close(element_name);
+	}
 	return;
 }
 
 void HBTK::Xml::XmlParser::parse_element_close()
 {
-	int tag_length = element_descriptor_length();
-	std::string tag_string;
-	for (int i = 0; i < tag_length; i++) {
-		tag_string += normalised_next_char();
+	read_tag_string();
+	while (!m_tag_string.empty() && isspace((unsigned char)m_tag_string.back())) {
+		m_tag_string.pop_back();
 	}
-	if (tag_string == m_element_stack.top()) {
+	if (!m_element_stack.empty() && m_tag_string == m_element_stack.top()) {
 		m_element_stack.pop();
 	}
 	else {
 		throw - 5;
 	}
-	on_element_close(tag_string);
+	on_element_close(m_tag_string);
 	return;
 }
 
 void HBTK::Xml::XmlParser::parse_parser_event()
 {
+	// <? ... ?>
+	read_tag_string();
+	return;
+}
+
+void HBTK::Xml::XmlParser::parse_markup_declaration()
+{
+	// Comments end "-->" and CDATA "]]>": both may contain '>'.
+	read_tag_string();
+	std::string terminator;
+	if (m_tag_string.compare(0, 2, "--") == 0) { terminator = "--"; }
+	else if (m_tag_string.compare(0, 7, "[CDATA[") == 0) { terminator = "]]"; }
+	while (!terminator.empty() && m_input_stream->good()
+		&& (m_tag_string.size() < terminator.size() + 2
+			|| m_tag_string.compare(m_tag_string.size() - 2, 2, terminator) != 0)) {
+		std::string more;
+		std::getline(*m_input_stream, more, '>');
+		m_tag_string += '>';
+		m_tag_string += more;
+	}
 	return;
 }
 
@@ -127,34 +170,19 @@ int HBTK::Xml::XmlParser::seek_next_xml_event()
 {
 	// Keep going until we find an xml tag opening.
 	assert(m_input_stream != NULL);
-	char next_character;
-	do {
-		next_character = normalised_next_char();
-	} while ((next_character != '<') && m_input_stream->good());
+	if (m_at_tag) {
+		m_at_tag = false;
+		return 1;
+	}
+	m_input_stream->ignore(std::numeric_limits<std::streamsize>::max(), '<');
 	if (m_input_stream->good()) return 1;
 	else return 0;
 }
 
-int HBTK::Xml::XmlParser::element_descriptor_length()
-{
-	assert(m_reading_file);
-	assert(m_input_stream != NULL);
-	auto position = m_input_stream->tellg();
-	int counter = 0;
-	char next_char;
-	do {
-		counter++;
-		next_char = normalised_next_char();
-	} while ((m_input_stream->good()) && next_char != '>');
-	m_input_stream->seekg(position);
-	return counter - 1;
-}
-
 void HBTK::Xml::XmlParser::act_on_xml_event()
 {
 	// Identify the type of XML event based on the next character.
-	auto position = m_input_stream->tellg();
-	char next_char = normalised_next_char();
+	int next_char = m_input_stream->peek();
 	switch( next_char ){
 	case ' ':
 		throw -1;
@@ -162,17 +190,31 @@ void HBTK::Xml::XmlParser::act_on_xml_event()
 	case '?':
 		parse_parser_event();
 		break;
+	case '!':
+		normalised_next_char();
+		parse_markup_declaration();
+		break;
 	case '/':
+		normalised_next_char();
 		parse_element_close();
 		break;
 	default:
-		m_input_stream->seekg(position);
 		parse_element_open();
 		break;
 	}
 	return;
 }
 
+void HBTK::Xml::XmlParser::read_tag_string()
+{
+	assert(m_reading_file);
+	assert(m_encoding == UTF8);
+	m_tag_string.clear();
+	std::getline(*m_input_stream, m_tag_string, '>');
+	if (m_input_stream->eof()) { throw - 7; } // Unterminated tag.
+	return;
+}
+
 char HBTK::Xml::XmlParser::normalised_next_char()
 {
 	assert(m_input_stream != NULL);
@@ -181,4 +223,3 @@ char HBTK::Xml::XmlParser::normalised_next_char()
 	m_input_stream->read(&buffer, sizeof(buffer));
 	return buffer;
 }
-
@@ -63,4 +63,60 @@ TEST_CASE("NACA 0012") {
 		REQUIRE(2 * 0.024071 == Approx(thickness(0.020877)).margin(1e-6));
 
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Batch NACA four digit aerofoils") {
+	std::vector<double> thickness, camber, position;
+	for (int i = 0; i < 50; i++) {
+		thickness.push_back(0.06 + 0.002 * i);
+		camber.push_back(0.001 * (i % 5));
+		position.push_back(0.2 + 0.01 * i);
+	}
+	std::vector<double> x_points = HBTK::AerofoilGenerators::cosine_chord_points(41);
+	REQUIRE(x_points.front() == 0.);
+	REQUIRE(x_points.back() == 1.);
+	HBTK::AerofoilSectionSet sections = HBTK::AerofoilGenerators::naca_four_digit(
+		thickness, camber, position, x_points, 3);
+	REQUIRE(sections.number_of_sections() == 50);
+	REQUIRE(sections.number_of_points() == 41);
+
+	SECTION("Matches single section generator") {
+		for (int s : { 0, 17, 49 }) {
+			HBTK::AerofoilGeometry foil = HBTK::AerofoilGenerators::naca_four_digit(
+				thickness[s], camber[s], position[s]);
+			foil.repoint([](double x) { return x; }, 41);
+			HBTK::CubicSpline1D ref_thickness = foil.get_thickness_spline();
+			std::vector<double> upper(41), lower(41);
+			sections.z_upper(s, upper.data());
+			sections.z_lower(s, lower.data());
+			for (int i = 0; i < 41; i++) {
+				REQUIRE(upper[i] - lower[i] == Approx(sections.thickness(s)[i]));
+				REQUIRE(0.5 * (upper[i] + lower[i]) == Approx(sections.camber(s)[i]));
+			}
+			REQUIRE(sections.thickness(s)[20] == Approx(ref_thickness(x_points[20])).margin(1e-4));
+		}
+	}
+	SECTION("Section geometry") {
+		HBTK::AerofoilGeometry foil = sections.geometry(3);
+		std::vector<double> x = foil.x_all();
+		REQUIRE((int)x.size() == 81);
+		REQUIRE(x.front() == 1.);
+		REQUIRE(x[40] == 0.);
+		REQUIRE(x.back() == 1.);
+		REQUIRE(foil.tailing_edge_gap() == Approx(sections.thickness(3)[40]));
+	}
+}
+
+TEST_CASE("Aerofoil spline cache") {
+	HBTK::AerofoilSplineCache cache(80);
+	HBTK::AerofoilSplineCache::Splines & first = cache.naca_four_digit(0.12, 0.02, 0.4);
+	HBTK::AerofoilSplineCache::Splines & second = cache.naca_four_digit(0.12, 0.02, 0.4);
+	REQUIRE(&first == &second);
+	REQUIRE(cache.size() == 1);
+	// NACA 2412: max camber 0.02 at 0.4 chord.
+	REQUIRE(first.camber(0.4) == Approx(0.02).margin(1e-5));
+	REQUIRE(first.thickness(0.3) == Approx(0.12).margin(2e-3));
+	cache.naca_four_digit(0.12, 0.0, 0.0);
+	REQUIRE(cache.size() == 2);
+	cache.clear();
+	REQUIRE(cache.size() == 0);
+}
@@ -0,0 +1,107 @@
+#include <HBTK/AutomaticDifferentiation.h>
+#include <HBTK/GaussLegendre.h>
+#include <HBTK/Integrators.h>
+#include <HBTK/NumericalDifferentiation.h>
+#include <HBTK/PotentialFlowDistributions.h>
+#include <HBTK/Remaps.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cmath>
+#include <complex>
+
+TEST_CASE("Dual numbers")
+{
+	typedef HBTK::Dual<double, 2> D2;
+
+	SECTION("Arithmetic and functions") {
+		D2 x = D2::variable(0.7, 0), y = D2::variable(1.3, 1);
+		D2 f = 2 * x * y - y / x + sqrt(x) * exp(y) + pow(x, 3) - 1.;
+		REQUIRE(f.value() == Approx(2 * 0.7 * 1.3 - 1.3 / 0.7 + sqrt(0.7) * exp(1.3) + pow(0.7, 3) - 1.));
+		REQUIRE(f.tangent(0) == Approx(2 * 1.3 + 1.3 / (0.7 * 0.7) + exp(1.3) / (2 * sqrt(0.7)) + 3 * 0.7 * 0.7));
+		REQUIRE(f.tangent(1) == Approx(2 * 0.7 - 1 / 0.7 + sqrt(0.7) * exp(1.3)));
+
+		D2 g = atan2(y, x) + hypot(x, y) + pow(y, x) + cbrt(x) * log(y) - abs(-x) * sin(x) * cos(y) / tanh(y);
+		auto g_of = [](double a, double b) {
+			return atan2(b, a) + hypot(a, b) + pow(b, a) + cbrt(a) * log(b) - a * sin(a) * cos(b) / tanh(b);
+		};
+		REQUIRE(g.value() == Approx(g_of(0.7, 1.3)));
+		REQUIRE(g.tangent(0) == Approx(HBTK::central_difference_O1A6([&](double a) { return g_of(a, 1.3); }, 0.7)));
+		REQUIRE(g.tangent(1) == Approx(HBTK::central_difference_O1A6([&](double b) { return g_of(0.7, b); }, 1.3)));
+		REQUIRE(x < y);
+		REQUIRE(x == 0.7);
+	}
+
+	SECTION("Powers at awkward points") {
+		// A constant exponent needs no log of a negative base.
+		D2 p = pow(D2::variable(-2.), D2(2.));
+		REQUIRE(p.value() == 4.);
+		REQUIRE(p.tangent(0) == -4.);
+		REQUIRE(p.tangent(1) == 0.);
+		D2 zero = D2::variable(0.);
+		for (D2 q : { pow(zero, 0), pow(zero, 0.), pow(zero, D2(0.)) }) {
+			REQUIRE(q.value() == 1.);
+			REQUIRE(q.tangent(0) == 0.);
+		}
+	}
+
+	SECTION("Derivative helpers") {
+		auto f = [](auto x) { return x * x * x + 2. * x; };
+		REQUIRE(HBTK::forward_derivative(f, 2.) == 14.);
+		REQUIRE(HBTK::complex_step_derivative(f, 2.) == Approx(14.).epsilon(1e-14));
+		std::array<double, 2> grad = HBTK::forward_gradient([](const std::array<D2, 2> & p) {
+			return p[0] * p[0] * p[1];
+		}, std::array<double, 2>({ 3., 5. }));
+		REQUIRE(grad[0] == 30.);
+		REQUIRE(grad[1] == 9.);
+	}
+
+	SECTION("Potential flow distributions") {
+		D2 x = D2::variable(1., 0), y = D2::variable(2., 1);
+		D2 u = HBTK::PointVortex::unity_u_vel<D2>(x, y, 0.5, -0.25);
+		REQUIRE(u.tangent(0) == Approx(HBTK::central_difference_O1A4([](double a) {
+			return HBTK::PointVortex::unity_u_vel<double>(a, 2., 0.5, -0.25); }, 1.)));
+		REQUIRE(u.tangent(1) == Approx(HBTK::central_difference_O1A4([](double b) {
+			return HBTK::PointVortex::unity_u_vel<double>(1., b, 0.5, -0.25); }, 2.)));
+		D2 v = HBTK::PointDoublet::unity_v_vel<D2>(x, y, 0., 0., 0.3);
+		REQUIRE(v.tangent(1) == Approx(HBTK::central_difference_O1A4([](double b) {
+			return HBTK::PointDoublet::unity_v_vel<double>(1., b, 0., 0., 0.3); }, 2.)));
+		D2 phi = HBTK::ConstantVortexDistribution::unity_vel_pot<D2>(x, y, 0., 0., 1., 0.5);
+		REQUIRE(phi.tangent(0) == Approx(HBTK::central_difference_O1A4([](double a) {
+			return HBTK::ConstantVortexDistribution::unity_vel_pot<double>(a, 2., 0., 0., 1., 0.5); }, 1.)));
+	}
+
+	SECTION("Remaps") {
+		// Sensitivity of a remapped point and weight to the singularity position.
+		HBTK::Dual<double> p(0.3), w(0.5), s = HBTK::Dual<double>::variable(0.4);
+		HBTK::telles_cubic_remap(p, w, s);
+		auto remapped = [](double sing) {
+			double pd = 0.3, wd = 0.5;
+			HBTK::telles_cubic_remap(pd, wd, sing);
+			return std::array<double, 2>({ pd, wd });
+		};
+		REQUIRE(p.tangent(0) == Approx(HBTK::central_difference_O1A4([&](double a) { return remapped(a)[0]; }, 0.4)));
+		REQUIRE(w.tangent(0) == Approx(HBTK::central_difference_O1A4([&](double a) { return remapped(a)[1]; }, 0.4)));
+	}
+
+	SECTION("Integrators") {
+		// d/da of the integral of exp(a x) over [0, 1] is ((a - 1) e^a + 1) / a^2.
+		const double a0 = 0.8;
+		const double exact = ((a0 - 1) * exp(a0) + 1) / (a0 * a0);
+		HBTK::Dual<double> a = HBTK::Dual<double>::variable(a0);
+		auto integrand = [&](double x) { return exp(a * x); };
+
+		std::array<double, 8> points, weights;
+		HBTK::gauss_legendre<8, double>(points, weights);
+		for (auto & point : points) { point = (point + 1) / 2; }
+		for (auto & weight : weights) { weight /= 2; }
+		HBTK::Dual<double> gauss = HBTK::static_integrate(integrand, points, weights, 8);
+		REQUIRE(gauss.tangent(0) == Approx(exact));
+
+		HBTK::Dual<double> simpsons = HBTK::adaptive_simpsons_integrate(integrand, 1e-10, 0., 1.);
+		REQUIRE(simpsons.tangent(0) == Approx(exact));
+		HBTK::Dual<double> trapezoidal = HBTK::adaptive_trapezoidal_integrate(integrand, 1e-8, 0., 1.);
+		REQUIRE(trapezoidal.tangent(0) == Approx(exact).epsilon(1e-4));
+	}
+}
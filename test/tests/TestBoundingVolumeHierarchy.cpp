@@ -0,0 +1,153 @@
+#include <HBTK/BoundingVolumeHierarchy.h>
+#include <HBTK/CartesianBoundingBox.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+	std::vector<HBTK::CartesianFiniteLine3D> random_lines(int number, unsigned seed) {
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> pos(-1., 1.), step(-0.1, 0.1);
+		std::vector<HBTK::CartesianFiniteLine3D> lines;
+		for (int i = 0; i < number; i++) {
+			HBTK::CartesianPoint3D start({ pos(gen), pos(gen), pos(gen) });
+			HBTK::CartesianPoint3D end = start + HBTK::CartesianVector3D({ step(gen), step(gen), step(gen) });
+			lines.emplace_back(start, end);
+		}
+		return lines;
+	}
+
+	// A flat grid of n x n unit square panels in z = height.
+	std::vector<HBTK::CartesianRectilinearPanel> panel_grid(int n, double height) {
+		std::vector<HBTK::CartesianRectilinearPanel> panels;
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				panels.emplace_back(
+					HBTK::CartesianPoint3D({ (double)i, (double)j, height }),
+					HBTK::CartesianPoint3D({ i + 1., (double)j, height }),
+					HBTK::CartesianPoint3D({ i + 1., j + 1., height }),
+					HBTK::CartesianPoint3D({ (double)i, j + 1., height }));
+			}
+		}
+		return panels;
+	}
+}
+
+TEST_CASE("Cartesian bounding box 3D") {
+	HBTK::CartesianBoundingBox3D box;
+	REQUIRE(box.empty());
+	box.expand(HBTK::CartesianPoint3D({ 1., 2., 3. }));
+	box.expand(HBTK::CartesianPoint3D({ -1., 0., 4. }));
+	REQUIRE_FALSE(box.empty());
+	REQUIRE(box.lower_corner() == HBTK::CartesianPoint3D({ -1., 0., 3. }));
+	REQUIRE(box.upper_corner() == HBTK::CartesianPoint3D({ 1., 2., 4. }));
+	REQUIRE(box.surface_area() == Approx(2 * (4. + 2. + 2.)));
+	REQUIRE(box.longest_axis() == 0);
+	REQUIRE(box.contains(HBTK::CartesianPoint3D({ 0., 1., 3.5 })));
+	REQUIRE(box.distance(HBTK::CartesianPoint3D({ 0., 1., 3.5 })) == 0.);
+	REQUIRE(box.distance(HBTK::CartesianPoint3D({ 4., 1., -1. })) == Approx(5.));
+	double t;
+	HBTK::CartesianLine3D line(HBTK::CartesianPoint3D({ -3., 1., 3.5 }), HBTK::CartesianVector3D({ 1., 0., 0. }));
+	REQUIRE(box.intersection(line, 0, 10, t));
+	REQUIRE(t == Approx(2.));
+	REQUIRE_FALSE(box.intersection(line, 0, 1, t));
+}
+
+TEST_CASE("Finite line BVH") {
+	std::vector<HBTK::CartesianFiniteLine3D> lines = random_lines(10000, 1);
+	HBTK::FiniteLineBVH3D bvh(lines, 4);
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<double> pos(-1.2, 1.2);
+	std::vector<HBTK::CartesianPoint3D> points;
+	for (int i = 0; i < 200; i++) {
+		points.push_back(HBTK::CartesianPoint3D({ pos(gen), pos(gen), pos(gen) }));
+	}
+
+	SECTION("Nearest matches brute force") {
+		std::vector<int> idxs;
+		std::vector<double> dists;
+		bvh.nearest(points, idxs, dists, 3);
+		for (int i = 0; i < (int)points.size(); i++) {
+			double best = 1e300;
+			for (auto & line : lines) {
+				best = std::min(best, HBTK::FiniteLineBVH3D::point_distance(line, points[i]));
+			}
+			REQUIRE(dists[i] == Approx(best));
+			REQUIRE(HBTK::FiniteLineBVH3D::point_distance(lines[idxs[i]], points[i]) == Approx(best));
+		}
+	}
+
+	SECTION("Radius query matches brute force") {
+		for (int i = 0; i < 20; i++) {
+			std::vector<int> found = bvh.within_radius(points[i], 0.2);
+			std::vector<int> expected;
+			for (int j = 0; j < (int)lines.size(); j++) {
+				if (HBTK::FiniteLineBVH3D::point_distance(lines[j], points[i]) <= 0.2) {
+					expected.push_back(j);
+				}
+			}
+			REQUIRE(found == expected);
+		}
+	}
+
+	SECTION("Refit after movement") {
+		HBTK::CartesianVector3D shift({ 10., 0., 0. });
+		for (auto & line : lines) {
+			line.start() += shift;
+			line.end() += shift;
+		}
+		bvh.refit(lines);
+		double dist;
+		int idx = bvh.nearest(points[0] + shift, dist);
+		HBTK::FiniteLineBVH3D fresh(lines, 1);
+		double fresh_dist;
+		fresh.nearest(points[0] + shift, fresh_dist);
+		REQUIRE(dist == Approx(fresh_dist));
+		REQUIRE(idx >= 0);
+	}
+
+	SECTION("Distance matches CartesianFiniteLine3D") {
+		HBTK::CartesianFiniteLine3D line(HBTK::CartesianPoint3D({ 0., 0., 0. }), HBTK::CartesianPoint3D({ 1., 0., 0. }));
+		HBTK::CartesianPoint3D p({ 0.5, 2., 0. });
+		REQUIRE(HBTK::FiniteLineBVH3D::point_distance(line, p) == Approx(line.distance(p)));
+		p = HBTK::CartesianPoint3D({ 3., 0., 4. });
+		REQUIRE(HBTK::FiniteLineBVH3D::point_distance(line, p) == Approx(sqrt(20.)));
+	}
+}
+
+TEST_CASE("Rectilinear panel BVH") {
+	std::vector<HBTK::CartesianRectilinearPanel> panels = panel_grid(20, 0.);
+	HBTK::RectilinearPanelBVH bvh(panels);
+
+	SECTION("Nearest") {
+		double dist;
+		int idx = bvh.nearest(HBTK::CartesianPoint3D({ 3.5, 7.5, 2. }), dist);
+		REQUIRE(idx == 3 * 20 + 7);
+		REQUIRE(dist == Approx(2.));
+		idx = bvh.nearest(HBTK::CartesianPoint3D({ -3., 0.5, 4. }), dist);
+		REQUIRE(idx == 0);
+		REQUIRE(dist == Approx(5.));
+	}
+
+	SECTION("Radius") {
+		std::vector<int> found = bvh.within_radius(HBTK::CartesianPoint3D({ 3.5, 7.5, 0.1 }), 0.2);
+		REQUIRE(found == std::vector<int>({ 3 * 20 + 7 }));
+	}
+
+	SECTION("Rays and line intersections") {
+		HBTK::CartesianLine3D ray(HBTK::CartesianPoint3D({ 5.25, 2.5, 3. }), HBTK::CartesianVector3D({ 0., 0., -1. }));
+		double t;
+		REQUIRE(bvh.first_intersection(ray, t) == 5 * 20 + 2);
+		REQUIRE(t == Approx(3.));
+		ray.direction() = HBTK::CartesianVector3D({ 0., 0., 1. });
+		REQUIRE(bvh.first_intersection(ray, t) == -1);
+
+		HBTK::CartesianFiniteLine3D line(HBTK::CartesianPoint3D({ 1.5, 1.5, -1. }), HBTK::CartesianPoint3D({ 2.2, 1.5, 1. }));
+		REQUIRE(bvh.intersections(line) == std::vector<int>({ 1 * 20 + 1 }));
+		line.end() = HBTK::CartesianPoint3D({ 2.5, 1.5, -0.5 });
+		REQUIRE(bvh.intersections(line).empty());
+	}
+}
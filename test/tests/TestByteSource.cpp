@@ -0,0 +1,72 @@
+#include <HBTK/ByteSource.h>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <utility>
+
+TEST_CASE("Byte sources") {
+
+	SECTION("Memory is read in place and can seek") {
+		const std::string text = "12 34 56";
+		HBTK::ByteSource source = HBTK::ByteSource::from_memory(text.data(), text.size());
+		REQUIRE(source.contiguous());
+		REQUIRE(source.data() == text.data());
+		std::istream & stream = source.stream();
+		int a, b;
+		stream >> a >> b;
+		REQUIRE(a == 12);
+		REQUIRE(b == 34);
+		REQUIRE(stream.tellg() == std::streampos(5));
+		stream.seekg(3);
+		stream >> a;
+		REQUIRE(a == 34);
+		stream.seekg(-2, std::ios_base::end);
+		stream >> a;
+		REQUIRE(a == 56);
+		REQUIRE(stream.eof());
+		char buffer[4];
+		stream.clear();
+		stream.seekg(0);
+		REQUIRE(stream.read(buffer, 4));
+		REQUIRE(std::string(buffer, 4) == "12 3");
+	}
+
+	SECTION("Owned strings survive moves") {
+		HBTK::ByteSource source = HBTK::ByteSource::from_string("short");
+		HBTK::ByteSource moved(std::move(source));
+		REQUIRE(moved.size() == 5);
+		REQUIRE(std::string(moved.data(), moved.size()) == "short");
+		std::string word;
+		moved.stream() >> word;
+		REQUIRE(word == "short");
+	}
+
+	SECTION("Moves keep the read position") {
+		std::string data = "abcdefgh";
+		for (int kind = 0; kind < 2; kind++) {
+			HBTK::ByteSource source = kind == 0 ? HBTK::ByteSource::from_string(data)
+				: HBTK::ByteSource::from_memory(data.data(), data.size());
+			char buffer[3];
+			REQUIRE(source.stream().read(buffer, 3));
+			HBTK::ByteSource moved(std::move(source));
+			REQUIRE(moved.stream().get() == 'd');
+			source = std::move(moved);
+			REQUIRE(source.stream().get() == 'e');
+		}
+	}
+
+	SECTION("Streams are not contiguous") {
+		std::istringstream input("7");
+		HBTK::ByteSource source = HBTK::ByteSource::from_stream(input);
+		REQUIRE_FALSE(source.contiguous());
+		int value;
+		source.stream() >> value;
+		REQUIRE(value == 7);
+	}
+
+	SECTION("Missing files throw") {
+		REQUIRE_THROWS_AS(HBTK::ByteSource::from_file("no/such/file.msh"), std::invalid_argument);
+	}
+}
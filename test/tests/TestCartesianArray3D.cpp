@@ -0,0 +1,140 @@
+#include <HBTK/CartesianArray3D.h>
+#include <HBTK/CartesianPlane.h>
+#include <HBTK/Constants.h>
+#include <HBTK/GmshMeshHolder.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("Point array 3D") {
+
+	std::vector<HBTK::CartesianPoint3D> aos({
+		HBTK::CartesianPoint3D({ 1., 2., 3. }),
+		HBTK::CartesianPoint3D({ -1., 0., 4. }),
+		HBTK::CartesianPoint3D({ 0.5, -2., 1. }) });
+
+	SECTION("Construction and access") {
+		HBTK::PointArray3D pnts(aos);
+		REQUIRE(pnts.size() == 3);
+		REQUIRE(pnts[1] == aos[1]);
+		REQUIRE(pnts.x()[2] == 0.5);
+		pnts.push_back(HBTK::CartesianPoint3D({ 7., 8., 9. }));
+		REQUIRE(pnts.size() == 4);
+		REQUIRE(pnts.z()[3] == 9.);
+		REQUIRE(pnts.as_points()[0] == aos[0]);
+	}
+
+	SECTION("Translation") {
+		HBTK::PointArray3D pnts(aos);
+		HBTK::CartesianVector3D vec({ 1., -1., 2. });
+		pnts.translate(vec);
+		for (int i = 0; i < 3; i++) {
+			REQUIRE(pnts[i] == aos[i] + vec);
+		}
+	}
+
+	SECTION("Rotation") {
+		HBTK::PointArray3D pnts(aos);
+		pnts.rotate(HBTK::CartesianVector3D({ 0, 0, 2 }), HBTK::Constants::pi() / 2,
+			HBTK::CartesianPoint3D({ 1, 0, 0 }));
+		REQUIRE(pnts[0].x() == Approx(-1.));
+		REQUIRE(pnts[0].y() == Approx(0.).margin(1e-12));
+		REQUIRE(pnts[0].z() == Approx(3.));
+		REQUIRE(pnts[1].x() == Approx(1.));
+		REQUIRE(pnts[1].y() == Approx(-2.));
+	}
+
+	SECTION("Distance and projection onto plane matches CartesianPlane") {
+		HBTK::PointArray3D pnts(aos);
+		HBTK::CartesianPlane plane(HBTK::CartesianPoint3D({ 0.1, 0.2, -0.3 }),
+			HBTK::CartesianVector3D({ 1, 2, 1 }));
+		std::vector<double> dist = pnts.distance(plane);
+		std::vector<double> lx, ly;
+		pnts.projection(plane, lx, ly);
+		for (int i = 0; i < 3; i++) {
+			REQUIRE(dist[i] == Approx(plane.distance(aos[i])));
+			HBTK::CartesianPoint2D proj = plane.projection(aos[i]);
+			REQUIRE(lx[i] == Approx(proj.x()).margin(1e-12));
+			REQUIRE(ly[i] == Approx(proj.y()).margin(1e-12));
+		}
+	}
+
+	SECTION("Differences") {
+		HBTK::PointArray3D pnts(aos);
+		HBTK::VectorArray3D vecs = pnts - HBTK::CartesianPoint3D({ 1., 1., 1. });
+		REQUIRE(vecs[0] == HBTK::CartesianVector3D({ 0., 1., 2. }));
+		vecs = pnts - pnts;
+		REQUIRE(vecs[2] == HBTK::CartesianVector3D({ 0., 0., 0. }));
+	}
+
+	SECTION("In place view of std::vector<CartesianPoint3D>") {
+		std::vector<HBTK::CartesianPoint3D> copy = aos;
+		HBTK::PointArrayView3D view(copy);
+		REQUIRE(view.size() == 3);
+		REQUIRE(view.stride() == 3);
+		REQUIRE(view[2] == aos[2]);
+		view.translate(HBTK::CartesianVector3D({ 0., 0., 1. }));
+		REQUIRE(copy[1] == HBTK::CartesianPoint3D({ -1., 0., 5. }));
+		HBTK::PointArray3D soa(view);
+		REQUIRE(soa[1] == copy[1]);
+	}
+
+	SECTION("Gathered from a GmshMeshHolder") {
+		HBTK::Gmsh::GmshMeshHolder mesh;
+		for (int i = 0; i < 3; i++) { mesh.add_node(10 + i, aos[i]); }
+		HBTK::PointArray3D pnts = mesh.node_coordinates({ 12, 10 });
+		REQUIRE(pnts.size() == 2);
+		REQUIRE(pnts[0] == aos[2]);
+		REQUIRE(pnts[1] == aos[0]);
+		REQUIRE_THROWS_AS(mesh.node_coordinates({ 10, 4 }), std::invalid_argument);
+		REQUIRE(mesh.number_of_nodes() == 3);
+	}
+}
+
+TEST_CASE("Vector array 3D") {
+
+	std::vector<HBTK::CartesianVector3D> aos1({
+		HBTK::CartesianVector3D({ 1., 2., 3. }),
+		HBTK::CartesianVector3D({ 3., 0., -4. }) });
+	std::vector<HBTK::CartesianVector3D> aos2({
+		HBTK::CartesianVector3D({ 6., 2., -1. }),
+		HBTK::CartesianVector3D({ 0., 1., 0. }) });
+
+	SECTION("Dot and cross") {
+		HBTK::VectorArray3D v1(aos1), v2(aos2);
+		std::vector<double> dots = v1.dot(v2);
+		HBTK::VectorArray3D crosses = v1.cross(v2);
+		for (int i = 0; i < 2; i++) {
+			REQUIRE(dots[i] == aos1[i].dot(aos2[i]));
+			REQUIRE(crosses[i] == aos1[i].cross(aos2[i]));
+		}
+		crosses = v1.cross(aos2[0]);
+		REQUIRE(crosses[1] == aos1[1].cross(aos2[0]));
+		REQUIRE(v1.dot(aos2[0])[1] == aos1[1].dot(aos2[0]));
+	}
+
+	SECTION("Magnitude and normalisation") {
+		HBTK::VectorArray3D v1(aos1);
+		std::vector<double> mag = v1.magnitude();
+		REQUIRE(mag[0] == Approx(sqrt(14.)));
+		REQUIRE(mag[1] == Approx(5.));
+		v1.normalise();
+		REQUIRE(v1[1].x() == Approx(0.6));
+		REQUIRE(v1[1].z() == Approx(-0.8));
+		REQUIRE(v1[0].magnitude() == Approx(1.));
+	}
+
+	SECTION("Arithmetic") {
+		HBTK::VectorArray3D v1(aos1), v2(aos2);
+		v1 += v2;
+		REQUIRE(v1[0] == aos1[0] + aos2[0]);
+		v1 -= v2;
+		v1 *= 2.;
+		REQUIRE(v1[1] == aos1[1] * 2.);
+		v1 *= std::vector<double>({ 1., 0.5 });
+		REQUIRE(v1[1] == aos1[1]);
+	}
+}
@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <array>
+#include <type_traits>
 
 TEST_CASE("Cartesian Point 2D") {
 	SECTION("Test constructor and x, y basics") {
@@ -184,6 +185,18 @@ TEST_CASE("Cartesian Point 3D") {
 		d = pnt1.distance(plane);
 		REQUIRE(d == 0.);
 	}
+
+	SECTION("Trivially copyable and constexpr") {
+		static_assert(std::is_trivially_copyable<HBTK::CartesianPoint3D>::value, "");
+		static_assert(std::is_trivially_copyable<HBTK::CartesianPoint2D>::value, "");
+		static_assert(sizeof(HBTK::CartesianPoint3D) == 3 * sizeof(double), "");
+		constexpr HBTK::CartesianPoint3D pnt1({ 1., 2., 3. });
+		constexpr HBTK::CartesianPoint3D pnt2 = pnt1 + HBTK::CartesianVector3D({ 1., 1., 1. });
+		static_assert(pnt2.z() == 4., "");
+		constexpr HBTK::CartesianVector3D vec = pnt2 - pnt1;
+		static_assert(vec.x() == 1., "");
+		REQUIRE(pnt2 == HBTK::CartesianPoint3D({ 2., 3., 4. }));
+	}
 }
 
 
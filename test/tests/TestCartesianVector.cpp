@@ -7,6 +7,7 @@
 
 #include <cmath>
 #include <array>
+#include <type_traits>
 
 TEST_CASE("Cartesian Vector 2D") {
 
@@ -305,4 +306,14 @@ TEST_CASE("Cartesian Vector 3D") {
 		angle = vec1.angle(vec4);
 		REQUIRE(angle == Approx(acos(8. / sqrt(145.))));
 	}
+	SECTION("Trivially copyable and constexpr") {
+		static_assert(std::is_trivially_copyable<HBTK::CartesianVector3D>::value, "");
+		static_assert(std::is_trivially_copyable<HBTK::CartesianVector2D>::value, "");
+		constexpr HBTK::CartesianVector3D vec1({ 1, 2, 3 }), vec2({ 6, 2, -1 });
+		static_assert(vec1.dot(vec2) == 7., "");
+		static_assert(vec1.cross(vec2) == HBTK::CartesianVector3D({ -8., 19., -10. }), "");
+		constexpr HBTK::CartesianVector3D vec3 = 2. * vec1 - vec2 / 2.;
+		static_assert(vec3.x() == -1., "");
+		REQUIRE((vec1 + vec2).y() == 4.);
+	}
 }
\ No newline at end of file
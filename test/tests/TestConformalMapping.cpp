@@ -0,0 +1,83 @@
+#include <HBTK/ConformalMapping.h>
+#include <HBTK/Constants.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace {
+	// Points around an offset circle through zeta = 1, as used for aerofoils.
+	void circle_points(int n, std::vector<double> & re, std::vector<double> & im) {
+		std::complex<double> centre(-0.1, 0.05);
+		double radius = std::abs(1. - centre);
+		re.resize(n);
+		im.resize(n);
+		for (int i = 0; i < n; i++) {
+			std::complex<double> zeta = centre + 1.2 * radius * std::exp(std::complex<double>(0, 0.1 + 6.2 * i / n));
+			re[i] = zeta.real();
+			im[i] = zeta.imag();
+		}
+	}
+}
+
+TEST_CASE("Batched conformal mapping") {
+	std::vector<double> re, im, z_re(101), z_im(101), dz_re(101), dz_im(101);
+	circle_points(101, re, im);
+
+	SECTION("Joukowsky") {
+		HBTK::joukowsky_transform(101, re.data(), im.data(), z_re.data(), z_im.data(), dz_re.data(), dz_im.data());
+		for (int i = 0; i < 101; i++) {
+			std::complex<double> zeta(re[i], im[i]);
+			std::complex<double> z = HBTK::joukowsky_transform(zeta);
+			std::complex<double> dz = HBTK::joukowsky_transform_derivative(zeta);
+			REQUIRE(z_re[i] == Approx(z.real()).margin(1e-14));
+			REQUIRE(z_im[i] == Approx(z.imag()).margin(1e-14));
+			REQUIRE(dz_re[i] == Approx(dz.real()).margin(1e-14));
+			REQUIRE(dz_im[i] == Approx(dz.imag()).margin(1e-14));
+		}
+	}
+	SECTION("Karman-Trefftz") {
+		const double alpha = 0.2;
+		HBTK::karman_trefftz_transform(101, re.data(), im.data(), alpha, 
+			z_re.data(), z_im.data(), dz_re.data(), dz_im.data());
+		for (int i = 0; i < 101; i++) {
+			std::complex<double> zeta(re[i], im[i]);
+			std::complex<double> z = HBTK::karman_trefftz_transform(zeta, alpha);
+			std::complex<double> dz = HBTK::karman_trefftz_transform_derivative(zeta, alpha);
+			REQUIRE(z_re[i] == Approx(z.real()).margin(1e-12));
+			REQUIRE(z_im[i] == Approx(z.imag()).margin(1e-12));
+			REQUIRE(dz_re[i] == Approx(dz.real()).margin(1e-12));
+			REQUIRE(dz_im[i] == Approx(dz.imag()).margin(1e-12));
+		}
+		// In place.
+		HBTK::karman_trefftz_transform(101, re.data(), im.data(), alpha, re.data(), im.data());
+		REQUIRE(re == z_re);
+		REQUIRE(im == z_im);
+	}
+}
+
+TEST_CASE("Conformal mapping grids") {
+	std::complex<double> centre(-0.1, 0.05);
+	double radius = std::abs(1. - centre);
+	std::vector<double> radii, angles;
+	for (int i = 0; i < 7; i++) { radii.push_back(radius * (1 + 0.5 * i)); }
+	for (int j = 0; j < 40; j++) { angles.push_back(2 * HBTK::Constants::pi() * j / 40.); }
+
+	HBTK::StructuredMeshBlock2D mesh = HBTK::karman_trefftz_grid(centre, radii, angles, 0.15, 3);
+	REQUIRE(mesh.extent()[0] == 7);
+	REQUIRE(mesh.extent()[1] == 40);
+	for (int i = 0; i < 7; i++) {
+		for (int j = 0; j < 40; j++) {
+			std::complex<double> z = HBTK::karman_trefftz_transform(
+				centre + radii[i] * std::exp(std::complex<double>(0, angles[j])), 0.15);
+			REQUIRE(mesh.coord({ i, j })[0] == Approx(z.real()).margin(1e-12));
+			REQUIRE(mesh.coord({ i, j })[1] == Approx(z.imag()).margin(1e-12));
+		}
+	}
+	mesh = HBTK::joukowsky_grid(centre, radii, angles, 2);
+	std::complex<double> z = HBTK::joukowsky_transform(centre + radii[3] * std::exp(std::complex<double>(0, angles[5])));
+	REQUIRE(mesh.coord({ 3, 5 })[0] == Approx(z.real()));
+	REQUIRE(mesh.coord({ 3, 5 })[1] == Approx(z.imag()));
+}
@@ -0,0 +1,217 @@
+#include <HBTK/ElementMapping.h>
+#include <HBTK/GmshElementLocator.h>
+#include <HBTK/GmshIntegrator.h>
+#include <HBTK/GmshMeshHolder.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+	// Gmsh reference node positions of the element types with shape functions.
+	std::vector<std::array<double, 3>> reference_nodes(int ele_id) {
+		switch (ele_id) {
+		case 1: return { {{ -1, 0, 0 }}, {{ 1, 0, 0 }} };
+		case 8: return { {{ -1, 0, 0 }}, {{ 1, 0, 0 }}, {{ 0, 0, 0 }} };
+		case 2: return { {{ 0, 0, 0 }}, {{ 1, 0, 0 }}, {{ 0, 1, 0 }} };
+		case 9: return { {{ 0, 0, 0 }}, {{ 1, 0, 0 }}, {{ 0, 1, 0 }},
+			{{ 0.5, 0, 0 }}, {{ 0.5, 0.5, 0 }}, {{ 0, 0.5, 0 }} };
+		case 3: return { {{ -1, -1, 0 }}, {{ 1, -1, 0 }}, {{ 1, 1, 0 }}, {{ -1, 1, 0 }} };
+		case 16: return { {{ -1, -1, 0 }}, {{ 1, -1, 0 }}, {{ 1, 1, 0 }}, {{ -1, 1, 0 }},
+			{{ 0, -1, 0 }}, {{ 1, 0, 0 }}, {{ 0, 1, 0 }}, {{ -1, 0, 0 }} };
+		case 4: return { {{ 0, 0, 0 }}, {{ 1, 0, 0 }}, {{ 0, 1, 0 }}, {{ 0, 0, 1 }} };
+		case 11: return { {{ 0, 0, 0 }}, {{ 1, 0, 0 }}, {{ 0, 1, 0 }}, {{ 0, 0, 1 }},
+			{{ 0.5, 0, 0 }}, {{ 0.5, 0.5, 0 }}, {{ 0, 0.5, 0 }},
+			{{ 0, 0, 0.5 }}, {{ 0, 0.5, 0.5 }}, {{ 0.5, 0, 0.5 }} };
+		case 5: return { {{ -1, -1, -1 }}, {{ 1, -1, -1 }}, {{ 1, 1, -1 }}, {{ -1, 1, -1 }},
+			{{ -1, -1, 1 }}, {{ 1, -1, 1 }}, {{ 1, 1, 1 }}, {{ -1, 1, 1 }} };
+		default: return {};
+		}
+	}
+
+	// A unit cube of n^3 hexahedra with its nodes moved by a smooth distortion.
+	HBTK::Gmsh::GmshMeshHolder distorted_hex_mesh(int n, double distortion = 1) {
+		HBTK::Gmsh::GmshMeshHolder mesh;
+		auto node_tag = [n](int i, int j, int k) { return 1 + i + (n + 1) * (j + (n + 1) * k); };
+		for (int k = 0; k <= n; k++) {
+			for (int j = 0; j <= n; j++) {
+				for (int i = 0; i <= n; i++) {
+					double x = i / (double)n, y = j / (double)n, z = k / (double)n;
+					mesh.add_node(node_tag(i, j, k), HBTK::CartesianPoint3D({
+						x + distortion * 0.3 * x * (1 - x) * y, 
+						y + distortion * 0.2 * y * (1 - y) * z, 
+						z + distortion * 0.1 * x * z }));
+				}
+			}
+		}
+		int tag = 1;
+		for (int k = 0; k < n; k++) {
+			for (int j = 0; j < n; j++) {
+				for (int i = 0; i < n; i++) {
+					mesh.add_element(tag++, 5, {
+						node_tag(i, j, k), node_tag(i + 1, j, k), node_tag(i + 1, j + 1, k), node_tag(i, j + 1, k),
+						node_tag(i, j, k + 1), node_tag(i + 1, j, k + 1), node_tag(i + 1, j + 1, k + 1), node_tag(i, j + 1, k + 1) },
+						{});
+				}
+			}
+		}
+		return mesh;
+	}
+}
+
+TEST_CASE("Element shapes") {
+	std::mt19937 gen(1);
+	std::uniform_real_distribution<double> pos(-0.9, 0.9);
+	for (int ele_id : { 1, 8, 2, 9, 3, 16, 4, 11, 5 }) {
+		const HBTK::Elements::ElementShape * shape = HBTK::Elements::gmsh_element_shape(ele_id);
+		REQUIRE(shape != nullptr);
+		std::vector<std::array<double, 3>> nodes = reference_nodes(ele_id);
+		const int n = shape->number_of_nodes, dims = shape->local_dimensions;
+		REQUIRE(n == (int)nodes.size());
+		REQUIRE(n <= HBTK::Elements::max_shape_nodes);
+		std::vector<double> values(n), derivs(3 * n);
+
+		SECTION("Nodal values, element id " + std::to_string(ele_id)) {
+			for (int i = 0; i < n; i++) {
+				REQUIRE(shape->contains(nodes[i].data(), 1e-12));
+				shape->evaluate(nodes[i].data(), values.data(), nullptr);
+				for (int j = 0; j < n; j++) {
+					REQUIRE(values[j] == Approx(i == j ? 1. : 0.).margin(1e-12));
+				}
+			}
+		}
+		SECTION("Partition of unity and derivatives, element id " + std::to_string(ele_id)) {
+			for (int trial = 0; trial < 10; trial++) {
+				std::array<double, 3> local = shape->centre;
+				for (int d = 0; d < dims; d++) { local[d] += 0.2 * pos(gen); }
+				shape->evaluate(local.data(), values.data(), derivs.data());
+				double sum = 0;
+				for (double v : values) { sum += v; }
+				REQUIRE(sum == Approx(1.));
+				for (int d = 0; d < dims; d++) {
+					const double h = 1e-6;
+					std::array<double, 3> lp = local, lm = local;
+					lp[d] += h;
+					lm[d] -= h;
+					std::vector<double> vp(n), vm(n);
+					shape->evaluate(lp.data(), vp.data(), nullptr);
+					shape->evaluate(lm.data(), vm.data(), nullptr);
+					for (int i = 0; i < n; i++) {
+						REQUIRE(derivs[d * n + i] == Approx((vp[i] - vm[i]) / (2 * h)).margin(1e-7));
+					}
+				}
+			}
+		}
+	}
+	REQUIRE(HBTK::Elements::gmsh_element_shape(15) == nullptr);
+}
+
+TEST_CASE("Inverse element mapping") {
+	SECTION("Curved tetrahedron") {
+		const HBTK::Elements::ElementShape & shape = *HBTK::Elements::gmsh_element_shape(11);
+		std::vector<HBTK::CartesianPoint3D> nodes;
+		for (auto & node : reference_nodes(11)) {
+			nodes.push_back(HBTK::CartesianPoint3D({ 2 * node[0], node[1] + 0.5 * node[0], 3 * node[2] }));
+		}
+		nodes[4].y() -= 0.2;
+		double target[3] = { 0.2, 0.3, 0.1 };
+		HBTK::CartesianPoint3D point = HBTK::Elements::forward_map(shape, nodes.data(), target);
+		double local[3] = { 0.25, 0.25, 0.25 };
+		REQUIRE(HBTK::Elements::inverse_map(shape, nodes.data(), point, local));
+		for (int d = 0; d < 3; d++) { REQUIRE(local[d] == Approx(target[d])); }
+	}
+	SECTION("Triangle in 3D gives closest point") {
+		const HBTK::Elements::ElementShape & shape = *HBTK::Elements::gmsh_element_shape(2);
+		std::vector<HBTK::CartesianPoint3D> nodes({
+			HBTK::CartesianPoint3D({ 0, 0, 1 }),
+			HBTK::CartesianPoint3D({ 2, 0, 1 }),
+			HBTK::CartesianPoint3D({ 0, 2, 1 }) });
+		double local[3] = { 1. / 3, 1. / 3, 0 };
+		REQUIRE(HBTK::Elements::inverse_map(shape, nodes.data(), HBTK::CartesianPoint3D({ 0.5, 1, 4 }), local));
+		REQUIRE(local[0] == Approx(0.25));
+		REQUIRE(local[1] == Approx(0.5));
+	}
+}
+
+TEST_CASE("Gmsh element locator") {
+	HBTK::Gmsh::GmshMeshHolder mesh = distorted_hex_mesh(8);
+	HBTK::Gmsh::GmshElementLocator locator(mesh, 2);
+	REQUIRE(locator.number_of_elements() == 512);
+	const HBTK::Elements::ElementShape & shape = *HBTK::Elements::gmsh_element_shape(5);
+
+	std::mt19937 gen(3);
+	std::uniform_real_distribution<double> pos(-1, 1);
+	std::uniform_int_distribution<int> ele(1, 512);
+	std::vector<HBTK::CartesianPoint3D> points;
+	for (int i = 0; i < 1000; i++) {
+		double local[3] = { pos(gen), pos(gen), pos(gen) };
+		std::vector<HBTK::CartesianPoint3D> nodes = mesh.element_nodes(ele(gen));
+		points.push_back(HBTK::Elements::forward_map(shape, nodes.data(), local));
+	}
+	points.push_back(HBTK::CartesianPoint3D({ 2., 0.5, 0.5 }));
+
+	std::vector<int> tags;
+	std::vector<std::array<double, 3>> locals;
+	locator.locate(points, tags, locals, 3);
+	for (int i = 0; i < 1000; i++) {
+		REQUIRE(tags[i] > 0);
+		REQUIRE(shape.contains(locals[i].data(), 1e-6));
+		std::vector<HBTK::CartesianPoint3D> nodes = mesh.element_nodes(tags[i]);
+		HBTK::CartesianPoint3D mapped = HBTK::Elements::forward_map(shape, nodes.data(), locals[i].data());
+		REQUIRE((mapped - points[i]).magnitude() == Approx(0.).margin(1e-9));
+	}
+	REQUIRE(tags[1000] == -1);
+}
+
+TEST_CASE("Gmsh integrator") {
+	SECTION("Polynomials over a cube and its face") {
+		HBTK::Gmsh::GmshMeshHolder mesh = distorted_hex_mesh(4, 0);
+		mesh.add_group(1, "volume", 3);
+		for (int tag : mesh.get_all_element_tags()) { mesh.add_element_to_group(1, tag); }
+		// Quadrangles on the face z = 0, with the same nodes as the hexahedra.
+		mesh.add_group(2, "bottom", 2);
+		for (int tag = 1; tag <= 16; tag++) {
+			std::vector<int> nodes = mesh.element_node_tags(tag);
+			nodes.resize(4);
+			mesh.add_element(1000 + tag, 3, nodes, { 2 });
+			mesh.add_element_to_group(2, 1000 + tag);
+		}
+
+		HBTK::Gmsh::GmshIntegrator volume(mesh, 1, 3, 2);
+		REQUIRE(volume.number_of_elements() == 64);
+		REQUIRE(volume.number_of_points() == 64 * 8);
+		REQUIRE(volume.integrate([](const HBTK::CartesianPoint3D & p) { return 1.; }) == Approx(1.));
+		REQUIRE(volume.integrate([](const HBTK::CartesianPoint3D & p) { 
+			return p.x() * p.x() * p.y(); }, 3) == Approx(1. / 6));
+
+		HBTK::Gmsh::GmshIntegrator face(mesh, 2, 2);
+		REQUIRE(face.number_of_elements() == 16);
+		REQUIRE(face.integrate([](const HBTK::CartesianPoint3D & p) { 
+			return p.x() + p.z(); }) == Approx(0.5));
+	}
+	SECTION("Deterministic element sums") {
+		HBTK::Gmsh::GmshMeshHolder mesh = distorted_hex_mesh(6);
+		HBTK::Gmsh::GmshIntegrator integrator;
+		integrator.build(mesh, mesh.get_all_element_tags(), 4);
+		auto func = [](const HBTK::CartesianPoint3D & p) { return exp(p.x()) * sin(p.y() + p.z()); };
+		double serial = integrator.integrate(func, 1);
+		REQUIRE(integrator.integrate(func, 3) == serial);
+		std::vector<double> per_element;
+		integrator.integrate_elements(func, per_element, 2);
+		REQUIRE((int)per_element.size() == 216);
+		double sum = 0;
+		for (double v : per_element) { sum += v; }
+		REQUIRE(sum == serial);
+		REQUIRE(integrator.point_offset(216) == integrator.number_of_points());
+	}
+	SECTION("Element types without cubature") {
+		HBTK::Gmsh::GmshMeshHolder mesh;
+		mesh.add_node(1, HBTK::CartesianPoint3D({ 0, 0, 0 }));
+		mesh.add_element(1, 15, { 1 }, {});
+		HBTK::Gmsh::GmshIntegrator integrator;
+		REQUIRE_THROWS(integrator.build(mesh, { 1 }));
+	}
+}
@@ -0,0 +1,127 @@
+#include <HBTK/ElementMapping.h>
+#include <HBTK/ElementTabulation.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+	double factorial(int n) { return n <= 1 ? 1. : n * factorial(n - 1); }
+}
+
+TEST_CASE("Element cubature") {
+	SECTION("Triangle monomials") {
+		for (int order = 0; order <= 6; order++) {
+			HBTK::Elements::ElementCubature rule = HBTK::Elements::gmsh_element_cubature(2, order);
+			for (int a = 0; a <= order; a++) {
+				int b = order - a;
+				double sum = 0;
+				for (int q = 0; q < rule.size(); q++) {
+					sum += rule.weights[q] * pow(rule.points[q][0], a) * pow(rule.points[q][1], b);
+				}
+				REQUIRE(sum == Approx(factorial(a) * factorial(b) / factorial(a + b + 2)));
+			}
+		}
+	}
+	SECTION("Tetrahedron monomials") {
+		for (int order = 0; order <= 5; order++) {
+			HBTK::Elements::ElementCubature rule = HBTK::Elements::gmsh_element_cubature(11, order);
+			for (int a = 0; a <= order; a++) {
+				for (int b = 0; a + b <= order; b++) {
+					int c = order - a - b;
+					double sum = 0;
+					for (int q = 0; q < rule.size(); q++) {
+						sum += rule.weights[q] * pow(rule.points[q][0], a) 
+							* pow(rule.points[q][1], b) * pow(rule.points[q][2], c);
+					}
+					REQUIRE(sum == Approx(factorial(a) * factorial(b) * factorial(c) / factorial(a + b + c + 3)));
+				}
+			}
+		}
+	}
+	SECTION("Hexahedron monomials") {
+		HBTK::Elements::ElementCubature rule = HBTK::Elements::gmsh_element_cubature(5, 4);
+		REQUIRE(rule.size() == 27);
+		double sum = 0;
+		for (int q = 0; q < rule.size(); q++) {
+			sum += rule.weights[q] * pow(rule.points[q][0], 4) * pow(rule.points[q][2], 2);
+		}
+		REQUIRE(sum == Approx(2. / 5 * 2 * 2. / 3));
+	}
+	SECTION("Prism monomials") {
+		HBTK::Elements::ElementCubature rule = HBTK::Elements::gmsh_element_cubature(18, 4);
+		double sum = 0;
+		for (int q = 0; q < rule.size(); q++) {
+			sum += rule.weights[q] * pow(rule.points[q][0], 2) * pow(rule.points[q][2], 2);
+		}
+		REQUIRE(sum == Approx(factorial(2) / factorial(4) * 2. / 3));
+	}
+	REQUIRE_THROWS(HBTK::Elements::gmsh_element_cubature(15, 2));
+}
+
+TEST_CASE("Shape function table") {
+	const HBTK::Elements::ElementShape & hex = *HBTK::Elements::gmsh_element_shape(5);
+	HBTK::Elements::ShapeFunctionTable table(hex, HBTK::Elements::gmsh_element_cubature(5, 3));
+	REQUIRE(table.number_of_points() == 8);
+	REQUIRE(table.number_of_nodes() == 8);
+
+	SECTION("Matches direct evaluation") {
+		std::vector<double> values(8), derivs(24);
+		for (int q = 0; q < table.number_of_points(); q++) {
+			hex.evaluate(table.points()[q].data(), values.data(), derivs.data());
+			for (int i = 0; i < 8; i++) {
+				REQUIRE(table.values()[q * 8 + i] == values[i]);
+				for (int d = 0; d < 3; d++) {
+					REQUIRE(table.derivatives()[(q * 3 + d) * 8 + i] == derivs[d * 8 + i]);
+				}
+			}
+		}
+	}
+
+	SECTION("Mapping and integration") {
+		// A box [0, 2] x [0, 1] x [0, 3] with its top face sheared.
+		std::vector<HBTK::CartesianPoint3D> nodes({
+			HBTK::CartesianPoint3D({ 0, 0, 0 }), HBTK::CartesianPoint3D({ 2, 0, 0 }),
+			HBTK::CartesianPoint3D({ 2, 1, 0 }), HBTK::CartesianPoint3D({ 0, 1, 0 }),
+			HBTK::CartesianPoint3D({ 1, 0, 3 }), HBTK::CartesianPoint3D({ 3, 0, 3 }),
+			HBTK::CartesianPoint3D({ 3, 1, 3 }), HBTK::CartesianPoint3D({ 1, 1, 3 }) });
+		std::vector<HBTK::CartesianPoint3D> points(table.number_of_points());
+		std::vector<double> jw(table.number_of_points());
+		table.map(nodes.data(), points.data(), jw.data());
+		double volume = 0, z_moment = 0;
+		for (int q = 0; q < table.number_of_points(); q++) {
+			volume += jw[q];
+			z_moment += jw[q] * points[q].z();
+		}
+		REQUIRE(volume == Approx(6.));
+		REQUIRE(z_moment == Approx(9.));
+	}
+
+	SECTION("Surface element scale factor") {
+		const HBTK::Elements::ElementShape & tri = *HBTK::Elements::gmsh_element_shape(2);
+		HBTK::Elements::ShapeFunctionTable tri_table(tri, HBTK::Elements::gmsh_element_cubature(2, 1));
+		std::vector<HBTK::CartesianPoint3D> nodes({
+			HBTK::CartesianPoint3D({ 0, 0, 0 }), HBTK::CartesianPoint3D({ 0, 2, 0 }),
+			HBTK::CartesianPoint3D({ 0, 0, 3 }) });
+		std::vector<HBTK::CartesianPoint3D> points(tri_table.number_of_points());
+		std::vector<double> jw(tri_table.number_of_points());
+		tri_table.map(nodes.data(), points.data(), jw.data());
+		double area = 0;
+		for (double w : jw) { area += w; }
+		REQUIRE(area == Approx(3.));
+	}
+
+	SECTION("Batched interpolation") {
+		std::vector<double> nodal(3 * 8);
+		for (int i = 0; i < (int)nodal.size(); i++) { nodal[i] = sin(i); }
+		std::vector<double> batched(3 * table.number_of_points()), single(table.number_of_points());
+		table.interpolate(3, nodal.data(), batched.data());
+		for (int e = 0; e < 3; e++) {
+			table.interpolate(nodal.data() + 8 * e, single.data());
+			for (int q = 0; q < table.number_of_points(); q++) {
+				REQUIRE(batched[e * table.number_of_points() + q] == Approx(single[q]));
+			}
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#include <HBTK/FieldSplitter.h>
+
+#include <catch2/catch.hpp>
+
+#include <string>
+
+TEST_CASE("Field splitter") {
+	HBTK::FieldSplitter fields;
+
+	SECTION("Splits on any whitespace") {
+		std::string line = "  12\t3.5e2  a_much_longer_field_than_eight_chars\r\n";
+		REQUIRE(fields.split(line) == 3);
+		REQUIRE(fields[0] == "12");
+		REQUIRE(fields[1] == "3.5e2");
+		REQUIRE(fields[2] == "a_much_longer_field_than_eight_chars");
+		REQUIRE(fields[2].data() == line.data() + 12);
+	}
+
+	SECTION("Empty and blank lines") {
+		REQUIRE(fields.split("") == 0);
+		REQUIRE(fields.empty());
+		REQUIRE(fields.split(" \t \r\n") == 0);
+		REQUIRE(fields.begin() == fields.end());
+	}
+
+	SECTION("Reuse with fewer fields") {
+		REQUIRE(fields.split("1 2 3 4 5") == 5);
+		REQUIRE(fields.split("6 7") == 2);
+		int count = 0;
+		for (HBTK::StringView field : fields) {
+			REQUIRE(field == (count == 0 ? "6" : "7"));
+			count++;
+		}
+		REQUIRE(count == 2);
+	}
+}
@@ -1,12 +1,49 @@
 
 #include <HBTK/GmshParser.h>
+#include <HBTK/GmshWriter.h>
 
 #include <catch2/catch.hpp>
 
+#include <fstream>
 #include <map>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <set>
 
+namespace {
+	std::string file_contents(const std::string & path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		std::ostringstream contents;
+		contents << file.rdbuf();
+		return contents.str();
+	}
+
+	// Node count and sum of x coordinates, and element count.
+	struct MeshSummary {
+		int nodes = 0, elements = 0;
+		double x_sum = 0;
+	};
+
+	MeshSummary summarise(HBTK::ByteSource source)
+	{
+		MeshSummary summary;
+		HBTK::Gmsh::GmshParser parser;
+		parser.add_node_function([&](int, double x, double, double)->bool {
+			summary.nodes++;
+			summary.x_sum += x;
+			return true;
+		});
+		parser.add_elem_function([&](int, int, std::vector<int>, std::vector<int>)->bool {
+			summary.elements++;
+			return true;
+		});
+		parser.parse(std::move(source));
+		return summary;
+	}
+}
+
 
 
 TEST_CASE("GmshParser")
@@ -141,4 +178,148 @@ TEST_CASE("GmshParser")
 		REQUIRE(112 == (int)phys_grps[2].size());
 		REQUIRE(z_zero_check);
 	}
+
+	SECTION("Memory, stream and file sources agree")
+	{
+		for (auto path : { TESTHBTK_RESOURCE_GMSH_TEST_FILE_ASCII, TESTHBTK_RESOURCE_GMSH_TEST_FILE_BINARY }) {
+			std::string contents = file_contents(path);
+			MeshSummary from_file = summarise(HBTK::ByteSource::from_file(path));
+			MeshSummary from_memory = summarise(HBTK::ByteSource::from_memory(contents.data(), contents.size()));
+			MeshSummary from_string = summarise(HBTK::ByteSource::from_string(contents));
+			std::unique_ptr<std::istream> stream(new std::istringstream(contents));
+			MeshSummary from_stream = summarise(HBTK::ByteSource::from_stream(std::move(stream)));
+			REQUIRE(from_file.nodes == 703);
+			REQUIRE(from_file.elements == 860);
+			for (auto & other : { from_memory, from_string, from_stream }) {
+				REQUIRE(other.nodes == from_file.nodes);
+				REQUIRE(other.elements == from_file.elements);
+				REQUIRE(other.x_sum == from_file.x_sum);
+			}
+		}
+	}
+}
+
+TEST_CASE("Gmsh node and element data")
+{
+	SECTION("Dense holder")
+	{
+		HBTK::Gmsh::GmshNodeDataHolder data;
+		data.node_data_type() = HBTK::Gmsh::GmshNodeDataHolder::vector;
+		REQUIRE(data.components() == 3);
+		data.add_node_data(7, std::vector<double>({ 1., 2., 3. }));
+		double values[3] = { 4., 5., 6. };
+		data.add_node_data(2, values);
+		data.add_node_data(40, std::vector<double>({ 7., 8., 9. }));
+		REQUIRE_THROWS(data.add_node_data(3, std::vector<double>({ 1. })));
+		REQUIRE(data.number_of_node_data_points() == 3);
+		REQUIRE(data.node_data(2)[1] == 5.);
+		REQUIRE_FALSE(data.node_data_exists(3));
+		data.remove_node_data(7);
+		REQUIRE(data.number_of_node_data_points() == 2);
+		REQUIRE_FALSE(data.node_data_exists(7));
+		REQUIRE(data.node_data(40)[2] == 9.);
+		REQUIRE(data.node_tags() == std::vector<int>({ 40, 2 }));
+		REQUIRE(data.values() == std::vector<double>({ 7., 8., 9., 4., 5., 6. }));
+		data.clear();
+		REQUIRE(data.number_of_node_data_points() == 0);
+		REQUIRE_FALSE(data.node_data_exists(40));
+	}
+
+	for (bool binary : { false, true }) {
+		SECTION(binary ? "Binary round trip over time steps" : "ASCII round trip over time steps")
+		{
+			std::ostringstream file;
+			if (binary) {
+				int one = 1;
+				file << "$MeshFormat\n2.2 1 8\n";
+				file.write(reinterpret_cast<const char*>(&one), sizeof(int));
+				file << "\n$EndMeshFormat\n";
+			}
+			else {
+				file << "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n";
+			}
+			for (int step = 0; step < 3; step++) {
+				HBTK::Gmsh::GmshNodeDataHolder pressure;
+				pressure.data_description() = "Pressure field";
+				pressure.time() = 0.1 * step;
+				pressure.time_step() = step;
+				for (int tag = 1; tag <= 5000; tag++) {
+					double value = 1. / (tag + step);
+					pressure.add_node_data(tag, &value);
+				}
+				REQUIRE(HBTK::Gmsh::GmshWriter::write_node_data(file, pressure, binary));
+				HBTK::Gmsh::GmshElementDataHolder velocity;
+				velocity.element_data_type() = HBTK::Gmsh::GmshElementDataHolder::vector;
+				velocity.data_description() = "Velocity";
+				velocity.time_step() = step;
+				for (int tag = 10; tag > 0; tag--) {
+					velocity.add_element_data(tag, std::vector<double>({ (double)tag, -0.3, 1e-300 * step }));
+				}
+				REQUIRE(HBTK::Gmsh::GmshWriter::write_element_data(file, velocity, binary));
+			}
+
+			std::vector<int> node_steps, element_steps;
+			HBTK::Gmsh::GmshParser parser;
+			parser.add_node_data_function([&](const HBTK::Gmsh::GmshNodeDataHolder & data)->bool {
+				REQUIRE(data.data_description() == "Pressure field");
+				REQUIRE(data.number_of_node_data_points() == 5000);
+				REQUIRE(data.components() == 1);
+				REQUIRE(data.time() == 0.1 * data.time_step());
+				REQUIRE(data.node_data(3)[0] == 1. / (3 + data.time_step()));
+				node_steps.push_back(data.time_step());
+				return true;
+			});
+			parser.add_element_data_function([&](const HBTK::Gmsh::GmshElementDataHolder & data)->bool {
+				REQUIRE(data.data_description() == "Velocity");
+				REQUIRE(data.number_of_element_data_points() == 10);
+				REQUIRE(data.element_data_type() == HBTK::Gmsh::GmshElementDataHolder::vector);
+				REQUIRE(data.element_tags().front() == 10);
+				REQUIRE(data.element_data(4)[0] == 4.);
+				REQUIRE(data.element_data(4)[2] == 1e-300 * data.time_step());
+				element_steps.push_back(data.time_step());
+				return true;
+			});
+			std::ostringstream errors;
+			parser.parse(HBTK::ByteSource::from_string(file.str()), errors);
+			REQUIRE(errors.str() == "");
+			REQUIRE(node_steps == std::vector<int>({ 0, 1, 2 }));
+			REQUIRE(element_steps == std::vector<int>({ 0, 1, 2 }));
+		}
+	}
+
+	SECTION("Truncated section throws")
+	{
+		std::string file = "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+			"$NodeData\n1\n\"T\"\n1\n0\n3\n0\n1\n3\n1 0.5\n2 0.25\n";
+		HBTK::Gmsh::GmshParser parser;
+		std::ostringstream errors;
+		REQUIRE_THROWS(parser.parse(HBTK::ByteSource::from_string(file), errors));
+	}
+
+	SECTION("Missing file throws -1")
+	{
+		HBTK::Gmsh::GmshParser parser;
+		int code = 0;
+		try { parser.parse(std::string("no_such_directory/no_such_file.msh")); }
+		catch (int exc) { code = exc; }
+		REQUIRE(code == -1);
+	}
+
+	SECTION("Negative data tag throws")
+	{
+		std::string file = "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+			"$NodeData\n1\n\"T\"\n1\n0\n3\n0\n1\n2\n1 0.5\n-3 1.5\n$EndNodeData\n";
+		HBTK::Gmsh::GmshParser parser;
+		std::ostringstream errors;
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(file), errors), int);
+	}
+
+	SECTION("Repeated data tag throws")
+	{
+		std::string file = "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+			"$ElementData\n1\n\"T\"\n1\n0\n3\n0\n1\n2\n4 0.5\n4 1.5\n$EndElementData\n";
+		HBTK::Gmsh::GmshParser parser;
+		std::ostringstream errors;
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(file), errors), int);
+	}
 }
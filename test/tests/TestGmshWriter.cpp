@@ -0,0 +1,138 @@
+#include <HBTK/GmshParser.h>
+#include <HBTK/GmshWriter.h>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	struct ParsedMesh {
+		std::map<int, std::vector<double>> nodes;
+		std::map<int, std::vector<int>> elements; // type, groups, then nodes.
+		std::map<int, std::string> groups;
+	};
+
+	ParsedMesh parse(const std::string & file)
+	{
+		ParsedMesh mesh;
+		HBTK::Gmsh::GmshParser parser;
+		parser.add_node_function([&](int tag, double x, double y, double z)->bool {
+			mesh.nodes[tag] = std::vector<double>({ x, y, z });
+			return true;
+		});
+		parser.add_elem_function([&](int tag, int type, std::vector<int> groups, std::vector<int> nodes)->bool {
+			std::vector<int> & element = mesh.elements[tag];
+			element.push_back(type);
+			element.insert(element.end(), groups.begin(), groups.end());
+			element.insert(element.end(), nodes.begin(), nodes.end());
+			return true;
+		});
+		parser.add_phys_name_function([&](int tag, int, std::string name)->bool {
+			mesh.groups[tag] = name;
+			return true;
+		});
+		std::ostringstream errors;
+		parser.parse(HBTK::ByteSource::from_string(file), errors);
+		REQUIRE(errors.str() == "");
+		return mesh;
+	}
+
+	// An n by n grid of quads split into triangles on the diagonal.
+	void add_grid(HBTK::Gmsh::GmshWriter & writer, int n)
+	{
+		// Out of order to exercise insertion.
+		for (int i = n; i >= 0; i--) {
+			for (int j = 0; j <= n; j++) {
+				REQUIRE(writer.add_node(1 + i * (n + 1) + j, 0.25 * i, 0.5 * j, 0.) == 0);
+			}
+		}
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				int corner = 1 + i * (n + 1) + j;
+				if (i == j) {
+					writer.add_element(3, { corner, corner + 1, corner + n + 2, corner + n + 1 }, { 2 });
+				}
+				else {
+					writer.add_element(2, { corner, corner + 1, corner + n + 2 }, { 1 });
+					writer.add_element(2, { corner, corner + n + 2, corner + n + 1 }, { 1 });
+				}
+			}
+		}
+		writer.add_element(15, { 1 });
+	}
+}
+
+TEST_CASE("GmshWriter")
+{
+	HBTK::Gmsh::GmshWriter writer;
+	writer.add_physical_group(1, 2, "Triangles");
+	writer.add_physical_group(2, 2, "Quads");
+	add_grid(writer, 30);
+	REQUIRE(writer.add_node(5, 0., 0., 0.) == -1);
+
+	std::ostringstream ascii, binary;
+	REQUIRE(writer.write(ascii));
+	writer.binary() = true;
+	REQUIRE(writer.write(binary));
+
+	SECTION("ASCII and binary agree")
+	{
+		ParsedMesh from_ascii = parse(ascii.str()), from_binary = parse(binary.str());
+		REQUIRE(from_ascii.nodes.size() == 31 * 31);
+		REQUIRE(from_ascii.elements.size() == 30 + 2 * 30 * 29 + 1);
+		REQUIRE(from_ascii.groups[2] == "Quads");
+		REQUIRE(from_ascii.nodes[33] == std::vector<double>({ 0.25, 0.5, 0. }));
+		REQUIRE(from_ascii.elements[0] == std::vector<int>({ 3, 2, 1, 2, 33, 32 }));
+		REQUIRE(from_binary.nodes == from_ascii.nodes);
+		REQUIRE(from_binary.elements == from_ascii.elements);
+		REQUIRE(from_binary.groups == from_ascii.groups);
+	}
+
+	SECTION("Streaming matches stored")
+	{
+		for (bool use_binary : { false, true }) {
+			HBTK::Gmsh::GmshWriter streamer;
+			streamer.binary() = use_binary;
+			streamer.add_physical_group(1, 2, "Triangles");
+			streamer.add_physical_group(2, 2, "Quads");
+			std::ostringstream streamed;
+			REQUIRE(streamer.begin(streamed));
+			REQUIRE(streamer.add_node(1, 0., 0., 0.) == -1);
+			REQUIRE(streamer.begin_nodes(31 * 31));
+			for (int i = 0; i <= 30; i++) {
+				for (int j = 0; j <= 30; j++) {
+					REQUIRE(streamer.add_node(1 + i * 31 + j, 0.25 * i, 0.5 * j, 0.) == 0);
+				}
+			}
+			REQUIRE(streamer.begin_elements(30 + 2 * 30 * 29 + 1));
+			for (int i = 0; i < 30; i++) {
+				for (int j = 0; j < 30; j++) {
+					int corner = 1 + i * 31 + j;
+					if (i == j) {
+						streamer.add_element(3, { corner, corner + 1, corner + 32, corner + 31 }, { 2 });
+					}
+					else {
+						streamer.add_element(2, { corner, corner + 1, corner + 32 }, { 1 });
+						streamer.add_element(2, { corner, corner + 32, corner + 31 }, { 1 });
+					}
+				}
+			}
+			streamer.add_element(15, { 1 });
+			REQUIRE(streamer.end());
+			REQUIRE(streamed.str() == (use_binary ? binary.str() : ascii.str()));
+		}
+	}
+
+	SECTION("Streaming with the wrong count fails")
+	{
+		HBTK::Gmsh::GmshWriter streamer;
+		std::ostringstream streamed;
+		REQUIRE(streamer.begin(streamed));
+		REQUIRE(streamer.begin_nodes(2));
+		REQUIRE(streamer.add_node(1, 0., 0., 0.) == 0);
+		REQUIRE_FALSE(streamer.end());
+	}
+}
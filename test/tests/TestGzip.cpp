@@ -0,0 +1,128 @@
+#include <HBTK/Gzip.h>
+#include <HBTK/GmshParser.h>
+#include <HBTK/GmshWriter.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+	// Output of gzip -9 for node_lines(), which uses dynamic Huffman codes.
+	const unsigned char reference_gzip[] = {
+		0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x92,
+		0xcb, 0x11, 0xc4, 0x20, 0x0c, 0x43, 0xef, 0xa9, 0x82, 0x0a, 0x32, 0xfe,
+		0x60, 0x20, 0xfd, 0x37, 0xb6, 0x32, 0x01, 0xc3, 0x84, 0xbd, 0x64, 0xc2,
+		0x43, 0x08, 0x61, 0x9b, 0x13, 0xdd, 0x2c, 0x46, 0x44, 0xfe, 0x93, 0xa5,
+		0x59, 0x4d, 0x74, 0x09, 0x16, 0x1d, 0x3a, 0xb5, 0x0a, 0xfe, 0x80, 0x2a,
+		0x16, 0x5a, 0xbb, 0x96, 0x6f, 0x57, 0x72, 0x06, 0xcd, 0x2e, 0xa1, 0xae,
+		0x95, 0x45, 0x0d, 0xb4, 0xc8, 0xd0, 0x86, 0x6f, 0x01, 0xad, 0xd3, 0x37,
+		0xb4, 0xd8, 0xb9, 0xdb, 0xeb, 0x2b, 0x4b, 0xdb, 0x70, 0x90, 0x5e, 0x5f,
+		0xbe, 0xbb, 0x14, 0xf7, 0x5f, 0x8f, 0xdb, 0x4d, 0xdf, 0xa0, 0xdc, 0x13,
+		0x19, 0x7d, 0x2c, 0x98, 0x81, 0x47, 0xe2, 0xed, 0x3e, 0x16, 0x60, 0x9b,
+		0xd6, 0x4b, 0xad, 0x58, 0x8d, 0xcc, 0xdb, 0x4b, 0xf0, 0xe1, 0x19, 0x7a,
+		0x7b, 0x36, 0x9b, 0x07, 0x98, 0xde, 0x51, 0x23, 0x2e, 0x38, 0x3b, 0x62,
+		0x6f, 0x05, 0xe5, 0xea, 0xb9, 0x66, 0x9d, 0xe7, 0xfe, 0xc5, 0xcd, 0x6f,
+		0xb2, 0x43, 0xfd, 0x00, 0xeb, 0xe1, 0x2d, 0x9e, 0x2b, 0x72, 0x47, 0x12,
+		0x61, 0xe0, 0x33, 0xb7, 0x08, 0x56, 0x91, 0x7b, 0xb5, 0x56, 0x81, 0xdb,
+		0x51, 0x13, 0xc9, 0x49, 0x67, 0xae, 0xad, 0x82, 0x62, 0xc0, 0x67, 0xbd,
+		0xa5, 0x00, 0x8b, 0x7d, 0x9b, 0x23, 0x15, 0x58, 0x8f, 0x4e, 0x4a, 0x03,
+		0x36, 0xfa, 0xb6, 0x1d, 0x6f, 0xd2, 0x3f, 0x33, 0xa2, 0x04, 0x5c, 0xed,
+		0x3b, 0x50, 0xca, 0xc0, 0xed, 0x98, 0x3e, 0x95, 0x94, 0x57, 0xbd, 0xd7,
+		0xa8, 0x2a, 0xf0, 0x39, 0xd7, 0x9a, 0x81, 0xa3, 0xde, 0xd1, 0x06, 0x35,
+		0xe0, 0xa8, 0xf7, 0x52, 0x17, 0x60, 0x3b, 0xbd, 0x2b, 0x70, 0xe4, 0x5e,
+		0x49, 0x1a, 0xf0, 0x9f, 0xdc, 0x0f, 0x70, 0xe4, 0x0e, 0xef, 0x4c, 0xc9,
+		0x56, 0xee, 0x50, 0xff, 0x00, 0x16, 0x02, 0x63, 0x53, 0x8f, 0x03, 0x00,
+		0x00,
+	};
+
+	std::string node_lines() {
+		std::string text;
+		char line[64];
+		for (int i = 1; i <= 40; i++) {
+			snprintf(line, sizeof(line), "%d %.6f %.6f 0\n", i, i * 0.125, (i * i % 17) / 7.0);
+			text += line;
+		}
+		return text;
+	}
+
+	std::string mixed_data(int size) {
+		std::mt19937 gen(3);
+		std::string data;
+		while ((int)data.size() < size) {
+			if (gen() % 2) { data += std::to_string(gen() % 1000) + " 0.5 1.25\n"; }
+			else { data.push_back((char)(gen() & 0xFF)); }
+		}
+		data.resize(size);
+		return data;
+	}
+}
+
+TEST_CASE("Gzip") {
+
+	SECTION("Decompress gzip output") {
+		std::string out = HBTK::gzip_decompress((const char*)reference_gzip, sizeof(reference_gzip));
+		REQUIRE(out == node_lines());
+	}
+
+	SECTION("Round trip") {
+		for (int size : { 0, 1, 1000, 65280, 65281, 400000 }) {
+			std::string data = mixed_data(size);
+			std::string compressed = HBTK::gzip_compress(data.data(), data.size(), 3);
+			REQUIRE(HBTK::is_gzip(compressed.data(), compressed.size()));
+			REQUIRE(HBTK::gzip_decompress(compressed.data(), compressed.size(), 1) == data);
+			REQUIRE(HBTK::gzip_decompress(compressed.data(), compressed.size(), 4) == data);
+		}
+		std::string text = node_lines() + node_lines();
+		std::string compressed = HBTK::gzip_compress(text.data(), text.size());
+		REQUIRE(compressed.size() < text.size() / 2);
+	}
+
+	SECTION("Corrupt data throws") {
+		std::string compressed((const char*)reference_gzip, sizeof(reference_gzip));
+		REQUIRE_THROWS_AS(HBTK::gzip_decompress(compressed.data(), compressed.size() - 20), std::invalid_argument);
+		compressed[compressed.size() - 6] ^= 1;	// CRC.
+		REQUIRE_THROWS_AS(HBTK::gzip_decompress(compressed.data(), compressed.size()), std::invalid_argument);
+		REQUIRE_THROWS_AS(HBTK::gzip_decompress("plain text", 10), std::invalid_argument);
+	}
+
+	SECTION("Streams") {
+		std::string data = mixed_data(200000);
+		std::ostringstream destination;
+		{
+			HBTK::GzipOutputStream stream(destination, 2);
+			for (int i = 0; i < (int)data.size(); i += 1000) { stream.write(data.data() + i, 1000); }
+		}
+		std::string compressed = destination.str();
+		REQUIRE(HBTK::gzip_decompress(compressed.data(), compressed.size()) == data);
+
+		HBTK::GzipInputStream input(HBTK::ByteSource::from_string(compressed));
+		std::ostringstream decompressed;
+		decompressed << input.rdbuf();
+		REQUIRE(decompressed.str() == data);
+	}
+
+	SECTION("Parse a compressed Gmsh mesh") {
+		HBTK::Gmsh::GmshWriter writer;
+		for (int i = 1; i <= 100; i++) { writer.add_node(i, i * 0.5, 0, 0); }
+		std::ostringstream destination;
+		HBTK::GzipOutputStream stream(destination);
+		REQUIRE(writer.write(stream));
+		stream.finish();
+
+		HBTK::Gmsh::GmshParser parser;
+		int nodes = 0;
+		double x_sum = 0;
+		parser.add_node_function([&](int, double x, double, double)->bool {
+			nodes++;
+			x_sum += x;
+			return true;
+		});
+		parser.parse(HBTK::decompressed(HBTK::ByteSource::from_string(destination.str())));
+		REQUIRE(nodes == 100);
+		REQUIRE(x_sum == Approx(0.5 * 5050));
+	}
+}
@@ -0,0 +1,111 @@
+#include <HBTK/ElementMapping.h>
+#include <HBTK/ElementShapeFunctions.h>
+#include <HBTK/LagrangeShapeFunctions.h>
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <random>
+#include <vector>
+
+namespace {
+	// Evaluated at compile time.
+	constexpr std::array<double, 27> hex27_at_node = 
+		HBTK::Elements::TriquadraticHexahedron27ShapeFunctions::shape_function(1., 1., -1.);
+	static_assert(hex27_at_node[2] > 1 - 1e-12 && hex27_at_node[2] < 1 + 1e-12, 
+		"Shape functions should be usable in constant expressions.");
+
+	// Checks the shape functions through the runtime ElementShape of Gmsh 
+	// element type ele_id against the node table of TElement.
+	template<typename TFuncs, typename TElement>
+	void check_shape_functions(int ele_id) {
+		const HBTK::Elements::ElementShape * shape = HBTK::Elements::gmsh_element_shape(ele_id);
+		REQUIRE(shape != nullptr);
+		const int n = TFuncs::number_of_nodes, dims = TFuncs::local_dimensions;
+		REQUIRE(shape->number_of_nodes == n);
+		REQUIRE(shape->local_dimensions == dims);
+		REQUIRE(n <= HBTK::Elements::max_shape_nodes);
+		std::vector<double> values(n), derivs(3 * n), vp(n), vm(n);
+
+		// Kronecker property at the nodes.
+		for (int i = 0; i < n; i++) {
+			std::array<double, 3> local({ { 0, 0, 0 } });
+			for (int d = 0; d < dims; d++) { local[d] = TElement::nodes[i][d]; }
+			REQUIRE(shape->contains(local.data(), 1e-12));
+			shape->evaluate(local.data(), values.data(), nullptr);
+			for (int j = 0; j < n; j++) {
+				REQUIRE(values[j] == Approx(i == j ? 1. : 0.).margin(1e-10));
+			}
+		}
+
+		// Partition of unity, reproduction of linear functions and derivatives.
+		std::mt19937 gen(ele_id);
+		std::uniform_real_distribution<double> pos(-0.15, 0.15);
+		for (int trial = 0; trial < 5; trial++) {
+			std::array<double, 3> local = shape->centre;
+			for (int d = 0; d < dims; d++) { local[d] += pos(gen); }
+			shape->evaluate(local.data(), values.data(), derivs.data());
+			double sum = 0, linear = 0;
+			for (int i = 0; i < n; i++) {
+				sum += values[i];
+				for (int d = 0; d < dims; d++) { linear += values[i] * (d + 1) * TElement::nodes[i][d]; }
+			}
+			REQUIRE(sum == Approx(1.));
+			double expected = 0;
+			for (int d = 0; d < dims; d++) { expected += (d + 1) * local[d]; }
+			REQUIRE(linear == Approx(expected));
+			for (int d = 0; d < dims; d++) {
+				const double h = 1e-6;
+				std::array<double, 3> lp = local, lm = local;
+				lp[d] += h;
+				lm[d] -= h;
+				shape->evaluate(lp.data(), vp.data(), nullptr);
+				shape->evaluate(lm.data(), vm.data(), nullptr);
+				for (int i = 0; i < n; i++) {
+					REQUIRE(derivs[d * n + i] == Approx((vp[i] - vm[i]) / (2 * h)).margin(1e-6));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Lagrange shape functions") {
+	using namespace HBTK::Elements;
+
+	SECTION("Lines") {
+		check_shape_functions<CubicShapeFunctions, Line4>(26);
+		check_shape_functions<QuarticShapeFunctions, Line5>(27);
+		check_shape_functions<QuinticShapeFunctions, Line6>(28);
+	}
+	SECTION("Triangles") {
+		check_shape_functions<IncompleteCubicTriangle9ShapeFunctions, Triangle9>(20);
+		check_shape_functions<CubicTriangle10ShapeFunctions, Triangle10>(21);
+		check_shape_functions<IncompleteQuarticTriangle12ShapeFunctions, Triangle12>(22);
+		check_shape_functions<QuarticTriangle15ShapeFunctions, Triangle15O4>(23);
+		check_shape_functions<IncompleteQuinticTriangle15ShapeFunctions, Triangle15O5>(24);
+		check_shape_functions<QuinticTriangle21ShapeFunctions, Triangle21>(25);
+	}
+	SECTION("Quadrangles") {
+		check_shape_functions<BiquadraticQuad9ShapeFunctions, Quadrangle9>(10);
+		check_shape_functions<SerendipityQuad12ShapeFunctions, Quadrangle12>(39);
+		check_shape_functions<BicubicQuad16ShapeFunctions, Quadrangle16>(36);
+	}
+	SECTION("Volumes") {
+		check_shape_functions<CubicTetrahedron20ShapeFunctions, Tetrahedron20>(29);
+		check_shape_functions<SerendipityHexahedron20ShapeFunctions, Hexahedron20>(17);
+		check_shape_functions<TriquadraticHexahedron27ShapeFunctions, Hexahedron27>(12);
+		check_shape_functions<LinearPrism6ShapeFunctions, Prism6>(6);
+		check_shape_functions<SerendipityPrism15ShapeFunctions, Prism15>(18);
+		check_shape_functions<QuadraticPrism18ShapeFunctions, Prism18>(13);
+	}
+	SECTION("Agrees with hand written shape functions") {
+		using LagrangeQuad8 = LagrangeShapeFunctions<Quadrangle8, PolynomialSpace::serendipity_quadrangle, 2>;
+		using LagrangeTet10 = LagrangeShapeFunctions<Tetrahedron10, PolynomialSpace::complete, 2>;
+		std::array<double, 8> quad = LagrangeQuad8::shape_function_d0(0.3, -0.4);
+		std::array<double, 8> quad_hand = SerendipityQuad8ShapeFunctions().shape_function_d0(0.3, -0.4);
+		for (int i = 0; i < 8; i++) { REQUIRE(quad[i] == Approx(quad_hand[i]).margin(1e-12)); }
+		std::array<double, 10> tet = LagrangeTet10::shape_function_d2(0.2, 0.1, 0.3);
+		std::array<double, 10> tet_hand = QuadraticTetrahedron10ShapeFunctions().shape_function_d2(0.2, 0.1, 0.3);
+		for (int i = 0; i < 10; i++) { REQUIRE(tet[i] == Approx(tet_hand[i]).margin(1e-12)); }
+	}
+}
@@ -0,0 +1,171 @@
+#include <HBTK/GmshMeshHolder.h>
+#include <HBTK/GmshNodeDataHolder.h>
+#include <HBTK/MeshReordering.h>
+#include <HBTK/VtkUnstructuredDataset.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+	// An n * n * n grid of hexahedra with randomly numbered points and cells.
+	HBTK::Vtk::VtkUnstructuredDataset shuffled_grid(int n, unsigned seed)
+	{
+		std::mt19937 gen(seed);
+		const int np = n + 1;
+		std::vector<int> point_numbers(np * np * np), cell_order(n * n * n);
+		std::iota(point_numbers.begin(), point_numbers.end(), 0);
+		std::iota(cell_order.begin(), cell_order.end(), 0);
+		std::shuffle(point_numbers.begin(), point_numbers.end(), gen);
+		std::shuffle(cell_order.begin(), cell_order.end(), gen);
+
+		HBTK::Vtk::VtkUnstructuredDataset dataset;
+		dataset.mesh.points.resize(point_numbers.size());
+		std::vector<double> & point_x = dataset.scalar_point_data["x"];
+		point_x.resize(point_numbers.size());
+		for (int i = 0; i < np; i++) {
+			for (int j = 0; j < np; j++) {
+				for (int k = 0; k < np; k++) {
+					int number = point_numbers[(i * np + j) * np + k];
+					dataset.mesh.points[number] = HBTK::CartesianPoint3D({ (double)i, (double)j, (double)k });
+					point_x[number] = i;
+				}
+			}
+		}
+		std::vector<int> & cell_i = dataset.integer_cell_data["i"];
+		for (int c : cell_order) {
+			int i = c / (n * n), j = (c / n) % n, k = c % n;
+			auto p = [&](int a, int b, int d) { return point_numbers[((i + a) * np + j + b) * np + k + d]; };
+			dataset.mesh.cells.push_back({ HBTK::Vtk::VTK_HEXAHEDRON,
+				{ p(0, 0, 0), p(1, 0, 0), p(1, 1, 0), p(0, 1, 0), p(0, 0, 1), p(1, 0, 1), p(1, 1, 1), p(0, 1, 1) } });
+			cell_i.push_back(i);
+		}
+		return dataset;
+	}
+
+	bool is_permutation(const std::vector<int> & new_index)
+	{
+		std::vector<int> sorted = new_index;
+		std::sort(sorted.begin(), sorted.end());
+		for (int i = 0; i < (int)sorted.size(); i++) {
+			if (sorted[i] != i) { return false; }
+		}
+		return true;
+	}
+
+	// Data follows points and cells: x data matches coordinates, and cell i
+	// data matches the lowest x of its nodes.
+	bool consistent(const HBTK::Vtk::VtkUnstructuredDataset & dataset)
+	{
+		for (int i = 0; i < (int)dataset.mesh.points.size(); i++) {
+			if (dataset.scalar_point_data.at("x")[i] != dataset.mesh.points[i].x()) { return false; }
+		}
+		for (int c = 0; c < (int)dataset.mesh.cells.size(); c++) {
+			double lowest = 1e300;
+			for (int node : dataset.mesh.cells[c].node_ids) {
+				lowest = std::min(lowest, dataset.mesh.points[node].x());
+			}
+			if (lowest != dataset.integer_cell_data.at("i")[c]) { return false; }
+		}
+		return true;
+	}
+}
+
+TEST_CASE("Mesh reordering")
+{
+	HBTK::Vtk::VtkUnstructuredDataset dataset = shuffled_grid(12, 3);
+	std::vector<int> offsets, nodes;
+	dataset.mesh.cell_connectivity(offsets, nodes);
+	HBTK::LocalityReport before = HBTK::locality_report(offsets, nodes);
+	REQUIRE(consistent(dataset));
+
+	SECTION("Reverse Cuthill-McKee")
+	{
+		std::vector<int> new_index = HBTK::reverse_cuthill_mckee((int)dataset.mesh.points.size(), offsets, nodes);
+		REQUIRE(is_permutation(new_index));
+		dataset.reorder_points(new_index);
+		dataset.mesh.cell_connectivity(offsets, nodes);
+		dataset.reorder_cells(HBTK::element_order_by_nodes(offsets, nodes));
+		REQUIRE(consistent(dataset));
+		dataset.mesh.cell_connectivity(offsets, nodes);
+		HBTK::LocalityReport after = HBTK::locality_report(offsets, nodes);
+		// Level sets of a hexahedral grid are cubic shells of up to 3 * 13^2 points.
+		REQUIRE(after.bandwidth < 2 * 3 * 13 * 13);
+		REQUIRE(after.bandwidth < before.bandwidth / 4);
+		REQUIRE(after.mean_element_jump < 5);
+		REQUIRE(after.mean_element_jump < before.mean_element_jump / 50);
+	}
+
+	SECTION("Space filling curves")
+	{
+		for (bool hilbert : { true, false }) {
+			HBTK::Vtk::VtkUnstructuredDataset copy = dataset;
+			std::vector<int> new_index = hilbert ? HBTK::hilbert_order(copy.mesh.points)
+				: HBTK::morton_order(copy.mesh.points);
+			REQUIRE(is_permutation(new_index));
+			copy.reorder_points(new_index);
+			copy.mesh.cell_connectivity(offsets, nodes);
+			copy.reorder_cells(HBTK::element_order_by_nodes(offsets, nodes));
+			REQUIRE(consistent(copy));
+			copy.mesh.cell_connectivity(offsets, nodes);
+			HBTK::LocalityReport after = HBTK::locality_report(offsets, nodes);
+			REQUIRE(after.mean_element_span < before.mean_element_span / 5);
+			// Consecutive points are mostly close together.
+			double mean_step = 0;
+			for (int i = 1; i < (int)copy.mesh.points.size(); i++) {
+				mean_step += (copy.mesh.points[i] - copy.mesh.points[i - 1]).magnitude();
+			}
+			mean_step /= copy.mesh.points.size() - 1;
+			REQUIRE(mean_step < (hilbert ? 1.5 : 2.5));
+		}
+	}
+
+	SECTION("Apply and invert orderings")
+	{
+		std::vector<int> new_index({ 2, 0, 1 });
+		std::vector<double> data({ 10., 11., 20., 21., 30., 31. });
+		HBTK::apply_ordering(data, new_index, 2);
+		REQUIRE(data == std::vector<double>({ 20., 21., 30., 31., 10., 11. }));
+		REQUIRE(HBTK::inverse_ordering(new_index) == std::vector<int>({ 1, 2, 0 }));
+	}
+
+	SECTION("Renumber Gmsh mesh and data")
+	{
+		HBTK::Gmsh::GmshMeshHolder mesh;
+		HBTK::Gmsh::GmshNodeDataHolder data;
+		for (int i = 0; i < (int)dataset.mesh.points.size(); i++) {
+			mesh.add_node(10 + i, dataset.mesh.points[i]);
+			double x = dataset.mesh.points[i].x();
+			data.add_node_data(10 + i, &x);
+		}
+		mesh.add_group(1, "Cells", 3);
+		for (int c = 0; c < (int)dataset.mesh.cells.size(); c++) {
+			std::vector<int> node_tags;
+			for (int node : dataset.mesh.cells[c].node_ids) { node_tags.push_back(10 + node); }
+			mesh.add_element(100 + c, 5, node_tags, { 1 });
+		}
+		std::vector<int> node_tags, element_tags;
+		mesh.dense_connectivity(node_tags, element_tags, offsets, nodes);
+		std::vector<int> new_index = HBTK::reverse_cuthill_mckee((int)node_tags.size(), offsets, nodes);
+		std::unordered_map<int, int> new_node_tags;
+		for (int i = 0; i < (int)node_tags.size(); i++) { new_node_tags[node_tags[i]] = 1 + new_index[i]; }
+		mesh.renumber_nodes(new_node_tags);
+		data.renumber_node_tags(new_node_tags);
+
+		mesh.dense_connectivity(node_tags, element_tags, offsets, nodes);
+		REQUIRE(node_tags.front() == 1);
+		REQUIRE(HBTK::locality_report(offsets, nodes).bandwidth < before.bandwidth / 4);
+		new_index = HBTK::element_order_by_nodes(offsets, nodes);
+		std::unordered_map<int, int> new_element_tags;
+		for (int i = 0; i < (int)element_tags.size(); i++) { new_element_tags[element_tags[i]] = 1 + new_index[i]; }
+		mesh.renumber_elements(new_element_tags);
+		REQUIRE(mesh.group_elements(1).size() == dataset.mesh.cells.size());
+		REQUIRE(mesh.element_in_group(1, 1));
+		for (int tag : mesh.get_all_node_tags()) {
+			REQUIRE(data.node_data(tag)[0] == mesh.node(tag).x());
+		}
+	}
+}
@@ -0,0 +1,171 @@
+#include <HBTK/GmshMeshHolder.h>
+#include <HBTK/MeshTopology.h>
+#include <HBTK/VtkUnstructuredMeshHolder.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+	// An n * n * n grid of unit hexahedra.
+	HBTK::Vtk::VtkUnstructuredMeshHolder hex_grid(int n)
+	{
+		const int np = n + 1;
+		HBTK::Vtk::VtkUnstructuredMeshHolder mesh;
+		for (int i = 0; i < np; i++) {
+			for (int j = 0; j < np; j++) {
+				for (int k = 0; k < np; k++) {
+					mesh.points.push_back(HBTK::CartesianPoint3D({ (double)i, (double)j, (double)k }));
+				}
+			}
+		}
+		for (int i = 0; i < n; i++) {
+			for (int j = 0; j < n; j++) {
+				for (int k = 0; k < n; k++) {
+					auto p = [&](int a, int b, int c) { return ((i + a) * np + j + b) * np + k + c; };
+					mesh.cells.push_back({ HBTK::Vtk::VTK_HEXAHEDRON,
+						{ p(0, 0, 0), p(1, 0, 0), p(1, 1, 0), p(0, 1, 0), p(0, 0, 1), p(1, 0, 1), p(1, 1, 1), p(0, 1, 1) } });
+				}
+			}
+		}
+		return mesh;
+	}
+
+	// Every face pairing is mutual and every neighbour uses the face's nodes.
+	void check_symmetric(const HBTK::MeshTopology & topology)
+	{
+		for (int face = 0; face < topology.number_of_faces(); face++) {
+			int other = topology.face_neighbours()[face];
+			if (other < 0) { continue; }
+			int element = topology.face_element(face);
+			bool found = false;
+			for (int f = topology.face_offsets()[other]; f < topology.face_offsets()[other + 1]; f++) {
+				if (topology.face_neighbours()[f] == element) {
+					std::vector<int> a = topology.face_nodes(face), b = topology.face_nodes(f);
+					std::sort(a.begin(), a.end());
+					std::sort(b.begin(), b.end());
+					found = found || a == b;
+				}
+			}
+			REQUIRE(found);
+		}
+	}
+}
+
+TEST_CASE("Mesh topology")
+{
+	SECTION("Hexahedral grid")
+	{
+		const int n = 10;
+		HBTK::Vtk::VtkUnstructuredMeshHolder mesh = hex_grid(n);
+		HBTK::MeshTopology topology = mesh.topology();
+		REQUIRE(topology.number_of_elements() == n * n * n);
+		REQUIRE(topology.number_of_faces() == 6 * n * n * n);
+		REQUIRE((int)topology.boundary_faces().size() == 6 * n * n);
+		check_symmetric(topology);
+
+		// Corner cell has 3 neighbours, a central cell 6.
+		auto neighbours = [&](int cell) {
+			return topology.element_neighbour_offsets()[cell + 1] - topology.element_neighbour_offsets()[cell];
+		};
+		REQUIRE(neighbours(0) == 3);
+		REQUIRE(neighbours((5 * n + 5) * n + 5) == 6);
+		// An interior point is used by 8 cells, a corner by 1.
+		auto users = [&](int point) {
+			return topology.node_element_offsets()[point + 1] - topology.node_element_offsets()[point];
+		};
+		REQUIRE(users(0) == 1);
+		REQUIRE(users((5 * (n + 1) + 5) * (n + 1) + 5) == 8);
+
+		for (int face : topology.boundary_faces()) {
+			// Boundary faces lie in a plane of the bounding cube.
+			std::vector<int> nodes = topology.face_nodes(face);
+			REQUIRE(nodes.size() == 4);
+			bool on_boundary = false;
+			for (int axis = 0; axis < 3; axis++) {
+				for (double plane : { 0., (double)n }) {
+					bool all = true;
+					for (int node : nodes) { all = all && mesh.points[node].as_array()[axis] == plane; }
+					on_boundary = on_boundary || all;
+				}
+			}
+			REQUIRE(on_boundary);
+		}
+
+		HBTK::MeshTopology serial = mesh.topology(1);
+		REQUIRE(serial.face_neighbours() == topology.face_neighbours());
+		REQUIRE(serial.element_neighbours() == topology.element_neighbours());
+	}
+
+	SECTION("Mixed elements")
+	{
+		// A hexahedron with a prism on top, a pyramid on one side and a 
+		// tetrahedron on the pyramid's apex face, plus a quad boundary element.
+		std::vector<HBTK::MeshTopology::element_geometry> geometries({
+			HBTK::MeshTopology::hexahedron, HBTK::MeshTopology::prism,
+			HBTK::MeshTopology::pyramid, HBTK::MeshTopology::tetrahedron,
+			HBTK::MeshTopology::quadrangle });
+		std::vector<int> nodes({
+			0, 1, 2, 3, 4, 5, 6, 7,	// hexahedron
+			4, 5, 8, 7, 6, 9,		// prism on face 4 5 6 7
+			1, 2, 6, 5, 10,			// pyramid on face 1 2 6 5
+			1, 5, 10, 11,			// tetrahedron on pyramid face 1 5 10 (reversed)
+			0, 1, 2, 3 });			// quad on the bottom face
+		std::vector<int> offsets({ 0, 8, 14, 19, 23, 27 });
+		HBTK::MeshTopology topology(12, geometries, offsets, nodes);
+		check_symmetric(topology);
+		const std::vector<int> & neighbours = topology.element_neighbours();
+		const std::vector<int> & neighbour_offsets = topology.element_neighbour_offsets();
+		std::vector<int> of_hex(neighbours.begin() + neighbour_offsets[0], neighbours.begin() + neighbour_offsets[1]);
+		std::sort(of_hex.begin(), of_hex.end());
+		REQUIRE(of_hex == std::vector<int>({ 1, 2 }));
+		std::vector<int> of_pyramid(neighbours.begin() + neighbour_offsets[2], neighbours.begin() + neighbour_offsets[3]);
+		std::sort(of_pyramid.begin(), of_pyramid.end());
+		REQUIRE(of_pyramid == std::vector<int>({ 0, 3 }));
+		// The quad's faces are edges, which match nothing here.
+		REQUIRE(neighbour_offsets[5] - neighbour_offsets[4] == 0);
+		REQUIRE(topology.number_of_faces() == 6 + 5 + 5 + 4 + 4);
+		REQUIRE((int)topology.boundary_faces().size() == topology.number_of_faces() - 6);
+		REQUIRE_THROWS(HBTK::MeshTopology(12, geometries, std::vector<int>({ 0, 8, 14, 19, 23, 26 }), nodes));
+	}
+
+	SECTION("Gmsh mesh")
+	{
+		// The hexahedral grid with tags offset from indices, plus quads on z = 0.
+		const int n = 4;
+		HBTK::Vtk::VtkUnstructuredMeshHolder grid = hex_grid(n);
+		HBTK::Gmsh::GmshMeshHolder mesh;
+		for (int i = 0; i < (int)grid.points.size(); i++) { mesh.add_node(100 + i, grid.points[i]); }
+		for (int c = 0; c < (int)grid.cells.size(); c++) {
+			std::vector<int> node_tags;
+			for (int node : grid.cells[c].node_ids) { node_tags.push_back(100 + node); }
+			mesh.add_element(1000 + c, 5, node_tags, {});
+			if (c % n == 0) {
+				mesh.add_element(5000 + c, 3, 
+					std::vector<int>(node_tags.begin(), node_tags.begin() + 4), {});
+			}
+		}
+		std::vector<int> node_tags, element_tags;
+		HBTK::MeshTopology topology = mesh.topology(node_tags, element_tags);
+		REQUIRE(topology.number_of_elements() == n * n * n + n * n);
+		REQUIRE(topology.number_of_nodes() == mesh.number_of_nodes());
+		REQUIRE(node_tags.front() == 100);
+		check_symmetric(topology);
+		// The quads form a surface, whose boundary is 4 * n edges.
+		int quad_boundary = 0;
+		for (int face : topology.boundary_faces()) {
+			if (element_tags[topology.face_element(face)] >= 5000) { quad_boundary++; }
+		}
+		REQUIRE(quad_boundary == 4 * n);
+		// Each element's nodes list it as a user.
+		for (int e = 0; e < topology.number_of_elements(); e++) {
+			for (int node_tag : mesh.element_node_tags(element_tags[e])) {
+				int node = (int)(std::lower_bound(node_tags.begin(), node_tags.end(), node_tag) - node_tags.begin());
+				auto first = topology.node_elements().begin() + topology.node_element_offsets()[node];
+				auto last = topology.node_elements().begin() + topology.node_element_offsets()[node + 1];
+				REQUIRE(std::binary_search(first, last, e));
+			}
+		}
+	}
+}
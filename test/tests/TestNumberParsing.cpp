@@ -0,0 +1,137 @@
+#include <HBTK/NumberParsing.h>
+
+#include <catch2/catch.hpp>
+
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+	// Parses to exactly the same bits as strtod.
+	bool matches_strtod(const std::string & str) {
+		double expected = strtod(str.c_str(), nullptr), value = -1;
+		const char * end = HBTK::parse_number(str.data(), str.data() + str.size(), value);
+		return end == str.data() + str.size() && memcmp(&expected, &value, sizeof(double)) == 0;
+	}
+}
+
+TEST_CASE("Parse doubles") {
+
+	SECTION("Simple values") {
+		REQUIRE(HBTK::to_double("1") == 1.);
+		REQUIRE(HBTK::to_double("-2.5") == -2.5);
+		REQUIRE(HBTK::to_double("+.5") == 0.5);
+		REQUIRE(HBTK::to_double("5.") == 5.);
+		REQUIRE(HBTK::to_double("1e3") == 1000.);
+		REQUIRE(HBTK::to_double("  1.5E-2\r\n") == 0.015);
+		REQUIRE(std::signbit(HBTK::to_double("-0")));
+		REQUIRE(std::isinf(HBTK::to_double("-inf")));
+		REQUIRE(std::isnan(HBTK::to_double("NaN")));
+	}
+
+	SECTION("Stops at the end of the number") {
+		const char str[] = "3.25e1x";
+		double value;
+		REQUIRE(HBTK::parse_number(str, str + 7, value) == str + 6);
+		REQUIRE(value == 32.5);
+		// An 'e' without digits isn't part of the number.
+		REQUIRE(HBTK::parse_number(str, str + 5, value) == str + 4);
+		REQUIRE(value == 3.25);
+		REQUIRE(HBTK::parse_number(str + 6, str + 7, value) == str + 6);
+	}
+
+	SECTION("Invalid input throws") {
+		REQUIRE_THROWS_AS(HBTK::to_double(""), std::invalid_argument);
+		REQUIRE_THROWS_AS(HBTK::to_double("."), std::invalid_argument);
+		REQUIRE_THROWS_AS(HBTK::to_double("-"), std::invalid_argument);
+		REQUIRE_THROWS_AS(HBTK::to_double("1.0.0"), std::invalid_argument);
+		REQUIRE_THROWS_AS(HBTK::to_double("1 2"), std::invalid_argument);
+	}
+
+	SECTION("Hard cases match strtod") {
+		const char * cases[] = {
+			"2.2250738585072011e-308", "2.2250738585072014e-308", "4.9406564584124654e-324",
+			"2.47032822920623272e-324", "1e-400", "1.7976931348623157e308", "1.7976931348623159e308",
+			"1e400", "9007199254740993", "9007199254740993.0000000001", "7.2057594037927933e16",
+			"1e23", "8.98846567431158e307", "0.1", "3.0517578125e-05",
+			"123456789012345678901234567890", "0.00000000000000000000000000000000000123456789012345678901",
+			"000000000000000000000000000001.5" };
+		for (auto str : cases) {
+			INFO(str);
+			REQUIRE(matches_strtod(str));
+		}
+	}
+
+	SECTION("Random values match strtod") {
+		std::mt19937_64 gen(1);
+		char buffer[64];
+		for (int i = 0; i < 100000; i++) {
+			uint64_t bits = gen();
+			double value;
+			memcpy(&value, &bits, sizeof(double));
+			if (!std::isfinite(value)) { continue; }
+			if (i % 2) { snprintf(buffer, sizeof(buffer), "%.17g", value); }
+			else { snprintf(buffer, sizeof(buffer), "%.*e", (int)(gen() % 17), value); }
+			INFO(buffer);
+			REQUIRE(matches_strtod(buffer));
+		}
+	}
+
+	SECTION("Fallback ignores the global locale") {
+		const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+		bool comma_locale = false;
+		for (const char * name : { "de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "de_DE", "German" }) {
+			if (std::setlocale(LC_NUMERIC, name) && std::localeconv()->decimal_point[0] == ',') {
+				comma_locale = true;
+				break;
+			}
+		}
+		if (comma_locale) {
+			// More than 19 significant digits, so the strtod fallback is used.
+			REQUIRE(HBTK::to_double("1.2345678901234567890123") == 1.2345678901234567);
+			REQUIRE(HBTK::to_double("9007199254740993.0000000001") == 9007199254740994.);
+		}
+		else {
+			WARN("No locale with a ',' decimal point is installed.");
+		}
+		std::setlocale(LC_NUMERIC, previous.c_str());
+	}
+}
+
+TEST_CASE("Parse integers") {
+	REQUIRE(HBTK::to_integer("42") == 42);
+	REQUIRE(HBTK::to_integer(" -7 ") == -7);
+	REQUIRE(HBTK::to_integer("9223372036854775807") == std::numeric_limits<long long>::max());
+	REQUIRE(HBTK::to_integer("-9223372036854775808") == std::numeric_limits<long long>::min());
+	REQUIRE_THROWS_AS(HBTK::to_integer("9223372036854775808"), std::invalid_argument);
+	REQUIRE_THROWS_AS(HBTK::to_integer("1.5"), std::invalid_argument);
+	REQUIRE(HBTK::to_int("-2147483648") == std::numeric_limits<int>::min());
+	REQUIRE_THROWS_AS(HBTK::to_int("2147483648"), std::invalid_argument);
+	REQUIRE_THROWS_AS(HBTK::to_int("x"), std::invalid_argument);
+}
+
+TEST_CASE("Read numbers from streams") {
+	std::istringstream stream(" 1.5\n\t-2e2 7 x");
+	double value;
+	int integer;
+	REQUIRE(HBTK::read_number(stream, value));
+	REQUIRE(value == 1.5);
+	REQUIRE(HBTK::read_number(stream, value));
+	REQUIRE(value == -200.);
+	REQUIRE(HBTK::read_number(stream, integer));
+	REQUIRE(integer == 7);
+	REQUIRE_FALSE(HBTK::read_number(stream, value));
+	REQUIRE(stream.fail());
+
+	std::istringstream end_stream("3");
+	REQUIRE(HBTK::read_number(end_stream, integer));
+	REQUIRE(end_stream.eof());
+	REQUIRE_FALSE(HBTK::read_number(end_stream, integer));
+}
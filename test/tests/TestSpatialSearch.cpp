@@ -0,0 +1,174 @@
+#include <HBTK/GmshMeshHolder.h>
+#include <HBTK/KdTree3D.h>
+#include <HBTK/SpatialHash3D.h>
+#include <HBTK/VtkUnstructuredMeshHolder.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+	std::vector<HBTK::CartesianPoint3D> random_points(int number, unsigned seed) {
+		std::mt19937 gen(seed);
+		std::uniform_real_distribution<double> pos(-1., 1.);
+		std::vector<HBTK::CartesianPoint3D> points;
+		for (int i = 0; i < number; i++) {
+			points.push_back(HBTK::CartesianPoint3D({ pos(gen), pos(gen), pos(gen) }));
+		}
+		return points;
+	}
+
+	std::vector<double> brute_distances(const std::vector<HBTK::CartesianPoint3D> & points,
+		const HBTK::CartesianPoint3D & point)
+	{
+		std::vector<double> dists;
+		for (auto & p : points) dists.push_back((p - point).magnitude());
+		return dists;
+	}
+}
+
+TEST_CASE("K-d tree 3D") {
+	std::vector<HBTK::CartesianPoint3D> points = random_points(5000, 1);
+	std::vector<HBTK::CartesianPoint3D> queries = random_points(100, 2);
+	HBTK::KdTree3D tree(points, 4);
+	REQUIRE(tree.size() == 5000);
+
+	SECTION("Nearest matches brute force") {
+		std::vector<int> idxs;
+		std::vector<double> dists;
+		tree.nearest(queries, idxs, dists, 3);
+		for (int i = 0; i < (int)queries.size(); i++) {
+			std::vector<double> brute = brute_distances(points, queries[i]);
+			auto best = std::min_element(brute.begin(), brute.end());
+			REQUIRE(idxs[i] == best - brute.begin());
+			REQUIRE(dists[i] == Approx(*best));
+		}
+	}
+
+	SECTION("K nearest matches brute force") {
+		std::vector<int> idxs;
+		std::vector<double> dists;
+		tree.k_nearest(queries, 7, idxs, dists, 3);
+		REQUIRE(idxs.size() == 7 * queries.size());
+		for (int i = 0; i < (int)queries.size(); i++) {
+			std::vector<double> brute = brute_distances(points, queries[i]);
+			std::sort(brute.begin(), brute.end());
+			for (int j = 0; j < 7; j++) {
+				REQUIRE(dists[i * 7 + j] == Approx(brute[j]));
+				REQUIRE((points[idxs[i * 7 + j]] - queries[i]).magnitude() == Approx(brute[j]));
+			}
+		}
+	}
+
+	SECTION("Radius query matches brute force") {
+		std::vector<std::vector<int>> found = tree.within_radius(queries, 0.2);
+		for (int i = 0; i < (int)queries.size(); i++) {
+			std::vector<double> brute = brute_distances(points, queries[i]);
+			std::vector<int> expected;
+			for (int j = 0; j < (int)points.size(); j++) {
+				if (brute[j] <= 0.2) expected.push_back(j);
+			}
+			REQUIRE(found[i] == expected);
+		}
+	}
+
+	SECTION("Small and empty trees") {
+		HBTK::KdTree3D small(std::vector<HBTK::CartesianPoint3D>(points.begin(), points.begin() + 3));
+		std::vector<int> idxs;
+		std::vector<double> dists;
+		small.k_nearest(std::vector<HBTK::CartesianPoint3D>({ queries[0] }), 5, idxs, dists);
+		REQUIRE(idxs[3] == -1);
+		REQUIRE(std::isinf(dists[4]));
+		HBTK::KdTree3D empty;
+		double dist;
+		REQUIRE(empty.nearest(queries[0], dist) == -1);
+	}
+}
+
+TEST_CASE("Spatial hash 3D") {
+	std::vector<HBTK::CartesianPoint3D> points = random_points(5000, 3);
+	HBTK::SpatialHash3D hash(points, 0.1);
+	REQUIRE(hash.size() == 5000);
+	REQUIRE_THROWS(hash.build(points, 0.));
+
+	SECTION("Radius query matches brute force") {
+		std::vector<HBTK::CartesianPoint3D> queries = random_points(50, 4);
+		std::vector<std::vector<int>> found = hash.within_radius(queries, 0.15);
+		for (int i = 0; i < (int)queries.size(); i++) {
+			std::vector<double> brute = brute_distances(points, queries[i]);
+			std::vector<int> expected;
+			for (int j = 0; j < (int)points.size(); j++) {
+				if (brute[j] <= 0.15) expected.push_back(j);
+			}
+			REQUIRE(found[i] == expected);
+			double dist;
+			int nearest = hash.nearest(queries[i], 0.15, dist);
+			if (expected.empty()) {
+				REQUIRE(nearest == -1);
+			}
+			else {
+				REQUIRE(dist == Approx(*std::min_element(brute.begin(), brute.end())));
+			}
+		}
+	}
+
+	SECTION("Coincident point map") {
+		std::vector<HBTK::CartesianPoint3D> pnts({
+			HBTK::CartesianPoint3D({ 0., 0., 0. }),
+			HBTK::CartesianPoint3D({ 1., 0., 0. }),
+			HBTK::CartesianPoint3D({ 1e-9, 0., 0. }),
+			HBTK::CartesianPoint3D({ 1., 1e-9, 0. }),
+			HBTK::CartesianPoint3D({ 2e-9, 0., 0. }) });
+		REQUIRE(HBTK::coincident_point_map(pnts, 1.5e-9) == std::vector<int>({ 0, 1, 0, 1, 0 }));
+		REQUIRE(HBTK::coincident_point_map(pnts, 0.) == std::vector<int>({ 0, 1, 2, 3, 4 }));
+	}
+
+	SECTION("Coincident point map far from the origin") {
+		std::vector<HBTK::CartesianPoint3D> pnts({
+			HBTK::CartesianPoint3D({ 3e7, -5e8, 1. }),
+			HBTK::CartesianPoint3D({ 1e20, 0., 0. }),
+			HBTK::CartesianPoint3D({ 3e7, -5e8, 1. }),
+			HBTK::CartesianPoint3D({ 1e20, 0., 0. }),
+			HBTK::CartesianPoint3D({ 3e7 + 1., -5e8, 1. }) });
+		REQUIRE(HBTK::coincident_point_map(pnts, 0.) == std::vector<int>({ 0, 1, 0, 1, 4 }));
+		REQUIRE(HBTK::coincident_point_map(pnts, 1e-9) == std::vector<int>({ 0, 1, 0, 1, 4 }));
+		REQUIRE(HBTK::coincident_point_map(pnts, 2.) == std::vector<int>({ 0, 1, 0, 1, 0 }));
+	}
+}
+
+TEST_CASE("Merging coincident mesh nodes") {
+	SECTION("VtkUnstructuredMeshHolder") {
+		HBTK::Vtk::VtkUnstructuredMeshHolder mesh;
+		mesh.points = std::vector<HBTK::CartesianPoint3D>({
+			HBTK::CartesianPoint3D({ 0., 0., 0. }),
+			HBTK::CartesianPoint3D({ 1., 0., 0. }),
+			HBTK::CartesianPoint3D({ 1., 1e-10, 0. }),
+			HBTK::CartesianPoint3D({ 2., 0., 0. }) });
+		mesh.cells.push_back({ HBTK::Vtk::VTK_LINE, { 0, 1 } });
+		mesh.cells.push_back({ HBTK::Vtk::VTK_LINE, { 2, 3 } });
+		std::vector<int> new_positions = mesh.merge_repeated_points(1e-8);
+		REQUIRE(new_positions == std::vector<int>({ 0, 1, 1, 2 }));
+		REQUIRE(mesh.points.size() == 3);
+		REQUIRE(mesh.cells[1].node_ids == std::vector<int>({ 1, 2 }));
+		REQUIRE(mesh.points[2] == HBTK::CartesianPoint3D({ 2., 0., 0. }));
+	}
+
+	SECTION("GmshMeshHolder") {
+		HBTK::Gmsh::GmshMeshHolder mesh;
+		mesh.add_node(5, HBTK::CartesianPoint3D({ 0., 0., 0. }));
+		mesh.add_node(7, HBTK::CartesianPoint3D({ 1., 0., 0. }));
+		mesh.add_node(3, HBTK::CartesianPoint3D({ 1., 0., 1e-10 }));
+		mesh.add_node(9, HBTK::CartesianPoint3D({ 2., 0., 0. }));
+		mesh.add_element(1, 1, { 5, 7 }, {});
+		mesh.add_element(2, 1, { 3, 9 }, {});
+		REQUIRE(mesh.merge_coincident_nodes(1e-8) == 1);
+		REQUIRE(mesh.number_of_nodes() == 3);
+		REQUIRE_FALSE(mesh.node_tag_exists(7));
+		REQUIRE(mesh.element_node_tags(1) == std::vector<int>({ 5, 3 }));
+		REQUIRE(mesh.nearest_node_tags({ HBTK::CartesianPoint3D({ 1.9, 0.1, 0. }) })
+			== std::vector<int>({ 9 }));
+	}
+}
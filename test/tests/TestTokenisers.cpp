@@ -1,5 +1,6 @@
 #include <HBTK/Token.h>
 #include <HBTK/BasicTokeniser.h>
+#include <HBTK/BufferedTokeniser.h>
 #include <catch2/catch.hpp>
 /*////////////////////////////////////////////////////////////////////////////
 TestTokeniser.cpp
@@ -27,6 +28,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */////////////////////////////////////////////////////////////////////////////
 
+#include <limits>
 #include <sstream>
 #include <vector>
 
@@ -176,3 +178,85 @@ TEST_CASE("Tokeniser & Tokens") {
 		REQUIRE(tokens[37].char_idx() == 8);
 	}
 }
+
+TEST_CASE("Buffered tokeniser") {
+	SECTION("Same tokens as BasicTokeniser") {
+		std::string str(
+			"$MeshFormat\n2.2 0 8\n$EndMeshFormat\n"
+			"foo_bar+12.5e-3 = (x1, y_2) \t\"quoted\"\n\n"
+			"Over mens noses as they lie asleep.");
+		HBTK::BasicTokeniser basic(str);
+		HBTK::BufferedTokeniser buffered(std::make_unique<std::istringstream>(str));
+		while (!basic.eof()) {
+			REQUIRE_FALSE(buffered.eof());
+			const HBTK::Token & a = basic.next();
+			const HBTK::Token & b = buffered.next();
+			REQUIRE(a.value() == b.value());
+			REQUIRE(buffered.view() == HBTK::StringView(a.value()));
+			REQUIRE(a.line() == b.line());
+			REQUIRE(a.char_idx() == b.char_idx());
+			REQUIRE(a.isnum() == b.isnum());
+			REQUIRE(a.isword() == b.isword());
+			REQUIRE(a.ispunct() == b.ispunct());
+			REQUIRE(a.iswhitespace() == b.iswhitespace());
+			REQUIRE(basic.position() == buffered.position());
+		}
+		REQUIRE(buffered.eof());
+	}
+
+	SECTION("Lookahead") {
+		HBTK::BufferedTokeniser tokeniser(std::string("a b c d e f g h i j"));
+		REQUIRE(tokeniser.current().value() == "a");
+		REQUIRE(tokeniser.peek(8).value() == "e");
+		REQUIRE(tokeniser.view(14) == "h");
+		REQUIRE_FALSE(tokeniser.eof());
+		HBTK::StringView second = tokeniser.view(2);
+		tokeniser.next();
+		tokeniser.next();
+		REQUIRE(tokeniser.current().value() == "b");
+		REQUIRE(second == "b");
+		REQUIRE(tokeniser.position() == 2);
+	}
+
+	SECTION("Number parsing") {
+		HBTK::BufferedTokeniser tokeniser(std::string(
+			"12 1.5e-3 .25 3. 7E+2 2elements -4.75 123456789012345678901 x1"), true);
+		std::vector<HBTK::Token> tokens;
+		while (!tokeniser.eof()) { tokens.push_back(tokeniser.next()); }
+		REQUIRE(tokens[0].isinteger());
+		REQUIRE(tokens[0].integer() == 12);
+		REQUIRE(tokens[2].isfloat());
+		REQUIRE(tokens[2].value() == "1.5e-3");
+		REQUIRE(tokens[2].number() == 1.5e-3);
+		REQUIRE(tokens[4].number() == 0.25);
+		REQUIRE(tokens[6].value() == "3.");
+		REQUIRE(tokens[6].number() == 3.);
+		REQUIRE(tokens[8].isnum());
+		REQUIRE(tokens[8].number() == 700.);
+		// Exponent only taken if digits follow.
+		REQUIRE(tokens[10].integer() == 2);
+		REQUIRE(tokens[11].value() == "elements");
+		REQUIRE(tokens[13].ispunct());
+		REQUIRE(tokens[14].number() == 4.75);
+		REQUIRE(tokens[16].isinteger());
+		REQUIRE(tokens[16].number() == Approx(1.23456789012345678901e20));
+		REQUIRE(tokens[18].isword());
+		REQUIRE(tokens[18].value() == "x1");
+		REQUIRE(tokens.size() == 19);
+	}
+
+	SECTION("Huge numbers saturate as integers") {
+		HBTK::BufferedTokeniser tokeniser(std::string("1.0e300 123456789012345678901"), true);
+		std::vector<HBTK::Token> tokens;
+		while (!tokeniser.eof()) { tokens.push_back(tokeniser.next()); }
+		REQUIRE(tokens[0].isfloat());
+		REQUIRE(tokens[0].integer() == std::numeric_limits<long long>::max());
+		REQUIRE(tokens[2].integer() == std::numeric_limits<long long>::max());
+	}
+
+	SECTION("Unparsed numbers convert on request") {
+		HBTK::BufferedTokeniser tokeniser(std::string("42"));
+		REQUIRE(tokeniser.current().integer() == 42);
+		REQUIRE(tokeniser.current().number() == 42.);
+	}
+}
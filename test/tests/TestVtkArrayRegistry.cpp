@@ -0,0 +1,114 @@
+#include <HBTK/VtkArrayRegistry.h>
+#include <HBTK/VtkUnstructuredMeshParser.h>
+#include <HBTK/VtkWriter.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	using Registry = HBTK::Vtk::VtkArrayRegistry;
+
+	// Tuple i, component j is 10 * i + j.
+	void fill(Registry & arrays, Registry::handle array)
+	{
+		for (int i = 0; i < arrays.tuples(array); i++) {
+			for (int j = 0; j < arrays.components(array); j++) {
+				arrays.set_value(array, i, j, 10. * i + j);
+			}
+		}
+	}
+
+	bool filled(const Registry & arrays, Registry::handle array, const std::vector<int> & order)
+	{
+		bool ok = arrays.tuples(array) == (int)order.size();
+		for (int i = 0; ok && i < (int)order.size(); i++) {
+			for (int j = 0; j < arrays.components(array); j++) {
+				ok = ok && arrays.value(array, i, j) == 10. * order[i] + j;
+			}
+		}
+		return ok;
+	}
+}
+
+TEST_CASE("Vtk array registry") {
+	Registry arrays;
+	Registry::handle a = arrays.add("a", Registry::FLOAT32, 2, 3);
+	Registry::handle b = arrays.add("b", Registry::FLOAT64, 3, 3, Registry::COMPONENT_ARRAYS);
+	Registry::handle c = arrays.add("c", Registry::INT64, 1, 3);
+	fill(arrays, a);
+	fill(arrays, b);
+	fill(arrays, c);
+
+	SECTION("Handles and typed access") {
+		REQUIRE(arrays.size() == 3);
+		REQUIRE(arrays.find("b") == b);
+		REQUIRE(arrays.find("d") == -1);
+		REQUIRE(arrays.data<float>(a)[3] == 11.f);
+		REQUIRE(arrays.data<double>(b)[3 + 1] == 11.);
+		REQUIRE_THROWS_AS(arrays.data<double>(a), std::invalid_argument);
+		REQUIRE_THROWS_AS(arrays.add("a", Registry::INT32, 1, 3), std::invalid_argument);
+		arrays.remove(a);
+		REQUIRE(arrays.handles() == std::vector<Registry::handle>({ b, c }));
+		REQUIRE(arrays.name(c) == "c");
+		REQUIRE_THROWS_AS(arrays.tuples(a), std::invalid_argument);
+		REQUIRE_THROWS_AS(arrays.set_output_type(c, Registry::FLOAT32), std::invalid_argument);
+	}
+
+	SECTION("Resize, reorder and append") {
+		arrays.resize(b, 4);
+		REQUIRE(arrays.value(b, 2, 2) == 22.);
+		REQUIRE(arrays.value(b, 3, 2) == 0.);
+		arrays.resize(b, 3);
+		arrays.reorder({ 2, 0, 1 });
+		for (auto array : { a, b, c }) { REQUIRE(filled(arrays, array, { 1, 2, 0 })); }
+
+		Registry more;
+		Registry::handle more_a = more.add("a", Registry::FLOAT32, 2, 2, Registry::COMPONENT_ARRAYS);
+		fill(more, more_a);
+		fill(more, more.add("b", Registry::FLOAT64, 3, 2));
+		fill(more, more.add("c", Registry::INT64, 1, 2));
+		REQUIRE(arrays.same_arrays(more));
+		arrays.append(more);
+		for (auto array : { a, b, c }) { REQUIRE(filled(arrays, array, { 1, 2, 0, 0, 1 })); }
+		more.remove(more_a);
+		REQUIRE_THROWS_AS(arrays.append(more), std::invalid_argument);
+	}
+
+	SECTION("Written as stored and read back") {
+		HBTK::Vtk::VtkUnstructuredDataset data;
+		for (int i = 0; i < 3; i++) { data.mesh.points.push_back(HBTK::CartesianPoint3D({ (double)i, 0., 0. })); }
+		data.mesh.cells.push_back({ HBTK::Vtk::VTK_TRIANGLE, { 0, 1, 2 } });
+		data.point_arrays = arrays;
+		data.point_arrays.set_output_type(b, Registry::FLOAT32);
+		fill(data.cell_arrays, data.cell_arrays.add("d", Registry::INT32, 4, 1, Registry::COMPONENT_ARRAYS));
+
+		for (int mode = 0; mode < 3; mode++) {
+			HBTK::Vtk::VtkWriter writer;
+			writer.ascii = mode == 0;
+			writer.appended = mode == 2;
+			std::ostringstream out;
+			writer.open_file(out, HBTK::Vtk::VtkWriter::UnstructuredGrid);
+			writer.write_piece(out, data);
+			writer.close_file(out);
+
+			HBTK::Vtk::VtkParser parser;
+			parser.typed_arrays = true;
+			HBTK::Vtk::VtkUnstructuredDataset read = parser.parse_dataset(HBTK::ByteSource::from_string(out.str()));
+			REQUIRE(read.point_arrays.size() == 3);
+			REQUIRE(read.scalar_point_data.empty());
+			Registry::handle read_b = read.point_arrays.find("b");
+			REQUIRE(read.point_arrays.type(read_b) == Registry::FLOAT32);
+			REQUIRE(filled(read.point_arrays, read_b, { 0, 1, 2 }));
+			Registry::handle read_c = read.point_arrays.find("c");
+			REQUIRE(read.point_arrays.type(read_c) == Registry::INT64);
+			REQUIRE(filled(read.point_arrays, read_c, { 0, 1, 2 }));
+			REQUIRE(filled(read.point_arrays, read.point_arrays.find("a"), { 0, 1, 2 }));
+			Registry::handle read_d = read.cell_arrays.find("d");
+			REQUIRE(read.cell_arrays.data<int32_t>(read_d)[3] == 3);
+		}
+	}
+}
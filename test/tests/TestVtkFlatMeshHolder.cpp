@@ -0,0 +1,108 @@
+#include <HBTK/VtkFlatMeshHolder.h>
+#include <HBTK/VtkUnstructuredDataset.h>
+#include <HBTK/VtkUnstructuredMeshParser.h>
+#include <HBTK/VtkWriter.h>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	// Two triangles and a quad on a 3 x 2 grid of points.
+	HBTK::Vtk::VtkFlatDataset small_dataset()
+	{
+		HBTK::Vtk::VtkFlatDataset data;
+		data.mesh.reserve(6, 3, 10);
+		for (int j = 0; j < 2; j++) {
+			for (int i = 0; i < 3; i++) {
+				data.mesh.add_point(HBTK::CartesianPoint3D({ (double)i, (double)j, 0.5 * i }));
+			}
+		}
+		data.mesh.add_cell(HBTK::Vtk::VTK_TRIANGLE, { 0, 1, 4 });
+		data.mesh.add_cell(HBTK::Vtk::VTK_TRIANGLE, { 0, 4, 3 });
+		data.mesh.add_cell(HBTK::Vtk::VTK_QUAD, { 1, 2, 5, 4 });
+		data.scalar_point_data["t"] = { 0., 1., 2., 3., 4., 5. };
+		data.integer_cell_data["zone"] = { 7, 7, 8 };
+		data.vector_cell_data["n"] = std::vector<HBTK::CartesianVector3D>(3, HBTK::CartesianVector3D({ 0., 0., 1. }));
+		return data;
+	}
+}
+
+TEST_CASE("Vtk flat mesh holder") {
+	HBTK::Vtk::VtkFlatDataset data = small_dataset();
+	HBTK::Vtk::VtkFlatMeshHolder & mesh = data.mesh;
+
+	SECTION("Layout") {
+		REQUIRE(mesh.number_of_points() == 6);
+		REQUIRE(mesh.number_of_cells() == 3);
+		REQUIRE(mesh.offsets == std::vector<int>({ 0, 3, 6, 10 }));
+		REQUIRE(mesh.connectivity.capacity() == 10);
+		REQUIRE(mesh.cell_type(2) == HBTK::Vtk::VTK_QUAD);
+		REQUIRE(mesh.cell_size(2) == 4);
+		REQUIRE(mesh.cell_nodes(1)[2] == 3);
+		REQUIRE(mesh.points.x()[5] == 2.);
+		REQUIRE(mesh.check_consistant_node_counts().empty());
+		REQUIRE(mesh.check_valid_cell_nodes_ids().empty());
+		mesh.add_cell(HBTK::Vtk::VTK_TRIANGLE, { 0, 1, 6 });
+		REQUIRE(mesh.check_valid_cell_nodes_ids() == std::vector<int>({ 3 }));
+		mesh.add_cell(HBTK::Vtk::VTK_QUAD, { 0, 1, 2 });
+		REQUIRE(mesh.check_consistant_node_counts() == std::vector<int>({ 4 }));
+		mesh.clear();
+		REQUIRE(mesh.number_of_cells() == 0);
+		REQUIRE(mesh.offsets == std::vector<int>({ 0 }));
+	}
+
+	SECTION("Conversion to and from cell-per-node-list meshes") {
+		HBTK::Vtk::VtkUnstructuredMeshHolder unstructured = mesh.to_unstructured();
+		REQUIRE(unstructured.cells[2].node_ids == std::vector<int>({ 1, 2, 5, 4 }));
+		REQUIRE(unstructured.points[4] == HBTK::CartesianPoint3D({ 1., 1., 0.5 }));
+		HBTK::Vtk::VtkFlatMeshHolder packed(unstructured);
+		REQUIRE(packed.connectivity == mesh.connectivity);
+		REQUIRE(packed.offsets == mesh.offsets);
+		REQUIRE(packed.types == mesh.types);
+		REQUIRE(packed.points.y() == mesh.points.y());
+	}
+
+	SECTION("Reordering and topology") {
+		data.reorder_cells({ 1, 2, 0 });
+		REQUIRE(mesh.cell_type(0) == HBTK::Vtk::VTK_QUAD);
+		REQUIRE(mesh.offsets == std::vector<int>({ 0, 4, 7, 10 }));
+		REQUIRE(mesh.cell_nodes(1)[1] == 1);
+		REQUIRE(data.integer_cell_data["zone"] == std::vector<int>({ 8, 7, 7 }));
+		data.reorder_points({ 5, 4, 3, 2, 1, 0 });
+		REQUIRE(mesh.points[0] == HBTK::CartesianPoint3D({ 2., 1., 1. }));
+		REQUIRE(mesh.cell_nodes(0)[0] == 4);
+		REQUIRE(data.scalar_point_data["t"][0] == 5.);
+		HBTK::MeshTopology topology = mesh.topology(1);
+		REQUIRE(topology.number_of_elements() == 3);
+		REQUIRE(topology.boundary_faces().size() == 6);
+	}
+
+	SECTION("Write and read back") {
+		for (int mode = 0; mode < 3; mode++) {
+			HBTK::Vtk::VtkWriter writer;
+			writer.ascii = mode == 0;
+			writer.appended = mode == 2;
+			writer.write_precision = 17;
+			std::ostringstream out;
+			writer.open_file(out, HBTK::Vtk::VtkWriter::UnstructuredGrid);
+			writer.write_piece(out, data);
+			writer.write_piece(out, data);
+			writer.close_file(out);
+			if (mode != 0) { REQUIRE(out.str().find("\"UInt8\"") != std::string::npos); }
+
+			HBTK::Vtk::VtkParser parser;
+			HBTK::Vtk::VtkUnstructuredDataset read = parser.parse_dataset(HBTK::ByteSource::from_string(out.str()));
+			HBTK::Vtk::VtkFlatDataset flat(read);
+			REQUIRE(flat.mesh.number_of_cells() == 6);
+			REQUIRE(flat.mesh.types[4] == HBTK::Vtk::VTK_TRIANGLE);
+			REQUIRE(flat.mesh.connectivity[6 + 10] == 1 + 6);
+			REQUIRE(flat.mesh.points.z()[8] == 1.);
+			REQUIRE(flat.scalar_point_data["t"][7] == 1.);
+			REQUIRE(flat.integer_cell_data["zone"] == std::vector<int>({ 7, 7, 8, 7, 7, 8 }));
+			REQUIRE(flat.vector_cell_data["n"][5] == HBTK::CartesianVector3D({ 0., 0., 1. }));
+		}
+	}
+}
@@ -0,0 +1,265 @@
+#include <HBTK/Base64.h>
+#include <HBTK/Gzip.h>
+#include <HBTK/VtkUnstructuredMeshParser.h>
+#include <HBTK/VtkWriter.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	// A strip of n quadrilaterals with some data, offset in y.
+	HBTK::Vtk::VtkUnstructuredDataset quad_strip(int n, double y)
+	{
+		HBTK::Vtk::VtkUnstructuredDataset data;
+		for (int i = 0; i <= n; i++) {
+			data.mesh.points.push_back(HBTK::CartesianPoint3D({ 0.1 * i, y, 0. }));
+			data.mesh.points.push_back(HBTK::CartesianPoint3D({ 0.1 * i, y + 1., 0.25 }));
+		}
+		for (int i = 0; i < n; i++) {
+			data.mesh.cells.push_back({ HBTK::Vtk::VTK_QUAD, { 2 * i, 2 * i + 2, 2 * i + 3, 2 * i + 1 } });
+		}
+		for (int i = 0; i < (int)data.mesh.points.size(); i++) {
+			data.scalar_point_data["pressure"].push_back(i * 0.5 - y);
+			data.integer_point_data["id"].push_back(i);
+			data.vector_point_data["velocity"].push_back(HBTK::CartesianVector3D({ (double)i, -y, 2. }));
+		}
+		for (int i = 0; i < n; i++) {
+			data.scalar_cell_data["area"].push_back(0.1 + i);
+			data.integer_cell_data["group"].push_back(i % 3);
+		}
+		return data;
+	}
+
+	std::string write_vtu(const std::vector<HBTK::Vtk::VtkUnstructuredDataset> & pieces, bool ascii, bool appended)
+	{
+		HBTK::Vtk::VtkWriter writer;
+		writer.ascii = ascii;
+		writer.appended = appended;
+		writer.write_precision = 17;
+		std::ostringstream out;
+		writer.open_file(out, HBTK::Vtk::VtkWriter::UnstructuredGrid);
+		for (auto & piece : pieces) { writer.write_piece(out, piece); }
+		writer.close_file(out);
+		return out.str();
+	}
+
+	void require_same(const HBTK::Vtk::VtkUnstructuredDataset & a, const HBTK::Vtk::VtkUnstructuredDataset & b)
+	{
+		REQUIRE(a.mesh.points.size() == b.mesh.points.size());
+		for (int i = 0; i < (int)a.mesh.points.size(); i++) {
+			REQUIRE(a.mesh.points[i] == b.mesh.points[i]);
+		}
+		REQUIRE(a.mesh.cells.size() == b.mesh.cells.size());
+		for (int i = 0; i < (int)a.mesh.cells.size(); i++) {
+			REQUIRE(a.mesh.cells[i].cell_type == b.mesh.cells[i].cell_type);
+			REQUIRE(a.mesh.cells[i].node_ids == b.mesh.cells[i].node_ids);
+		}
+		REQUIRE(a.scalar_point_data == b.scalar_point_data);
+		REQUIRE(a.integer_point_data == b.integer_point_data);
+		REQUIRE(a.scalar_cell_data == b.scalar_cell_data);
+		REQUIRE(a.integer_cell_data == b.integer_cell_data);
+		REQUIRE(a.vector_point_data.size() == b.vector_point_data.size());
+		for (auto & vec : a.vector_point_data) {
+			REQUIRE(b.vector_point_data.count(vec.first) == 1);
+			const auto & other = b.vector_point_data.at(vec.first);
+			REQUIRE(vec.second.size() == other.size());
+			for (int i = 0; i < (int)other.size(); i++) { REQUIRE(vec.second[i] == other[i]); }
+		}
+	}
+
+	// Little endian bytes of a value.
+	template<typename T>
+	void put(std::string & bytes, T value)
+	{
+		bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	// A vtkZLibDataCompressor array: UInt32 header and blocks, encoded separately.
+	std::string compressed_base64(const std::string & data, size_t block_size)
+	{
+		std::string header, blocks;
+		uint32_t n_blocks = (uint32_t)((data.size() + block_size - 1) / block_size);
+		put(header, n_blocks);
+		put(header, (uint32_t)block_size);
+		put(header, (uint32_t)(data.size() % block_size));
+		for (size_t i = 0; i < data.size(); i += block_size) {
+			std::string block = HBTK::zlib_compress(data.data() + i, std::min(block_size, data.size() - i));
+			put(header, (uint32_t)block.size());
+			blocks += block;
+		}
+		return HBTK::encode_base64((unsigned char*)&header[0], (int)header.size())
+			+ HBTK::encode_base64((unsigned char*)&blocks[0], (int)blocks.size());
+	}
+}
+
+TEST_CASE("Vtk parser") {
+	std::vector<HBTK::Vtk::VtkUnstructuredDataset> pieces({ quad_strip(5, 0.), quad_strip(3, 2.) });
+
+	SECTION("Round trip ascii, binary and appended files") {
+		for (int mode = 0; mode < 3; mode++) {
+			std::string file = write_vtu(pieces, mode == 0, mode == 2);
+			HBTK::Vtk::VtkParser parser;
+			std::vector<HBTK::Vtk::VtkUnstructuredDataset> read;
+			parser.add_piece_function([&](HBTK::Vtk::VtkUnstructuredDataset & piece)->bool {
+				read.push_back(piece);
+				return true;
+			});
+			parser.parse(HBTK::ByteSource::from_string(file));
+			REQUIRE(read.size() == 2);
+			require_same(read[0], pieces[0]);
+			require_same(read[1], pieces[1]);
+		}
+	}
+
+	SECTION("Whole file as one dataset") {
+		HBTK::Vtk::VtkParser parser;
+		HBTK::Vtk::VtkUnstructuredDataset data = parser.parse_dataset(
+			HBTK::ByteSource::from_string(write_vtu(pieces, false, true)));
+		HBTK::Vtk::VtkUnstructuredDataset expected = pieces[0];
+		expected.append(pieces[1]);
+		require_same(data, expected);
+		REQUIRE(data.mesh.cells[5].node_ids == std::vector<int>({ 12, 14, 15, 13 }));
+	}
+
+	SECTION("Stream from an unseekable gzip stream") {
+		std::string file = write_vtu(pieces, false, true);
+		std::string compressed = HBTK::gzip_compress(file.data(), file.size());
+		HBTK::GzipInputStream stream(HBTK::ByteSource::from_string(compressed));
+		HBTK::Vtk::VtkParser parser;
+		int count = 0;
+		parser.add_piece_function([&](HBTK::Vtk::VtkUnstructuredDataset & piece)->bool {
+			require_same(piece, pieces[count++]);
+			return true;
+		});
+		parser.parse(stream);
+		REQUIRE(count == 2);
+	}
+
+	SECTION("Compressed, self closing tags and unused elements") {
+		std::string points, connectivity, offsets;
+		for (float v : { 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f }) { put(points, v); }
+		for (int32_t v : { 0, 1, 2 }) { put(connectivity, v); }
+		put(offsets, (int32_t)3);
+		std::string file =
+			"<?xml version=\"1.0\"?>\n"
+			"<!-- Written by hand > -->\n"
+			"<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">\n"
+			"<UnstructuredGrid>\n"
+			"<FieldData><DataArray type=\"Float64\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">0</DataArray></FieldData>\n"
+			"<Piece NumberOfPoints='3' NumberOfCells='1'>\n"
+			"<PointData/>\n"
+			"<Points><DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"binary\">"
+			+ compressed_base64(points, 16) + "</DataArray></Points>\n"
+			"<Cells>\n"
+			"<DataArray type=\"Int32\" Name=\"connectivity\" format=\"binary\">" + compressed_base64(connectivity, 32768) + "</DataArray>\n"
+			"<DataArray type=\"Int32\" Name=\"offsets\" format=\"binary\">" + compressed_base64(offsets, 32768) + "</DataArray>\n"
+			"<DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\"> 5 </DataArray>\n"
+			"</Cells>\n"
+			"<CellData><DataArray type=\"Float64\" Name=\"tensor\" NumberOfComponents=\"9\" format=\"ascii\">1 2 3 4 5 6 7 8 9</DataArray></CellData>\n"
+			"</Piece>\n"
+			"</UnstructuredGrid>\n"
+			"</VTKFile>\n";
+		HBTK::Vtk::VtkParser parser;
+		std::ostringstream errors;
+		std::istringstream input(file);
+		HBTK::Vtk::VtkUnstructuredDataset data;
+		parser.add_piece_function([&](HBTK::Vtk::VtkUnstructuredDataset & piece)->bool {
+			data = piece;
+			return true;
+		});
+		parser.parse(input, errors);
+		REQUIRE(data.mesh.points.size() == 3);
+		REQUIRE(data.mesh.points[2] == HBTK::CartesianPoint3D({ 0., 1., 0. }));
+		REQUIRE(data.mesh.cells.size() == 1);
+		REQUIRE(data.mesh.cells[0].cell_type == HBTK::Vtk::VTK_TRIANGLE);
+		REQUIRE(data.mesh.cells[0].node_ids == std::vector<int>({ 0, 1, 2 }));
+		REQUIRE(data.scalar_cell_data.empty());
+		HBTK::Vtk::VtkArrayRegistry::handle tensor = data.cell_arrays.find("tensor");
+		REQUIRE(tensor >= 0);
+		REQUIRE(data.cell_arrays.type(tensor) == HBTK::Vtk::VtkArrayRegistry::FLOAT64);
+		REQUIRE(data.cell_arrays.components(tensor) == 9);
+		REQUIRE(data.cell_arrays.value(tensor, 0, 5) == 6.);
+		REQUIRE(errors.str().empty());
+	}
+
+	SECTION("Bad files") {
+		HBTK::Vtk::VtkParser parser;
+		std::string file = write_vtu(pieces, false, false);
+		std::string image = file;
+		image.replace(image.find("UnstructuredGrid"), 16, "ImageData");
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(image)), std::invalid_argument);
+		std::string lz4 = file;
+		lz4.replace(lz4.find("header_type"), 11, "compressor=\"vtkLZ4DataCompressor\" header_type");
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(lz4)), std::invalid_argument);
+	}
+
+	SECTION("Bad cell types and node ids") {
+		auto line_file = [](const std::string & type, const std::string & node) {
+			return "<?xml version=\"1.0\"?>\n"
+				"<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\">\n"
+				"<UnstructuredGrid>\n"
+				"<Piece NumberOfPoints=\"2\" NumberOfCells=\"1\">\n"
+				"<Points><DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">0 0 0 1 0 0</DataArray></Points>\n"
+				"<Cells>\n"
+				"<DataArray type=\"Int32\" Name=\"types\" format=\"ascii\">" + type + "</DataArray>\n"
+				"<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">2</DataArray>\n"
+				"<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">0 " + node + "</DataArray>\n"
+				"</Cells>\n"
+				"</Piece>\n"
+				"</UnstructuredGrid>\n"
+				"</VTKFile>\n";
+		};
+		HBTK::Vtk::VtkParser parser;
+		REQUIRE(parser.parse_dataset(HBTK::ByteSource::from_string(line_file("3", "1"))).mesh.cells.size() == 1);
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(line_file("63493", "1"))), std::invalid_argument);
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(line_file("0", "1"))), std::invalid_argument);
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(line_file("3", "2"))), std::invalid_argument);
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(line_file("3", "-1"))), std::invalid_argument);
+	}
+
+	SECTION("Corrupt compressed appended header") {
+		// (3 + 2^61 - 2) * 8 header bytes wraps to 8.
+		std::string header;
+		put(header, (uint64_t)((1ull << 61) - 2));
+		put(header, (uint64_t)32768);
+		put(header, (uint64_t)0);
+		std::string file =
+			"<?xml version=\"1.0\"?>\n"
+			"<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\" compressor=\"vtkZLibDataCompressor\">\n"
+			"<UnstructuredGrid>\n"
+			"<Piece NumberOfPoints=\"1\" NumberOfCells=\"0\">\n"
+			"<Points><DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"appended\" offset=\"0\"/></Points>\n"
+			"</Piece>\n"
+			"</UnstructuredGrid>\n";
+		std::string raw = file + "<AppendedData encoding=\"raw\">_" + header + "\n</AppendedData>\n</VTKFile>\n";
+		std::string base64 = file + "<AppendedData encoding=\"base64\">_"
+			+ HBTK::encode_base64((unsigned char*)&header[0], (int)header.size()) + "\n</AppendedData>\n</VTKFile>\n";
+		HBTK::Vtk::VtkParser parser;
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(raw)), std::invalid_argument);
+		REQUIRE_THROWS_AS(parser.parse(HBTK::ByteSource::from_string(base64)), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Base64 decode of concatenated blocks") {
+	std::string text = HBTK::encode_base64((unsigned char*)"head", 4)
+		+ "\n " + HBTK::encode_base64((unsigned char*)"body.", 5);
+	std::vector<unsigned char> out(text.size());
+	size_t n = HBTK::decode_base64(text.data(), text.size(), out.data());
+	REQUIRE(std::string(out.begin(), out.begin() + n) == "headbody.");
+}
+
+TEST_CASE("Zlib round trip") {
+	std::string data;
+	for (int i = 0; i < 50000; i++) { data += (char)('a' + (i * i) % 7); }
+	std::string compressed = HBTK::zlib_compress(data.data(), data.size());
+	REQUIRE(compressed.size() < data.size());
+	std::string out = "x";
+	HBTK::zlib_decompress(compressed.data(), compressed.size(), out);
+	REQUIRE(out == "x" + data);
+	compressed[compressed.size() - 1] ^= 1;
+	REQUIRE_THROWS_AS(HBTK::zlib_decompress(compressed.data(), compressed.size(), out), std::invalid_argument);
+}
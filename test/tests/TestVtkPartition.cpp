@@ -0,0 +1,118 @@
+#include <HBTK/VtkPartition.h>
+#include <HBTK/VtkPvtuWriter.h>
+#include <HBTK/VtkUnstructuredMeshParser.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+	// n x n quadrilaterals in shuffled order, with data.
+	HBTK::Vtk::VtkUnstructuredDataset shuffled_grid(int n)
+	{
+		HBTK::Vtk::VtkUnstructuredDataset data;
+		for (int j = 0; j <= n; j++) {
+			for (int i = 0; i <= n; i++) {
+				data.mesh.points.push_back(HBTK::CartesianPoint3D({ (double)i, (double)j, 0. }));
+				data.scalar_point_data["x"].push_back(i);
+			}
+		}
+		std::vector<int> order(n * n);
+		for (int i = 0; i < n * n; i++) { order[i] = i; }
+		std::shuffle(order.begin(), order.end(), std::mt19937(3));
+		for (int c : order) {
+			const int i = c % n, j = c / n, p = j * (n + 1) + i;
+			data.mesh.cells.push_back({ HBTK::Vtk::VTK_QUAD, { p, p + 1, p + n + 2, p + n + 1 } });
+			data.integer_cell_data["cell"].push_back(c);
+		}
+		HBTK::Vtk::VtkArrayRegistry::handle y = data.point_arrays.add("y", HBTK::Vtk::VtkArrayRegistry::FLOAT32, 1, (int)data.mesh.points.size());
+		for (int i = 0; i < (int)data.mesh.points.size(); i++) { data.point_arrays.data<float>(y)[i] = (float)(i / (n + 1)); }
+		return data;
+	}
+
+	// Points in more than one part.
+	int shared_points(const HBTK::Vtk::VtkUnstructuredDataset & data, const std::vector<int> & cell_part)
+	{
+		std::vector<int> part(data.mesh.points.size(), -1);
+		std::vector<char> shared(data.mesh.points.size(), 0);
+		for (int c = 0; c < (int)cell_part.size(); c++) {
+			for (int id : data.mesh.cells[c].node_ids) {
+				if (part[id] >= 0 && part[id] != cell_part[c]) { shared[id] = 1; }
+				part[id] = cell_part[c];
+			}
+		}
+		return (int)std::count(shared.begin(), shared.end(), 1);
+	}
+}
+
+TEST_CASE("Vtk partitioning") {
+	HBTK::Vtk::VtkUnstructuredDataset data = shuffled_grid(20);
+
+	SECTION("Parts are balanced, graph parts are compact") {
+		for (auto cell_part : { HBTK::Vtk::contiguous_partition(data.mesh, 7),
+			HBTK::Vtk::graph_partition(data.mesh, 7) }) {
+			std::vector<std::vector<int>> cells = HBTK::Vtk::part_cells(cell_part, 7);
+			for (auto & part : cells) {
+				REQUIRE(part.size() >= 57);
+				REQUIRE(part.size() <= 58);
+			}
+		}
+		// A shuffled grid split contiguously shares most points.
+		REQUIRE(shared_points(data, HBTK::Vtk::graph_partition(data.mesh, 4)) < 100);
+		REQUIRE(shared_points(data, HBTK::Vtk::contiguous_partition(data.mesh, 4)) > 300);
+		REQUIRE_THROWS_AS(HBTK::Vtk::part_cells({ 0, 2 }, 2), std::invalid_argument);
+	}
+
+	SECTION("Pieces keep their data") {
+		std::vector<HBTK::Vtk::VtkUnstructuredDataset> pieces =
+			HBTK::Vtk::split_dataset(data, HBTK::Vtk::graph_partition(data.mesh, 3), 3, 2);
+		REQUIRE(pieces.size() == 3);
+		int cells = 0;
+		for (auto & piece : pieces) {
+			cells += (int)piece.mesh.cells.size();
+			HBTK::Vtk::VtkArrayRegistry::handle y = piece.point_arrays.find("y");
+			for (int i = 0; i < (int)piece.mesh.points.size(); i++) {
+				REQUIRE(piece.scalar_point_data["x"][i] == piece.mesh.points[i].x());
+				REQUIRE(piece.point_arrays.value(y, i, 0) == piece.mesh.points[i].y());
+			}
+			for (int i = 0; i < (int)piece.mesh.cells.size(); i++) {
+				const int c = piece.integer_cell_data["cell"][i];
+				REQUIRE(piece.mesh.points[piece.mesh.cells[i].node_ids[0]] 
+					== HBTK::CartesianPoint3D({ (double)(c % 20), (double)(c / 20), 0. }));
+			}
+		}
+		REQUIRE(cells == 400);
+	}
+
+	SECTION("Pvtu file and pieces") {
+		const std::string path = "TestVtkPartition.pvtu";
+		REQUIRE(HBTK::Vtk::VtkPvtuWriter::piece_path("dir.d/name.pvtu", 2) == "dir.d/name_2.vtu");
+		REQUIRE(HBTK::Vtk::VtkPvtuWriter::piece_path("dir.d/name", 0) == "dir.d/name_0.vtu");
+		HBTK::Vtk::VtkPvtuWriter writer;
+		writer.num_threads = 2;
+		writer.write(path, data, HBTK::Vtk::graph_partition(data.mesh, 3), 3);
+
+		std::ifstream pvtu(path);
+		std::stringstream pvtu_text;
+		pvtu_text << pvtu.rdbuf();
+		pvtu.close();
+		REQUIRE(pvtu_text.str().find("<Piece Source=\"TestVtkPartition_2.vtu\">") != std::string::npos);
+		REQUIRE(pvtu_text.str().find("<PDataArray type=\"Float32\" Name=\"y\"") != std::string::npos);
+		REQUIRE(pvtu_text.str().find("<PDataArray type=\"Int64\" Name=\"cell\"") != std::string::npos);
+
+		int cells = 0;
+		for (int i = 0; i < 3; i++) {
+			HBTK::Vtk::VtkParser parser;
+			cells += (int)parser.parse_dataset(HBTK::Vtk::VtkPvtuWriter::piece_path(path, i)).mesh.cells.size();
+			std::remove(HBTK::Vtk::VtkPvtuWriter::piece_path(path, i).c_str());
+		}
+		std::remove(path.c_str());
+		REQUIRE(cells == 400);
+	}
+}